@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include "mts/audio/buffer.h"
+
+// A stereo scratch buffer per callback, from the system allocator against a pool.
+// Many channels of a power of two size processed in lockstep, packed against staggered.
+
+namespace {
+void BM_buffer_allocate(benchmark::State& state) {
+  const std::size_t buffer_size = (std::size_t)state.range(0);
+
+  for (auto _ : state) {
+    mts::audio_buffer<float> buffer(buffer_size, 2);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+
+void BM_buffer_pool(benchmark::State& state) {
+  const std::size_t buffer_size = (std::size_t)state.range(0);
+  mts::audio_buffer_pool<float> pool(4, 4096, 2);
+
+  for (auto _ : state) {
+    mts::audio_buffer<float> buffer = pool.acquire(buffer_size, 2);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+
+// Removes the mean of all the channels, frame by frame.
+void BM_buffer_channel_stagger(benchmark::State& state) {
+  const std::size_t n_channels = (std::size_t)state.range(0);
+  constexpr std::size_t buffer_size = 1024;
+
+  mts::buffer_allocation_policy policy;
+  policy.channel_stagger = (std::size_t)state.range(1);
+  mts::audio_buffer<float> buffer(buffer_size, n_channels, policy);
+
+  for (std::size_t c = 0; c < n_channels; c++) {
+    mts::vec::fill(buffer[c], 1, (float)c, buffer_size);
+  }
+
+  float* const* channels = buffer.data();
+  const float scale = 1.0f / (float)n_channels;
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < buffer_size; i++) {
+      float mean = 0;
+      for (std::size_t c = 0; c < n_channels; c++) {
+        mean += channels[c][i];
+      }
+
+      mean *= scale;
+      for (std::size_t c = 0; c < n_channels; c++) {
+        channels[c][i] -= mean;
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * buffer_size * n_channels));
+}
+} // namespace
+
+BENCHMARK(BM_buffer_allocate)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_buffer_pool)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_buffer_channel_stagger)->ArgNames({ "channels", "stagger" })->ArgsProduct({ { 16, 32, 64 }, { 0, 1 } });
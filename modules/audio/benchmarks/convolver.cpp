@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+#include "mts/audio/convolver.h"
+#include "mts/audio/buffer.h"
+#include <cmath>
+#include <vector>
+
+// Stereo convolution with a 2 second impulse response at 48 kHz, per host block.
+
+namespace {
+void BM_convolver(benchmark::State& state) {
+  constexpr std::size_t ir_size = 96000;
+  const std::size_t block_size = (std::size_t)state.range(0);
+  const bool background = state.range(1) != 0;
+
+  mts::audio_buffer<float> ir(ir_size, 2);
+  mts::audio_buffer<float> buffer(block_size, 2);
+
+  for (std::size_t i = 0; i < ir_size; i++) {
+    const float decay = (float)std::exp(-3.0 * (double)i / (double)ir_size);
+    ir[0][i] = (float)std::sin(0.37 * (double)i) * decay;
+    ir[1][i] = (float)std::cos(0.21 * (double)i) * decay;
+  }
+
+  for (std::size_t i = 0; i < block_size; i++) {
+    buffer[0][i] = (float)std::sin(0.1 * (double)i);
+    buffer[1][i] = (float)std::cos(0.1 * (double)i);
+  }
+
+  mts::convolver<float> conv(ir, 2, block_size, background);
+
+  for (auto _ : state) {
+    conv.process(buffer);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * block_size));
+}
+} // namespace
+
+BENCHMARK(BM_convolver)->ArgNames({ "block", "background" })->ArgsProduct({ { 64, 256, 1024 }, { 0, 1 } });
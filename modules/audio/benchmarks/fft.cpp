@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include "mts/audio/fft.h"
+#include <cmath>
+#include <complex>
+#include <vector>
+
+// Forward transforms, power of two sizes and a few mixed radix ones.
+
+namespace {
+template <typename T>
+void BM_fft_complex(benchmark::State& state) {
+  const std::size_t size = (std::size_t)state.range(0);
+  mts::fft<T> plan(size);
+  std::vector<std::complex<T>> input(size);
+  std::vector<std::complex<T>> output(size);
+
+  for (std::size_t i = 0; i < size; i++) {
+    input[i] = std::complex<T>((T)std::sin(0.1 * (double)i), (T)std::cos(0.3 * (double)i));
+  }
+
+  for (auto _ : state) {
+    plan.forward(input.data(), output.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * size));
+}
+
+template <typename T>
+void BM_fft_real(benchmark::State& state) {
+  const std::size_t size = (std::size_t)state.range(0);
+  mts::real_fft<T> plan(size);
+  std::vector<T> input(size);
+  std::vector<std::complex<T>> output(size / 2 + 1);
+
+  for (std::size_t i = 0; i < size; i++) {
+    input[i] = (T)std::sin(0.1 * (double)i);
+  }
+
+  for (auto _ : state) {
+    plan.forward(input.data(), output.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * size));
+}
+
+void power_of_two_args(benchmark::internal::Benchmark* b) {
+  b->ArgName("size")->RangeMultiplier(2)->Range(64, 65536);
+}
+
+void mixed_radix_args(benchmark::internal::Benchmark* b) {
+  b->ArgName("size")->Arg(480)->Arg(1000)->Arg(1536)->Arg(2187);
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_fft_complex, float)->Apply(power_of_two_args)->Apply(mixed_radix_args);
+BENCHMARK_TEMPLATE(BM_fft_complex, double)->Apply(power_of_two_args)->Apply(mixed_radix_args);
+BENCHMARK_TEMPLATE(BM_fft_real, float)->Apply(power_of_two_args)->Arg(480)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_fft_real, double)->Apply(power_of_two_args)->Arg(480)->Arg(1000);
@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+#include "mts/audio/meter.h"
+#include "mts/audio/buffer.h"
+#include <cmath>
+#include <vector>
+
+// Peak, true peak, rms and loudness of a 48 kHz bus, per host block.
+
+namespace {
+void BM_meter(benchmark::State& state) {
+  const std::size_t n_channels = (std::size_t)state.range(0);
+  constexpr std::size_t block_size = 512;
+
+  mts::audio_buffer<float> buffer(block_size, n_channels);
+  for (std::size_t c = 0; c < n_channels; c++) {
+    for (std::size_t i = 0; i < block_size; i++) {
+      buffer[c][i] = 0.5f * (float)std::sin(0.05 * (double)(i + c));
+    }
+  }
+
+  mts::meter<float> m(n_channels, 48000);
+
+  for (auto _ : state) {
+    m.process(buffer);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * block_size * n_channels));
+}
+} // namespace
+
+BENCHMARK(BM_meter)->ArgName("channels")->Arg(1)->Arg(2)->Arg(6)->Arg(16);
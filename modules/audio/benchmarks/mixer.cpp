@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include "mts/audio/mixer.h"
+#include "mts/audio/buffer.h"
+#include <cmath>
+#include <vector>
+
+// 256 stereo tracks into 4 stereo busses, every track sent to every bus.
+// One vec pass per (track, bus) over the whole buffer against the tiled mixer.
+
+namespace {
+constexpr std::size_t n_tracks = 256;
+constexpr std::size_t n_busses = 4;
+
+struct mix_operands {
+  inline mix_operands(std::size_t buffer_size) {
+    for (std::size_t t = 0; t < n_tracks; t++) {
+      tracks.emplace_back(buffer_size, 2);
+      for (std::size_t c = 0; c < 2; c++) {
+        for (std::size_t i = 0; i < buffer_size; i++) {
+          tracks[t][c][i] = (float)std::sin(0.01 * (double)(i + t * 7 + c));
+        }
+      }
+    }
+
+    for (std::size_t b = 0; b < n_busses; b++) {
+      busses.emplace_back(buffer_size, 2);
+    }
+
+    for (std::size_t t = 0; t < n_tracks; t++) {
+      sources.emplace_back(tracks[t]);
+    }
+
+    for (std::size_t b = 0; b < n_busses; b++) {
+      destinations.emplace_back(busses[b]);
+    }
+  }
+
+  std::vector<mts::audio_buffer<float>> tracks;
+  std::vector<mts::audio_buffer<float>> busses;
+  std::vector<mts::audio_bus<const float>> sources;
+  std::vector<mts::audio_bus<float>> destinations;
+};
+
+void BM_mixer_passes(benchmark::State& state) {
+  const std::size_t buffer_size = (std::size_t)state.range(0);
+  mix_operands x(buffer_size);
+
+  for (auto _ : state) {
+    for (std::size_t b = 0; b < n_busses; b++) {
+      for (std::size_t c = 0; c < 2; c++) {
+        mts::vec::clear(x.busses[b][c], 1, buffer_size);
+      }
+
+      for (std::size_t t = 0; t < n_tracks; t++) {
+        for (std::size_t c = 0; c < 2; c++) {
+          mts::vec::mul_sum(x.tracks[t][c], 1, 0.5f, x.busses[b][c], 1, x.busses[b][c], 1, buffer_size);
+        }
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * buffer_size * n_tracks));
+}
+
+void BM_mixer(benchmark::State& state) {
+  const std::size_t buffer_size = (std::size_t)state.range(0);
+  mix_operands x(buffer_size);
+
+  mts::mixer<float> mix(n_tracks, n_busses);
+  for (std::size_t t = 0; t < n_tracks; t++) {
+    for (std::size_t b = 0; b < n_busses; b++) {
+      mix.set_gain(t, b, 0.5f);
+    }
+  }
+
+  for (auto _ : state) {
+    mix.process(x.sources, x.destinations, buffer_size);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * buffer_size * n_tracks));
+}
+} // namespace
+
+BENCHMARK(BM_mixer_passes)->RangeMultiplier(4)->Range(256, 16384);
+BENCHMARK(BM_mixer)->RangeMultiplier(4)->Range(256, 16384);
@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+#include "mts/audio/resampler.h"
+#include "mts/audio/buffer.h"
+#include <cmath>
+
+// Stereo 44.1 kHz to 48 kHz (exact phases) and to 47.9995 kHz (interpolated phases), per 256 output frames.
+
+namespace {
+void BM_resampler(benchmark::State& state) {
+  constexpr std::size_t block_size = 256;
+  const double target_rate = state.range(0) ? 47999.5 : 48000;
+  const auto quality = (mts::resampler_quality)state.range(1);
+
+  mts::resampler<float> r(2, 44100, target_rate, quality);
+  mts::audio_buffer<float> input(block_size, 2);
+  mts::audio_buffer<float> output(block_size, 2);
+
+  for (std::size_t i = 0; i < block_size; i++) {
+    input[0][i] = (float)std::sin(0.1 * (double)i);
+    input[1][i] = (float)std::cos(0.1 * (double)i);
+  }
+
+  for (auto _ : state) {
+    const std::size_t n = r.input_size(block_size);
+    r.process(mts::audio_bus<const float>(input.data(), n, 2), output);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * block_size));
+}
+} // namespace
+
+BENCHMARK(BM_resampler)->ArgNames({ "interpolated", "quality" })->ArgsProduct({ { 0, 1 }, { 0, 1, 2 } });
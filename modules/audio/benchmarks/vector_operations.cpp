@@ -0,0 +1,588 @@
+#include <benchmark/benchmark.h>
+#include "mts/audio/vector_operations.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Every vec operation for float and double, default_op against optimized_op.
+// The simd backend can be pinned with the MTS_SIMD_ISA environment variable (none, sse2, avx2, avx512).
+
+namespace {
+namespace vec = mts::vec;
+using vec::length_t;
+using vec::stride_t;
+
+template <typename T>
+std::vector<T> make_signal(std::size_t size) {
+  std::vector<T> v(size);
+  for (std::size_t i = 0; i < size; i++) {
+    const double x = 0.5 + 0.45 * std::sin(0.01 * (double)i);
+
+    if constexpr (std::is_floating_point_v<T>) {
+      v[i] = (T)x;
+    }
+    else if constexpr (std::is_same_v<T, mts::int24_t>) {
+      v[i] = mts::int24_t((std::int32_t)(x * 8388607.0));
+    }
+    else {
+      v[i] = (T)(x * (double)std::numeric_limits<T>::max());
+    }
+  }
+
+  return v;
+}
+
+template <typename T>
+struct operands {
+  inline operands(length_t length, stride_t stride)
+      : s1(make_signal<T>(length * stride))
+      , s2(make_signal<T>(length * stride))
+      , s3(make_signal<T>(length * stride))
+      , d1(length * stride) {}
+
+  std::vector<T> s1;
+  std::vector<T> s2;
+  std::vector<T> s3;
+  std::vector<T> d1;
+};
+
+/// Non-interleaved channels.
+template <typename T>
+struct channels {
+  inline channels(length_t n_channels, length_t length) {
+    for (length_t c = 0; c < n_channels; c++) {
+      buffers.push_back(make_signal<T>(length));
+    }
+
+    for (std::vector<T>& b : buffers) {
+      pointers.push_back(b.data());
+    }
+  }
+
+  std::vector<std::vector<T>> buffers;
+  std::vector<T*> pointers;
+};
+
+inline void set_counters(benchmark::State& state, length_t n_samples, std::size_t bytes_per_sample) {
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * n_samples));
+  state.SetBytesProcessed((std::int64_t)(state.iterations() * n_samples * bytes_per_sample));
+}
+
+/// Runs fct(operands, length, stride) with the length and stride arguments.
+/// n_operands is the number of buffers read or written per sample.
+template <typename T, typename Fct>
+void run_strided(benchmark::State& state, std::size_t n_operands, Fct&& fct) {
+  const length_t length = (length_t)state.range(0);
+  const stride_t stride = state.range(1);
+  operands<T> x(length, stride);
+
+  for (auto _ : state) {
+    fct(x, length, stride);
+    benchmark::ClobberMemory();
+  }
+
+  set_counters(state, length, n_operands * sizeof(T));
+}
+
+/// Runs fct(s1, s_s1, d1, length) converting from S to T.
+template <typename T, typename S, typename Fct>
+void run_convert(benchmark::State& state, Fct&& fct) {
+  const length_t length = (length_t)state.range(0);
+  const stride_t stride = state.range(1);
+  std::vector<S> s1 = make_signal<S>(length * stride);
+  std::vector<T> d1(length * stride);
+
+  for (auto _ : state) {
+    fct(s1.data(), stride, d1.data(), length);
+    benchmark::ClobberMemory();
+  }
+
+  set_counters(state, length, sizeof(S) + sizeof(T));
+}
+
+/// Runs fct(interleaved, n_channels, channel_pointers, length) with the length and channels arguments.
+template <typename I, typename C, typename Fct>
+void run_interleaved(benchmark::State& state, Fct&& fct) {
+  const length_t length = (length_t)state.range(0);
+  const length_t n_channels = (length_t)state.range(1);
+  std::vector<I> interleaved = make_signal<I>(length * n_channels);
+  channels<C> ch(n_channels, length);
+
+  for (auto _ : state) {
+    fct(interleaved.data(), n_channels, ch.pointers.data(), length);
+    benchmark::ClobberMemory();
+  }
+
+  set_counters(state, length * n_channels, sizeof(I) + sizeof(C));
+}
+
+//
+// Arguments.
+//
+void length_args(benchmark::internal::Benchmark* b) {
+  b->ArgNames({ "length", "stride" })->ArgsProduct({ benchmark::CreateRange(32, 65536, 4), { 1 } });
+}
+
+void strided_args(benchmark::internal::Benchmark* b) {
+  b->ArgNames({ "length", "stride" })->ArgsProduct({ benchmark::CreateRange(32, 65536, 4), { 1, 2 } });
+}
+
+void channel_args(benchmark::internal::Benchmark* b) {
+  b->ArgNames({ "length", "channels" })->ArgsProduct({ benchmark::CreateRange(32, 65536, 4), { 2, 8 } });
+}
+
+void filter_args(benchmark::internal::Benchmark* b) {
+  b->ArgNames({ "length", "channels" })->ArgsProduct({ benchmark::CreateRange(32, 65536, 4), { 1, 4, 8, 16 } });
+}
+
+//
+// Basic.
+//
+template <typename T, typename O>
+void BM_clear(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::clear<O>(x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_fill(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::fill<O>(x.d1.data(), stride, (T)0.5, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_copy(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::copy<O>(x.s1.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_lshift(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t) {
+    vec::lshift<O>(x.d1.data(), 1, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_clip(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::clip<O>(x.s1.data(), stride, (T)0.2, (T)0.8, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_abs(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::abs<O>(x.s1.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+//
+// Scalar and vector arithmetic.
+//
+template <typename T, typename O>
+void BM_s_add(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::add<O>(x.s1.data(), stride, (T)0.5, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_s_mul(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul<O>(x.s1.data(), stride, (T)0.5, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_s_div(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::div<O>(x.s1.data(), stride, (T)3, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_s_vdiv(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::vdiv<O>((T)3, x.s1.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_v_sum(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::sum<O>(x.s1.data(), stride, x.s2.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_v_sub(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::sub<O>(x.s1.data(), stride, x.s2.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_v_mul(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul<O>(x.s1.data(), stride, x.s2.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_v_div(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::div<O>(x.s1.data(), stride, x.s2.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+//
+// Fused.
+//
+template <typename T, typename O>
+void BM_sum_s_mul(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::sum_mul<O>(x.s1.data(), stride, x.s2.data(), stride, (T)0.5, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_sum_v_mul(benchmark::State& state) {
+  run_strided<T>(state, 4, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::sum_mul<O>(x.s1.data(), stride, x.s2.data(), stride, x.s3.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_sum_mul(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::sum_mul<O>(x.s1.data(), stride, (T)0.5, x.s2.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_mul_s_sum(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul_sum<O>(x.s1.data(), stride, x.s2.data(), stride, (T)0.5, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_mul_v_sum(benchmark::State& state) {
+  run_strided<T>(state, 4, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul_sum<O>(x.s1.data(), stride, x.s2.data(), stride, x.s3.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_mul_sum(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul_sum<O>(x.s1.data(), stride, (T)0.5, x.s2.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+//
+// Ramps.
+//
+template <typename T, typename O>
+void BM_ramp(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::ramp<O>(x.d1.data(), stride, (T)0.25, (T)0.001, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_mul_ramp(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul_ramp<O>(x.s1.data(), stride, (T)0.25, (T)0.001, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_mul_ramp_add(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul_ramp_add<O>(x.s1.data(), stride, (T)0.25, (T)0.001, x.s2.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_exp_ramp(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::exp_ramp<O>(x.d1.data(), stride, (T)0.25, (T)1.0001, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_mul_exp_ramp(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul_exp_ramp<O>(x.s1.data(), stride, (T)0.25, (T)1.0001, x.d1.data(), stride, length);
+  });
+}
+
+template <typename T, typename O>
+void BM_mul_exp_ramp_add(benchmark::State& state) {
+  run_strided<T>(state, 3, [](operands<T>& x, length_t length, stride_t stride) {
+    vec::mul_exp_ramp_add<O>(
+        x.s1.data(), stride, (T)0.25, (T)1.0001, x.s2.data(), stride, x.d1.data(), stride, length);
+  });
+}
+
+//
+// Reductions.
+//
+template <typename T, typename O>
+void BM_sum(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    benchmark::DoNotOptimize(vec::sum<O>(x.s1.data(), stride, length));
+  });
+}
+
+template <typename T, typename O>
+void BM_sum_of_squares(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    benchmark::DoNotOptimize(vec::sum_of_squares<O>(x.s1.data(), stride, length));
+  });
+}
+
+template <typename T, typename O>
+void BM_rms(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    benchmark::DoNotOptimize(vec::rms<O>(x.s1.data(), stride, length));
+  });
+}
+
+template <typename T, typename O>
+void BM_max_abs(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    benchmark::DoNotOptimize(vec::max_abs<O>(x.s1.data(), stride, length));
+  });
+}
+
+template <typename T, typename O>
+void BM_min_index(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    benchmark::DoNotOptimize(vec::min_index<O>(x.s1.data(), stride, length));
+  });
+}
+
+template <typename T, typename O>
+void BM_max_index(benchmark::State& state) {
+  run_strided<T>(state, 1, [](operands<T>& x, length_t length, stride_t stride) {
+    benchmark::DoNotOptimize(vec::max_index<O>(x.s1.data(), stride, length));
+  });
+}
+
+template <typename T, typename O>
+void BM_dot(benchmark::State& state) {
+  run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t stride) {
+    benchmark::DoNotOptimize(vec::dot<O>(x.s1.data(), stride, x.s2.data(), stride, length));
+  });
+}
+
+//
+// Math.
+//
+#define MTS_VEC_BENCHMARK_MATH(NAME)                                                                                   \
+  template <typename T, typename O>                                                                                    \
+  void BM_##NAME(benchmark::State& state) {                                                                            \
+    run_strided<T>(state, 2, [](operands<T>& x, length_t length, stride_t) {                                           \
+      vec::NAME<O>(x.s1.data(), x.d1.data(), length);                                                                  \
+    });                                                                                                                \
+  }
+
+MTS_VEC_BENCHMARK_MATH(sqrt)
+MTS_VEC_BENCHMARK_MATH(sin)
+MTS_VEC_BENCHMARK_MATH(cos)
+MTS_VEC_BENCHMARK_MATH(tan)
+MTS_VEC_BENCHMARK_MATH(tanh)
+
+//
+// Conversions.
+//
+#define MTS_VEC_BENCHMARK_CONVERT_FROM(NAME, S)                                                                        \
+  template <typename T, typename O>                                                                                    \
+  void BM_##NAME(benchmark::State& state) {                                                                            \
+    run_convert<T, S>(state, [](const S* s1, stride_t s_s1, T* d1, length_t length) {                                  \
+      vec::NAME<O>(s1, s_s1, d1, length);                                                                              \
+    });                                                                                                                \
+  }
+
+#define MTS_VEC_BENCHMARK_CONVERT_TO(NAME, D)                                                                          \
+  template <typename T, typename O>                                                                                    \
+  void BM_##NAME(benchmark::State& state) {                                                                            \
+    run_convert<D, T>(state, [](const T* s1, stride_t s_s1, D* d1, length_t length) {                                  \
+      vec::NAME<O>(s1, s_s1, d1, 1, length);                                                                           \
+    });                                                                                                                \
+  }
+
+#define MTS_VEC_BENCHMARK_DEINTERLEAVE_FROM(NAME, S)                                                                   \
+  template <typename T, typename O>                                                                                    \
+  void BM_##NAME(benchmark::State& state) {                                                                            \
+    run_interleaved<S, T>(state, [](S* s1, length_t n_channels, T* const* d, length_t length) {                        \
+      vec::NAME<O>(s1, (stride_t)n_channels, d, n_channels, length);                                                   \
+    });                                                                                                                \
+  }
+
+#define MTS_VEC_BENCHMARK_INTERLEAVE_FROM(NAME, S)                                                                     \
+  template <typename T, typename O>                                                                                    \
+  void BM_##NAME(benchmark::State& state) {                                                                            \
+    run_interleaved<T, S>(state, [](T* d1, length_t n_channels, S* const* s, length_t length) {                        \
+      vec::NAME<O>(s, d1, (stride_t)n_channels, n_channels, length);                                                   \
+    });                                                                                                                \
+  }
+
+#define MTS_VEC_BENCHMARK_INTERLEAVE_TO(NAME, D)                                                                       \
+  template <typename T, typename O>                                                                                    \
+  void BM_##NAME(benchmark::State& state) {                                                                            \
+    run_interleaved<D, T>(state, [](D* d1, length_t n_channels, T* const* s, length_t length) {                        \
+      vec::NAME<O>(s, d1, (stride_t)n_channels, n_channels, length);                                                   \
+    });                                                                                                                \
+  }
+
+MTS_VEC_BENCHMARK_CONVERT_FROM(convert_from_int8, std::int8_t)
+MTS_VEC_BENCHMARK_CONVERT_FROM(convert_from_int16, std::int16_t)
+MTS_VEC_BENCHMARK_CONVERT_FROM(convert_from_int24, mts::int24_t)
+MTS_VEC_BENCHMARK_CONVERT_FROM(convert_from_int32, std::int32_t)
+MTS_VEC_BENCHMARK_CONVERT_FROM(convert_from_float, float)
+MTS_VEC_BENCHMARK_CONVERT_FROM(convert_from_double, double)
+
+MTS_VEC_BENCHMARK_CONVERT_TO(convert_to_int8, std::int8_t)
+MTS_VEC_BENCHMARK_CONVERT_TO(convert_to_int16, std::int16_t)
+MTS_VEC_BENCHMARK_CONVERT_TO(convert_to_int24, mts::int24_t)
+MTS_VEC_BENCHMARK_CONVERT_TO(convert_to_int32, std::int32_t)
+
+MTS_VEC_BENCHMARK_DEINTERLEAVE_FROM(deinterleave_from_int8, std::int8_t)
+MTS_VEC_BENCHMARK_DEINTERLEAVE_FROM(deinterleave_from_int16, std::int16_t)
+MTS_VEC_BENCHMARK_DEINTERLEAVE_FROM(deinterleave_from_int24, mts::int24_t)
+MTS_VEC_BENCHMARK_DEINTERLEAVE_FROM(deinterleave_from_int32, std::int32_t)
+MTS_VEC_BENCHMARK_DEINTERLEAVE_FROM(deinterleave_from_float, float)
+MTS_VEC_BENCHMARK_DEINTERLEAVE_FROM(deinterleave_from_double, double)
+
+MTS_VEC_BENCHMARK_INTERLEAVE_FROM(interleave_from_float, float)
+MTS_VEC_BENCHMARK_INTERLEAVE_FROM(interleave_from_double, double)
+
+MTS_VEC_BENCHMARK_INTERLEAVE_TO(interleave_to_int8, std::int8_t)
+MTS_VEC_BENCHMARK_INTERLEAVE_TO(interleave_to_int16, std::int16_t)
+MTS_VEC_BENCHMARK_INTERLEAVE_TO(interleave_to_int24, mts::int24_t)
+MTS_VEC_BENCHMARK_INTERLEAVE_TO(interleave_to_int32, std::int32_t)
+
+//
+// Filters.
+//
+template <typename T, typename O>
+void BM_biquad(benchmark::State& state) {
+  constexpr length_t n_stages = 2;
+  const length_t length = (length_t)state.range(0);
+  const length_t n_channels = (length_t)state.range(1);
+  channels<T> s(n_channels, length);
+  channels<T> d(n_channels, length);
+
+  // Same stable lowpass on every stage and channel.
+  const T coefficients[5] = { T(0.0675), T(0.135), T(0.0675), T(-1.143), T(0.413) };
+  std::vector<T> c(n_stages * 5 * n_channels);
+  std::vector<T> z(n_stages * 2 * n_channels, T(0));
+
+  for (length_t i = 0; i < c.size(); i++) {
+    c[i] = coefficients[(i / n_channels) % 5];
+  }
+
+  for (auto _ : state) {
+    vec::biquad<O>(s.pointers.data(), d.pointers.data(), n_channels, length, c.data(), z.data(), n_stages);
+    benchmark::ClobberMemory();
+  }
+
+  set_counters(state, length * n_channels, 2 * sizeof(T));
+}
+} // namespace
+
+//
+// Registration.
+//
+#define MTS_VEC_BENCHMARK(NAME, ARGS)                                                                                  \
+  BENCHMARK_TEMPLATE(NAME, float, vec::default_op)->Apply(ARGS);                                                       \
+  BENCHMARK_TEMPLATE(NAME, float, vec::optimized_op)->Apply(ARGS);                                                     \
+  BENCHMARK_TEMPLATE(NAME, double, vec::default_op)->Apply(ARGS);                                                      \
+  BENCHMARK_TEMPLATE(NAME, double, vec::optimized_op)->Apply(ARGS)
+
+#define MTS_VEC_BENCHMARK_APPROX(NAME, ARGS)                                                                           \
+  MTS_VEC_BENCHMARK(NAME, ARGS);                                                                                       \
+  BENCHMARK_TEMPLATE(NAME, float, vec::approx_op)->Apply(ARGS);                                                        \
+  BENCHMARK_TEMPLATE(NAME, float, vec::fast_approx_op)->Apply(ARGS);                                                   \
+  BENCHMARK_TEMPLATE(NAME, double, vec::approx_op)->Apply(ARGS);                                                       \
+  BENCHMARK_TEMPLATE(NAME, double, vec::fast_approx_op)->Apply(ARGS)
+
+MTS_VEC_BENCHMARK(BM_clear, strided_args);
+MTS_VEC_BENCHMARK(BM_fill, strided_args);
+MTS_VEC_BENCHMARK(BM_copy, strided_args);
+MTS_VEC_BENCHMARK(BM_lshift, length_args);
+MTS_VEC_BENCHMARK(BM_clip, strided_args);
+MTS_VEC_BENCHMARK(BM_abs, strided_args);
+
+MTS_VEC_BENCHMARK(BM_s_add, strided_args);
+MTS_VEC_BENCHMARK(BM_s_mul, strided_args);
+MTS_VEC_BENCHMARK(BM_s_div, strided_args);
+MTS_VEC_BENCHMARK(BM_s_vdiv, strided_args);
+MTS_VEC_BENCHMARK(BM_v_sum, strided_args);
+MTS_VEC_BENCHMARK(BM_v_sub, strided_args);
+MTS_VEC_BENCHMARK(BM_v_mul, strided_args);
+MTS_VEC_BENCHMARK(BM_v_div, strided_args);
+
+MTS_VEC_BENCHMARK(BM_sum_s_mul, strided_args);
+MTS_VEC_BENCHMARK(BM_sum_v_mul, strided_args);
+MTS_VEC_BENCHMARK(BM_sum_mul, strided_args);
+MTS_VEC_BENCHMARK(BM_mul_s_sum, strided_args);
+MTS_VEC_BENCHMARK(BM_mul_v_sum, strided_args);
+MTS_VEC_BENCHMARK(BM_mul_sum, strided_args);
+
+MTS_VEC_BENCHMARK(BM_ramp, strided_args);
+MTS_VEC_BENCHMARK(BM_mul_ramp, strided_args);
+MTS_VEC_BENCHMARK(BM_mul_ramp_add, strided_args);
+MTS_VEC_BENCHMARK(BM_exp_ramp, strided_args);
+MTS_VEC_BENCHMARK(BM_mul_exp_ramp, strided_args);
+MTS_VEC_BENCHMARK(BM_mul_exp_ramp_add, strided_args);
+
+MTS_VEC_BENCHMARK(BM_sum, strided_args);
+MTS_VEC_BENCHMARK(BM_sum_of_squares, strided_args);
+MTS_VEC_BENCHMARK(BM_rms, strided_args);
+MTS_VEC_BENCHMARK(BM_max_abs, strided_args);
+MTS_VEC_BENCHMARK(BM_min_index, strided_args);
+MTS_VEC_BENCHMARK(BM_max_index, strided_args);
+MTS_VEC_BENCHMARK(BM_dot, strided_args);
+
+MTS_VEC_BENCHMARK(BM_sqrt, length_args);
+MTS_VEC_BENCHMARK_APPROX(BM_sin, length_args);
+MTS_VEC_BENCHMARK_APPROX(BM_cos, length_args);
+MTS_VEC_BENCHMARK_APPROX(BM_tan, length_args);
+MTS_VEC_BENCHMARK_APPROX(BM_tanh, length_args);
+
+MTS_VEC_BENCHMARK(BM_convert_from_int8, strided_args);
+MTS_VEC_BENCHMARK(BM_convert_from_int16, strided_args);
+MTS_VEC_BENCHMARK(BM_convert_from_int24, strided_args);
+MTS_VEC_BENCHMARK(BM_convert_from_int32, strided_args);
+MTS_VEC_BENCHMARK(BM_convert_from_float, strided_args);
+MTS_VEC_BENCHMARK(BM_convert_from_double, strided_args);
+
+MTS_VEC_BENCHMARK(BM_convert_to_int8, strided_args);
+MTS_VEC_BENCHMARK(BM_convert_to_int16, strided_args);
+MTS_VEC_BENCHMARK(BM_convert_to_int24, strided_args);
+MTS_VEC_BENCHMARK(BM_convert_to_int32, strided_args);
+
+MTS_VEC_BENCHMARK(BM_deinterleave_from_int8, channel_args);
+MTS_VEC_BENCHMARK(BM_deinterleave_from_int16, channel_args);
+MTS_VEC_BENCHMARK(BM_deinterleave_from_int24, channel_args);
+MTS_VEC_BENCHMARK(BM_deinterleave_from_int32, channel_args);
+MTS_VEC_BENCHMARK(BM_deinterleave_from_float, channel_args);
+MTS_VEC_BENCHMARK(BM_deinterleave_from_double, channel_args);
+
+MTS_VEC_BENCHMARK(BM_interleave_from_float, channel_args);
+MTS_VEC_BENCHMARK(BM_interleave_from_double, channel_args);
+
+MTS_VEC_BENCHMARK(BM_interleave_to_int8, channel_args);
+MTS_VEC_BENCHMARK(BM_interleave_to_int16, channel_args);
+MTS_VEC_BENCHMARK(BM_interleave_to_int24, channel_args);
+MTS_VEC_BENCHMARK(BM_interleave_to_int32, channel_args);
+
+MTS_VEC_BENCHMARK(BM_biquad, filter_args);
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include "mts/audio/wire.h"
+#include <vector>
+
+// out = (a + b) * g + c, with one vec operation per step against a single expression.
+
+namespace {
+struct wire_operands {
+  inline wire_operands(std::size_t length)
+      : a(length, 0.25f)
+      , b(length, 0.5f)
+      , c(length, 0.75f)
+      , out(length) {}
+
+  std::vector<float> a;
+  std::vector<float> b;
+  std::vector<float> c;
+  std::vector<float> out;
+};
+
+void BM_wire_passes(benchmark::State& state) {
+  wire_operands x((std::size_t)state.range(0));
+  mts::wire<float> out(x.out);
+
+  for (auto _ : state) {
+    out.copy(mts::wire<const float>(x.a));
+    out.add_mul(mts::wire<const float>(x.b), 0.5f);
+    out += mts::wire<const float>(x.c);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * state.range(0)));
+}
+
+void BM_wire_expression(benchmark::State& state) {
+  wire_operands x((std::size_t)state.range(0));
+  mts::wire<float> out(x.out);
+  mts::wire<const float> a(x.a);
+  mts::wire<const float> b(x.b);
+  mts::wire<const float> c(x.c);
+
+  for (auto _ : state) {
+    out = (a + b) * 0.5f + c;
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * state.range(0)));
+}
+
+void BM_wire_expression_fixed(benchmark::State& state) {
+  constexpr std::size_t length = 256;
+  wire_operands x(length);
+  mts::wire<float, length> out(x.out.data());
+  mts::wire<const float, length> a(x.a.data());
+  mts::wire<const float, length> b(x.b.data());
+  mts::wire<const float, length> c(x.c.data());
+
+  for (auto _ : state) {
+    out = (a + b) * 0.5f + c;
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * length));
+}
+
+// Fixed extents use the unrolled vec::fixed_ops, dynamic ones the runtime dispatched kernels.
+template <std::size_t N>
+void BM_wire_fixed_mul_add(benchmark::State& state) {
+  wire_operands x(N);
+  mts::wire<float, N> out(x.out.data());
+  mts::wire<const float, N> a(x.a.data());
+
+  for (auto _ : state) {
+    out.mul_add(a, 0.5f);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * N));
+}
+
+template <std::size_t N>
+void BM_wire_dynamic_mul_add(benchmark::State& state) {
+  wire_operands x(N);
+  mts::wire<float> out(x.out);
+  mts::wire<const float> a(x.a);
+
+  for (auto _ : state) {
+    out.mul_add(a, 0.5f);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed((std::int64_t)(state.iterations() * N));
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_wire_fixed_mul_add, 16);
+BENCHMARK_TEMPLATE(BM_wire_fixed_mul_add, 32);
+BENCHMARK_TEMPLATE(BM_wire_fixed_mul_add, 64);
+BENCHMARK_TEMPLATE(BM_wire_fixed_mul_add, 128);
+BENCHMARK_TEMPLATE(BM_wire_dynamic_mul_add, 16);
+BENCHMARK_TEMPLATE(BM_wire_dynamic_mul_add, 32);
+BENCHMARK_TEMPLATE(BM_wire_dynamic_mul_add, 64);
+BENCHMARK_TEMPLATE(BM_wire_dynamic_mul_add, 128);
+
+BENCHMARK(BM_wire_passes)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK(BM_wire_expression)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK(BM_wire_expression_fixed);
@@ -39,6 +39,7 @@
 #include "mts/memory_range.h"
 #include "mts/int24_t.h"
 #include "mts/util.h"
+#include "mts/audio/dither.h"
 #include "mts/audio/wire.h"
 
 #include <vector>
@@ -115,8 +116,10 @@ namespace wav {
 
   inline const char* error_to_string(save_error err);
 
+  /// Integer formats are rounded and saturated, with optional dither.
   template <typename _Tp>
-  save_error save(const mts::filesystem::path& file_path, const audio_data<_Tp>& data_view, format e_format);
+  save_error save(const mts::filesystem::path& file_path, const audio_data<_Tp>& data_view, format e_format,
+      mts::dither_type d_type = mts::dither_type::none);
 
 } // namespace wav.
 
@@ -216,48 +219,74 @@ namespace wav {
     constexpr std::string_view data_header_id = "data";
     constexpr std::string_view fact_header_id = "fact";
 
-    template <typename _T, typename _ConvertType>
-    inline void convert_pcm(mts::audio_buffer<_T>& buffers, const mts::byte_view& data, std::int16_t n_byte_per_block) {
-      using value_type = _T;
-      using wire = mts::wire<value_type>;
+    /// Deinterleaves frames of stride samples into n_channel channels, integer
+    /// samples are scaled to [-1, 1).
+    template <typename _ConvertType, typename _T>
+    inline void deinterleave(const _ConvertType* input, std::size_t stride, _T* const* output, std::size_t n_channel,
+        std::size_t n_samples) {
+      const mts::vec::stride_t s = (mts::vec::stride_t)stride;
 
-      std::size_t n_channel = buffers.channel_size();
-      std::size_t n_samples = buffers.buffer_size();
-      constexpr value_type denom = value_type(1.0) / (1L << (8L * sizeof(_ConvertType) - 1L));
+      if constexpr (std::is_same_v<_ConvertType, std::int16_t>) {
+        mts::vec::deinterleave_from_int16(input, s, output, n_channel, n_samples);
+      }
+      else if constexpr (std::is_same_v<_ConvertType, mts::int24_t>) {
+        mts::vec::deinterleave_from_int24(input, s, output, n_channel, n_samples);
+      }
+      else if constexpr (std::is_same_v<_ConvertType, std::int32_t>) {
+        mts::vec::deinterleave_from_int32(input, s, output, n_channel, n_samples);
+      }
+      else if constexpr (std::is_same_v<_ConvertType, float>) {
+        mts::vec::deinterleave_from_float(input, s, output, n_channel, n_samples);
+      }
+      else if constexpr (std::is_same_v<_ConvertType, double>) {
+        mts::vec::deinterleave_from_double(input, s, output, n_channel, n_samples);
+      }
+    }
 
-      if (n_channel == 1) {
-        if (n_byte_per_block == sizeof(_ConvertType)) {
-          const _ConvertType* v = data.data<_ConvertType>();
-          wire(buffers.channel_wire(0)).template assign_from<_ConvertType>(v) *= denom;
-          return;
-        }
+    /// Appends the channels as interleaved integer samples.
+    template <typename _ConvertType, typename _T>
+    inline void encode_pcm(mts::byte_vector& data, const mts::audio_buffer<_T>& buffers, mts::dither_type d_type) {
+      const std::size_t offset = data.size();
+      const std::size_t n_channel = buffers.channel_size();
+      data.resize(offset + buffers.buffer_size() * n_channel * sizeof(_ConvertType));
 
-        for (std::size_t i = 0; i < n_samples; i++) {
-          buffers[0][i] = ((value_type) * (const _ConvertType*)&data[n_byte_per_block * i]) * denom;
-        }
+      mts::dither(d_type).interleave(buffers.data(), data.data<_ConvertType>(offset), (mts::vec::stride_t)n_channel,
+          n_channel, buffers.buffer_size());
+    }
 
-        return;
+    /// Appends the channels as interleaved floating point samples.
+    template <typename _ConvertType, typename _T>
+    inline void encode_ieee(mts::byte_vector& data, const mts::audio_buffer<_T>& buffers) {
+      const std::size_t offset = data.size();
+      const std::size_t n_channel = buffers.channel_size();
+      data.resize(offset + buffers.buffer_size() * n_channel * sizeof(_ConvertType));
+
+      _ConvertType* output = data.data<_ConvertType>(offset);
+      const mts::vec::stride_t stride = (mts::vec::stride_t)n_channel;
+
+      if constexpr (std::is_same_v<_T, float>) {
+        mts::vec::interleave_from_float(buffers.data(), output, stride, n_channel, buffers.buffer_size());
       }
+      else {
+        mts::vec::interleave_from_double(buffers.data(), output, stride, n_channel, buffers.buffer_size());
+      }
+    }
 
-      if (n_channel == 2) {
-        if (n_byte_per_block == 2 * sizeof(_ConvertType)) {
-          const _ConvertType* v = data.data<_ConvertType>();
-          wire(buffers.channel_wire(0)).template assign_from<_ConvertType>(v, 2) *= denom;
-          wire(buffers.channel_wire(1)).template assign_from<_ConvertType>(v + 1, 2) *= denom;
-          return;
-        }
+    template <typename _T, typename _ConvertType>
+    inline void convert_pcm(mts::audio_buffer<_T>& buffers, const mts::byte_view& data, std::int16_t n_byte_per_block) {
+      using value_type = _T;
 
-        for (std::size_t i = 0; i < n_samples; i++) {
-          std::size_t dt = (n_byte_per_block * i);
-          for (std::size_t channel = 0; channel < n_channel; channel++) {
-            std::size_t s_index = dt + channel * sizeof(_ConvertType);
-            buffers[channel][i] = ((value_type) * (const _ConvertType*)&data[s_index]) * denom;
-          }
-        }
+      std::size_t n_channel = buffers.channel_size();
+      std::size_t n_samples = buffers.buffer_size();
 
+      if (n_byte_per_block % sizeof(_ConvertType) == 0) {
+        deinterleave(data.data<_ConvertType>(), n_byte_per_block / sizeof(_ConvertType), buffers.data(), n_channel,
+            n_samples);
         return;
       }
 
+      constexpr value_type denom = value_type(1.0) / (1L << (8L * sizeof(_ConvertType) - 1L));
+
       for (std::size_t i = 0; i < n_samples; i++) {
         std::size_t dt = n_byte_per_block * i;
         for (std::size_t channel = 0; channel < n_channel; channel++) {
@@ -270,41 +299,12 @@ namespace wav {
     template <typename _T, typename _ConvertType>
     inline void convert_ieee(
         mts::audio_buffer<_T>& buffers, const mts::byte_view& data, std::int16_t n_byte_per_block) {
-      using value_type = _T;
-      using wire = mts::wire<value_type>;
-
       std::size_t n_channel = buffers.channel_size();
       std::size_t n_samples = buffers.buffer_size();
 
-      if (n_channel == 1) {
-        if (n_byte_per_block == sizeof(_ConvertType)) {
-
-          const _ConvertType* v = data.data<_ConvertType>();
-          wire(buffers.channel_wire(0)).template assign_from<_ConvertType>(v);
-          return;
-        }
-
-        for (std::size_t i = 0; i < n_samples; i++) {
-          buffers[0][i] = *(const _ConvertType*)&data[n_byte_per_block * i];
-        }
-
-        return;
-      }
-
-      if (n_channel == 2) {
-        if (n_byte_per_block == 2 * sizeof(_ConvertType)) {
-          const _ConvertType* v = data.data<_ConvertType>();
-          wire(buffers.channel_wire(0)).template assign_from<_ConvertType>(v, 2);
-          wire(buffers.channel_wire(1)).template assign_from<_ConvertType>(v + 1, 2);
-          return;
-        }
-
-        for (std::size_t i = 0; i < n_samples; i++) {
-          std::size_t s_index = n_byte_per_block * i;
-          buffers[0][i] = *(const _ConvertType*)&data[s_index];
-          buffers[1][i] = *(const _ConvertType*)&data[s_index + sizeof(_ConvertType)];
-        }
-
+      if (n_byte_per_block % sizeof(_ConvertType) == 0) {
+        deinterleave(data.data<_ConvertType>(), n_byte_per_block / sizeof(_ConvertType), buffers.data(), n_channel,
+            n_samples);
         return;
       }
 
@@ -438,7 +438,8 @@ namespace wav {
         std::size_t dt = samplesStartIndex + (n_byte_per_block * i);
         for (std::size_t channel = 0; channel < n_channel; channel++) {
           std::size_t s_index = dt + channel * n_bytes_per_sample;
-          buffers[channel][i] = data.as<value_type, convert_options::pcm_8>(s_index);
+          // Calling data.as<value_type, pcm::pcm_8> would pick the endianness overload since pcm_8 is zero.
+          buffers[channel][i] = mts::pcm::convert<value_type, convert_options::pcm_8>(data.data() + s_index);
         }
       }
     } break;
@@ -532,9 +533,8 @@ namespace wav {
   // Save.
   //
   template <typename _Tp>
-  save_error save(const mts::filesystem::path& file_path, const audio_data<_Tp>& data_view, format e_format) {
-    using value_type = _Tp;
-
+  save_error save(const mts::filesystem::path& file_path, const audio_data<_Tp>& data_view, format e_format,
+      mts::dither_type d_type) {
     if (data_view.sample_rate == 0) {
       return save_error::invalid_sampling_rate;
     }
@@ -641,57 +641,32 @@ namespace wav {
 
     switch (e_format) {
     case format::pcm_8_bit: {
-      data.reserve(data.size() + buffer_size * channel_size);
-      for (std::size_t i = 0; i < buffer_size; i++) {
-        for (std::size_t channel = 0; channel < channel_size; channel++) {
-          data.push_back<value_type, mts::byte_vector::convert_options::pcm_8_bit>(buffers[channel][i]);
-        }
+      // 8 bit wav samples are unsigned, flipping the sign bit adds 128.
+      const std::size_t offset = data.size();
+      detail::encode_pcm<std::int8_t>(data, buffers, d_type);
+      for (std::size_t i = offset; i < data.size(); i++) {
+        data[i] ^= 0x80;
       }
     } break;
 
     case format::pcm_16_bit: {
-      data.reserve(data.size() + buffer_size * channel_size * 2);
-      for (std::size_t i = 0; i < buffer_size; i++) {
-        for (std::size_t channel = 0; channel < channel_size; channel++) {
-          data.push_back<value_type, mts::byte_vector::convert_options::pcm_16_bit>(buffers[channel][i]);
-        }
-      }
+      detail::encode_pcm<std::int16_t>(data, buffers, d_type);
     } break;
 
     case format::pcm_24_bit: {
-      data.reserve(data.size() + buffer_size * channel_size * 3);
-      for (std::size_t i = 0; i < buffer_size; i++) {
-        for (std::size_t channel = 0; channel < channel_size; channel++) {
-          data.push_back<value_type, mts::byte_vector::convert_options::pcm_24_bit>(buffers[channel][i]);
-        }
-      }
+      detail::encode_pcm<mts::int24_t>(data, buffers, d_type);
     } break;
 
     case format::pcm_32_bit: {
-      data.reserve(data.size() + buffer_size * channel_size * 4);
-      for (std::size_t i = 0; i < buffer_size; i++) {
-        for (std::size_t channel = 0; channel < channel_size; channel++) {
-          data.push_back<value_type, mts::byte_vector::convert_options::pcm_32_bit>(buffers[channel][i]);
-        }
-      }
+      detail::encode_pcm<std::int32_t>(data, buffers, d_type);
     } break;
 
     case format::ieee_32_bit: {
-      data.reserve(data.size() + buffer_size * channel_size * 4);
-      for (std::size_t i = 0; i < buffer_size; i++) {
-        for (std::size_t channel = 0; channel < channel_size; channel++) {
-          data.push_back<float>(buffers[channel][i]);
-        }
-      }
+      detail::encode_ieee<float>(data, buffers);
     } break;
 
     case format::ieee_64_bit: {
-      data.reserve(data.size() + buffer_size * channel_size * 8);
-      for (std::size_t i = 0; i < buffer_size; i++) {
-        for (std::size_t channel = 0; channel < channel_size; channel++) {
-          data.push_back<double>(buffers[channel][i]);
-        }
-      }
+      detail::encode_ieee<double>(data, buffers);
     } break;
 
     default: {
@@ -0,0 +1,306 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/audio/bus.h"
+#include "mts/audio/wire.h"
+#include "mts/audio/vector_operations.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+
+///
+/// Biquad coefficients normalized by a0.
+///
+/// The designs are from the RBJ audio EQ cookbook, frequency and sample_rate
+/// are in Hz and gain in dB.
+///
+template <typename T>
+struct biquad_coefficients {
+  T b0 = 1;
+  T b1 = 0;
+  T b2 = 0;
+  T a1 = 0;
+  T a2 = 0;
+
+  static inline biquad_coefficients lowpass(double frequency, double q, double sample_rate) noexcept {
+    const design d(frequency, q, sample_rate);
+    return d.normalize((1 - d.cos_w) / 2, 1 - d.cos_w, (1 - d.cos_w) / 2, 1 + d.alpha, -2 * d.cos_w, 1 - d.alpha);
+  }
+
+  static inline biquad_coefficients highpass(double frequency, double q, double sample_rate) noexcept {
+    const design d(frequency, q, sample_rate);
+    return d.normalize((1 + d.cos_w) / 2, -(1 + d.cos_w), (1 + d.cos_w) / 2, 1 + d.alpha, -2 * d.cos_w, 1 - d.alpha);
+  }
+
+  /// Constant 0 dB peak gain.
+  static inline biquad_coefficients bandpass(double frequency, double q, double sample_rate) noexcept {
+    const design d(frequency, q, sample_rate);
+    return d.normalize(d.alpha, 0, -d.alpha, 1 + d.alpha, -2 * d.cos_w, 1 - d.alpha);
+  }
+
+  static inline biquad_coefficients notch(double frequency, double q, double sample_rate) noexcept {
+    const design d(frequency, q, sample_rate);
+    return d.normalize(1, -2 * d.cos_w, 1, 1 + d.alpha, -2 * d.cos_w, 1 - d.alpha);
+  }
+
+  static inline biquad_coefficients allpass(double frequency, double q, double sample_rate) noexcept {
+    const design d(frequency, q, sample_rate);
+    return d.normalize(1 - d.alpha, -2 * d.cos_w, 1 + d.alpha, 1 + d.alpha, -2 * d.cos_w, 1 - d.alpha);
+  }
+
+  static inline biquad_coefficients peak(double frequency, double q, double gain, double sample_rate) noexcept {
+    const design d(frequency, q, sample_rate, gain);
+    return d.normalize(1 + d.alpha * d.a, -2 * d.cos_w, 1 - d.alpha * d.a, 1 + d.alpha / d.a, -2 * d.cos_w,
+        1 - d.alpha / d.a);
+  }
+
+  static inline biquad_coefficients low_shelf(double frequency, double q, double gain, double sample_rate) noexcept {
+    const design d(frequency, q, sample_rate, gain);
+    const double a = d.a;
+    const double k = 2 * std::sqrt(a) * d.alpha;
+    return d.normalize(a * ((a + 1) - (a - 1) * d.cos_w + k), 2 * a * ((a - 1) - (a + 1) * d.cos_w),
+        a * ((a + 1) - (a - 1) * d.cos_w - k), (a + 1) + (a - 1) * d.cos_w + k, -2 * ((a - 1) + (a + 1) * d.cos_w),
+        (a + 1) + (a - 1) * d.cos_w - k);
+  }
+
+  static inline biquad_coefficients high_shelf(double frequency, double q, double gain, double sample_rate) noexcept {
+    const design d(frequency, q, sample_rate, gain);
+    const double a = d.a;
+    const double k = 2 * std::sqrt(a) * d.alpha;
+    return d.normalize(a * ((a + 1) + (a - 1) * d.cos_w + k), -2 * a * ((a - 1) + (a + 1) * d.cos_w),
+        a * ((a + 1) + (a - 1) * d.cos_w - k), (a + 1) - (a - 1) * d.cos_w + k, 2 * ((a - 1) - (a + 1) * d.cos_w),
+        (a + 1) - (a - 1) * d.cos_w - k);
+  }
+
+private:
+  struct design {
+    inline design(double frequency, double q, double sample_rate, double gain = 0) noexcept {
+      const double w = 2 * 3.14159265358979323846 * frequency / sample_rate;
+      cos_w = std::cos(w);
+      alpha = std::sin(w) / (2 * q);
+      a = std::pow(10.0, gain / 40);
+    }
+
+    inline biquad_coefficients normalize(
+        double b0, double b1, double b2, double a0, double a1, double a2) const noexcept {
+      return biquad_coefficients{ (T)(b0 / a0), (T)(b1 / a0), (T)(b2 / a0), (T)(a1 / a0), (T)(a2 / a0) };
+    }
+
+    double cos_w;
+    double alpha;
+    double a;
+  };
+};
+
+///
+/// Cascade of n_stages biquads (transposed direct form II) on n_channels.
+///
+/// Channels are filtered in groups of simd register width with one channel
+/// per lane (see vec::biquad), a single channel runs the scalar path.
+///
+/// With smoothing, new coefficients are reached linearly over smoothing_size()
+/// samples, updated every smoothing_block_size samples. Every point on the line
+/// between two stable biquads is stable.
+///
+/// Allocation only happens in the constructor and in reset(n_channels, n_stages).
+///
+template <typename T>
+class biquad_bank {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using coefficients_type = biquad_coefficients<T>;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::biquad_bank only works with floating point value type.");
+
+  static constexpr size_type smoothing_block_size = 32;
+
+  biquad_bank() noexcept = default;
+
+  inline biquad_bank(size_type n_channels, size_type n_stages) { reset(n_channels, n_stages); }
+
+  /// All stages are reset to pass through.
+  inline void reset(size_type n_channels, size_type n_stages) {
+    _n_channels = n_channels;
+    _n_stages = n_stages;
+    _coefficients.assign(n_stages * 5 * n_channels, T(0));
+    _state.assign(n_stages * 2 * n_channels, T(0));
+    _inputs.resize(n_channels);
+    _outputs.resize(n_channels);
+
+    for (size_type k = 0; k < n_stages; k++) {
+      std::fill_n(_coefficients.data() + k * 5 * n_channels, n_channels, T(1));
+    }
+
+    _targets = _coefficients;
+    _increments.assign(_coefficients.size(), T(0));
+    _ramp_remaining = 0;
+  }
+
+  /// Clears the filter states.
+  inline void clear() noexcept { std::fill(_state.begin(), _state.end(), T(0)); }
+
+  inline size_type channel_size() const noexcept { return _n_channels; }
+  inline size_type stage_size() const noexcept { return _n_stages; }
+
+  inline void set_smoothing(size_type n_samples) noexcept { _smoothing_size = n_samples; }
+  inline size_type smoothing_size() const noexcept { return _smoothing_size; }
+
+  /// Sets the coefficients of a stage on all channels.
+  inline void set_coefficients(size_type stage, const coefficients_type& c) noexcept {
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      set_target(stage, ch, c);
+    }
+
+    start_ramp();
+  }
+
+  inline void set_coefficients(size_type stage, size_type channel, const coefficients_type& c) noexcept {
+    set_target(stage, channel, c);
+    start_ramp();
+  }
+
+  /// Current coefficients, which differ from the last ones set during smoothing.
+  inline coefficients_type get_coefficients(size_type stage, size_type channel) const noexcept {
+    const T* c = _coefficients.data() + stage * 5 * _n_channels + channel;
+    return coefficients_type{ c[0], c[_n_channels], c[2 * _n_channels], c[3 * _n_channels], c[4 * _n_channels] };
+  }
+
+  /// output may be input.
+  inline void process(const audio_bus<const T>& input, audio_bus<T> output) noexcept {
+    mts_assert(input.channel_size() >= _n_channels && output.channel_size() >= _n_channels, "Invalid channel size");
+    mts_assert(input.buffer_size() >= output.buffer_size(), "Invalid buffer size");
+    process_channels(input.data(), output.data(), output.buffer_size());
+  }
+
+  inline void process(audio_bus<T> bus) noexcept {
+    mts_assert(bus.channel_size() >= _n_channels, "Invalid channel size");
+    process_channels(bus.data(), bus.data(), bus.buffer_size());
+  }
+
+  /// Single channel bank only, output may be input.
+  inline void process(wire<const T> input, wire<T> output) noexcept {
+    mts_assert(_n_channels == 1, "Invalid channel size");
+    mts_assert(input.size() >= output.size(), "Invalid buffer size");
+    const T* in = input.data();
+    T* out = output.data();
+    process_channels(&in, &out, output.size());
+  }
+
+private:
+  size_type _n_channels = 0;
+  size_type _n_stages = 0;
+  size_type _smoothing_size = 0;
+  size_type _ramp_remaining = 0;
+  std::vector<T> _coefficients;
+  std::vector<T> _targets;
+  std::vector<T> _increments;
+  std::vector<T> _state;
+  std::vector<const T*> _inputs;
+  std::vector<T*> _outputs;
+
+  inline void set_target(size_type stage, size_type channel, const coefficients_type& c) noexcept {
+    mts_assert(stage < _n_stages && channel < _n_channels, "Out of bounds stage or channel");
+    T* t = _targets.data() + stage * 5 * _n_channels + channel;
+    t[0] = c.b0;
+    t[_n_channels] = c.b1;
+    t[2 * _n_channels] = c.b2;
+    t[3 * _n_channels] = c.a1;
+    t[4 * _n_channels] = c.a2;
+  }
+
+  inline void start_ramp() noexcept {
+    if (_smoothing_size == 0) {
+      _coefficients = _targets;
+      _ramp_remaining = 0;
+      return;
+    }
+
+    const T scale = T(1) / (T)_smoothing_size;
+    for (size_type j = 0; j < _coefficients.size(); j++) {
+      _increments[j] = (_targets[j] - _coefficients[j]) * scale;
+    }
+
+    _ramp_remaining = _smoothing_size;
+  }
+
+  inline void step_ramp(size_type n) noexcept {
+    _ramp_remaining -= n;
+
+    if (_ramp_remaining == 0) {
+      std::copy(_targets.begin(), _targets.end(), _coefficients.begin());
+      return;
+    }
+
+    vec::mul_sum(_increments.data(), 1, (T)n, _coefficients.data(), 1, _coefficients.data(), 1, _coefficients.size());
+  }
+
+  inline void process_channels(const T* const* input, T* const* output, size_type length) noexcept {
+    size_type i = 0;
+
+    while (_ramp_remaining && i < length) {
+      const size_type n = std::min({ smoothing_block_size, _ramp_remaining, length - i });
+      step_ramp(n);
+
+      for (size_type ch = 0; ch < _n_channels; ch++) {
+        _inputs[ch] = input[ch] + i;
+        _outputs[ch] = output[ch] + i;
+      }
+
+      vec::biquad(_inputs.data(), _outputs.data(), _n_channels, n, _coefficients.data(), _state.data(), _n_stages);
+      i += n;
+    }
+
+    if (i == 0) {
+      vec::biquad(input, output, _n_channels, length, _coefficients.data(), _state.data(), _n_stages);
+      return;
+    }
+
+    if (i < length) {
+      for (size_type ch = 0; ch < _n_channels; ch++) {
+        _inputs[ch] = input[ch] + i;
+        _outputs[ch] = output[ch] + i;
+      }
+
+      vec::biquad(_inputs.data(), _outputs.data(), _n_channels, length - i, _coefficients.data(), _state.data(),
+          _n_stages);
+    }
+  }
+};
+MTS_END_NAMESPACE
@@ -35,11 +35,20 @@
 #include "mts/config.h"
 #include "mts/assert.h"
 #include "mts/traits.h"
+#include "mts/audio/buffer_allocation.h"
 #include "mts/audio/detail/buffer_allocator.h"
 #include "mts/audio/vector_operations.h"
 #include "mts/audio/wire.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 MTS_BEGIN_NAMESPACE
+template <typename T>
+class audio_buffer_pool;
+
 template <typename T>
 class audio_buffer {
 public:
@@ -58,24 +67,24 @@ public:
 
   inline audio_buffer(size_type __buffer_size, size_type __channel_size)
       : audio_buffer() {
+    allocate(__buffer_size, __channel_size, nullptr);
+  }
 
-    detail::allocate_audio_buffer(_buffers, __buffer_size, __channel_size);
-
-    if (_buffers) {
-      _buffer_size = __buffer_size;
-      _channel_size = __channel_size;
-
-      clear();
-    }
+  inline audio_buffer(size_type __buffer_size, size_type __channel_size, const buffer_allocation_policy& policy)
+      : audio_buffer() {
+    allocate(__buffer_size, __channel_size, &policy);
   }
 
   inline audio_buffer(audio_buffer&& d) noexcept
       : _buffers(d._buffers)
       , _buffer_size(d._buffer_size)
-      , _channel_size(d._channel_size) {
+      , _channel_size(d._channel_size)
+      , _pool(d._pool)
+      , _slot(d._slot) {
     d._buffers = nullptr;
     d._buffer_size = 0;
     d._channel_size = 0;
+    d._pool = nullptr;
   }
 
   inline ~audio_buffer() { reset(); }
@@ -87,14 +96,20 @@ public:
     _buffers = d._buffers;
     _buffer_size = d._buffer_size;
     _channel_size = d._channel_size;
+    _pool = d._pool;
+    _slot = d._slot;
     d._buffers = nullptr;
     d._buffer_size = 0;
     d._channel_size = 0;
+    d._pool = nullptr;
     return *this;
   }
 
   inline bool is_valid() const noexcept { return (bool)_buffers; }
 
+  /// True when the storage comes from an audio_buffer_pool.
+  inline bool is_pooled() const noexcept { return _pool != nullptr; }
+
   inline size_type channel_size() const noexcept { return _channel_size; }
   inline size_type buffer_size() const noexcept { return _buffer_size; }
 
@@ -139,8 +154,14 @@ public:
     }
   }
 
+  /// A pooled buffer goes back to its pool.
   inline void reset() {
-    if (_buffers) {
+    if (_pool) {
+      _pool->release(_slot);
+      _pool = nullptr;
+      _buffers = nullptr;
+    }
+    else if (_buffers) {
       detail::deallocate_audio_buffer(_buffers);
       _buffers = nullptr;
     }
@@ -149,27 +170,65 @@ public:
     _channel_size = 0;
   }
 
+  /// A pooled buffer is reshaped in place without allocation when the new
+  /// shape fits in its pool, otherwise it goes back to the pool and the new
+  /// buffer is allocated.
   inline void reset(size_type __buffer_size, size_type __channel_size) {
+    reallocate(__buffer_size, __channel_size, nullptr);
+  }
+
+  /// The policy only applies when the buffer is reallocated.
+  inline void reset(size_type __buffer_size, size_type __channel_size, const buffer_allocation_policy& policy) {
+    reallocate(__buffer_size, __channel_size, &policy);
+  }
+
+private:
+  buffer_pointer _buffers = nullptr;
+  size_type _buffer_size = 0;
+  size_type _channel_size = 0;
+  audio_buffer_pool<T>* _pool = nullptr;
+  std::uint32_t _slot = 0;
+
+  friend class audio_buffer_pool<T>;
+
+  inline void allocate(size_type __buffer_size, size_type __channel_size, const buffer_allocation_policy* policy) {
+    detail::allocate_audio_buffer(_buffers, __buffer_size, __channel_size, policy);
+
+    if (_buffers) {
+      _buffer_size = __buffer_size;
+      _channel_size = __channel_size;
 
-    if (_buffers && _buffer_size == __buffer_size && _channel_size == __channel_size) {
       clear();
-      return;
     }
+  }
 
-    reset();
+  inline void reallocate(size_type __buffer_size, size_type __channel_size, const buffer_allocation_policy* policy) {
 
-    detail::allocate_audio_buffer(_buffers, __buffer_size, __channel_size);
+    if (_buffers && _buffer_size == __buffer_size && _channel_size == __channel_size) {
+      clear();
+      return;
+    }
 
-    if (_buffers) {
+    if (_pool && _pool->fits(__buffer_size, __channel_size)) {
       _buffer_size = __buffer_size;
       _channel_size = __channel_size;
+      clear();
+      return;
     }
+
+    reset();
+    allocate(__buffer_size, __channel_size, policy);
   }
 
-private:
-  buffer_pointer _buffers = nullptr;
-  size_type _buffer_size = 0;
-  size_type _channel_size = 0;
+  inline audio_buffer(audio_buffer_pool<T>* pool, std::uint32_t slot, buffer_pointer buffers, size_type __buffer_size,
+      size_type __channel_size) noexcept
+      : _buffers(buffers)
+      , _buffer_size(__buffer_size)
+      , _channel_size(__channel_size)
+      , _pool(pool)
+      , _slot(slot) {
+    clear();
+  }
 };
 
 template <typename T>
@@ -192,15 +251,13 @@ public:
 
   inline interleaved_audio_buffer(size_type __buffer_size, size_type __channel_size)
       : interleaved_audio_buffer() {
+    allocate(__buffer_size, __channel_size, nullptr);
+  }
 
-    detail::allocate_interleaved_audio_buffer(_buffers, __buffer_size, __channel_size);
-
-    if (_buffers) {
-      _buffer_size = __buffer_size;
-      _channel_size = __channel_size;
-
-      clear();
-    }
+  inline interleaved_audio_buffer(
+      size_type __buffer_size, size_type __channel_size, const buffer_allocation_policy& policy)
+      : interleaved_audio_buffer() {
+    allocate(__buffer_size, __channel_size, &policy);
   }
 
   inline interleaved_audio_buffer(interleaved_audio_buffer&& d) noexcept
@@ -262,6 +319,31 @@ public:
   }
 
   inline void reset(size_type __buffer_size, size_type __channel_size) {
+    reallocate(__buffer_size, __channel_size, nullptr);
+  }
+
+  /// The policy only applies when the buffer is reallocated.
+  inline void reset(size_type __buffer_size, size_type __channel_size, const buffer_allocation_policy& policy) {
+    reallocate(__buffer_size, __channel_size, &policy);
+  }
+
+private:
+  buffer_pointer _buffers = nullptr;
+  size_type _buffer_size = 0;
+  size_type _channel_size = 0;
+
+  inline void allocate(size_type __buffer_size, size_type __channel_size, const buffer_allocation_policy* policy) {
+    detail::allocate_interleaved_audio_buffer(_buffers, __buffer_size, __channel_size, policy);
+
+    if (_buffers) {
+      _buffer_size = __buffer_size;
+      _channel_size = __channel_size;
+
+      clear();
+    }
+  }
+
+  inline void reallocate(size_type __buffer_size, size_type __channel_size, const buffer_allocation_policy* policy) {
 
     if (_buffers && _buffer_size == __buffer_size && _channel_size == __channel_size) {
       clear();
@@ -269,19 +351,183 @@ public:
     }
 
     reset();
+    allocate(__buffer_size, __channel_size, policy);
+  }
+};
+
+///
+/// Fixed number of preallocated audio buffers of at most max_buffer_size
+/// frames and max_channel_size channels, with cache aligned channels.
+///
+/// acquire() and the release of a pooled audio_buffer (reset() or its
+/// destructor) are lock free and never touch the system allocator, they can
+/// be called from the audio thread and from any other thread. A pooled buffer
+/// can also be reshaped without allocation with reset(buffer_size, channel_size).
+///
+/// Allocation only happens in the constructor and in reset(). All the
+/// buffers must be released before the pool is reset or destroyed.
+///
+template <typename T>
+class audio_buffer_pool {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using buffer_type = audio_buffer<T>;
 
-    detail::allocate_interleaved_audio_buffer(_buffers, __buffer_size, __channel_size);
+  struct statistics {
+    size_type capacity;
+    size_type in_use;
+    size_type peak_in_use;
+    std::uint64_t acquired;
+    std::uint64_t failed;
+  };
 
-    if (_buffers) {
-      _buffer_size = __buffer_size;
-      _channel_size = __channel_size;
+  audio_buffer_pool() noexcept = default;
+
+  inline audio_buffer_pool(size_type n_buffers, size_type max_buffer_size, size_type max_channel_size) {
+    reset(n_buffers, max_buffer_size, max_channel_size);
+  }
+
+  inline audio_buffer_pool(size_type n_buffers, size_type max_buffer_size, size_type max_channel_size,
+      const buffer_allocation_policy& policy) {
+    reset(n_buffers, max_buffer_size, max_channel_size, policy);
+  }
+
+  audio_buffer_pool(const audio_buffer_pool&) = delete;
+  audio_buffer_pool(audio_buffer_pool&&) = delete;
+
+  inline ~audio_buffer_pool() { deallocate(); }
+
+  audio_buffer_pool& operator=(const audio_buffer_pool&) = delete;
+  audio_buffer_pool& operator=(audio_buffer_pool&&) = delete;
+
+  /// The pool is left empty if the allocation fails.
+  inline void reset(size_type n_buffers, size_type max_buffer_size, size_type max_channel_size) {
+    reset(n_buffers, max_buffer_size, max_channel_size, get_default_buffer_allocation_policy());
+  }
+
+  /// A policy locking the buffers keeps the whole pool resident.
+  inline void reset(size_type n_buffers, size_type max_buffer_size, size_type max_channel_size,
+      const buffer_allocation_policy& policy) {
+    mts_assert(n_buffers < empty_slot, "Too many buffers");
+    deallocate();
+
+    _max_buffer_size = max_buffer_size;
+    _max_channel_size = max_channel_size;
+    _slots.assign(n_buffers, nullptr);
+    _next = std::make_unique<std::atomic<std::uint32_t>[]>(n_buffers);
+
+    for (size_type i = 0; i < n_buffers; i++) {
+      detail::allocate_audio_buffer(_slots[i], max_buffer_size, max_channel_size, &policy);
+
+      if (!_slots[i]) {
+        deallocate();
+        return;
+      }
+
+      _next[i].store(i + 1 < n_buffers ? (std::uint32_t)(i + 1) : empty_slot, std::memory_order_relaxed);
+    }
+
+    _head.store(n_buffers ? 0 : empty_slot, std::memory_order_release);
+    _in_use.store(0, std::memory_order_relaxed);
+    _peak_in_use.store(0, std::memory_order_relaxed);
+    _acquired.store(0, std::memory_order_relaxed);
+    _failed.store(0, std::memory_order_relaxed);
+  }
+
+  inline size_type capacity() const noexcept { return _slots.size(); }
+  inline size_type max_buffer_size() const noexcept { return _max_buffer_size; }
+  inline size_type max_channel_size() const noexcept { return _max_channel_size; }
+
+  inline bool fits(size_type buffer_size, size_type channel_size) const noexcept {
+    return buffer_size && channel_size && buffer_size <= _max_buffer_size && channel_size <= _max_channel_size;
+  }
+
+  /// Cleared buffer, or an invalid one when the pool is empty or the shape
+  /// doesn't fit.
+  inline buffer_type acquire(size_type buffer_size, size_type channel_size) noexcept {
+    const std::uint32_t slot = fits(buffer_size, channel_size) ? pop() : empty_slot;
+
+    if (slot == empty_slot) {
+      _failed.fetch_add(1, std::memory_order_relaxed);
+      return buffer_type();
     }
+
+    _acquired.fetch_add(1, std::memory_order_relaxed);
+    const size_type in_use = _in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_type peak = _peak_in_use.load(std::memory_order_relaxed);
+
+    while (in_use > peak && !_peak_in_use.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
+    }
+
+    return buffer_type(this, slot, _slots[slot], buffer_size, channel_size);
+  }
+
+  inline statistics get_statistics() const noexcept {
+    return statistics{ capacity(), _in_use.load(std::memory_order_relaxed),
+      _peak_in_use.load(std::memory_order_relaxed), _acquired.load(std::memory_order_relaxed),
+      _failed.load(std::memory_order_relaxed) };
   }
 
 private:
-  buffer_pointer _buffers = nullptr;
-  size_type _buffer_size = 0;
-  size_type _channel_size = 0;
+  static constexpr std::uint32_t empty_slot = ~std::uint32_t(0);
+
+  std::vector<T* const*> _slots;
+  size_type _max_buffer_size = 0;
+  size_type _max_channel_size = 0;
+
+  // Free list, the head is a slot in the low 32 bits and a tag against
+  // the aba problem in the high ones.
+  std::unique_ptr<std::atomic<std::uint32_t>[]> _next;
+  std::atomic<std::uint64_t> _head = empty_slot;
+
+  std::atomic<size_type> _in_use = 0;
+  std::atomic<size_type> _peak_in_use = 0;
+  std::atomic<std::uint64_t> _acquired = 0;
+  std::atomic<std::uint64_t> _failed = 0;
+
+  friend class audio_buffer<T>;
+
+  inline void release(std::uint32_t slot) noexcept {
+    _in_use.fetch_sub(1, std::memory_order_relaxed);
+    std::uint64_t head = _head.load(std::memory_order_relaxed);
+
+    do {
+      _next[slot].store((std::uint32_t)head, std::memory_order_relaxed);
+    } while (!_head.compare_exchange_weak(
+        head, next_tag(head) | slot, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  inline std::uint32_t pop() noexcept {
+    std::uint64_t head = _head.load(std::memory_order_acquire);
+
+    while ((std::uint32_t)head != empty_slot) {
+      const std::uint32_t slot = (std::uint32_t)head;
+      const std::uint64_t next = next_tag(head) | _next[slot].load(std::memory_order_relaxed);
+
+      if (_head.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire)) {
+        return slot;
+      }
+    }
+
+    return empty_slot;
+  }
+
+  static inline std::uint64_t next_tag(std::uint64_t head) noexcept { return ((head >> 32) + 1) << 32; }
+
+  inline void deallocate() noexcept {
+    mts_assert(_in_use.load() == 0, "Pooled buffers still in use");
+
+    for (T* const* buffers : _slots) {
+      if (buffers) {
+        detail::deallocate_audio_buffer(buffers);
+      }
+    }
+
+    _slots.clear();
+    _next.reset();
+    _head.store(empty_slot, std::memory_order_relaxed);
+  }
 };
 MTS_END_NAMESPACE
 
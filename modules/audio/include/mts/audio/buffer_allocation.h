@@ -0,0 +1,107 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include <cstddef>
+
+MTS_BEGIN_NAMESPACE
+enum class huge_page_mode {
+  none,
+
+  /// Transparent huge pages (madvise), used by the kernel when it can.
+  transparent,
+
+  /// Huge pages reserved by the system (vm.nr_hugepages on linux), falls back
+  /// to transparent huge pages when none are available.
+  reserved
+};
+
+///
+/// How the storage of the audio buffers is allocated.
+///
+/// A buffer touched for the first time in the audio callback can page fault.
+/// prefault touches all the pages on allocation, lock keeps them in physical
+/// memory (mlock, which also prefaults) and huge pages reduce the number of
+/// pages of the buffers of at least huge_page_threshold bytes.
+///
+/// Channels are aligned to the cache line. With power of two buffer sizes
+/// they all start at the same offset within a page and map to the same cache
+/// sets, channel_stagger shifts the start of each channel by that many cache
+/// lines from the previous one.
+///
+/// Locking and huge pages are only available on unix and linux, a failure
+/// (e.g. RLIMIT_MEMLOCK) is counted in the buffer_allocation_statistics and
+/// the buffer is still allocated.
+///
+struct buffer_allocation_policy {
+  bool prefault = false;
+  bool lock = false;
+  huge_page_mode huge_pages = huge_page_mode::none;
+  std::size_t huge_page_threshold = 2 * 1024 * 1024;
+  std::size_t channel_stagger = 0;
+};
+
+/// Layout of a planar audio buffer, in bytes.
+struct buffer_layout {
+  std::size_t cache_size;
+
+  /// Distance between the start of two consecutive channels.
+  std::size_t channel_stride;
+
+  /// Padding of each channel after its samples, staggering included.
+  std::size_t channel_padding;
+
+  /// Allocated size, pointer table included.
+  std::size_t size;
+};
+
+struct buffer_allocation_statistics {
+  /// Bytes currently locked and backed by huge pages.
+  std::size_t locked_bytes;
+  std::size_t huge_page_bytes;
+
+  std::size_t lock_failures;
+  std::size_t huge_page_failures;
+};
+
+/// Policy of the buffers allocated without one, thread safe.
+void set_default_buffer_allocation_policy(const buffer_allocation_policy& policy);
+buffer_allocation_policy get_default_buffer_allocation_policy();
+
+buffer_allocation_statistics get_buffer_allocation_statistics();
+
+/// Layout of the planar buffers of buffer_size frames of value_size bytes.
+buffer_layout get_buffer_layout(
+    std::size_t buffer_size, std::size_t channel_size, std::size_t value_size, const buffer_allocation_policy& policy);
+MTS_END_NAMESPACE
@@ -146,6 +146,36 @@ public:
   inline channel_pointer operator[](size_type index) noexcept { return _buffers[index]; }
   inline channel_const_pointer operator[](size_type index) const noexcept { return _buffers[index]; }
 
+  /// View of the frames [offset, offset + frames) of all the channels.
+  inline audio_bus subbus(size_type offset, size_type frames) const noexcept {
+    mts_assert(offset + frames <= _buffer_size, "Out of bounds frames");
+
+    audio_bus b;
+    for (std::size_t i = 0; i < Size; i++) {
+      b._buffers[i] = _buffers[i] + offset;
+    }
+    b._buffer_size = frames;
+    return b;
+  }
+
+  /// View of the N channels from First.
+  template <std::size_t First, std::size_t N>
+  inline audio_bus<T, N> channels() const noexcept {
+    static_assert(First + N <= Size, "Invalid channel size");
+    return audio_bus<T, N>(_buffers.data() + First, _buffer_size);
+  }
+
+  /// View of the given channels in that order, e.g. select<2>({ 3, 4 }).
+  template <std::size_t N>
+  inline audio_bus<T, N> select(const std::array<size_type, N>& indices) const noexcept {
+    std::array<channel_pointer, N> buffers;
+    for (std::size_t i = 0; i < N; i++) {
+      mts_assert(indices[i] < Size, "Out of bounds index");
+      buffers[i] = _buffers[indices[i]];
+    }
+    return audio_bus<T, N>(buffers.data(), _buffer_size);
+  }
+
 private:
   template <class, std::size_t>
   friend class bus;
@@ -219,6 +249,46 @@ public:
   inline channel_pointer operator[](size_type index) noexcept { return _buffers[index]; }
   inline channel_const_pointer operator[](size_type index) const noexcept { return _buffers[index]; }
 
+  /// View of the frames [offset, offset + frames) of all the channels.
+  ///
+  /// The bus only points to its channel pointers, the offset ones are written
+  /// to pointers which must hold channel_size() elements and outlive the view.
+  inline audio_bus subbus(size_type offset, size_type frames, channel_pointer* pointers) const noexcept {
+    mts_assert(offset + frames <= _buffer_size, "Out of bounds frames");
+
+    for (std::size_t i = 0; i < _channel_size; i++) {
+      pointers[i] = _buffers[i] + offset;
+    }
+    return audio_bus(pointers, frames, _channel_size);
+  }
+
+  /// View of the n channels from first.
+  inline audio_bus channels(size_type first, size_type n) const noexcept {
+    mts_assert(first + n <= _channel_size, "Out of bounds channels");
+    return audio_bus(_buffers + first, _buffer_size, n);
+  }
+
+  /// View of the given channels in that order, e.g. select<2>({ 3, 4 }).
+  template <std::size_t N>
+  inline audio_bus<T, N> select(const std::array<size_type, N>& indices) const noexcept {
+    std::array<channel_pointer, N> buffers;
+    for (std::size_t i = 0; i < N; i++) {
+      mts_assert(indices[i] < _channel_size, "Out of bounds index");
+      buffers[i] = _buffers[indices[i]];
+    }
+    return audio_bus<T, N>(buffers.data(), _buffer_size);
+  }
+
+  /// View of the n channels of indices, their channel pointers are written to
+  /// pointers which must outlive the view.
+  inline audio_bus select(const size_type* indices, size_type n, channel_pointer* pointers) const noexcept {
+    for (std::size_t i = 0; i < n; i++) {
+      mts_assert(indices[i] < _channel_size, "Out of bounds index");
+      pointers[i] = _buffers[indices[i]];
+    }
+    return audio_bus(pointers, _buffer_size, n);
+  }
+
 private:
   buffer_pointer _buffers = nullptr;
   size_type _buffer_size = 0;
@@ -292,6 +362,12 @@ public:
   inline reference operator[](size_type index) noexcept { return data()[index]; }
   inline const_reference operator[](size_type index) const noexcept { return data()[index]; }
 
+  /// View of the frames [offset, offset + frames).
+  inline interleaved_audio_bus subbus(size_type offset, size_type frames) const noexcept {
+    mts_assert(offset + frames <= _buffer_size, "Out of bounds frames");
+    return interleaved_audio_bus(_buffer + offset * _channel_size, frames, _channel_size);
+  }
+
 private:
   pointer _buffer = nullptr;
   size_type _buffer_size = 0;
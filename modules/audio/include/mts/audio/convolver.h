@@ -0,0 +1,506 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/audio/bus.h"
+#include "mts/audio/fft.h"
+#include "mts/audio/wire.h"
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+
+///
+/// Partitioned fft convolution of n_channels with a multichannel impulse
+/// response, channel ch uses the impulse response channel ch % ir channels.
+///
+/// The first block_size taps are a direct form fir so there is no added
+/// latency. The rest is split in segments of uniformly partitioned overlap
+/// save convolutions: the first one has block_size partitions and each next
+/// segment four times larger partitions, up to max_partition_size. A segment
+/// with partition size P starts at 2 * P taps, which leaves a whole partition
+/// period to compute it. With background_tail, each segment after the first
+/// one is computed on its own worker thread, a long partition never delays a
+/// shorter one.
+///
+/// Handing a job over to a worker is a store and an atomic notify, the audio
+/// thread never takes a lock. It only waits when a job isn't done by the next
+/// boundary of its segment, these waits are counted by late_job_count().
+///
+/// process() takes any number of frames, block_size doesn't need to match the
+/// host block size: the direct form costs block_size multiply adds per sample.
+/// Allocation only happens in reset().
+///
+template <typename T>
+class convolver {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using complex_type = std::complex<T>;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::convolver only works with floating point value type.");
+
+  static constexpr size_type default_max_partition_size = 8192;
+
+  convolver() noexcept = default;
+
+  inline convolver(const audio_bus<const T>& ir, size_type n_channels, size_type block_size,
+      bool background_tail = true, size_type max_partition_size = default_max_partition_size) {
+    reset(ir, n_channels, block_size, background_tail, max_partition_size);
+  }
+
+  convolver(const convolver&) = delete;
+  convolver(convolver&&) = delete;
+
+  inline ~convolver() { stop_worker(); }
+
+  convolver& operator=(const convolver&) = delete;
+  convolver& operator=(convolver&&) = delete;
+
+  /// The impulse response is copied.
+  inline void reset(const audio_bus<const T>& ir, size_type n_channels, size_type block_size,
+      bool background_tail = true, size_type max_partition_size = default_max_partition_size) {
+    mts_assert(ir.channel_size() > 0 && block_size > 0, "Invalid impulse response or block size");
+    stop_worker();
+
+    _n_channels = n_channels;
+    _ir_channels = ir.channel_size();
+    _ir_size = ir.buffer_size();
+    _block_size = block_size;
+    _time = 0;
+
+    const size_type b = block_size;
+    _head.assign(_ir_channels * b, T(0));
+    _history.assign(n_channels * 2 * b, T(0));
+
+    for (size_type c = 0; c < _ir_channels; c++) {
+      std::copy_n(ir[c], std::min(b, _ir_size), _head.data() + c * b);
+    }
+
+    // Segment layout.
+    std::vector<layout> layouts;
+    size_type ring_size = b;
+
+    for (size_type offset = b, p = b; offset < _ir_size;) {
+      const size_type next_p = p * 4 <= std::max(max_partition_size, b) ? p * 4 : p;
+      const size_type end = next_p == p ? _ir_size : std::min(_ir_size, 2 * next_p);
+      const size_type n_parts = (end - offset + p - 1) / p;
+      layouts.push_back(layout{ p, offset, n_parts });
+      ring_size = std::max(ring_size, offset + p + b);
+      offset += n_parts * p;
+      p = next_p;
+    }
+
+    // A multiple of block_size so that a block never wraps around.
+    _ring_size = (ring_size + b - 1) / b * b;
+
+    _ring.assign(n_channels * _ring_size, T(0));
+    _n_segments = layouts.size();
+    _segments = _n_segments ? std::make_unique<segment[]>(_n_segments) : nullptr;
+
+    for (size_type k = 0; k < _n_segments; k++) {
+      init_segment(_segments[k], layouts[k], ir, background_tail && k > 0);
+    }
+
+    for (size_type k = 0; k < _n_segments; k++) {
+      segment& s = _segments[k];
+
+      if (s.background) {
+        s.worker = std::thread([this, &s]() { run_worker(s); });
+      }
+    }
+
+    _late_jobs.store(0, std::memory_order_relaxed);
+  }
+
+  /// Clears the convolution state, waits for the background jobs.
+  inline void clear() noexcept {
+    for (size_type k = 0; k < _n_segments; k++) {
+      segment& s = _segments[k];
+      wait_job(s);
+      s.queued = false;
+      s.fdl_position = 0;
+      std::fill(s.input.begin(), s.input.end(), T(0));
+      std::fill(s.pending_input.begin(), s.pending_input.end(), T(0));
+      std::fill(s.spectra.begin(), s.spectra.end(), complex_type(0));
+    }
+
+    std::fill(_history.begin(), _history.end(), T(0));
+    std::fill(_ring.begin(), _ring.end(), T(0));
+    _time = 0;
+  }
+
+  inline size_type channel_size() const noexcept { return _n_channels; }
+  inline size_type block_size() const noexcept { return _block_size; }
+  inline size_type ir_size() const noexcept { return _ir_size; }
+  inline size_type segment_size() const noexcept { return _n_segments; }
+
+  /// Number of times process() had to wait for a background job.
+  inline std::uint64_t late_job_count() const noexcept { return _late_jobs.load(std::memory_order_relaxed); }
+
+  /// output may be input.
+  inline void process(const audio_bus<const T>& input, audio_bus<T> output) noexcept {
+    mts_assert(input.channel_size() >= _n_channels && output.channel_size() >= _n_channels, "Invalid channel size");
+    mts_assert(input.buffer_size() >= output.buffer_size(), "Invalid buffer size");
+    process_channels(input.data(), output.data(), output.buffer_size());
+  }
+
+  inline void process(audio_bus<T> bus) noexcept {
+    mts_assert(bus.channel_size() >= _n_channels, "Invalid channel size");
+    process_channels(bus.data(), bus.data(), bus.buffer_size());
+  }
+
+  /// Single channel convolver only, output may be input.
+  inline void process(wire<const T> input, wire<T> output) noexcept {
+    mts_assert(_n_channels == 1, "Invalid channel size");
+    mts_assert(input.size() >= output.size(), "Invalid buffer size");
+    const T* in = input.data();
+    T* out = output.data();
+    process_channels(&in, &out, output.size());
+  }
+
+private:
+  enum : std::uint32_t { job_idle, job_pending, job_stop };
+
+  struct layout {
+    size_type partition_size;
+    size_type offset;
+    size_type n_partitions;
+  };
+
+  ///
+  /// Uniformly partitioned overlap save convolution of the taps
+  /// [offset, offset + n_partitions * partition_size).
+  ///
+  /// Every partition_size frames, the last 2 * partition_size input samples
+  /// go through a frequency domain delay line and the partition_size output
+  /// samples for the frames [time - partition_size + offset, ...) are
+  /// added to the output ring.
+  ///
+  struct segment {
+    size_type partition_size = 0;
+    size_type offset = 0;
+    size_type n_partitions = 0;
+    size_type n_bins = 0;
+    size_type fdl_position = 0;
+    size_type output_time = 0;
+    bool background = false;
+    bool queued = false;
+    std::atomic<std::uint32_t> state = job_idle;
+    std::thread worker;
+    real_fft<T> plan;
+
+    // n_channels * 2 * partition_size, read by the job.
+    std::vector<T> input;
+
+    // n_channels * partition_size, filled by process.
+    std::vector<T> pending_input;
+
+    // n_channels * partition_size, written by the job.
+    std::vector<T> output;
+
+    // n_channels * n_partitions * n_bins.
+    std::vector<complex_type> spectra;
+
+    // ir channels * n_partitions * n_bins, scaled by 1 / (2 * partition_size).
+    std::vector<complex_type> ir_spectra;
+
+    // n_bins.
+    std::vector<complex_type> accumulator;
+  };
+
+  size_type _n_channels = 0;
+  size_type _ir_channels = 0;
+  size_type _ir_size = 0;
+  size_type _block_size = 0;
+  size_type _ring_size = 0;
+  size_type _n_segments = 0;
+  size_type _time = 0;
+
+  // ir channels * block_size.
+  std::vector<T> _head;
+
+  // n_channels * 2 * block_size, the previous and current blocks.
+  std::vector<T> _history;
+
+  // n_channels * ring_size of future output.
+  std::vector<T> _ring;
+
+  std::unique_ptr<segment[]> _segments;
+  std::atomic<std::uint64_t> _late_jobs = 0;
+
+  inline void stop_worker() {
+    for (size_type k = 0; k < _n_segments; k++) {
+      segment& s = _segments[k];
+
+      if (s.worker.joinable()) {
+        wait_job(s);
+        s.state.store(job_stop, std::memory_order_release);
+        s.state.notify_one();
+        s.worker.join();
+      }
+    }
+  }
+
+  inline void init_segment(segment& s, const layout& l, const audio_bus<const T>& ir, bool background) {
+    const size_type p = l.partition_size;
+    s.partition_size = p;
+    s.offset = l.offset;
+    s.n_partitions = l.n_partitions;
+    s.n_bins = p + 1;
+    s.background = background;
+    s.plan.reset(2 * p);
+    s.input.assign(_n_channels * 2 * p, T(0));
+    s.pending_input.assign(_n_channels * p, T(0));
+    s.output.assign(_n_channels * p, T(0));
+    s.spectra.assign(_n_channels * s.n_partitions * s.n_bins, complex_type(0));
+    s.ir_spectra.assign(_ir_channels * s.n_partitions * s.n_bins, complex_type(0));
+    s.accumulator.assign(s.n_bins, complex_type(0));
+
+    std::vector<T> taps(2 * p);
+    const T scale = T(1) / (T)(2 * p);
+
+    for (size_type c = 0; c < _ir_channels; c++) {
+      for (size_type i = 0; i < s.n_partitions; i++) {
+        const size_type start = s.offset + i * p;
+        const size_type n = start < _ir_size ? std::min(p, _ir_size - start) : 0;
+        std::fill(taps.begin(), taps.end(), T(0));
+
+        for (size_type j = 0; j < n; j++) {
+          taps[j] = ir[c][start + j] * scale;
+        }
+
+        s.plan.forward(taps.data(), s.ir_spectra.data() + (c * s.n_partitions + i) * s.n_bins);
+      }
+    }
+  }
+
+  static constexpr size_type wait_spin_size = 1000;
+
+  // Spins a little before blocking, a late job is usually close to done.
+  static inline void wait_job(segment& s) noexcept {
+    for (size_type i = 0; i < wait_spin_size && s.state.load(std::memory_order_acquire) == job_pending; i++) {
+      MTS_NOP();
+    }
+
+    for (std::uint32_t state; (state = s.state.load(std::memory_order_acquire)) == job_pending;) {
+      s.state.wait(state, std::memory_order_acquire);
+    }
+  }
+
+  inline void run_worker(segment& s) noexcept {
+    while (true) {
+      s.state.wait(job_idle, std::memory_order_acquire);
+      const std::uint32_t state = s.state.load(std::memory_order_acquire);
+
+      if (state == job_stop) {
+        return;
+      }
+
+      if (state == job_pending) {
+        compute_segment(s);
+        s.state.store(job_idle, std::memory_order_release);
+        s.state.notify_one();
+      }
+    }
+  }
+
+  /// Convolves the input of the last partition into output.
+  inline void compute_segment(segment& s) noexcept {
+    const size_type p = s.partition_size;
+    const size_type n_bins = s.n_bins;
+    const size_type n_parts = s.n_partitions;
+
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      complex_type* spectra = s.spectra.data() + ch * n_parts * n_bins;
+      const complex_type* ir = s.ir_spectra.data() + (ch % _ir_channels) * n_parts * n_bins;
+      s.plan.forward(s.input.data() + ch * 2 * p, spectra + s.fdl_position * n_bins);
+
+      complex_type* acc = s.accumulator.data();
+      std::fill_n(acc, n_bins, complex_type(0));
+
+      for (size_type i = 0; i < n_parts; i++) {
+        const size_type slot = (s.fdl_position + n_parts - i) % n_parts;
+        multiply_accumulate(reinterpret_cast<const T*>(spectra + slot * n_bins),
+            reinterpret_cast<const T*>(ir + i * n_bins), reinterpret_cast<T*>(acc), n_bins);
+      }
+
+      // The inverse fits in the accumulator's 2 * partition_size + 2 values.
+      T* y = reinterpret_cast<T*>(acc);
+      s.plan.inverse(acc, y);
+      std::copy_n(y + p, p, s.output.data() + ch * p);
+    }
+
+    s.fdl_position = (s.fdl_position + 1) % n_parts;
+  }
+
+  static inline void multiply_accumulate(
+      const T* __restrict x, const T* __restrict h, T* __restrict acc, size_type n_bins) noexcept {
+    for (size_type i = 0; i < 2 * n_bins; i += 2) {
+      acc[i] += x[i] * h[i] - x[i + 1] * h[i + 1];
+      acc[i + 1] += x[i] * h[i + 1] + x[i + 1] * h[i];
+    }
+  }
+
+  /// Adds the output of a segment to the ring.
+  inline void accumulate_output(const segment& s) noexcept {
+    const size_type p = s.partition_size;
+    const size_type start = s.output_time % _ring_size;
+    const size_type n_first = std::min(p, _ring_size - start);
+
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      T* ring = _ring.data() + ch * _ring_size;
+      const T* y = s.output.data() + ch * p;
+
+      for (size_type i = 0; i < n_first; i++) {
+        ring[start + i] += y[i];
+      }
+
+      for (size_type i = n_first; i < p; i++) {
+        ring[i - n_first] += y[i];
+      }
+    }
+  }
+
+  /// Called on every block_size boundary, before the frames at _time are processed.
+  inline void run_boundaries() noexcept {
+    const size_type b = _block_size;
+
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      T* h = _history.data() + ch * 2 * b;
+      std::copy_n(h + b, b, h);
+    }
+
+    if (_time == 0) {
+      return;
+    }
+
+    for (size_type k = 0; k < _n_segments; k++) {
+      segment& s = _segments[k];
+      const size_type p = s.partition_size;
+
+      if (_time % p) {
+        continue;
+      }
+
+      if (s.background) {
+        if (s.state.load(std::memory_order_acquire) != job_idle) {
+          _late_jobs.fetch_add(1, std::memory_order_relaxed);
+          wait_job(s);
+        }
+
+        if (s.queued) {
+          accumulate_output(s);
+        }
+      }
+
+      for (size_type ch = 0; ch < _n_channels; ch++) {
+        T* x = s.input.data() + ch * 2 * p;
+        std::copy_n(x + p, p, x);
+        std::copy_n(s.pending_input.data() + ch * p, p, x + p);
+      }
+
+      s.output_time = _time - p + s.offset;
+
+      if (s.background) {
+        s.queued = true;
+        s.state.store(job_pending, std::memory_order_release);
+        s.state.notify_one();
+        continue;
+      }
+
+      compute_segment(s);
+      accumulate_output(s);
+    }
+  }
+
+  static inline void convolve_head(const T* __restrict h, const T* __restrict x, T* __restrict y, size_type n_taps,
+      size_type length) noexcept {
+    for (size_type k = 0; k < n_taps; k++) {
+      const T hk = h[k];
+      const T* xk = x - k;
+
+      for (size_type i = 0; i < length; i++) {
+        y[i] += hk * xk[i];
+      }
+    }
+  }
+
+  inline void process_channels(const T* const* input, T* const* output, size_type length) noexcept {
+    const size_type b = _block_size;
+
+    for (size_type i = 0; i < length;) {
+      const size_type position = _time % b;
+
+      if (position == 0) {
+        run_boundaries();
+      }
+
+      const size_type n = std::min(length - i, b - position);
+
+      for (size_type ch = 0; ch < _n_channels; ch++) {
+        std::copy_n(input[ch] + i, n, _history.data() + ch * 2 * b + b + position);
+
+        for (size_type k = 0; k < _n_segments; k++) {
+          segment& s = _segments[k];
+          const size_type p = s.partition_size;
+          std::copy_n(input[ch] + i, n, s.pending_input.data() + ch * p + _time % p);
+        }
+      }
+
+      const size_type r = _time % _ring_size;
+
+      for (size_type ch = 0; ch < _n_channels; ch++) {
+        T* y = output[ch] + i;
+        T* ring = _ring.data() + ch * _ring_size + r;
+        std::copy_n(ring, n, y);
+        std::fill_n(ring, n, T(0));
+
+        const T* x = _history.data() + ch * 2 * b + b + position;
+        convolve_head(_head.data() + (ch % _ir_channels) * b, x, y, b, n);
+      }
+
+      _time += n;
+      i += n;
+    }
+  }
+};
+MTS_END_NAMESPACE
@@ -33,16 +33,24 @@
 
 #pragma once
 #include "mts/config.h"
+#include "mts/audio/buffer_allocation.h"
 
 MTS_BEGIN_NAMESPACE
 namespace detail {
-void allocate_audio_buffer(float* const*& buffers, std::size_t buffer_size, std::size_t channel_size);
-void allocate_audio_buffer(double* const*& buffers, std::size_t buffer_size, std::size_t channel_size);
-void allocate_audio_buffer(long double* const*& buffers, std::size_t buffer_size, std::size_t channel_size);
+/// The default policy is used when policy is null.
+void allocate_audio_buffer(float* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy = nullptr);
+void allocate_audio_buffer(double* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy = nullptr);
+void allocate_audio_buffer(long double* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy = nullptr);
 
-void allocate_interleaved_audio_buffer(float* const*& buffers, std::size_t buffer_size, std::size_t channel_size);
-void allocate_interleaved_audio_buffer(double* const*& buffers, std::size_t buffer_size, std::size_t channel_size);
-void allocate_interleaved_audio_buffer(long double* const*& buffers, std::size_t buffer_size, std::size_t channel_size);
+void allocate_interleaved_audio_buffer(float* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy = nullptr);
+void allocate_interleaved_audio_buffer(double* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy = nullptr);
+void allocate_interleaved_audio_buffer(long double* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy = nullptr);
 
 void deallocate_audio_buffer(float* const* buffers);
 void deallocate_audio_buffer(double* const* buffers);
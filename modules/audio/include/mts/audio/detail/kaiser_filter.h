@@ -0,0 +1,89 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#pragma once
+#include "mts/config.h"
+#include "mts/math.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+namespace detail {
+/// Modified bessel function of the first kind of order zero.
+inline double bessel_i0(double x) noexcept {
+  double sum = 1;
+  double term = 1;
+  for (int k = 1; k < 64 && term > sum * 1e-17; k++) {
+    const double h = x / (2 * k);
+    term *= h * h;
+    sum += term;
+  }
+  return sum;
+}
+
+///
+/// Polyphase kaiser windowed sinc, shared by the resampler and the true peak
+/// meter.
+///
+/// Tap k of phase p is sinc(cutoff * t) windowed at t = k - center - p * phase_step,
+/// the window is zero outside (-half_width, half_width). Every phase is
+/// normalized to a unity dc gain.
+///
+template <typename T>
+inline void design_kaiser_polyphase(T* filter, std::size_t n_phases, std::size_t phase_size, double center,
+    double phase_step, double half_width, double cutoff, double beta) {
+  constexpr double pi = math::pi<double>;
+  const double i0_beta = bessel_i0(beta);
+  std::vector<double> row(phase_size);
+
+  for (std::size_t p = 0; p < n_phases; p++) {
+    double sum = 0;
+
+    for (std::size_t k = 0; k < phase_size; k++) {
+      const double t = (double)k - center - (double)p * phase_step;
+      const double r = t / half_width;
+      const double window = std::abs(r) < 1 ? bessel_i0(beta * std::sqrt(1 - r * r)) / i0_beta : 0;
+      const double x = pi * cutoff * t;
+      row[k] = (x == 0 ? 1 : std::sin(x) / x) * window;
+      sum += row[k];
+    }
+
+    for (std::size_t k = 0; k < phase_size; k++) {
+      filter[p * phase_size + k] = (T)(row[k] / sum);
+    }
+  }
+}
+} // namespace detail.
+MTS_END_NAMESPACE
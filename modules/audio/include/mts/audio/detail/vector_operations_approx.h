@@ -0,0 +1,83 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/traits.h"
+#include "mts/audio/detail/vector_operations_vdsp.h"
+#include "mts/audio/detail/vector_operations_simd.h"
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace detail {
+using optimized_ops = std::conditional_t<mts::is_defined_v<ops_type>, ops_type, base_ops>;
+} // namespace detail.
+
+///
+/// The optimized operations with sin, cos, tan and tanh replaced by vectorized
+/// polynomial approximations.
+///
+/// Max absolute error below 1e-6 for float and double (relative to
+/// max(1, |tan(x)|) for tan, at least 0.2 from its poles, the float error
+/// grows like 1e-7 / distance closer to them). sin, cos and tan are accurate
+/// for |x| < 8192 * pi.
+///
+struct approx_ops : detail::optimized_ops {
+  using detail::optimized_ops::sin;
+  using detail::optimized_ops::cos;
+  using detail::optimized_ops::tan;
+  using detail::optimized_ops::tanh;
+
+  MTS_AUDIO_DECLARE_OP_FD(SIN);
+  MTS_AUDIO_DECLARE_OP_FD(COS);
+  MTS_AUDIO_DECLARE_OP_FD(TAN);
+  MTS_AUDIO_DECLARE_OP_FD(TANH);
+};
+
+///
+/// Same as approx_ops with lower order approximations.
+///
+/// Max absolute error below 1e-3 (sin and cos ~1.2e-4, tanh ~8e-4).
+///
+struct fast_approx_ops : detail::optimized_ops {
+  using detail::optimized_ops::sin;
+  using detail::optimized_ops::cos;
+  using detail::optimized_ops::tan;
+  using detail::optimized_ops::tanh;
+
+  MTS_AUDIO_DECLARE_OP_FD(SIN);
+  MTS_AUDIO_DECLARE_OP_FD(COS);
+  MTS_AUDIO_DECLARE_OP_FD(TAN);
+  MTS_AUDIO_DECLARE_OP_FD(TANH);
+};
+
+MTS_END_SUB_NAMESPACE(vec)
@@ -36,6 +36,7 @@
 #include "mts/int24_t.h"
 #include "mts/math.h"
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstring>
 #include <type_traits>
@@ -49,11 +50,28 @@
   _(fill);                                                                                                             \
   _(copy);                                                                                                             \
   _(lshift);                                                                                                           \
+  _(clip);                                                                                                             \
   _(abs);                                                                                                              \
   _(add);                                                                                                              \
   _(mul);                                                                                                              \
   _(div);                                                                                                              \
   _(vdiv);                                                                                                             \
+  _(sum);                                                                                                              \
+  _(sub);                                                                                                              \
+  _(sum_mul);                                                                                                          \
+  _(mul_sum);                                                                                                          \
+  _(ramp);                                                                                                             \
+  _(mul_ramp);                                                                                                         \
+  _(mul_ramp_add);                                                                                                     \
+  _(exp_ramp);                                                                                                         \
+  _(mul_exp_ramp);                                                                                                     \
+  _(mul_exp_ramp_add);                                                                                                 \
+  _(sum_of_squares);                                                                                                   \
+  _(rms);                                                                                                              \
+  _(max_abs);                                                                                                          \
+  _(min_index);                                                                                                        \
+  _(max_index);                                                                                                        \
+  _(dot);                                                                                                              \
   _(sqrt);                                                                                                             \
   _(sin);                                                                                                              \
   _(cos);                                                                                                              \
@@ -64,7 +82,24 @@
   _(convert_from_int24);                                                                                               \
   _(convert_from_int32);                                                                                               \
   _(convert_from_float);                                                                                               \
-  _(convert_from_double)
+  _(convert_from_double);                                                                                              \
+  _(deinterleave_from_int8);                                                                                           \
+  _(deinterleave_from_int16);                                                                                          \
+  _(deinterleave_from_int24);                                                                                          \
+  _(deinterleave_from_int32);                                                                                          \
+  _(deinterleave_from_float);                                                                                          \
+  _(deinterleave_from_double);                                                                                         \
+  _(interleave_from_float);                                                                                            \
+  _(interleave_from_double);                                                                                           \
+  _(convert_to_int8);                                                                                                  \
+  _(convert_to_int16);                                                                                                 \
+  _(convert_to_int24);                                                                                                 \
+  _(convert_to_int32);                                                                                                 \
+  _(interleave_to_int8);                                                                                               \
+  _(interleave_to_int16);                                                                                              \
+  _(interleave_to_int24);                                                                                              \
+  _(interleave_to_int32);                                                                                              \
+  _(biquad)
 
 #define __MTS_AUDIO_OPS_DECLARE_USING() __MTS_AUDIO_OP_LIST(__MTS_AUDIO_USING_OP)
 
@@ -79,6 +114,21 @@ struct indexed_value {
   T value;
 };
 
+///
+/// Range of the integer sample type D (std::int8_t, std::int16_t, mts::int24_t
+/// or std::int32_t) as values of type T. scale maps [-1, 1) onto [min, max].
+///
+/// The largest 32 bit integer is not representable as a float, max is then the
+/// largest float below 2^31.
+///
+template <typename D, typename T>
+struct int_sample_range {
+  static constexpr int bits = std::is_same_v<D, mts::int24_t> ? 24 : (int)(8 * sizeof(D));
+  static constexpr T scale = (T)(1LL << (bits - 1));
+  static constexpr T min = -scale;
+  static constexpr T max = bits == 32 && sizeof(T) == 4 ? (T)2147483520.0 : (T)((1LL << (bits - 1)) - 1);
+};
+
 struct ops_type;
 
 struct base_ops {
@@ -97,6 +147,55 @@ private:
     return v;
   }
 
+  template <typename T, typename S>
+  static inline void deinterleave(
+      const S* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length, T scale) {
+    for (length_t i = 0; i < length; i++, s1 += s_s1) {
+      for (length_t c = 0; c < n_channels; c++) {
+        if constexpr (std::is_same_v<S, mts::int24_t>) {
+          d[c][i] = (T)(std::int32_t)s1[c] * scale;
+        }
+        else {
+          d[c][i] = (T)s1[c] * scale;
+        }
+      }
+    }
+  }
+
+  template <typename T, typename S>
+  static inline void interleave(const S* const* s, T* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    for (length_t i = 0; i < length; i++, d1 += s_d1) {
+      for (length_t c = 0; c < n_channels; c++) {
+        d1[c] = (T)s[c][i];
+      }
+    }
+  }
+
+  // Saturates and rounds to nearest.
+  template <typename D, typename T>
+  static inline D to_int(T v) {
+    using range = int_sample_range<D, T>;
+    return (D)(std::int32_t)std::nearbyint(std::clamp<T>(v, range::min, range::max));
+  }
+
+  template <typename D, typename T>
+  static inline void convert_to_int(const T* s1, stride_t s_s1, D* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = to_int<D>(sincr(s1, s_s1));
+    }
+  }
+
+  template <typename D, typename T>
+  static inline void interleave_to_int(const T* const* s, D* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    constexpr T scale = int_sample_range<D, T>::scale;
+
+    for (length_t i = 0; i < length; i++, d1 += s_d1) {
+      for (length_t c = 0; c < n_channels; c++) {
+        d1[c] = to_int<D>(s[c][i] * scale);
+      }
+    }
+  }
+
 public:
   template <typename T>
   static inline void clear(T* sd, stride_t s_sd, length_t length) {
@@ -176,6 +275,202 @@ public:
     }
   }
 
+  template <typename T>
+  static inline void sum(
+      const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) + sincr(s2, s_s2);
+    }
+  }
+
+  template <typename T>
+  static inline void sub(
+      const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) - sincr(s2, s_s2);
+    }
+  }
+
+  template <typename T>
+  static inline void mul(
+      const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) * sincr(s2, s_s2);
+    }
+  }
+
+  template <typename T>
+  static inline void div(
+      const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) / sincr(s2, s_s2);
+    }
+  }
+
+  template <typename T>
+  static inline void sum_mul(
+      const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T value, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = (sincr(s1, s_s1) + sincr(s2, s_s2)) * value;
+    }
+  }
+
+  template <typename T>
+  static inline void sum_mul(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, const T* s3, stride_t s_s3, T* d1,
+      stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = (sincr(s1, s_s1) + sincr(s2, s_s2)) * sincr(s3, s_s3);
+    }
+  }
+
+  template <typename T>
+  static inline void sum_mul(
+      const T* s1, stride_t s_s1, T value, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = (sincr(s1, s_s1) + value) * sincr(s2, s_s2);
+    }
+  }
+
+  template <typename T>
+  static inline void mul_sum(
+      const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T value, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) * sincr(s2, s_s2) + value;
+    }
+  }
+
+  template <typename T>
+  static inline void mul_sum(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, const T* s3, stride_t s_s3, T* d1,
+      stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) * sincr(s2, s_s2) + sincr(s3, s_s3);
+    }
+  }
+
+  template <typename T>
+  static inline void mul_sum(
+      const T* s1, stride_t s_s1, T value, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) * value + sincr(s2, s_s2);
+    }
+  }
+
+  //
+  // Ramps.
+  //
+
+  template <typename T>
+  static inline void ramp(T* d1, stride_t s_d1, T start, T increment, length_t length) {
+    for (length_t i = 0; i < length; i++) {
+      sincr(d1, s_d1) = start + (T)i * increment;
+    }
+  }
+
+  template <typename T>
+  static inline void mul_ramp(
+      const T* s1, stride_t s_s1, T start, T increment, T* d1, stride_t s_d1, length_t length) {
+    for (length_t i = 0; i < length; i++) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) * (start + (T)i * increment);
+    }
+  }
+
+  template <typename T>
+  static inline void mul_ramp_add(const T* s1, stride_t s_s1, T start, T increment, const T* s2, stride_t s_s2, T* d1,
+      stride_t s_d1, length_t length) {
+    for (length_t i = 0; i < length; i++) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) * (start + (T)i * increment) + sincr(s2, s_s2);
+    }
+  }
+
+  template <typename T>
+  static inline void exp_ramp(T* d1, stride_t s_d1, T start, T ratio, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = start;
+      start *= ratio;
+    }
+  }
+
+  template <typename T>
+  static inline void mul_exp_ramp(const T* s1, stride_t s_s1, T start, T ratio, T* d1, stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) * start;
+      start *= ratio;
+    }
+  }
+
+  template <typename T>
+  static inline void mul_exp_ramp_add(const T* s1, stride_t s_s1, T start, T ratio, const T* s2, stride_t s_s2, T* d1,
+      stride_t s_d1, length_t length) {
+    while (length--) {
+      sincr(d1, s_d1) = sincr(s1, s_s1) * start + sincr(s2, s_s2);
+      start *= ratio;
+    }
+  }
+
+  template <typename T>
+  static inline T sum(const T* s1, stride_t s_s1, length_t length) {
+    T result = 0;
+    while (length--) {
+      result += sincr(s1, s_s1);
+    }
+    return result;
+  }
+
+  template <typename T>
+  static inline T sum_of_squares(const T* s1, stride_t s_s1, length_t length) {
+    T result = 0;
+    while (length--) {
+      const T v = sincr(s1, s_s1);
+      result += v * v;
+    }
+    return result;
+  }
+
+  template <typename T>
+  static inline T rms(const T* s1, stride_t s_s1, length_t length) {
+    return length ? std::sqrt(sum_of_squares(s1, s_s1, length) / (T)length) : T(0);
+  }
+
+  template <typename T>
+  static inline T max_abs(const T* s1, stride_t s_s1, length_t length) {
+    T result = 0;
+    while (length--) {
+      result = std::max(result, std::abs(sincr(s1, s_s1)));
+    }
+    return result;
+  }
+
+  template <typename T>
+  static inline indexed_value<T> min_index(const T* s1, stride_t s_s1, length_t length) {
+    indexed_value<T> result = { 0, length ? *s1 : T(0) };
+    for (length_t i = 1; i < length; i++) {
+      if (const T v = s1[(stride_t)i * s_s1]; v < result.value) {
+        result = { i, v };
+      }
+    }
+    return result;
+  }
+
+  template <typename T>
+  static inline indexed_value<T> max_index(const T* s1, stride_t s_s1, length_t length) {
+    indexed_value<T> result = { 0, length ? *s1 : T(0) };
+    for (length_t i = 1; i < length; i++) {
+      if (const T v = s1[(stride_t)i * s_s1]; v > result.value) {
+        result = { i, v };
+      }
+    }
+    return result;
+  }
+
+  template <typename T>
+  static inline T dot(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, length_t length) {
+    T result = 0;
+    while (length--) {
+      result += sincr(s1, s_s1) * sincr(s2, s_s2);
+    }
+    return result;
+  }
+
   template <typename T>
   static inline void sqrt(const T* s1, T* d1, length_t length) {
     while (length--) {
@@ -266,6 +561,135 @@ public:
       }
     }
   }
+
+  template <typename T>
+  static inline void deinterleave_from_int8(
+      const std::int8_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+    deinterleave(s1, s_s1, d, n_channels, length, T(1.0 / 128.0));
+  }
+
+  template <typename T>
+  static inline void deinterleave_from_int16(
+      const std::int16_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+    deinterleave(s1, s_s1, d, n_channels, length, T(1.0 / 32768.0));
+  }
+
+  template <typename T>
+  static inline void deinterleave_from_int24(
+      const mts::int24_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+    deinterleave(s1, s_s1, d, n_channels, length, T(1.0 / 8388608.0));
+  }
+
+  template <typename T>
+  static inline void deinterleave_from_int32(
+      const std::int32_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+    deinterleave(s1, s_s1, d, n_channels, length, T(1.0 / 2147483648.0));
+  }
+
+  template <typename T>
+  static inline void deinterleave_from_float(
+      const float* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+    deinterleave(s1, s_s1, d, n_channels, length, T(1));
+  }
+
+  template <typename T>
+  static inline void deinterleave_from_double(
+      const double* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+    deinterleave(s1, s_s1, d, n_channels, length, T(1));
+  }
+
+  template <typename T>
+  static inline void interleave_from_float(
+      const float* const* s, T* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave(s, d1, s_d1, n_channels, length);
+  }
+
+  template <typename T>
+  static inline void interleave_from_double(
+      const double* const* s, T* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave(s, d1, s_d1, n_channels, length);
+  }
+
+  template <typename T>
+  static inline void convert_to_int8(const T* s1, stride_t s_s1, std::int8_t* d1, stride_t s_d1, length_t length) {
+    convert_to_int(s1, s_s1, d1, s_d1, length);
+  }
+
+  template <typename T>
+  static inline void convert_to_int16(const T* s1, stride_t s_s1, std::int16_t* d1, stride_t s_d1, length_t length) {
+    convert_to_int(s1, s_s1, d1, s_d1, length);
+  }
+
+  template <typename T>
+  static inline void convert_to_int24(const T* s1, stride_t s_s1, mts::int24_t* d1, stride_t s_d1, length_t length) {
+    convert_to_int(s1, s_s1, d1, s_d1, length);
+  }
+
+  template <typename T>
+  static inline void convert_to_int32(const T* s1, stride_t s_s1, std::int32_t* d1, stride_t s_d1, length_t length) {
+    convert_to_int(s1, s_s1, d1, s_d1, length);
+  }
+
+  template <typename T>
+  static inline void interleave_to_int8(
+      const T* const* s, std::int8_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave_to_int(s, d1, s_d1, n_channels, length);
+  }
+
+  template <typename T>
+  static inline void interleave_to_int16(
+      const T* const* s, std::int16_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave_to_int(s, d1, s_d1, n_channels, length);
+  }
+
+  template <typename T>
+  static inline void interleave_to_int24(
+      const T* const* s, mts::int24_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave_to_int(s, d1, s_d1, n_channels, length);
+  }
+
+  template <typename T>
+  static inline void interleave_to_int32(
+      const T* const* s, std::int32_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave_to_int(s, d1, s_d1, n_channels, length);
+  }
+
+  //
+  // Filters.
+  //
+
+  template <typename T>
+  static inline void biquad(const T* const* s, T* const* d, length_t n_channels, length_t length, const T* c, T* z,
+      length_t n_stages) {
+    for (length_t ch = 0; ch < n_channels; ch++) {
+      const T* input = s[ch];
+
+      for (length_t k = 0; k < n_stages; k++) {
+        const T* kc = c + k * 5 * n_channels + ch;
+        T* kz = z + k * 2 * n_channels + ch;
+        const T b0 = kc[0], b1 = kc[n_channels], b2 = kc[2 * n_channels];
+        const T a1 = kc[3 * n_channels], a2 = kc[4 * n_channels];
+        T z1 = kz[0], z2 = kz[n_channels];
+
+        T* output = d[ch];
+        for (length_t i = 0; i < length; i++) {
+          const T x = input[i];
+          const T y = b0 * x + z1;
+          z1 = b1 * x - a1 * y + z2;
+          z2 = b2 * x - a2 * y;
+          output[i] = y;
+        }
+
+        kz[0] = z1;
+        kz[n_channels] = z2;
+        input = output;
+      }
+
+      if (n_stages == 0 && d[ch] != s[ch]) {
+        copy(s[ch], 1, d[ch], 1, length);
+      }
+    }
+  }
 };
 
 MTS_END_SUB_NAMESPACE(vec)
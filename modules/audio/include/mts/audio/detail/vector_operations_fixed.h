@@ -0,0 +1,230 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+
+/// Largest extent for which fixed_ops are used by wire<T, Extent>.
+/// Longer blocks are better served by the runtime dispatched simd kernels,
+/// which can use wider registers than the ones this code is compiled for.
+/// It doesn't depend on the target flags, translation units built with
+/// different ones must agree on the wire<T, Extent> code paths.
+inline constexpr std::size_t fixed_ops_max_extent = 64;
+
+///
+/// Contiguous operations on N elements known at compile time.
+///
+/// The loops are unrolled by blocks of 8 elements with the remainder unrolled
+/// at compile time, there is no tail loop and no length check. Reductions keep
+/// one accumulator per block element.
+///
+template <std::size_t N>
+struct fixed_ops {
+  static constexpr std::size_t block_size = 8;
+  static constexpr std::size_t n_blocks = N / block_size;
+  static constexpr std::size_t remainder = N % block_size;
+
+  template <typename T>
+  static inline void clear(T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = T(0); });
+  }
+
+  template <typename T>
+  static inline void fill(T* d1, T value) noexcept {
+    for_each([&](std::size_t i) { d1[i] = value; });
+  }
+
+  template <typename T>
+  static inline void copy(const T* s1, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i]; });
+  }
+
+  // d1[i] = s1[i] + value
+  template <typename T>
+  static inline void add(const T* s1, T value, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] + value; });
+  }
+
+  // d1[i] = s1[i] * value
+  template <typename T>
+  static inline void mul(const T* s1, T value, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] * value; });
+  }
+
+  // d1[i] = s1[i] / value
+  template <typename T>
+  static inline void div(const T* s1, T value, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] / value; });
+  }
+
+  // d1[i] = s1[i] + s2[i]
+  template <typename T>
+  static inline void sum(const T* s1, const T* s2, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] + s2[i]; });
+  }
+
+  // d1[i] = s1[i] - s2[i]
+  template <typename T>
+  static inline void sub(const T* s1, const T* s2, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] - s2[i]; });
+  }
+
+  // d1[i] = s1[i] * s2[i]
+  template <typename T>
+  static inline void mul(const T* s1, const T* s2, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] * s2[i]; });
+  }
+
+  // d1[i] = s1[i] / s2[i]
+  template <typename T>
+  static inline void div(const T* s1, const T* s2, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] / s2[i]; });
+  }
+
+  // d1[i] = (s1[i] + s2[i]) * value
+  template <typename T>
+  static inline void sum_mul(const T* s1, const T* s2, T value, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = (s1[i] + s2[i]) * value; });
+  }
+
+  // d1[i] = (s1[i] + s2[i]) * s3[i]
+  template <typename T>
+  static inline void sum_mul(const T* s1, const T* s2, const T* s3, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = (s1[i] + s2[i]) * s3[i]; });
+  }
+
+  // d1[i] = (s1[i] + value) * s2[i]
+  template <typename T>
+  static inline void sum_mul(const T* s1, T value, const T* s2, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = (s1[i] + value) * s2[i]; });
+  }
+
+  // d1[i] = s1[i] * s2[i] + value
+  template <typename T>
+  static inline void mul_sum(const T* s1, const T* s2, T value, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] * s2[i] + value; });
+  }
+
+  // d1[i] = s1[i] * s2[i] + s3[i]
+  template <typename T>
+  static inline void mul_sum(const T* s1, const T* s2, const T* s3, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] * s2[i] + s3[i]; });
+  }
+
+  // d1[i] = s1[i] * value + s2[i]
+  template <typename T>
+  static inline void mul_sum(const T* s1, T value, const T* s2, T* d1) noexcept {
+    for_each([&](std::size_t i) { d1[i] = s1[i] * value + s2[i]; });
+  }
+
+  // sum(s1[i])
+  template <typename T>
+  static inline T sum(const T* s1) noexcept {
+    return reduce<T>([&](T acc, std::size_t i) { return acc + s1[i]; }, [](T a, T b) { return a + b; });
+  }
+
+  // sum(s1[i] * s1[i])
+  template <typename T>
+  static inline T sum_of_squares(const T* s1) noexcept {
+    return reduce<T>([&](T acc, std::size_t i) { return acc + s1[i] * s1[i]; }, [](T a, T b) { return a + b; });
+  }
+
+  // sqrt(sum(s1[i] * s1[i]) / N)
+  template <typename T>
+  static inline T rms(const T* s1) noexcept {
+    return N ? std::sqrt(sum_of_squares(s1) / (T)N) : T(0);
+  }
+
+  // max(|s1[i]|)
+  template <typename T>
+  static inline T max_abs(const T* s1) noexcept {
+    return reduce<T>([&](T acc, std::size_t i) { return acc < std::abs(s1[i]) ? std::abs(s1[i]) : acc; },
+        [](T a, T b) { return a < b ? b : a; });
+  }
+
+  // sum(s1[i] * s2[i])
+  template <typename T>
+  static inline T dot(const T* s1, const T* s2) noexcept {
+    return reduce<T>([&](T acc, std::size_t i) { return acc + s1[i] * s2[i]; }, [](T a, T b) { return a + b; });
+  }
+
+private:
+  template <std::size_t Offset, class Fct, std::size_t... I>
+  static inline void unroll(std::size_t index, Fct& fct, std::index_sequence<I...>) noexcept {
+    (fct(index + Offset + I), ...);
+  }
+
+  template <class Fct>
+  static inline void for_each(Fct&& fct) noexcept {
+    for (std::size_t i = 0; i < n_blocks * block_size; i += block_size) {
+      unroll<0>(i, fct, std::make_index_sequence<block_size>());
+    }
+
+    unroll<n_blocks * block_size>(0, fct, std::make_index_sequence<remainder>());
+  }
+
+  // acc_fct(acc, i) folds element i into acc, merge_fct(a, b) merges two accumulators.
+  template <typename T, class AccFct, class MergeFct>
+  static inline T reduce(AccFct&& acc_fct, MergeFct&& merge_fct) noexcept {
+    T acc[block_size] = {};
+
+    for (std::size_t i = 0; i < n_blocks * block_size; i += block_size) {
+      for_each_lane([&](std::size_t k) { acc[k] = acc_fct(acc[k], i + k); });
+    }
+
+    for_each_lane([&](std::size_t k) {
+      if (k < remainder) {
+        acc[k] = acc_fct(acc[k], n_blocks * block_size + k);
+      }
+    });
+
+    for (std::size_t width = block_size / 2; width > 0; width /= 2) {
+      for (std::size_t k = 0; k < width; k++) {
+        acc[k] = merge_fct(acc[k], acc[k + width]);
+      }
+    }
+
+    return acc[0];
+  }
+
+  template <class Fct>
+  static inline void for_each_lane(Fct&& fct) noexcept {
+    unroll<0>(0, fct, std::make_index_sequence<block_size>());
+  }
+};
+MTS_END_SUB_NAMESPACE(vec)
@@ -173,7 +173,7 @@
 /// @def MTS_AUDIO_OP_SUM_MUL
 /// d1[i] = (s1[i] + value) * s2[i]
 #define MTS_AUDIO_OP_SUM_MUL(TYPE)                                                                                     \
-  void sum_mul(const TYPE* s1, stride_t s_s1, TYPE value, const TYPE* src2, stride_t s_s2, TYPE* d1, stride_t s_d1,    \
+  void sum_mul(const TYPE* s1, stride_t s_s1, TYPE value, const TYPE* s2, stride_t s_s2, TYPE* d1, stride_t s_d1,      \
       length_t length)
 
 /// @def MTS_AUDIO_OP_MUL_S_SUM
@@ -182,14 +182,213 @@
   void mul_sum(const TYPE* s1, stride_t s_s1, const TYPE* s2, stride_t s_s2, TYPE value, TYPE* d1, stride_t s_d1,      \
       length_t length)
 
-/// @def MTS_AUDIO_OPS_MUL_V_SUM
+/// @def MTS_AUDIO_OP_MUL_V_SUM
 /// d1[i] = (s1[i] * s2[i]) + s3[i]
-#define MTS_AUDIO_OPS_MUL_V_SUM(TYPE)                                                                                  \
+#define MTS_AUDIO_OP_MUL_V_SUM(TYPE)                                                                                   \
   void mul_sum(const TYPE* s1, stride_t s_s1, const TYPE* s2, stride_t s_s2, const TYPE* s3, stride_t s_s3, TYPE* d1,  \
       stride_t s_d1, length_t length)
 
-/// @def MTS_AUDIO_OPS_MUL_SUM
+/// @def MTS_AUDIO_OP_MUL_SUM
 /// d1[i] = (s1[i] * value) + s2[i]
-#define MTS_AUDIO_OPS_MUL_SUM(TYPE)                                                                                    \
+#define MTS_AUDIO_OP_MUL_SUM(TYPE)                                                                                     \
   void mul_sum(const TYPE* s1, stride_t s_s1, TYPE value, const TYPE* s2, stride_t s_s2, TYPE* d1, stride_t s_d1,      \
       length_t length)
+
+/// @def MTS_AUDIO_OP_RAMP
+/// d1[i] = start + i * increment
+#define MTS_AUDIO_OP_RAMP(TYPE) void ramp(TYPE* d1, stride_t s_d1, TYPE start, TYPE increment, length_t length)
+
+/// @def MTS_AUDIO_OP_MUL_RAMP
+/// d1[i] = s1[i] * (start + i * increment)
+#define MTS_AUDIO_OP_MUL_RAMP(TYPE)                                                                                    \
+  void mul_ramp(const TYPE* s1, stride_t s_s1, TYPE start, TYPE increment, TYPE* d1, stride_t s_d1, length_t length)
+
+/// @def MTS_AUDIO_OP_MUL_RAMP_ADD
+/// d1[i] = s1[i] * (start + i * increment) + s2[i]
+#define MTS_AUDIO_OP_MUL_RAMP_ADD(TYPE)                                                                                \
+  void mul_ramp_add(const TYPE* s1, stride_t s_s1, TYPE start, TYPE increment, const TYPE* s2, stride_t s_s2,          \
+      TYPE* d1, stride_t s_d1, length_t length)
+
+/// @def MTS_AUDIO_OP_EXP_RAMP
+/// d1[i] = start * ratio^i
+#define MTS_AUDIO_OP_EXP_RAMP(TYPE) void exp_ramp(TYPE* d1, stride_t s_d1, TYPE start, TYPE ratio, length_t length)
+
+/// @def MTS_AUDIO_OP_MUL_EXP_RAMP
+/// d1[i] = s1[i] * start * ratio^i
+#define MTS_AUDIO_OP_MUL_EXP_RAMP(TYPE)                                                                                \
+  void mul_exp_ramp(const TYPE* s1, stride_t s_s1, TYPE start, TYPE ratio, TYPE* d1, stride_t s_d1, length_t length)
+
+/// @def MTS_AUDIO_OP_MUL_EXP_RAMP_ADD
+/// d1[i] = s1[i] * start * ratio^i + s2[i]
+#define MTS_AUDIO_OP_MUL_EXP_RAMP_ADD(TYPE)                                                                            \
+  void mul_exp_ramp_add(const TYPE* s1, stride_t s_s1, TYPE start, TYPE ratio, const TYPE* s2, stride_t s_s2,          \
+      TYPE* d1, stride_t s_d1, length_t length)
+
+//
+//
+//
+
+/// @def MTS_AUDIO_OP_SUM
+/// s1[0] + ... + s1[length - 1]
+#define MTS_AUDIO_OP_SUM(TYPE) TYPE sum(const TYPE* s1, stride_t s_s1, length_t length)
+
+/// @def MTS_AUDIO_OP_SUM_OF_SQUARES
+/// s1[0] * s1[0] + ... + s1[length - 1] * s1[length - 1]
+#define MTS_AUDIO_OP_SUM_OF_SQUARES(TYPE) TYPE sum_of_squares(const TYPE* s1, stride_t s_s1, length_t length)
+
+/// @def MTS_AUDIO_OP_RMS
+/// sqrt(sum_of_squares(s1) / length)
+#define MTS_AUDIO_OP_RMS(TYPE) TYPE rms(const TYPE* s1, stride_t s_s1, length_t length)
+
+/// @def MTS_AUDIO_OP_MAX_ABS
+/// max(abs(s1[i]))
+#define MTS_AUDIO_OP_MAX_ABS(TYPE) TYPE max_abs(const TYPE* s1, stride_t s_s1, length_t length)
+
+/// @def MTS_AUDIO_OP_MIN_INDEX
+/// { i, s1[i] } of the first minimum value.
+#define MTS_AUDIO_OP_MIN_INDEX(TYPE) indexed_value<TYPE> min_index(const TYPE* s1, stride_t s_s1, length_t length)
+
+/// @def MTS_AUDIO_OP_MAX_INDEX
+/// { i, s1[i] } of the first maximum value.
+#define MTS_AUDIO_OP_MAX_INDEX(TYPE) indexed_value<TYPE> max_index(const TYPE* s1, stride_t s_s1, length_t length)
+
+/// @def MTS_AUDIO_OP_DOT
+/// s1[0] * s2[0] + ... + s1[length - 1] * s2[length - 1]
+#define MTS_AUDIO_OP_DOT(TYPE) TYPE dot(const TYPE* s1, stride_t s_s1, const TYPE* s2, stride_t s_s2, length_t length)
+
+//
+//
+//
+
+/// @def MTS_AUDIO_OP_CONVERT_FROM_INT8
+/// d1[i] = s1[i * s_s1]
+#define MTS_AUDIO_OP_CONVERT_FROM_INT8(TYPE)                                                                           \
+  void convert_from_int8(const std::int8_t* s1, stride_t s_s1, TYPE* d1, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_FROM_INT16
+/// d1[i] = s1[i * s_s1]
+#define MTS_AUDIO_OP_CONVERT_FROM_INT16(TYPE)                                                                          \
+  void convert_from_int16(const std::int16_t* s1, stride_t s_s1, TYPE* d1, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_FROM_INT24
+/// d1[i] = s1[i * s_s1]
+#define MTS_AUDIO_OP_CONVERT_FROM_INT24(TYPE)                                                                          \
+  void convert_from_int24(const mts::int24_t* s1, stride_t s_s1, TYPE* d1, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_FROM_INT32
+/// d1[i] = s1[i * s_s1]
+#define MTS_AUDIO_OP_CONVERT_FROM_INT32(TYPE)                                                                          \
+  void convert_from_int32(const std::int32_t* s1, stride_t s_s1, TYPE* d1, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_FROM_FLOAT
+/// d1[i] = s1[i * s_s1]
+#define MTS_AUDIO_OP_CONVERT_FROM_FLOAT(TYPE)                                                                          \
+  void convert_from_float(const float* s1, stride_t s_s1, TYPE* d1, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_FROM_DOUBLE
+/// d1[i] = s1[i * s_s1]
+#define MTS_AUDIO_OP_CONVERT_FROM_DOUBLE(TYPE)                                                                         \
+  void convert_from_double(const double* s1, stride_t s_s1, TYPE* d1, length_t length)
+
+/// @def MTS_AUDIO_OP_DEINTERLEAVE_FROM_INT8
+/// d[c][i] = s1[i * s_s1 + c] / 2^7 for c < n_channels
+#define MTS_AUDIO_OP_DEINTERLEAVE_FROM_INT8(TYPE)                                                                      \
+  void deinterleave_from_int8(                                                                                         \
+      const std::int8_t* s1, stride_t s_s1, TYPE* const* d, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_DEINTERLEAVE_FROM_INT16
+/// d[c][i] = s1[i * s_s1 + c] / 2^15 for c < n_channels
+#define MTS_AUDIO_OP_DEINTERLEAVE_FROM_INT16(TYPE)                                                                     \
+  void deinterleave_from_int16(                                                                                        \
+      const std::int16_t* s1, stride_t s_s1, TYPE* const* d, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_DEINTERLEAVE_FROM_INT24
+/// d[c][i] = s1[i * s_s1 + c] / 2^23 for c < n_channels
+#define MTS_AUDIO_OP_DEINTERLEAVE_FROM_INT24(TYPE)                                                                     \
+  void deinterleave_from_int24(                                                                                        \
+      const mts::int24_t* s1, stride_t s_s1, TYPE* const* d, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_DEINTERLEAVE_FROM_INT32
+/// d[c][i] = s1[i * s_s1 + c] / 2^31 for c < n_channels
+#define MTS_AUDIO_OP_DEINTERLEAVE_FROM_INT32(TYPE)                                                                     \
+  void deinterleave_from_int32(                                                                                        \
+      const std::int32_t* s1, stride_t s_s1, TYPE* const* d, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_DEINTERLEAVE_FROM_FLOAT
+/// d[c][i] = s1[i * s_s1 + c] for c < n_channels
+#define MTS_AUDIO_OP_DEINTERLEAVE_FROM_FLOAT(TYPE)                                                                     \
+  void deinterleave_from_float(const float* s1, stride_t s_s1, TYPE* const* d, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_DEINTERLEAVE_FROM_DOUBLE
+/// d[c][i] = s1[i * s_s1 + c] for c < n_channels
+#define MTS_AUDIO_OP_DEINTERLEAVE_FROM_DOUBLE(TYPE)                                                                    \
+  void deinterleave_from_double(const double* s1, stride_t s_s1, TYPE* const* d, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_INTERLEAVE_FROM_FLOAT
+/// d1[i * s_d1 + c] = s[c][i] for c < n_channels
+#define MTS_AUDIO_OP_INTERLEAVE_FROM_FLOAT(TYPE)                                                                       \
+  void interleave_from_float(const float* const* s, TYPE* d1, stride_t s_d1, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_INTERLEAVE_FROM_DOUBLE
+/// d1[i * s_d1 + c] = s[c][i] for c < n_channels
+#define MTS_AUDIO_OP_INTERLEAVE_FROM_DOUBLE(TYPE)                                                                      \
+  void interleave_from_double(const double* const* s, TYPE* d1, stride_t s_d1, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_TO_INT8
+/// d1[i * s_d1] = round(s1[i * s_s1]) saturated to [-2^7, 2^7 - 1]
+#define MTS_AUDIO_OP_CONVERT_TO_INT8(TYPE)                                                                             \
+  void convert_to_int8(const TYPE* s1, stride_t s_s1, std::int8_t* d1, stride_t s_d1, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_TO_INT16
+/// d1[i * s_d1] = round(s1[i * s_s1]) saturated to [-2^15, 2^15 - 1]
+#define MTS_AUDIO_OP_CONVERT_TO_INT16(TYPE)                                                                            \
+  void convert_to_int16(const TYPE* s1, stride_t s_s1, std::int16_t* d1, stride_t s_d1, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_TO_INT24
+/// d1[i * s_d1] = round(s1[i * s_s1]) saturated to [-2^23, 2^23 - 1]
+#define MTS_AUDIO_OP_CONVERT_TO_INT24(TYPE)                                                                            \
+  void convert_to_int24(const TYPE* s1, stride_t s_s1, mts::int24_t* d1, stride_t s_d1, length_t length)
+
+/// @def MTS_AUDIO_OP_CONVERT_TO_INT32
+/// d1[i * s_d1] = round(s1[i * s_s1]) saturated to [-2^31, 2^31 - 1]
+#define MTS_AUDIO_OP_CONVERT_TO_INT32(TYPE)                                                                            \
+  void convert_to_int32(const TYPE* s1, stride_t s_s1, std::int32_t* d1, stride_t s_d1, length_t length)
+
+/// @def MTS_AUDIO_OP_INTERLEAVE_TO_INT8
+/// d1[i * s_d1 + c] = round(s[c][i] * 2^7) saturated to [-2^7, 2^7 - 1] for c < n_channels
+#define MTS_AUDIO_OP_INTERLEAVE_TO_INT8(TYPE)                                                                          \
+  void interleave_to_int8(                                                                                             \
+      const TYPE* const* s, std::int8_t* d1, stride_t s_d1, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_INTERLEAVE_TO_INT16
+/// d1[i * s_d1 + c] = round(s[c][i] * 2^15) saturated to [-2^15, 2^15 - 1] for c < n_channels
+#define MTS_AUDIO_OP_INTERLEAVE_TO_INT16(TYPE)                                                                         \
+  void interleave_to_int16(                                                                                            \
+      const TYPE* const* s, std::int16_t* d1, stride_t s_d1, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_INTERLEAVE_TO_INT24
+/// d1[i * s_d1 + c] = round(s[c][i] * 2^23) saturated to [-2^23, 2^23 - 1] for c < n_channels
+#define MTS_AUDIO_OP_INTERLEAVE_TO_INT24(TYPE)                                                                         \
+  void interleave_to_int24(                                                                                            \
+      const TYPE* const* s, mts::int24_t* d1, stride_t s_d1, length_t n_channels, length_t length)
+
+/// @def MTS_AUDIO_OP_INTERLEAVE_TO_INT32
+/// d1[i * s_d1 + c] = round(s[c][i] * 2^31) saturated to [-2^31, 2^31 - 1] for c < n_channels
+#define MTS_AUDIO_OP_INTERLEAVE_TO_INT32(TYPE)                                                                         \
+  void interleave_to_int32(                                                                                            \
+      const TYPE* const* s, std::int32_t* d1, stride_t s_d1, length_t n_channels, length_t length)
+
+//
+//
+// Filters.
+//
+//
+
+/// @def MTS_AUDIO_OP_BIQUAD
+/// d[c] = cascade of n_stages transposed direct form II biquads applied to s[c] for c < n_channels
+/// y = b0 * x + z1, z1 = b1 * x - a1 * y + z2, z2 = b2 * x - a2 * y
+/// c[(k * 5 + j) * n_channels + c] is coefficient j (b0, b1, b2, a1, a2) of stage k.
+/// z[(k * 2 + j) * n_channels + c] is state j (z1, z2) of stage k, updated in place. d may be s.
+#define MTS_AUDIO_OP_BIQUAD(TYPE)                                                                                      \
+  void biquad(const TYPE* const* s, TYPE* const* d, length_t n_channels, length_t length, const TYPE* c, TYPE* z,      \
+      length_t n_stages)
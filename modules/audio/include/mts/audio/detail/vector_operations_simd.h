@@ -0,0 +1,148 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/audio/detail/vector_operations_list.h"
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+
+///
+/// Instruction sets the portable simd backend can dispatch to.
+///
+/// The best one supported by the cpu is detected on first use. It can be
+/// overridden with the MTS_SIMD_ISA environment variable (none, sse2, avx2,
+/// avx512 or neon) or with set_simd_isa().
+///
+/// simd_isa::none runs the scalar base_ops implementation.
+///
+enum class simd_isa { none, sse2, avx2, avx512, neon };
+
+/// Returns the instruction set currently used by simd_ops.
+/// Always returns simd_isa::none when the simd backend isn't compiled in.
+simd_isa get_simd_isa() noexcept;
+
+/// Returns true if simd_ops can run the given instruction set on this cpu.
+bool is_simd_isa_supported(simd_isa isa) noexcept;
+
+/// Makes every simd_ops operation use the given instruction set.
+/// Returns false and keeps the current one if it isn't supported.
+///
+/// This is mostly meant for testing and benchmarking, calling it while
+/// another thread is running vector operations is safe but that thread
+/// may still use the previous instruction set for a while.
+bool set_simd_isa(simd_isa isa) noexcept;
+
+MTS_END_SUB_NAMESPACE(vec)
+
+#if __MTS_USE_SIMD__
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+
+///
+/// Every operation goes through a function table bound at runtime to the best
+/// instruction set (see simd_isa).
+///
+struct simd_ops : base_ops {
+  MTS_AUDIO_DECLARE_OP_FD(FILL);
+  MTS_AUDIO_DECLARE_OP_FD(CLIP);
+  MTS_AUDIO_DECLARE_OP_FD(ABS);
+
+  MTS_AUDIO_DECLARE_OP_FD(SQRT);
+
+  MTS_AUDIO_DECLARE_OP_FD(S_ADD);
+  MTS_AUDIO_DECLARE_OP_FD(S_MUL);
+  MTS_AUDIO_DECLARE_OP_FD(S_DIV);
+  MTS_AUDIO_DECLARE_OP_FD(S_VDIV);
+
+  MTS_AUDIO_DECLARE_OP_FD(V_SUM);
+  MTS_AUDIO_DECLARE_OP_FD(V_SUB);
+  MTS_AUDIO_DECLARE_OP_FD(V_MUL);
+  MTS_AUDIO_DECLARE_OP_FD(V_DIV);
+
+  MTS_AUDIO_DECLARE_OP_FD(SUM_S_MUL);
+  MTS_AUDIO_DECLARE_OP_FD(SUM_V_MUL);
+  MTS_AUDIO_DECLARE_OP_FD(SUM_MUL);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_S_SUM);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_V_SUM);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_SUM);
+
+  MTS_AUDIO_DECLARE_OP_FD(RAMP);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_RAMP);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_RAMP_ADD);
+  MTS_AUDIO_DECLARE_OP_FD(EXP_RAMP);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_EXP_RAMP);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_EXP_RAMP_ADD);
+
+  MTS_AUDIO_DECLARE_OP_FD(SUM);
+  MTS_AUDIO_DECLARE_OP_FD(SUM_OF_SQUARES);
+  MTS_AUDIO_DECLARE_OP_FD(RMS);
+  MTS_AUDIO_DECLARE_OP_FD(MAX_ABS);
+  MTS_AUDIO_DECLARE_OP_FD(MIN_INDEX);
+  MTS_AUDIO_DECLARE_OP_FD(MAX_INDEX);
+  MTS_AUDIO_DECLARE_OP_FD(DOT);
+
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_FROM_INT8);
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_FROM_INT16);
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_FROM_INT24);
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_FROM_INT32);
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_FROM_FLOAT);
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_FROM_DOUBLE);
+
+  MTS_AUDIO_DECLARE_OP_FD(DEINTERLEAVE_FROM_INT8);
+  MTS_AUDIO_DECLARE_OP_FD(DEINTERLEAVE_FROM_INT16);
+  MTS_AUDIO_DECLARE_OP_FD(DEINTERLEAVE_FROM_INT24);
+  MTS_AUDIO_DECLARE_OP_FD(DEINTERLEAVE_FROM_INT32);
+  MTS_AUDIO_DECLARE_OP_FD(DEINTERLEAVE_FROM_FLOAT);
+  MTS_AUDIO_DECLARE_OP_FD(DEINTERLEAVE_FROM_DOUBLE);
+  MTS_AUDIO_DECLARE_OP_FD(INTERLEAVE_FROM_FLOAT);
+  MTS_AUDIO_DECLARE_OP_FD(INTERLEAVE_FROM_DOUBLE);
+
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_TO_INT8);
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_TO_INT16);
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_TO_INT24);
+  MTS_AUDIO_DECLARE_OP_FD(CONVERT_TO_INT32);
+  MTS_AUDIO_DECLARE_OP_FD(INTERLEAVE_TO_INT8);
+  MTS_AUDIO_DECLARE_OP_FD(INTERLEAVE_TO_INT16);
+  MTS_AUDIO_DECLARE_OP_FD(INTERLEAVE_TO_INT24);
+  MTS_AUDIO_DECLARE_OP_FD(INTERLEAVE_TO_INT32);
+  MTS_AUDIO_DECLARE_OP_FD(BIQUAD);
+};
+
+using impl_ops = simd_ops;
+struct ops_type : impl_ops {
+  __MTS_AUDIO_OPS_DECLARE_USING();
+};
+
+MTS_END_SUB_NAMESPACE(vec)
+#endif // __MTS_USE_SIMD__
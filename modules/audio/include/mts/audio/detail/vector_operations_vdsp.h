@@ -55,6 +55,25 @@ struct vdsp_ops : base_ops {
   MTS_AUDIO_DECLARE_OP_FD(S_MUL);
   MTS_AUDIO_DECLARE_OP_FD(S_DIV);
   MTS_AUDIO_DECLARE_OP_FD(S_VDIV);
+
+  MTS_AUDIO_DECLARE_OP_FD(V_SUM);
+  MTS_AUDIO_DECLARE_OP_FD(V_SUB);
+  MTS_AUDIO_DECLARE_OP_FD(V_MUL);
+  MTS_AUDIO_DECLARE_OP_FD(V_DIV);
+
+  MTS_AUDIO_DECLARE_OP_FD(SUM_S_MUL);
+  MTS_AUDIO_DECLARE_OP_FD(SUM_V_MUL);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_S_SUM);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_V_SUM);
+  MTS_AUDIO_DECLARE_OP_FD(MUL_SUM);
+
+  MTS_AUDIO_DECLARE_OP_FD(SUM);
+  MTS_AUDIO_DECLARE_OP_FD(SUM_OF_SQUARES);
+  MTS_AUDIO_DECLARE_OP_FD(RMS);
+  MTS_AUDIO_DECLARE_OP_FD(MAX_ABS);
+  MTS_AUDIO_DECLARE_OP_FD(MIN_INDEX);
+  MTS_AUDIO_DECLARE_OP_FD(MAX_INDEX);
+  MTS_AUDIO_DECLARE_OP_FD(DOT);
 };
 
 using impl_ops = vdsp_ops;
@@ -0,0 +1,205 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/int24_t.h"
+#include "mts/audio/vector_operations.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+
+enum class dither_type {
+  /// Round to nearest.
+  none,
+
+  /// Triangular (tpdf) noise of +/- 1 lsb added before rounding.
+  tpdf,
+
+  /// tpdf with first order error feedback, the quantization noise is moved
+  /// towards high frequencies.
+  shaped
+};
+
+///
+/// Encodes floating point channels to interleaved integer samples like
+/// vec::interleave_to_int8/16/24/32, with optional dither.
+///
+/// The noise sequence and the error feedback carry over from one call to the
+/// next. Dithered encoding allocates its block buffer when the channel count
+/// grows, it is meant for file export and not for the audio thread.
+///
+class dither {
+public:
+  inline dither(dither_type type = dither_type::tpdf, std::uint32_t seed = 1) noexcept
+      : _type(type)
+      , _seed(seed)
+      , _state(seed) {}
+
+  inline dither_type type() const noexcept { return _type; }
+
+  /// Restarts the noise sequence and clears the error feedback.
+  inline void reset() noexcept {
+    _state = _seed;
+    _error.clear();
+  }
+
+  /// d1[i * s_d1 + c] = s[c][i] * 2^(bits - 1) + noise, rounded and saturated.
+  template <typename T, typename D>
+  inline void interleave(
+      const T* const* s, D* d1, vec::stride_t s_d1, vec::length_t n_channels, vec::length_t length) {
+    if (_type == dither_type::none) {
+      encode(s, d1, s_d1, n_channels, length);
+      return;
+    }
+
+    constexpr T scale = vec::int_sample_range<D, T>::scale;
+    constexpr T lsb = (T)1 / scale;
+
+    if (_error.size() < n_channels) {
+      _error.resize(n_channels, 0.0);
+    }
+
+    // The noise is added in blocks, each block is then encoded with the
+    // vectorized operation.
+    block<T>& b = get_block<T>();
+    b.reserve(n_channels);
+
+    for (vec::length_t i = 0; i < length; i += block_size) {
+      const vec::length_t n = std::min(block_size, length - i);
+
+      for (vec::length_t c = 0; c < n_channels; c++) {
+        const T* in = s[c] + i;
+        T* out = b.buffer.data() + c * block_size;
+
+        if (_type == dither_type::tpdf) {
+          for (vec::length_t k = 0; k < n; k++) {
+            out[k] = in[k] + (T)tpdf() * lsb;
+          }
+          continue;
+        }
+
+        // The output is quantized here and the error is taken from the value
+        // the encoding emits, which is not q when T can't hold it (float to
+        // int32). Saturation is left out of the feedback, it would grow
+        // without bound on a clipped signal.
+        double e = _error[c];
+        for (vec::length_t k = 0; k < n; k++) {
+          const double w = (double)in[k] * (double)scale - e;
+          const double q = std::nearbyint(w + tpdf());
+          out[k] = (T)(q * (double)lsb);
+          e = (double)out[k] * (double)scale - w;
+        }
+
+        _error[c] = e;
+      }
+
+      encode(b.channels.data(), d1 + (vec::stride_t)i * s_d1, s_d1, n_channels, n);
+    }
+  }
+
+private:
+  static constexpr vec::length_t block_size = 256;
+
+  template <typename T>
+  struct block {
+    std::vector<T> buffer;
+    std::vector<const T*> channels;
+
+    inline void reserve(vec::length_t n_channels) {
+      if (channels.size() >= n_channels) {
+        return;
+      }
+
+      buffer.resize(n_channels * block_size);
+      channels.resize(n_channels);
+      for (vec::length_t c = 0; c < n_channels; c++) {
+        channels[c] = buffer.data() + c * block_size;
+      }
+    }
+  };
+
+  dither_type _type;
+  std::uint32_t _seed;
+  std::uint32_t _state;
+  std::vector<double> _error;
+  block<float> _float_block;
+  block<double> _double_block;
+
+  template <typename T>
+  inline block<T>& get_block() noexcept {
+    if constexpr (std::is_same_v<T, float>) {
+      return _float_block;
+    }
+    else {
+      static_assert(std::is_same_v<T, double>, "Unsupported floating point sample type.");
+      return _double_block;
+    }
+  }
+
+  template <typename T, typename D>
+  static inline void encode(
+      const T* const* s, D* d1, vec::stride_t s_d1, vec::length_t n_channels, vec::length_t length) {
+    if constexpr (std::is_same_v<D, std::int8_t>) {
+      vec::interleave_to_int8(s, d1, s_d1, n_channels, length);
+    }
+    else if constexpr (std::is_same_v<D, std::int16_t>) {
+      vec::interleave_to_int16(s, d1, s_d1, n_channels, length);
+    }
+    else if constexpr (std::is_same_v<D, mts::int24_t>) {
+      vec::interleave_to_int24(s, d1, s_d1, n_channels, length);
+    }
+    else {
+      static_assert(std::is_same_v<D, std::int32_t>, "Unsupported integer sample type.");
+      vec::interleave_to_int32(s, d1, s_d1, n_channels, length);
+    }
+  }
+
+  // Uniform in [0, 1).
+  inline double uniform() noexcept {
+    _state = _state * 1664525u + 1013904223u;
+    return (double)(_state >> 8) * (1.0 / 16777216.0);
+  }
+
+  // Triangular in (-1, 1).
+  inline double tpdf() noexcept {
+    const double a = uniform();
+    return a - uniform();
+  }
+};
+
+MTS_END_NAMESPACE
@@ -0,0 +1,574 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/audio/wire.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <type_traits>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+
+namespace detail {
+/// Complex value of the split (separate real and imaginary arrays) buffers
+/// used by fft, spelled out since std::complex multiplication checks for nan
+/// and doesn't vectorize.
+template <typename T>
+struct fft_value {
+  T re;
+  T im;
+
+  inline static fft_value load(const T* re, const T* im, std::size_t i) noexcept { return { re[i], im[i] }; }
+
+  inline void store(T* re_out, T* im_out, std::size_t i) const noexcept {
+    re_out[i] = re;
+    im_out[i] = im;
+  }
+
+  inline fft_value operator+(const fft_value& b) const noexcept { return { re + b.re, im + b.im }; }
+  inline fft_value operator-(const fft_value& b) const noexcept { return { re - b.re, im - b.im }; }
+  inline fft_value operator*(T b) const noexcept { return { re * b, im * b }; }
+
+  /// this * w, or this * conj(w) for the inverse transform.
+  template <bool Inverse>
+  inline fft_value mul(T w_re, T w_im) const noexcept {
+    if constexpr (Inverse) {
+      return { re * w_re + im * w_im, im * w_re - re * w_im };
+    }
+    else {
+      return { re * w_re - im * w_im, im * w_re + re * w_im };
+    }
+  }
+
+  /// this * -i for the forward transform, this * i for the inverse.
+  template <bool Inverse>
+  inline fft_value rotate() const noexcept {
+    if constexpr (Inverse) {
+      return { -im, re };
+    }
+    else {
+      return { im, -re };
+    }
+  }
+};
+
+/// exp(-2 pi i k / n) computed in double precision.
+template <typename T>
+inline std::complex<T> fft_twiddle(std::size_t k, std::size_t n) noexcept {
+  const double angle = -2.0 * 3.14159265358979323846 * (double)(k % n) / (double)n;
+  return std::complex<T>((T)std::cos(angle), (T)std::sin(angle));
+}
+} // namespace detail.
+
+///
+/// Complex fft plan of any size.
+///
+/// The transform is a self sorting (Stockham) mixed radix fft with radix 4, 2,
+/// 3 and 5 butterflies and a generic one for other prime factors, which makes
+/// sizes with large prime factors slow. The stages run on split real and
+/// imaginary buffers with contiguous butterflies so that the compiler can
+/// vectorize them, the data is only interleaved on the way in and out.
+///
+/// All twiddles and work buffers are allocated by the constructor or reset(),
+/// forward() and inverse() never allocate. A plan can therefore be used on the
+/// audio thread, but not from two threads at once.
+///
+/// The inverse transform isn't normalized, forward then inverse scales by size().
+///
+template <typename T>
+class fft {
+public:
+  using value_type = T;
+  using complex_type = std::complex<T>;
+  using size_type = std::size_t;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::fft only works with floating point value type.");
+
+  fft() noexcept = default;
+
+  inline explicit fft(size_type size) { reset(size); }
+
+  inline void reset(size_type size) {
+    _size = size;
+    _stages.clear();
+    _twiddles.clear();
+    _work.assign(4 * (size + work_padding), T(0));
+
+    size_type max_radix = 0;
+    size_type n = size;
+    size_type s = 1;
+
+    // Twiddles of a stage are stored as m real parts then m imaginary parts for every u.
+    while (n > 1) {
+      const size_type radix = next_radix(n);
+      const size_type m = n / radix;
+      stage st = { radix, m, s, _twiddles.size(), 0 };
+
+      for (size_type u = 1; u < radix; u++) {
+        for (size_type p = 0; p < m; p++) {
+          _twiddles.push_back(detail::fft_twiddle<T>(p * u, n).real());
+        }
+
+        for (size_type p = 0; p < m; p++) {
+          _twiddles.push_back(detail::fft_twiddle<T>(p * u, n).imag());
+        }
+      }
+
+      if (radix > 5) {
+        st.root_offset = _twiddles.size();
+        for (size_type u = 0; u < radix; u++) {
+          _twiddles.push_back(detail::fft_twiddle<T>(u, radix).real());
+        }
+
+        for (size_type u = 0; u < radix; u++) {
+          _twiddles.push_back(detail::fft_twiddle<T>(u, radix).imag());
+        }
+
+        max_radix = std::max(max_radix, radix);
+      }
+
+      _stages.push_back(st);
+      n = m;
+      s *= radix;
+    }
+
+    _scratch.assign(2 * max_radix, T(0));
+  }
+
+  inline size_type size() const noexcept { return _size; }
+
+  /// output may be input.
+  inline void forward(const complex_type* input, complex_type* output) noexcept { transform<false>(input, output); }
+
+  /// output may be input.
+  inline void inverse(const complex_type* input, complex_type* output) noexcept { transform<true>(input, output); }
+
+private:
+  using value = detail::fft_value<T>;
+
+  struct stage {
+    size_type radix;
+    size_type m;
+    size_type s;
+    size_type twiddle_offset;
+    size_type root_offset;
+  };
+
+  /// Keeps power of two sized work buffers from mapping to the same cache sets.
+  static constexpr size_type work_padding = 64 / sizeof(T) + 16 / sizeof(T);
+
+  size_type _size = 0;
+  std::vector<stage> _stages;
+  std::vector<T> _twiddles;
+  std::vector<T> _work;
+  std::vector<T> _scratch;
+
+  static inline size_type next_radix(size_type n) noexcept {
+    for (size_type radix : { 4, 2, 3, 5 }) {
+      if (n % radix == 0) {
+        return radix;
+      }
+    }
+
+    for (size_type radix = 7; radix * radix <= n; radix += 2) {
+      if (n % radix == 0) {
+        return radix;
+      }
+    }
+
+    return n;
+  }
+
+  template <bool Inverse>
+  inline void transform(const complex_type* input, complex_type* output) noexcept {
+    const size_type n = _size;
+    T* xr = _work.data();
+    T* xi = xr + n + work_padding;
+    T* yr = xi + n + work_padding;
+    T* yi = yr + n + work_padding;
+
+    for (size_type i = 0; i < n; i++) {
+      xr[i] = input[i].real();
+      xi[i] = input[i].imag();
+    }
+
+    for (const stage& st : _stages) {
+      run_stage<Inverse>(st, xr, xi, yr, yi);
+      std::swap(xr, yr);
+      std::swap(xi, yi);
+    }
+
+    for (size_type i = 0; i < n; i++) {
+      output[i] = complex_type(xr[i], xi[i]);
+    }
+  }
+
+  ///
+  /// Butterfly views, element t of the input is at x[t * xs], output u at
+  /// y[u * ys] and the real part of twiddle u at w[2 * (u - 1) * ws] followed
+  /// by its imaginary part at ws.
+  ///
+  struct butterfly_data {
+    const T* xr;
+    const T* xi;
+    size_type xs;
+    T* yr;
+    T* yi;
+    size_type ys;
+    const T* w;
+    size_type ws;
+
+    MTS_ALWAYS_INLINE value load(size_type t) const noexcept { return { xr[t * xs], xi[t * xs] }; }
+
+    MTS_ALWAYS_INLINE void store(size_type u, const value& v) const noexcept {
+      yr[u * ys] = v.re;
+      yi[u * ys] = v.im;
+    }
+
+    template <bool Inverse>
+    MTS_ALWAYS_INLINE void store(size_type u, const value& v) const noexcept {
+      store(u, v.template mul<Inverse>(w[2 * (u - 1) * ws], w[(2 * u - 1) * ws]));
+    }
+  };
+
+  template <bool Inverse>
+  struct radix_2 {
+    static constexpr size_type radix = 2;
+
+    static MTS_ALWAYS_INLINE void butterfly(const butterfly_data& b) noexcept {
+      const value a0 = b.load(0);
+      const value a1 = b.load(1);
+      b.store(0, a0 + a1);
+      b.template store<Inverse>(1, a0 - a1);
+    }
+  };
+
+  template <bool Inverse>
+  struct radix_3 {
+    static constexpr size_type radix = 3;
+
+    static MTS_ALWAYS_INLINE void butterfly(const butterfly_data& b) noexcept {
+      // sin(2 pi / 3).
+      constexpr T h = (T)0.86602540378443864676;
+      const value a0 = b.load(0);
+      const value a1 = b.load(1);
+      const value a2 = b.load(2);
+      const value t1 = a1 + a2;
+      const value t2 = a0 - t1 * (T)0.5;
+      const value t3 = ((a1 - a2) * h).template rotate<Inverse>();
+      b.store(0, a0 + t1);
+      b.template store<Inverse>(1, t2 + t3);
+      b.template store<Inverse>(2, t2 - t3);
+    }
+  };
+
+  template <bool Inverse>
+  struct radix_4 {
+    static constexpr size_type radix = 4;
+
+    static MTS_ALWAYS_INLINE void butterfly(const butterfly_data& b) noexcept {
+      const value a0 = b.load(0);
+      const value a1 = b.load(1);
+      const value a2 = b.load(2);
+      const value a3 = b.load(3);
+      const value t0 = a0 + a2;
+      const value t1 = a0 - a2;
+      const value t2 = a1 + a3;
+      const value t3 = (a1 - a3).template rotate<Inverse>();
+      b.store(0, t0 + t2);
+      b.template store<Inverse>(1, t1 + t3);
+      b.template store<Inverse>(2, t0 - t2);
+      b.template store<Inverse>(3, t1 - t3);
+    }
+  };
+
+  template <bool Inverse>
+  struct radix_5 {
+    static constexpr size_type radix = 5;
+
+    static MTS_ALWAYS_INLINE void butterfly(const butterfly_data& b) noexcept {
+      // cos and sin of 2 pi / 5 and 4 pi / 5.
+      constexpr T c1 = (T)0.30901699437494742410;
+      constexpr T c2 = (T)-0.80901699437494742410;
+      constexpr T s1 = (T)0.95105651629515357212;
+      constexpr T s2 = (T)0.58778525229247312917;
+      const value a0 = b.load(0);
+      const value a1 = b.load(1);
+      const value a2 = b.load(2);
+      const value a3 = b.load(3);
+      const value a4 = b.load(4);
+      const value b1 = a1 + a4;
+      const value b2 = a2 + a3;
+      const value d1 = a1 - a4;
+      const value d2 = a2 - a3;
+      const value e1 = a0 + b1 * c1 + b2 * c2;
+      const value e2 = a0 + b1 * c2 + b2 * c1;
+      const value r1 = (d1 * s1 + d2 * s2).template rotate<Inverse>();
+      const value r2 = (d1 * s2 - d2 * s1).template rotate<Inverse>();
+      b.store(0, a0 + b1 + b2);
+      b.template store<Inverse>(1, e1 + r1);
+      b.template store<Inverse>(2, e2 + r2);
+      b.template store<Inverse>(3, e2 - r2);
+      b.template store<Inverse>(4, e1 - r1);
+    }
+  };
+
+  ///
+  /// Stage from x[q + s * (p + t * m)] to y[q + s * (radix * p + u)].
+  ///
+  /// Butterflies sharing twiddles (same p) are contiguous in q. The first
+  /// stage only has one per twiddle, it loops over p instead.
+  ///
+  template <class Radix>
+  static inline void run_butterflies(const T* __restrict xr, const T* __restrict xi, T* __restrict yr,
+      T* __restrict yi, const T* __restrict tw, size_type m, size_type s) noexcept {
+    constexpr size_type radix = Radix::radix;
+
+    if (s == 1) {
+      for (size_type p = 0; p < m; p++) {
+        Radix::butterfly({ xr + p, xi + p, m, yr + radix * p, yi + radix * p, 1, tw + p, m });
+      }
+      return;
+    }
+
+    const size_type sm = s * m;
+    for (size_type p = 0; p < m; p++) {
+      const T* pxr = xr + s * p;
+      const T* pxi = xi + s * p;
+      T* pyr = yr + s * radix * p;
+      T* pyi = yi + s * radix * p;
+
+      for (size_type q = 0; q < s; q++) {
+        Radix::butterfly({ pxr + q, pxi + q, sm, pyr + q, pyi + q, s, tw + p, m });
+      }
+    }
+  }
+
+  template <bool Inverse>
+  inline void run_stage(const stage& st, const T* xr, const T* xi, T* yr, T* yi) noexcept {
+    const T* tw = _twiddles.data() + st.twiddle_offset;
+    const size_type m = st.m;
+    const size_type s = st.s;
+
+    switch (st.radix) {
+    case 2:
+      run_butterflies<radix_2<Inverse>>(xr, xi, yr, yi, tw, m, s);
+      break;
+
+    case 3:
+      run_butterflies<radix_3<Inverse>>(xr, xi, yr, yi, tw, m, s);
+      break;
+
+    case 4:
+      run_butterflies<radix_4<Inverse>>(xr, xi, yr, yi, tw, m, s);
+      break;
+
+    case 5:
+      run_butterflies<radix_5<Inverse>>(xr, xi, yr, yi, tw, m, s);
+      break;
+
+    default: {
+      const size_type radix = st.radix;
+      const T* roots = _twiddles.data() + st.root_offset;
+      T* ar = _scratch.data();
+      T* ai = ar + radix;
+
+      for (size_type p = 0; p < m; p++) {
+        for (size_type q = 0; q < s; q++) {
+          const butterfly_data b = { xr + s * p + q, xi + s * p + q, s * m, yr + s * radix * p + q,
+            yi + s * radix * p + q, s, tw + p, m };
+
+          for (size_type t = 0; t < radix; t++) {
+            const value a = b.load(t);
+            ar[t] = a.re;
+            ai[t] = a.im;
+          }
+
+          for (size_type u = 0; u < radix; u++) {
+            value sum = value::load(ar, ai, 0);
+            for (size_type t = 1, k = u; t < radix; t++, k = (k + u) % radix) {
+              sum = sum + value::load(ar, ai, t).template mul<Inverse>(roots[k], roots[radix + k]);
+            }
+
+            if (u) {
+              b.template store<Inverse>(u, sum);
+            }
+            else {
+              b.store(0, sum);
+            }
+          }
+        }
+      }
+    } break;
+    }
+  }
+};
+
+///
+/// Real fft plan of an even size, computed with a complex fft of half the size.
+///
+/// The spectrum has size() / 2 + 1 bins. The packed in place overloads store
+/// the real nyquist bin in the imaginary part of bin 0 (which is always zero)
+/// so that a spectrum fits in the size() samples of a wire.
+///
+/// Like fft, nothing is allocated after construction and the inverse transform
+/// isn't normalized.
+///
+template <typename T>
+class real_fft {
+public:
+  using value_type = T;
+  using complex_type = std::complex<T>;
+  using size_type = std::size_t;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::real_fft only works with floating point value type.");
+
+  real_fft() noexcept = default;
+
+  inline explicit real_fft(size_type size) { reset(size); }
+
+  inline void reset(size_type size) {
+    mts_assert(size % 2 == 0, "real_fft size must be even");
+    _size = size;
+    _fft.reset(size / 2);
+    _twiddles.resize(size / 4 + 1);
+
+    for (size_type k = 0; k < _twiddles.size(); k++) {
+      _twiddles[k] = detail::fft_twiddle<T>(k, size);
+    }
+  }
+
+  inline size_type size() const noexcept { return _size; }
+
+  /// Writes size() / 2 + 1 bins, output may be input if it has room for size() + 2 values.
+  inline void forward(const value_type* input, complex_type* output) noexcept {
+    const size_type h = _size / 2;
+    forward_packed(input, output);
+    output[h] = complex_type(output[0].imag(), 0);
+    output[0] = complex_type(output[0].real(), 0);
+  }
+
+  /// Reads size() / 2 + 1 bins, output may be input.
+  inline void inverse(const complex_type* input, value_type* output) noexcept {
+    const size_type h = _size / 2;
+    inverse_packed(input, input[0].real(), input[h].real(), output);
+  }
+
+  inline void forward(wire<const T> input, complex_type* output) noexcept {
+    mts_assert(input.size() >= _size, "Invalid wire size");
+    forward(input.data(), output);
+  }
+
+  inline void inverse(const complex_type* input, wire<T> output) noexcept {
+    mts_assert(output.size() >= _size, "Invalid wire size");
+    inverse(input, output.data());
+  }
+
+  /// In place packed transforms.
+  inline void forward(wire<T> data) noexcept {
+    mts_assert(data.size() >= _size, "Invalid wire size");
+    forward_packed(data.data(), reinterpret_cast<complex_type*>(data.data()));
+  }
+
+  inline void inverse(wire<T> data) noexcept {
+    mts_assert(data.size() >= _size, "Invalid wire size");
+    const complex_type* spectrum = reinterpret_cast<const complex_type*>(data.data());
+    inverse_packed(spectrum, spectrum[0].real(), spectrum[0].imag(), data.data());
+  }
+
+private:
+  size_type _size = 0;
+  fft<T> _fft;
+  std::vector<complex_type> _twiddles;
+
+  /// The even and odd samples are the real and imaginary parts of a half size
+  /// complex transform, which gets split into the real spectrum.
+  inline void forward_packed(const value_type* input, complex_type* output) noexcept {
+    const size_type h = _size / 2;
+    if (h == 0) {
+      return;
+    }
+
+    _fft.forward(reinterpret_cast<const complex_type*>(input), output);
+
+    const complex_type z0 = output[0];
+    output[0] = complex_type(z0.real() + z0.imag(), z0.real() - z0.imag());
+
+    for (size_type k = 1; k <= h / 2; k++) {
+      const complex_type zk = output[k];
+      const complex_type zn = std::conj(output[h - k]);
+      const complex_type fe = (zk + zn) * (T)0.5;
+      const complex_type fo = complex_type(zk.imag() - zn.imag(), zn.real() - zk.real()) * (T)0.5;
+      const complex_type wfo = mul<false>(fo, twiddle(k));
+      output[k] = fe + wfo;
+      output[h - k] = std::conj(fe - wfo);
+    }
+  }
+
+  /// Reads bins 1 to size() / 2 - 1 from input.
+  inline void inverse_packed(const complex_type* input, T dc, T nyquist, value_type* output) noexcept {
+    const size_type h = _size / 2;
+    if (h == 0) {
+      return;
+    }
+
+    complex_type* z = reinterpret_cast<complex_type*>(output);
+
+    for (size_type k = 1; k <= h / 2; k++) {
+      const complex_type xk = input[k];
+      const complex_type xn = std::conj(input[h - k]);
+      const complex_type fe = xk + xn;
+      const complex_type fo = mul<true>(xk - xn, twiddle(k));
+      z[k] = complex_type(fe.real() - fo.imag(), fe.imag() + fo.real());
+      z[h - k] = complex_type(fe.real() + fo.imag(), fo.real() - fe.imag());
+    }
+
+    z[0] = complex_type(dc + nyquist, dc - nyquist);
+    _fft.inverse(z, z);
+  }
+
+  template <bool Conjugate>
+  static inline complex_type mul(const complex_type& a, const complex_type& w) noexcept {
+    const detail::fft_value<T> v
+        = detail::fft_value<T>{ a.real(), a.imag() }.template mul<Conjugate>(w.real(), w.imag());
+    return complex_type(v.re, v.im);
+  }
+
+  /// exp(-2 pi i k / size()), only the first quarter is needed.
+  inline const complex_type& twiddle(size_type k) const noexcept { return _twiddles[k]; }
+};
+MTS_END_NAMESPACE
@@ -0,0 +1,781 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/audio/buffer.h"
+#include "mts/audio/bus.h"
+#include "mts/audio/vector_operations.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+enum class audio_graph_error { invalid_node, invalid_port, channel_mismatch, already_connected, cycle, memory_error };
+
+const std::error_category& audio_graph_error_category() noexcept;
+inline std::error_code make_error_code(mts::audio_graph_error ec) noexcept {
+  return { static_cast<int>(ec), audio_graph_error_category() };
+}
+
+///
+/// Processing node with a fixed number of input and output busses, each with
+/// a fixed number of channels.
+///
+template <typename T>
+class audio_node {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::audio_node only works with floating point value type.");
+
+  inline audio_node(std::vector<size_type> input_channels, std::vector<size_type> output_channels)
+      : _input_channels(std::move(input_channels))
+      , _output_channels(std::move(output_channels)) {}
+
+  virtual ~audio_node() = default;
+
+  inline size_type input_size() const noexcept { return _input_channels.size(); }
+  inline size_type output_size() const noexcept { return _output_channels.size(); }
+
+  inline size_type input_channel_size(size_type index) const noexcept {
+    mts_assert(index < input_size(), "Out of bounds index");
+    return _input_channels[index];
+  }
+
+  inline size_type output_channel_size(size_type index) const noexcept {
+    mts_assert(index < output_size(), "Out of bounds index");
+    return _output_channels[index];
+  }
+
+  /// Called from the audio thread with input_size() inputs and output_size()
+  /// outputs of buffer_size frames. The outputs never alias the inputs and
+  /// must all be written, an unconnected input is silent.
+  virtual void process(const audio_bus<const T>* inputs, audio_bus<T>* outputs, size_type buffer_size) noexcept = 0;
+
+private:
+  std::vector<size_type> _input_channels;
+  std::vector<size_type> _output_channels;
+};
+
+template <typename T>
+class audio_graph;
+
+template <typename T>
+class audio_graph_executor;
+
+///
+/// Compiled audio_graph, runs the nodes in topological order.
+///
+/// Every node output gets a scratch buffer for its lifetime in the schedule,
+/// from the node that writes it to the last node that reads it, and the
+/// scratch buffers are shared between outputs whose lifetimes don't overlap.
+/// An input with a single connection reads the output buffer directly, the
+/// connections of an input with many are summed into a scratch buffer.
+///
+/// Each step depends on the steps writing its inputs and, when it reuses a
+/// scratch buffer, on the previous users of that buffer, so independent
+/// steps can run in parallel with an audio_graph_executor.
+///
+/// process() never allocates. The nodes are kept alive by the program.
+///
+template <typename T>
+class audio_graph_program {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using node_type = audio_node<T>;
+
+  struct timing {
+    std::chrono::nanoseconds last;
+    std::chrono::nanoseconds peak;
+  };
+
+  audio_graph_program(const audio_graph_program&) = delete;
+  audio_graph_program& operator=(const audio_graph_program&) = delete;
+
+  inline size_type max_buffer_size() const noexcept { return _max_buffer_size; }
+
+  /// Nodes in processing order.
+  inline size_type step_size() const noexcept { return _steps.size(); }
+  inline const node_type* step_node(size_type index) const noexcept { return _steps[index].node; }
+
+  /// Number of steps that must run before this one.
+  inline size_type step_dependency_size(size_type index) const noexcept { return _steps[index].dependency_size; }
+
+  /// Processing time of the node of a step, can be read from any thread.
+  inline timing step_time(size_type index) const noexcept {
+    const step_state& state = _states[index];
+    return timing{ std::chrono::nanoseconds(state.last_time.load(std::memory_order_relaxed)),
+      std::chrono::nanoseconds(state.peak_time.load(std::memory_order_relaxed)) };
+  }
+
+  inline void reset_step_times() noexcept {
+    for (size_type s = 0; s < _steps.size(); s++) {
+      _states[s].last_time.store(0, std::memory_order_relaxed);
+      _states[s].peak_time.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// Number of scratch buffers and their total channel count.
+  inline size_type buffer_size() const noexcept { return _buffers.size(); }
+
+  inline size_type buffer_channel_size() const noexcept {
+    size_type n = 0;
+    for (const audio_buffer<T>& b : _buffers) {
+      n += b.channel_size();
+    }
+    return n;
+  }
+
+  /// The inputs and outputs are the ones of the graph, buffer_size must not
+  /// exceed max_buffer_size().
+  inline void process(const audio_bus<const T>* inputs, audio_bus<T>* outputs, size_type buffer_size) noexcept {
+    mts_assert(buffer_size <= _max_buffer_size, "Invalid buffer size");
+
+    for (size_type s = 0; s < _steps.size(); s++) {
+      run_step(s, inputs, buffer_size);
+    }
+
+    process_outputs(inputs, outputs, buffer_size);
+  }
+
+private:
+  // Index of the buffer of a source connected to a graph input.
+  static constexpr size_type graph_input = ~size_type(0);
+
+  struct source {
+    size_type buffer;
+
+    // Graph input index when buffer is graph_input.
+    size_type input;
+  };
+
+  struct input_port {
+    size_type first_source;
+    size_type source_size;
+    size_type channel_size;
+
+    // Buffer receiving the sum of the sources.
+    size_type sum_buffer;
+  };
+
+  struct output_port {
+    size_type buffer;
+    size_type channel_size;
+  };
+
+  struct step {
+    node_type* node;
+    size_type first_input;
+    size_type first_output;
+    size_type first_successor;
+    size_type successor_size;
+    size_type dependency_size;
+  };
+
+  struct step_state {
+    // Dependencies left in the current callback of an audio_graph_executor.
+    std::atomic<size_type> remaining = 0;
+
+    std::atomic<std::uint64_t> last_time = 0;
+    std::atomic<std::uint64_t> peak_time = 0;
+  };
+
+  std::vector<std::shared_ptr<node_type>> _nodes;
+  std::vector<step> _steps;
+  std::vector<input_port> _inputs;
+  std::vector<output_port> _outputs;
+  std::vector<source> _sources;
+  std::vector<size_type> _successors;
+  std::unique_ptr<step_state[]> _states;
+
+  // Graph outputs.
+  std::vector<input_port> _graph_outputs;
+
+  std::vector<audio_buffer<T>> _buffers;
+  audio_buffer<T> _silence;
+  size_type _max_buffer_size = 0;
+
+  // Busses of all the steps, each step only uses its own ones.
+  std::vector<audio_bus<const T>> _input_busses;
+  std::vector<audio_bus<T>> _output_busses;
+
+  friend class audio_graph<T>;
+  friend class audio_graph_executor<T>;
+
+  audio_graph_program() = default;
+
+  inline audio_bus<const T> source_bus(const source& src, const audio_bus<const T>* inputs, size_type channel_size,
+      size_type buffer_size) const noexcept {
+    return src.buffer == graph_input ? audio_bus<const T>(inputs[src.input].data(), buffer_size, channel_size)
+                                     : audio_bus<const T>(_buffers[src.buffer].data(), buffer_size, channel_size);
+  }
+
+  inline void sum_sources(
+      const input_port& p, const audio_bus<const T>* inputs, T* const* dst, size_type buffer_size) const noexcept {
+    for (size_type i = 0; i < p.source_size; i++) {
+      audio_bus<const T> src = source_bus(_sources[p.first_source + i], inputs, p.channel_size, buffer_size);
+
+      for (size_type c = 0; c < p.channel_size; c++) {
+        if (i == 0) {
+          vec::copy(src[c], 1, dst[c], 1, buffer_size);
+        }
+        else {
+          vec::sum(src[c], 1, dst[c], 1, dst[c], 1, buffer_size);
+        }
+      }
+    }
+  }
+
+  inline audio_bus<const T> input_bus(
+      const input_port& p, const audio_bus<const T>* inputs, size_type buffer_size) noexcept {
+    if (p.source_size == 0) {
+      return audio_bus<const T>(_silence.data(), buffer_size, p.channel_size);
+    }
+
+    if (p.source_size == 1) {
+      return source_bus(_sources[p.first_source], inputs, p.channel_size, buffer_size);
+    }
+
+    sum_sources(p, inputs, _buffers[p.sum_buffer].data(), buffer_size);
+    return audio_bus<const T>(_buffers[p.sum_buffer].data(), buffer_size, p.channel_size);
+  }
+
+  inline void run_step(size_type index, const audio_bus<const T>* inputs, size_type buffer_size) noexcept {
+    using clock = std::chrono::steady_clock;
+
+    const step& s = _steps[index];
+    const size_type n_inputs = s.node->input_size();
+    const size_type n_outputs = s.node->output_size();
+    const clock::time_point start = clock::now();
+
+    for (size_type i = 0; i < n_inputs; i++) {
+      _input_busses[s.first_input + i] = input_bus(_inputs[s.first_input + i], inputs, buffer_size);
+    }
+
+    for (size_type i = 0; i < n_outputs; i++) {
+      const output_port& p = _outputs[s.first_output + i];
+      _output_busses[s.first_output + i] = audio_bus<T>(_buffers[p.buffer].data(), buffer_size, p.channel_size);
+    }
+
+    s.node->process(_input_busses.data() + s.first_input, _output_busses.data() + s.first_output, buffer_size);
+
+    const std::uint64_t time
+        = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+    step_state& state = _states[index];
+    state.last_time.store(time, std::memory_order_relaxed);
+
+    if (time > state.peak_time.load(std::memory_order_relaxed)) {
+      state.peak_time.store(time, std::memory_order_relaxed);
+    }
+  }
+
+  inline void process_outputs(const audio_bus<const T>* inputs, audio_bus<T>* outputs, size_type buffer_size) noexcept {
+    for (size_type i = 0; i < _graph_outputs.size(); i++) {
+      const input_port& p = _graph_outputs[i];
+      mts_assert(outputs[i].channel_size() >= p.channel_size, "Invalid channel size");
+
+      if (p.source_size == 0) {
+        for (size_type c = 0; c < p.channel_size; c++) {
+          vec::clear(outputs[i][c], 1, buffer_size);
+        }
+      }
+      else {
+        sum_sources(p, inputs, outputs[i].data(), buffer_size);
+      }
+    }
+  }
+};
+
+///
+/// Description of a graph of audio_node, edited and compiled outside of the
+/// audio thread.
+///
+/// The graph inputs are the outputs of input_node and the graph outputs the
+/// inputs of output_node. An output can be connected to any number of inputs
+/// with the same channel count and the connections to an input are summed.
+///
+template <typename T>
+class audio_graph {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using node_type = audio_node<T>;
+  using program_type = audio_graph_program<T>;
+  using node_id = size_type;
+
+  static constexpr node_id input_node = 0;
+  static constexpr node_id output_node = 1;
+
+  struct connection {
+    node_id source;
+    size_type output;
+    node_id destination;
+    size_type input;
+  };
+
+  inline audio_graph(std::vector<size_type> input_channels, std::vector<size_type> output_channels) {
+    _nodes.push_back(node_info{ nullptr, {}, std::move(input_channels) });
+    _nodes.push_back(node_info{ nullptr, std::move(output_channels), {} });
+  }
+
+  /// Number of nodes, input_node and output_node included.
+  inline size_type node_size() const noexcept { return _nodes.size(); }
+  inline const std::vector<connection>& connections() const noexcept { return _connections; }
+
+  inline node_id add_node(std::shared_ptr<node_type> node) {
+    mts_assert(node != nullptr, "Invalid node");
+
+    std::vector<size_type> inputs(node->input_size());
+    std::vector<size_type> outputs(node->output_size());
+    for (size_type i = 0; i < inputs.size(); i++) {
+      inputs[i] = node->input_channel_size(i);
+    }
+
+    for (size_type i = 0; i < outputs.size(); i++) {
+      outputs[i] = node->output_channel_size(i);
+    }
+
+    _nodes.push_back(node_info{ std::move(node), std::move(inputs), std::move(outputs) });
+    return _nodes.size() - 1;
+  }
+
+  inline std::error_code connect(node_id source, size_type output, node_id destination, size_type input) {
+    if (source >= _nodes.size() || destination >= _nodes.size() || source == output_node
+        || destination == input_node) {
+      return make_error_code(audio_graph_error::invalid_node);
+    }
+
+    if (output >= _nodes[source].outputs.size() || input >= _nodes[destination].inputs.size()) {
+      return make_error_code(audio_graph_error::invalid_port);
+    }
+
+    if (_nodes[source].outputs[output] != _nodes[destination].inputs[input]) {
+      return make_error_code(audio_graph_error::channel_mismatch);
+    }
+
+    if (find(source, output, destination, input) != _connections.end()) {
+      return make_error_code(audio_graph_error::already_connected);
+    }
+
+    _connections.push_back(connection{ source, output, destination, input });
+    return {};
+  }
+
+  inline void disconnect(node_id source, size_type output, node_id destination, size_type input) {
+    auto it = find(source, output, destination, input);
+    if (it != _connections.end()) {
+      _connections.erase(it);
+    }
+  }
+
+  /// Sorts the nodes and assigns the scratch buffers of a program processing
+  /// up to max_buffer_size frames. Returns null with ec set on a cycle or an
+  /// allocation failure.
+  inline std::unique_ptr<program_type> compile(size_type max_buffer_size, std::error_code& ec) const {
+    ec = {};
+
+    std::vector<node_id> order;
+    if (!sort(order)) {
+      ec = make_error_code(audio_graph_error::cycle);
+      return nullptr;
+    }
+
+    std::unique_ptr<program_type> p(new program_type());
+    p->_max_buffer_size = max_buffer_size;
+
+    // Schedule position of each node, the graph inputs come before all the
+    // steps and the graph outputs after.
+    const size_type end_step = order.size();
+    std::vector<size_type> step_of(_nodes.size());
+    step_of[input_node] = 0;
+    step_of[output_node] = end_step;
+    for (size_type s = 0; s < order.size(); s++) {
+      step_of[order[s]] = s;
+    }
+
+    // Last step reading each node output.
+    std::vector<size_type> first_output(_nodes.size() + 1, 0);
+    for (node_id n = 0; n < _nodes.size(); n++) {
+      first_output[n + 1] = first_output[n] + _nodes[n].outputs.size();
+    }
+
+    std::vector<size_type> last_use(first_output.back());
+    for (node_id n = 0; n < _nodes.size(); n++) {
+      for (size_type o = 0; o < _nodes[n].outputs.size(); o++) {
+        last_use[first_output[n] + o] = step_of[n];
+      }
+    }
+
+    for (const connection& c : _connections) {
+      size_type& last = last_use[first_output[c.source] + c.output];
+      last = std::max(last, step_of[c.destination]);
+    }
+
+    buffer_assigner assigner;
+    std::vector<size_type> output_buffer(first_output.back(), program_type::graph_input);
+    size_type silence_channels = 0;
+
+    // Dependencies of each step, and the steps that used each scratch buffer
+    // since it was last acquired.
+    std::vector<std::vector<size_type>> dependencies(order.size());
+    std::vector<std::vector<size_type>> buffer_users;
+
+    auto acquire = [&](size_type s, size_type channel_size) {
+      const size_type b = assigner.acquire(channel_size);
+      buffer_users.resize(assigner.channels.size());
+
+      for (size_type u : buffer_users[b]) {
+        dependencies[s].push_back(u);
+      }
+
+      buffer_users[b].assign(1, s);
+      return b;
+    };
+
+    auto add_input = [&](node_id n, size_type i) {
+      typename program_type::input_port port{ p->_sources.size(), 0, _nodes[n].inputs[i], 0 };
+
+      for (const connection& c : _connections) {
+        if (c.destination == n && c.input == i) {
+          const size_type buffer = output_buffer[first_output[c.source] + c.output];
+          p->_sources.push_back(typename program_type::source{ buffer, c.output });
+          port.source_size++;
+        }
+      }
+
+      if (port.source_size == 0) {
+        silence_channels = std::max(silence_channels, port.channel_size);
+      }
+
+      return port;
+    };
+
+    for (size_type s = 0; s < order.size(); s++) {
+      const node_id n = order[s];
+      const node_info& info = _nodes[n];
+      p->_nodes.push_back(info.node);
+      p->_steps.push_back(
+          typename program_type::step{ info.node.get(), p->_inputs.size(), p->_outputs.size(), 0, 0, 0 });
+
+      // Sum buffers only live during the step but can't alias the outputs.
+      std::vector<size_type> sums;
+      for (size_type i = 0; i < info.inputs.size(); i++) {
+        typename program_type::input_port port = add_input(n, i);
+
+        for (size_type j = 0; j < port.source_size; j++) {
+          const size_type buffer = p->_sources[port.first_source + j].buffer;
+
+          if (buffer != program_type::graph_input) {
+            dependencies[s].push_back(buffer_users[buffer].front());
+            buffer_users[buffer].push_back(s);
+          }
+        }
+
+        if (port.source_size > 1) {
+          port.sum_buffer = acquire(s, port.channel_size);
+          sums.push_back(port.sum_buffer);
+        }
+
+        p->_inputs.push_back(port);
+      }
+
+      for (size_type o = 0; o < info.outputs.size(); o++) {
+        const size_type buffer = acquire(s, info.outputs[o]);
+        output_buffer[first_output[n] + o] = buffer;
+        p->_outputs.push_back(typename program_type::output_port{ buffer, info.outputs[o] });
+      }
+
+      for (size_type b : sums) {
+        assigner.release(b);
+      }
+
+      // Outputs read for the last time in this step, its own unread outputs
+      // included.
+      for (node_id m = 0; m < _nodes.size(); m++) {
+        if (m == input_node || (step_of[m] > s && m != n)) {
+          continue;
+        }
+
+        for (size_type o = 0; o < _nodes[m].outputs.size(); o++) {
+          const size_type port = first_output[m] + o;
+          if (last_use[port] == s && output_buffer[port] != program_type::graph_input) {
+            assigner.release(output_buffer[port]);
+            output_buffer[port] = program_type::graph_input;
+          }
+        }
+      }
+    }
+
+    for (size_type i = 0; i < _nodes[output_node].inputs.size(); i++) {
+      p->_graph_outputs.push_back(add_input(output_node, i));
+    }
+
+    for (size_type channels : assigner.channels) {
+      p->_buffers.emplace_back(max_buffer_size, channels);
+
+      if (!p->_buffers.back().is_valid()) {
+        ec = make_error_code(audio_graph_error::memory_error);
+        return nullptr;
+      }
+    }
+
+    if (silence_channels) {
+      p->_silence.reset(max_buffer_size, silence_channels);
+
+      if (!p->_silence.is_valid()) {
+        ec = make_error_code(audio_graph_error::memory_error);
+        return nullptr;
+      }
+    }
+
+    // Successors of each step.
+    std::vector<std::vector<size_type>> successors(order.size());
+    for (size_type s = 0; s < order.size(); s++) {
+      std::vector<size_type>& deps = dependencies[s];
+      std::sort(deps.begin(), deps.end());
+      deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+      deps.erase(std::remove(deps.begin(), deps.end(), s), deps.end());
+      p->_steps[s].dependency_size = deps.size();
+
+      for (size_type d : deps) {
+        successors[d].push_back(s);
+      }
+    }
+
+    for (size_type s = 0; s < order.size(); s++) {
+      p->_steps[s].first_successor = p->_successors.size();
+      p->_steps[s].successor_size = successors[s].size();
+      p->_successors.insert(p->_successors.end(), successors[s].begin(), successors[s].end());
+    }
+
+    p->_states = std::make_unique<typename program_type::step_state[]>(order.size());
+    p->_input_busses.resize(p->_inputs.size());
+    p->_output_busses.resize(p->_outputs.size());
+    return p;
+  }
+
+private:
+  struct node_info {
+    std::shared_ptr<node_type> node;
+    std::vector<size_type> inputs;
+    std::vector<size_type> outputs;
+  };
+
+  // Scratch buffers by channel count, a free buffer is reused by the next
+  // output and grown when it has too few channels.
+  struct buffer_assigner {
+    std::vector<size_type> channels;
+    std::vector<bool> used;
+
+    inline size_type acquire(size_type channel_size) {
+      size_type best = channels.size();
+
+      for (size_type b = 0; b < channels.size(); b++) {
+        if (used[b]) {
+          continue;
+        }
+
+        if (best == channels.size()) {
+          best = b;
+        }
+        else if (channels[b] >= channel_size) {
+          // Smallest buffer large enough.
+          if (channels[best] < channel_size || channels[b] < channels[best]) {
+            best = b;
+          }
+        }
+        else if (channels[best] < channel_size && channels[b] > channels[best]) {
+          // Otherwise the largest one.
+          best = b;
+        }
+      }
+
+      if (best == channels.size()) {
+        channels.push_back(channel_size);
+        used.push_back(true);
+        return best;
+      }
+
+      channels[best] = std::max(channels[best], channel_size);
+      used[best] = true;
+      return best;
+    }
+
+    inline void release(size_type b) { used[b] = false; }
+  };
+
+  std::vector<node_info> _nodes;
+  std::vector<connection> _connections;
+
+  inline typename std::vector<connection>::const_iterator find(
+      node_id source, size_type output, node_id destination, size_type input) const {
+    return std::find_if(_connections.begin(), _connections.end(), [&](const connection& c) {
+      return c.source == source && c.output == output && c.destination == destination && c.input == input;
+    });
+  }
+
+  // Kahn's algorithm, ready nodes are taken in the order they were added.
+  inline bool sort(std::vector<node_id>& order) const {
+    std::vector<size_type> n_dependencies(_nodes.size(), 0);
+    for (const connection& c : _connections) {
+      if (c.source != input_node && c.destination != output_node) {
+        n_dependencies[c.destination]++;
+      }
+    }
+
+    order.clear();
+    for (node_id n = 2; n < _nodes.size(); n++) {
+      if (n_dependencies[n] == 0) {
+        order.push_back(n);
+      }
+    }
+
+    for (size_type i = 0; i < order.size(); i++) {
+      for (const connection& c : _connections) {
+        if (c.source == order[i] && c.destination != output_node && --n_dependencies[c.destination] == 0) {
+          order.push_back(c.destination);
+        }
+      }
+    }
+
+    return order.size() == _nodes.size() - 2;
+  }
+};
+
+///
+/// Runs the program of an audio_graph on the audio thread.
+///
+/// set_program() hands a new program over from another thread without
+/// locking, the audio thread picks it at the start of its next process() and
+/// the replaced one is destroyed by the next set_program() or collect() call,
+/// never on the audio thread. Only one thread may call set_program() and
+/// collect().
+///
+template <typename T>
+class audio_graph_engine {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using program_type = audio_graph_program<T>;
+
+  audio_graph_engine() noexcept = default;
+
+  audio_graph_engine(const audio_graph_engine&) = delete;
+  audio_graph_engine& operator=(const audio_graph_engine&) = delete;
+
+  inline ~audio_graph_engine() {
+    delete _current;
+    delete _pending.load();
+    delete _retired.load();
+  }
+
+  /// A program set before the previous one was picked replaces it.
+  inline void set_program(std::unique_ptr<program_type> program) {
+    collect();
+    delete _pending.exchange(program.release(), std::memory_order_acq_rel);
+  }
+
+  /// Destroys the program replaced by the audio thread, if any.
+  inline void collect() { delete _retired.exchange(nullptr, std::memory_order_acquire); }
+
+  /// True until the audio thread picks the last program set.
+  inline bool is_pending() const noexcept { return _pending.load(std::memory_order_acquire) != nullptr; }
+
+  /// Called from the audio thread, the outputs are cleared when there is no
+  /// program or when buffer_size exceeds its max_buffer_size().
+  inline void process(const audio_bus<const T>* inputs, audio_bus<T>* outputs, size_type n_outputs,
+      size_type buffer_size) noexcept {
+    if (program_type* p = update(buffer_size)) {
+      p->process(inputs, outputs, buffer_size);
+    }
+    else {
+      clear(outputs, n_outputs, buffer_size);
+    }
+  }
+
+  /// Same with the program run by an executor (see audio_graph_executor).
+  inline void process(audio_graph_executor<T>& executor, const audio_bus<const T>* inputs, audio_bus<T>* outputs,
+      size_type n_outputs, size_type buffer_size, std::chrono::nanoseconds deadline) noexcept {
+    if (program_type* p = update(buffer_size)) {
+      executor.process(*p, inputs, outputs, buffer_size, deadline);
+    }
+    else {
+      clear(outputs, n_outputs, buffer_size);
+    }
+  }
+
+private:
+  // Only used by the audio thread.
+  program_type* _current = nullptr;
+
+  std::atomic<program_type*> _pending = nullptr;
+  std::atomic<program_type*> _retired = nullptr;
+
+  // Picks the pending program, returns the one to run.
+  inline program_type* update(size_type buffer_size) noexcept {
+    // The replaced program can only be retired once the previous one was
+    // collected.
+    if (_retired.load(std::memory_order_acquire) == nullptr) {
+      if (program_type* p = _pending.exchange(nullptr, std::memory_order_acq_rel)) {
+        _retired.store(_current, std::memory_order_release);
+        _current = p;
+      }
+    }
+
+    return _current && buffer_size <= _current->max_buffer_size() ? _current : nullptr;
+  }
+
+  static inline void clear(audio_bus<T>* outputs, size_type n_outputs, size_type buffer_size) noexcept {
+    for (size_type i = 0; i < n_outputs; i++) {
+      for (size_type c = 0; c < outputs[i].channel_size(); c++) {
+        vec::clear(outputs[i][c], 1, buffer_size);
+      }
+    }
+  }
+};
+MTS_END_NAMESPACE
+
+namespace std {
+template <>
+struct is_error_code_enum<mts::audio_graph_error> : std::true_type {};
+inline std::error_code make_error_code(mts::audio_graph_error ec) noexcept { return mts::make_error_code(ec); }
+} // namespace std.
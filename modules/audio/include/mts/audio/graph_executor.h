@@ -0,0 +1,411 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/math.h"
+#include "mts/audio/graph.h"
+#include "mts/audio/detail/worker_thread.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+
+///
+/// Runs the independent steps of an audio_graph_program on a pool of worker
+/// threads.
+///
+/// The thread calling process() takes part in the work. Each thread owns a
+/// work stealing queue of ready steps, a step is queued by the thread that
+/// completes its last dependency and idle threads steal from the others. The
+/// workers spin for a while before sleeping so that they're awake for the
+/// next callback.
+///
+/// The whole program always runs within process(). When a callback takes
+/// more than deadline_ratio of its deadline, the next fallback_size
+/// callbacks run single threaded, which avoids waiting on preempted workers
+/// when the system is overloaded.
+///
+template <typename T>
+class audio_graph_executor {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using program_type = audio_graph_program<T>;
+
+  ///
+  /// The defaults are safe for any process: the workers use normal scheduling,
+  /// aren't pinned and only spin briefly. For a production audio thread, set
+  /// realtime (which usually needs privileges, see is_realtime()), pin the
+  /// workers away from the cpu of the audio thread with first_cpu, and raise
+  /// spin_size so that the workers stay awake between callbacks.
+  ///
+  struct options {
+    size_type n_workers = default_worker_size();
+
+    /// Fifo scheduling of the workers, see detail::set_worker_thread_realtime.
+    bool realtime = false;
+    int priority = 70;
+
+    /// Worker i is pinned to cpu first_cpu + i, modulo the number of cpus.
+    bool pin = false;
+    size_type first_cpu = 1;
+
+    /// Programs with more steps run single threaded.
+    size_type max_step_size = 4096;
+
+    double deadline_ratio = 0.75;
+    size_type fallback_size = 256;
+
+    /// Iterations a worker spins on an empty queue before sleeping.
+    size_type spin_size = 1000;
+  };
+
+  struct statistics {
+    std::uint64_t callbacks;
+
+    /// Callbacks run single threaded after a deadline at risk.
+    std::uint64_t fallback_callbacks;
+    std::uint64_t deadlines_at_risk;
+
+    /// Steps run by the worker threads.
+    std::uint64_t stolen_steps;
+
+    std::chrono::nanoseconds last_time;
+    std::chrono::nanoseconds peak_time;
+  };
+
+  /// One worker per core besides the one of the audio thread.
+  static inline size_type default_worker_size() noexcept {
+    const size_type n = std::thread::hardware_concurrency();
+    return n > 1 ? n - 1 : 0;
+  }
+
+  inline audio_graph_executor()
+      : audio_graph_executor(options{}) {}
+
+  inline audio_graph_executor(const options& opts)
+      : _options(opts) {
+    const size_type capacity = math::round_to_power_of_two(std::max<size_type>(opts.max_step_size, 2));
+    _queues = std::make_unique<queue[]>(opts.n_workers + 1);
+
+    for (size_type i = 0; i < opts.n_workers + 1; i++) {
+      _queues[i].reset(capacity);
+    }
+
+    _realtime = opts.realtime;
+    _pinned = opts.pin;
+
+    for (size_type i = 0; i < opts.n_workers; i++) {
+      _workers.emplace_back([this, i]() { run_worker(i + 1); });
+
+      if (opts.realtime) {
+        _realtime = detail::set_worker_thread_realtime(_workers.back().native_handle(), opts.priority) && _realtime;
+      }
+
+      if (opts.pin) {
+        const size_type cpu = (opts.first_cpu + i) % std::max<size_type>(std::thread::hardware_concurrency(), 1);
+        _pinned = detail::set_worker_thread_affinity(_workers.back().native_handle(), cpu) && _pinned;
+      }
+    }
+  }
+
+  audio_graph_executor(const audio_graph_executor&) = delete;
+  audio_graph_executor& operator=(const audio_graph_executor&) = delete;
+
+  inline ~audio_graph_executor() {
+    _stop.store(true, std::memory_order_release);
+    _generation.fetch_add(1, std::memory_order_release);
+    _generation.notify_all();
+
+    for (std::thread& t : _workers) {
+      t.join();
+    }
+  }
+
+  inline size_type worker_size() const noexcept { return _workers.size(); }
+
+  /// False if a worker couldn't get realtime scheduling or be pinned.
+  inline bool is_realtime() const noexcept { return _realtime; }
+  inline bool is_pinned() const noexcept { return _pinned; }
+
+  /// Can be read from any thread.
+  inline statistics get_statistics() const noexcept {
+    return statistics{ _callbacks.load(std::memory_order_relaxed), _fallback_callbacks.load(std::memory_order_relaxed),
+      _deadlines_at_risk.load(std::memory_order_relaxed), _stolen_steps.load(std::memory_order_relaxed),
+      std::chrono::nanoseconds(_last_time.load(std::memory_order_relaxed)),
+      std::chrono::nanoseconds(_peak_time.load(std::memory_order_relaxed)) };
+  }
+
+  /// Runs the program from the audio thread, only one thread at a time. A
+  /// zero deadline never falls back to single threaded processing.
+  inline void process(program_type& program, const audio_bus<const T>* inputs, audio_bus<T>* outputs,
+      size_type buffer_size, std::chrono::nanoseconds deadline) noexcept {
+    using clock = std::chrono::steady_clock;
+    mts_assert(buffer_size <= program.max_buffer_size(), "Invalid buffer size");
+
+    const clock::time_point start = clock::now();
+    const bool parallel = !_workers.empty() && program.step_size() > 1
+        && program.step_size() <= _queues[0].capacity() && _fallback_remaining == 0;
+
+    if (parallel) {
+      run_parallel(program, inputs, buffer_size);
+      program.process_outputs(inputs, outputs, buffer_size);
+    }
+    else {
+      program.process(inputs, outputs, buffer_size);
+    }
+
+    if (_fallback_remaining) {
+      _fallback_remaining--;
+      _fallback_callbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const clock::duration time = clock::now() - start;
+    if (parallel && deadline.count() && time > std::chrono::duration<double>(deadline) * _options.deadline_ratio) {
+      _fallback_remaining = _options.fallback_size;
+      _deadlines_at_risk.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const std::uint64_t ns = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+    _last_time.store(ns, std::memory_order_relaxed);
+    if (ns > _peak_time.load(std::memory_order_relaxed)) {
+      _peak_time.store(ns, std::memory_order_relaxed);
+    }
+
+    _callbacks.fetch_add(1, std::memory_order_relaxed);
+  }
+
+private:
+  // Chase-Lev work stealing deque of step indices. The owner pushes and pops
+  // at the bottom, the other threads steal at the top. It's emptied at every
+  // callback and a step is pushed once per callback so it never wraps around.
+  struct alignas(64) queue {
+    std::unique_ptr<std::atomic<std::uint32_t>[]> steps;
+    size_type mask = 0;
+    std::atomic<std::int64_t> top = 0;
+    std::atomic<std::int64_t> bottom = 0;
+
+    inline void reset(size_type capacity) {
+      steps = std::make_unique<std::atomic<std::uint32_t>[]>(capacity);
+      mask = capacity - 1;
+    }
+
+    inline size_type capacity() const noexcept { return mask + 1; }
+
+    inline void clear() noexcept {
+      top.store(0, std::memory_order_relaxed);
+      bottom.store(0, std::memory_order_relaxed);
+    }
+
+    inline void push(std::uint32_t step) noexcept {
+      const std::int64_t b = bottom.load(std::memory_order_relaxed);
+      steps[(size_type)b & mask].store(step, std::memory_order_relaxed);
+      bottom.store(b + 1, std::memory_order_release);
+    }
+
+    inline bool pop(std::uint32_t& step) noexcept {
+      const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+      bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::int64_t t = top.load(std::memory_order_relaxed);
+
+      if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+      }
+
+      step = steps[(size_type)b & mask].load(std::memory_order_relaxed);
+      if (t == b) {
+        // Last one, race against the thieves.
+        const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+      }
+
+      return true;
+    }
+
+    inline bool steal(std::uint32_t& step) noexcept {
+      std::int64_t t = top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const std::int64_t b = bottom.load(std::memory_order_acquire);
+
+      if (t >= b) {
+        return false;
+      }
+
+      step = steps[(size_type)t & mask].load(std::memory_order_relaxed);
+      return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+  };
+
+  options _options;
+  std::vector<std::thread> _workers;
+  std::unique_ptr<queue[]> _queues;
+  bool _realtime = false;
+  bool _pinned = false;
+
+  // Program of the current callback, only valid while _open is set.
+  program_type* _program = nullptr;
+  const audio_bus<const T>* _inputs = nullptr;
+  size_type _buffer_size = 0;
+
+  alignas(64) std::atomic<std::uint32_t> _generation = 0;
+  std::atomic<bool> _open = false;
+  std::atomic<bool> _stop = false;
+
+  // Workers inside the current callback.
+  alignas(64) std::atomic<size_type> _busy = 0;
+
+  // Steps left in the current callback.
+  alignas(64) std::atomic<size_type> _remaining = 0;
+
+  // Only used by the audio thread.
+  size_type _fallback_remaining = 0;
+
+  std::atomic<std::uint64_t> _callbacks = 0;
+  std::atomic<std::uint64_t> _fallback_callbacks = 0;
+  std::atomic<std::uint64_t> _deadlines_at_risk = 0;
+  std::atomic<std::uint64_t> _stolen_steps = 0;
+  std::atomic<std::uint64_t> _last_time = 0;
+  std::atomic<std::uint64_t> _peak_time = 0;
+
+  inline void run_parallel(program_type& program, const audio_bus<const T>* inputs, size_type buffer_size) noexcept {
+    const size_type n_queues = _workers.size() + 1;
+    for (size_type i = 0; i < n_queues; i++) {
+      _queues[i].clear();
+    }
+
+    // The steps without dependencies are spread over all the queues.
+    size_type n_ready = 0;
+    for (size_type s = 0; s < program.step_size(); s++) {
+      const size_type n = program._steps[s].dependency_size;
+      program._states[s].remaining.store(n, std::memory_order_relaxed);
+
+      if (n == 0) {
+        _queues[n_ready++ % n_queues].push((std::uint32_t)s);
+      }
+    }
+
+    _program = &program;
+    _inputs = inputs;
+    _buffer_size = buffer_size;
+    _remaining.store(program.step_size(), std::memory_order_relaxed);
+    _open.store(true, std::memory_order_seq_cst);
+
+    _generation.fetch_add(1, std::memory_order_release);
+    _generation.notify_all();
+
+    run_steps(0);
+
+    // Wait for the workers still looking for steps before the queues can be
+    // cleared again.
+    _open.store(false, std::memory_order_seq_cst);
+    while (_busy.load(std::memory_order_seq_cst)) {
+      MTS_NOP();
+    }
+  }
+
+  inline void run_steps(size_type index) noexcept {
+    program_type& program = *_program;
+    const size_type n_queues = _workers.size() + 1;
+    std::uint64_t n_stolen = 0;
+
+    while (_remaining.load(std::memory_order_acquire)) {
+      std::uint32_t s;
+      bool found = _queues[index].pop(s);
+
+      for (size_type i = 1; !found && i < n_queues; i++) {
+        found = _queues[(index + i) % n_queues].steal(s);
+      }
+
+      if (!found) {
+        MTS_NOP();
+        continue;
+      }
+
+      program.run_step(s, _inputs, _buffer_size);
+      n_stolen += index != 0;
+
+      const typename program_type::step& st = program._steps[s];
+      for (size_type i = 0; i < st.successor_size; i++) {
+        const size_type next = program._successors[st.first_successor + i];
+
+        if (program._states[next].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          _queues[index].push((std::uint32_t)next);
+        }
+      }
+
+      _remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    if (n_stolen) {
+      _stolen_steps.fetch_add(n_stolen, std::memory_order_relaxed);
+    }
+  }
+
+  // A worker can start after the first callbacks, it begins from the
+  // generation of the constructor instead of the current one.
+  inline void run_worker(size_type index) noexcept {
+    std::uint32_t generation = 0;
+
+    while (true) {
+      for (size_type i = 0; i < _options.spin_size && _generation.load(std::memory_order_acquire) == generation; i++) {
+        MTS_NOP();
+      }
+
+      _generation.wait(generation, std::memory_order_acquire);
+      generation = _generation.load(std::memory_order_acquire);
+
+      if (_stop.load(std::memory_order_acquire)) {
+        return;
+      }
+
+      // Only join a callback still open, a late worker leaves right away.
+      _busy.fetch_add(1, std::memory_order_seq_cst);
+      if (_open.load(std::memory_order_seq_cst)) {
+        run_steps(index);
+      }
+
+      _busy.fetch_sub(1, std::memory_order_release);
+    }
+  }
+};
+MTS_END_NAMESPACE
@@ -0,0 +1,422 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/audio/biquad.h"
+#include "mts/audio/buffer.h"
+#include "mts/audio/bus.h"
+#include "mts/audio/vector_operations.h"
+#include "mts/audio/detail/kaiser_filter.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+
+///
+/// Peak, true peak, rms and ITU-R BS.1770 loudness of n_channels.
+///
+/// The input is measured in blocks of 100 ms. At the end of every block, the
+/// values are published with atomics and can be read from any thread while
+/// process() runs on the audio thread:
+///   - momentary, short term and integrated loudness in LUFS, over 400 ms,
+///     3 s and since clear() (gated, with a 0.1 LU histogram),
+///   - peak and true peak (4x oversampled) of the last block, linear,
+///   - max true peak since clear(), linear,
+///   - rms over rms_window seconds, linear.
+///
+/// The K-weighting filters run on all channels at once with a biquad_bank. The
+/// true peak interpolates 4 phases of a 48 taps kaiser windowed sinc, each one
+/// computed over a whole block with vec::mul_sum.
+///
+/// Allocation only happens in reset().
+///
+template <typename T>
+class meter {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::meter only works with floating point value type.");
+  static_assert(std::atomic<T>::is_always_lock_free, "mts::meter needs lock free atomics.");
+
+  /// Frames filtered at once.
+  static constexpr size_type process_block_size = 256;
+
+  static constexpr size_type momentary_blocks = 4;
+  static constexpr size_type short_term_blocks = 30;
+  static constexpr size_type true_peak_factor = 4;
+  static constexpr size_type true_peak_phase_size = 12;
+
+  meter() noexcept = default;
+
+  inline meter(size_type n_channels, double sample_rate, double rms_window = 0.3) {
+    reset(n_channels, sample_rate, rms_window);
+  }
+
+  meter(const meter&) = delete;
+  meter& operator=(const meter&) = delete;
+
+  /// All channel weights are reset to 1.
+  inline void reset(size_type n_channels, double sample_rate, double rms_window = 0.3) {
+    mts_assert(n_channels > 0 && sample_rate > 0, "Invalid channel size or sample rate");
+    _n_channels = n_channels;
+    _sample_rate = sample_rate;
+    _block_size = std::max<size_type>(1, (size_type)std::llround(sample_rate * 0.1));
+    _rms_blocks = std::clamp<size_type>((size_type)std::llround(rms_window * 10), 1, short_term_blocks);
+
+    _k_weighting.reset(n_channels, 2);
+    _k_weighting.set_coefficients(0, k_weighting_shelf(sample_rate));
+    _k_weighting.set_coefficients(1, k_weighting_highpass(sample_rate));
+    design_true_peak_filter();
+
+    _weighted.reset(process_block_size, n_channels);
+    _history.reset(true_peak_phase_size - 1 + process_block_size, n_channels);
+    _phase_output.assign(process_block_size, T(0));
+    _inputs.resize(n_channels);
+
+    _weights.assign(n_channels, T(1));
+    _squares.assign(n_channels, 0.0);
+    _weighted_squares.assign(n_channels, 0.0);
+    _peaks.assign(n_channels, T(0));
+    _true_peaks.assign(n_channels, T(0));
+    _max_true_peaks.assign(n_channels, T(0));
+    _powers.assign(short_term_blocks, 0.0);
+    _channel_powers.assign(n_channels * short_term_blocks, 0.0);
+    _histogram_counts.assign(histogram_size, 0);
+    _histogram_powers.assign(histogram_size, 0.0);
+    _published = std::make_unique<channel_values[]>(n_channels);
+
+    clear();
+  }
+
+  /// Restarts the measurement, from the audio thread.
+  inline void clear() noexcept {
+    _k_weighting.clear();
+    _history.clear();
+    _position = 0;
+    _n_blocks = 0;
+
+    std::fill(_squares.begin(), _squares.end(), 0.0);
+    std::fill(_weighted_squares.begin(), _weighted_squares.end(), 0.0);
+    std::fill(_peaks.begin(), _peaks.end(), T(0));
+    std::fill(_true_peaks.begin(), _true_peaks.end(), T(0));
+    std::fill(_max_true_peaks.begin(), _max_true_peaks.end(), T(0));
+    std::fill(_powers.begin(), _powers.end(), 0.0);
+    std::fill(_channel_powers.begin(), _channel_powers.end(), 0.0);
+    std::fill(_histogram_counts.begin(), _histogram_counts.end(), 0);
+    std::fill(_histogram_powers.begin(), _histogram_powers.end(), 0.0);
+
+    _momentary.store(silence, std::memory_order_relaxed);
+    _short_term.store(silence, std::memory_order_relaxed);
+    _integrated.store(silence, std::memory_order_relaxed);
+
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      _published[ch].peak.store(T(0), std::memory_order_relaxed);
+      _published[ch].true_peak.store(T(0), std::memory_order_relaxed);
+      _published[ch].max_true_peak.store(T(0), std::memory_order_relaxed);
+      _published[ch].rms.store(T(0), std::memory_order_relaxed);
+    }
+
+    _update_count.fetch_add(1, std::memory_order_release);
+  }
+
+  inline size_type channel_size() const noexcept { return _n_channels; }
+  inline double sample_rate() const noexcept { return _sample_rate; }
+
+  /// Loudness weight of a channel, e.g. 1.41 for the surround channels and 0
+  /// for the lfe.
+  inline void set_channel_weight(size_type channel, value_type weight) noexcept {
+    mts_assert(channel < _n_channels, "Out of bounds channel");
+    _weights[channel] = weight;
+  }
+
+  inline value_type channel_weight(size_type channel) const noexcept { return _weights[channel]; }
+
+  inline void process(const audio_bus<const T>& input) noexcept {
+    mts_assert(input.channel_size() >= _n_channels, "Invalid channel size");
+
+    for (size_type i = 0; i < input.buffer_size();) {
+      const size_type n = std::min({ process_block_size, _block_size - _position, input.buffer_size() - i });
+
+      for (size_type ch = 0; ch < _n_channels; ch++) {
+        _inputs[ch] = input[ch] + i;
+      }
+
+      measure(n);
+      i += n;
+      _position += n;
+
+      if (_position == _block_size) {
+        end_block();
+      }
+    }
+  }
+
+  //
+  // Published values, any thread.
+  //
+
+  inline value_type momentary_loudness() const noexcept { return _momentary.load(std::memory_order_relaxed); }
+  inline value_type short_term_loudness() const noexcept { return _short_term.load(std::memory_order_relaxed); }
+  inline value_type integrated_loudness() const noexcept { return _integrated.load(std::memory_order_relaxed); }
+
+  inline value_type peak(size_type channel) const noexcept { return load(channel, &channel_values::peak); }
+  inline value_type true_peak(size_type channel) const noexcept { return load(channel, &channel_values::true_peak); }
+  inline value_type rms(size_type channel) const noexcept { return load(channel, &channel_values::rms); }
+
+  inline value_type max_true_peak(size_type channel) const noexcept {
+    return load(channel, &channel_values::max_true_peak);
+  }
+
+  /// Incremented after every publication.
+  inline std::uint64_t update_count() const noexcept { return _update_count.load(std::memory_order_acquire); }
+
+  /// Loudness in LUFS of a weighted mean square.
+  static inline value_type loudness(double power) noexcept {
+    return power > 0 ? (value_type)(-0.691 + 10 * std::log10(power)) : silence;
+  }
+
+  /// BS.1770 K-weighting pre-filter, a high shelf.
+  static inline biquad_coefficients<T> k_weighting_shelf(double sample_rate) noexcept {
+    const double k = std::tan(3.14159265358979323846 * 1681.974450955533 / sample_rate);
+    const double q = 0.7071752369554196;
+    const double vh = std::pow(10.0, 3.999843853973347 / 20);
+    const double vb = std::pow(vh, 0.4996667741545416);
+    const double a0 = 1 + k / q + k * k;
+    return biquad_coefficients<T>{ (T)((vh + vb * k / q + k * k) / a0), (T)(2 * (k * k - vh) / a0),
+      (T)((vh - vb * k / q + k * k) / a0), (T)(2 * (k * k - 1) / a0), (T)((1 - k / q + k * k) / a0) };
+  }
+
+  /// BS.1770 K-weighting rlb filter, a high pass.
+  static inline biquad_coefficients<T> k_weighting_highpass(double sample_rate) noexcept {
+    const double k = std::tan(3.14159265358979323846 * 38.13547087602444 / sample_rate);
+    const double q = 0.5003270373238773;
+    const double a0 = 1 + k / q + k * k;
+    return biquad_coefficients<T>{ T(1), T(-2), T(1), (T)(2 * (k * k - 1) / a0), (T)((1 - k / q + k * k) / a0) };
+  }
+
+private:
+  struct channel_values {
+    std::atomic<T> peak = T(0);
+    std::atomic<T> true_peak = T(0);
+    std::atomic<T> max_true_peak = T(0);
+    std::atomic<T> rms = T(0);
+  };
+
+  static constexpr value_type silence = -std::numeric_limits<value_type>::infinity();
+
+  // Gating blocks histogram, 0.1 LU bins from the absolute gate.
+  static constexpr double absolute_gate = -70;
+  static constexpr double relative_gate = -10;
+  static constexpr size_type histogram_size = 800;
+
+  size_type _n_channels = 0;
+  double _sample_rate = 0;
+  size_type _block_size = 0;
+  size_type _rms_blocks = 1;
+  size_type _position = 0;
+  size_type _n_blocks = 0;
+
+  biquad_bank<T> _k_weighting;
+  audio_buffer<T> _weighted;
+  std::vector<const T*> _inputs;
+
+  // true_peak_factor phases of true_peak_phase_size taps, and the last
+  // true_peak_phase_size - 1 input frames followed by the current block.
+  std::vector<T> _true_peak_filter;
+  audio_buffer<T> _history;
+  std::vector<T> _phase_output;
+
+  std::vector<T> _weights;
+  std::vector<double> _squares;
+  std::vector<double> _weighted_squares;
+  std::vector<T> _peaks;
+  std::vector<T> _true_peaks;
+  std::vector<T> _max_true_peaks;
+
+  // Weighted power of the last short_term_blocks blocks, and mean square per
+  // channel (n_channels * short_term_blocks), indexed by block % short_term_blocks.
+  std::vector<double> _powers;
+  std::vector<double> _channel_powers;
+
+  std::vector<std::uint64_t> _histogram_counts;
+  std::vector<double> _histogram_powers;
+
+  std::unique_ptr<channel_values[]> _published;
+  std::atomic<T> _momentary = silence;
+  std::atomic<T> _short_term = silence;
+  std::atomic<T> _integrated = silence;
+  std::atomic<std::uint64_t> _update_count = 0;
+
+  inline value_type load(size_type channel, std::atomic<T> channel_values::*value) const noexcept {
+    mts_assert(channel < _n_channels, "Out of bounds channel");
+    return (_published[channel].*value).load(std::memory_order_relaxed);
+  }
+
+  inline void measure(size_type n) noexcept {
+    const audio_bus<const T> input(_inputs.data(), n, _n_channels);
+    _k_weighting.process(input, audio_bus<T>(_weighted.data(), n, _n_channels));
+
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      _squares[ch] += (double)vec::sum_of_squares(_inputs[ch], 1, n);
+      _weighted_squares[ch] += (double)vec::sum_of_squares(_weighted[ch], 1, n);
+      _peaks[ch] = std::max(_peaks[ch], vec::max_abs(_inputs[ch], 1, n));
+    }
+
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      _true_peaks[ch] = std::max({ _true_peaks[ch], _peaks[ch], true_peak(ch, n) });
+    }
+  }
+
+  // max |y| of y[4 * i + p] = sum h[4 * k + p] * x[i - k].
+  inline value_type true_peak(size_type channel, size_type n) noexcept {
+    constexpr size_type h = true_peak_phase_size - 1;
+    T* x = _history[channel];
+    T* y = _phase_output.data();
+    std::copy_n(_inputs[channel], n, x + h);
+
+    value_type peak = 0;
+    for (size_type p = 0; p < true_peak_factor; p++) {
+      const T* taps = _true_peak_filter.data() + p * true_peak_phase_size;
+      vec::mul(x + h, 1, taps[0], y, 1, n);
+
+      for (size_type k = 1; k < true_peak_phase_size; k++) {
+        vec::mul_sum(x + h - k, 1, taps[k], y, 1, y, 1, n);
+      }
+
+      peak = std::max(peak, vec::max_abs(y, 1, n));
+    }
+
+    std::copy_n(x + n, h, x);
+    return peak;
+  }
+
+  // Phase p holds the taps 4 * k + p of a 48 taps kaiser windowed sinc.
+  inline void design_true_peak_filter() {
+    constexpr double factor = (double)true_peak_factor;
+    constexpr double center = (double)(true_peak_factor * true_peak_phase_size - 1) / 2;
+    _true_peak_filter.resize(true_peak_factor * true_peak_phase_size);
+    detail::design_kaiser_polyphase(_true_peak_filter.data(), true_peak_factor, true_peak_phase_size,
+        center / factor, -1.0 / factor, (center + 1) / factor, 0.9, 6.0);
+  }
+
+  inline void end_block() noexcept {
+    const size_type slot = _n_blocks % short_term_blocks;
+    _n_blocks++;
+    _position = 0;
+
+    double power = 0;
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      power += (double)_weights[ch] * _weighted_squares[ch] / (double)_block_size;
+      _channel_powers[ch * short_term_blocks + slot] = _squares[ch] / (double)_block_size;
+    }
+
+    _powers[slot] = power;
+
+    const double momentary = last_mean(_powers.data(), slot, momentary_blocks);
+    const double short_term = last_mean(_powers.data(), slot, short_term_blocks);
+
+    if (_n_blocks >= momentary_blocks && loudness(momentary) > absolute_gate) {
+      const size_type bin
+          = std::min(histogram_size - 1, (size_type)(((double)loudness(momentary) - absolute_gate) * 10));
+      _histogram_counts[bin]++;
+      _histogram_powers[bin] += momentary;
+    }
+
+    _momentary.store(loudness(momentary), std::memory_order_relaxed);
+    _short_term.store(loudness(short_term), std::memory_order_relaxed);
+    _integrated.store(integrated(), std::memory_order_relaxed);
+
+    for (size_type ch = 0; ch < _n_channels; ch++) {
+      _max_true_peaks[ch] = std::max(_max_true_peaks[ch], _true_peaks[ch]);
+
+      channel_values& v = _published[ch];
+      v.peak.store(_peaks[ch], std::memory_order_relaxed);
+      v.true_peak.store(_true_peaks[ch], std::memory_order_relaxed);
+      v.max_true_peak.store(_max_true_peaks[ch], std::memory_order_relaxed);
+      v.rms.store((T)std::sqrt(last_mean(_channel_powers.data() + ch * short_term_blocks, slot, _rms_blocks)),
+          std::memory_order_relaxed);
+
+      _squares[ch] = 0;
+      _weighted_squares[ch] = 0;
+      _peaks[ch] = 0;
+      _true_peaks[ch] = 0;
+    }
+
+    _update_count.fetch_add(1, std::memory_order_release);
+  }
+
+  /// Mean of the last n blocks ending at slot, blocks before the start count as silence.
+  static inline double last_mean(const double* values, size_type slot, size_type n) noexcept {
+    double sum = 0;
+    for (size_type k = 0; k < n; k++) {
+      sum += values[(slot + short_term_blocks - k) % short_term_blocks];
+    }
+
+    return sum / (double)n;
+  }
+
+  inline value_type integrated() const noexcept {
+    std::uint64_t count = 0;
+    double power = 0;
+    for (size_type b = 0; b < histogram_size; b++) {
+      count += _histogram_counts[b];
+      power += _histogram_powers[b];
+    }
+
+    if (count == 0) {
+      return silence;
+    }
+
+    const double gate = (double)loudness(power / (double)count) + relative_gate;
+    const size_type first = gate > absolute_gate ? (size_type)((gate - absolute_gate) * 10) : 0;
+
+    count = 0;
+    power = 0;
+    for (size_type b = std::min(first, histogram_size - 1); b < histogram_size; b++) {
+      count += _histogram_counts[b];
+      power += _histogram_powers[b];
+    }
+
+    return count ? loudness(power / (double)count) : silence;
+  }
+};
+MTS_END_NAMESPACE
@@ -0,0 +1,180 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/audio/bus.h"
+#include "mts/audio/vector_operations.h"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+
+///
+/// Mixes n_sources busses into n_destinations busses with a gain matrix.
+///
+/// Channel c of a (source, destination) pair goes from source channel
+/// c % source channels to destination channel c % destination channels for
+/// c < max(source channels, destination channels), a mono source is sent to
+/// every destination channel and a stereo source summed into a mono one.
+///
+/// The frames are processed in tiles so that every destination tile stays in
+/// cache while all the sources are accumulated into it with vec::mul_sum, and
+/// every source tile is read once for all its destinations. Zero gains are
+/// skipped and a destination without any source is cleared.
+///
+template <typename T>
+class mixer {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::mixer only works with floating point value type.");
+
+  /// Destination tiles are sized to fit in this many bytes.
+  static constexpr size_type default_cache_size = 32 * 1024;
+
+  mixer() noexcept = default;
+
+  inline mixer(size_type n_sources, size_type n_destinations) { reset(n_sources, n_destinations); }
+
+  /// All the gains are set to zero.
+  inline void reset(size_type n_sources, size_type n_destinations) {
+    _n_sources = n_sources;
+    _n_destinations = n_destinations;
+    _gains.assign(n_sources * n_destinations, T(0));
+    _written.assign(n_destinations, false);
+  }
+
+  inline size_type source_size() const noexcept { return _n_sources; }
+  inline size_type destination_size() const noexcept { return _n_destinations; }
+
+  inline void set_gain(size_type source, size_type destination, value_type gain) noexcept {
+    mts_assert(source < _n_sources && destination < _n_destinations, "Index out of bounds");
+    _gains[source * _n_destinations + destination] = gain;
+  }
+
+  inline value_type gain(size_type source, size_type destination) const noexcept {
+    mts_assert(source < _n_sources && destination < _n_destinations, "Index out of bounds");
+    return _gains[source * _n_destinations + destination];
+  }
+
+  inline void clear_gains() noexcept { std::fill(_gains.begin(), _gains.end(), T(0)); }
+
+  inline void set_cache_size(size_type n_bytes) noexcept { _cache_size = n_bytes; }
+  inline size_type cache_size() const noexcept { return _cache_size; }
+
+  /// Number of frames per tile for destinations with n_channels in total.
+  inline size_type tile_size(size_type n_channels) const noexcept {
+    const size_type n = _cache_size / (sizeof(value_type) * (n_channels + 1));
+    return std::max<size_type>(64, n / 16 * 16);
+  }
+
+  /// Overwrites the first buffer_size frames of every destination, sources
+  /// must have at least buffer_size frames.
+  inline void process(const audio_bus<const T>* sources, audio_bus<T>* destinations, size_type buffer_size) noexcept {
+    size_type n_channels = 0;
+    for (size_type d = 0; d < _n_destinations; d++) {
+      mts_assert(destinations[d].buffer_size() >= buffer_size, "Invalid destination size");
+      n_channels += destinations[d].channel_size();
+    }
+
+    const size_type tile = tile_size(n_channels);
+
+    for (size_type offset = 0; offset < buffer_size; offset += tile) {
+      const size_type n = std::min(tile, buffer_size - offset);
+      std::fill(_written.begin(), _written.end(), false);
+
+      for (size_type s = 0; s < _n_sources; s++) {
+        const audio_bus<const T>& src = sources[s];
+        mts_assert(src.buffer_size() >= buffer_size, "Invalid source size");
+        const value_type* gains = _gains.data() + s * _n_destinations;
+
+        // Busses without channels are skipped, a destination only fed by empty
+        // sources is cleared.
+        if (!src.channel_size()) {
+          continue;
+        }
+
+        for (size_type d = 0; d < _n_destinations; d++) {
+          if (gains[d] != 0 && destinations[d].channel_size()) {
+            accumulate(src, destinations[d], gains[d], offset, n, _written[d]);
+            _written[d] = true;
+          }
+        }
+      }
+
+      for (size_type d = 0; d < _n_destinations; d++) {
+        if (!_written[d]) {
+          for (size_type c = 0; c < destinations[d].channel_size(); c++) {
+            vec::clear(destinations[d][c] + offset, 1, n);
+          }
+        }
+      }
+    }
+  }
+
+  inline void process(const std::vector<audio_bus<const T>>& sources, std::vector<audio_bus<T>>& destinations,
+      size_type buffer_size) noexcept {
+    mts_assert(sources.size() == _n_sources && destinations.size() == _n_destinations, "Invalid bus count");
+    process(sources.data(), destinations.data(), buffer_size);
+  }
+
+private:
+  std::vector<value_type> _gains;
+  std::vector<bool> _written;
+  size_type _n_sources = 0;
+  size_type _n_destinations = 0;
+  size_type _cache_size = default_cache_size;
+
+  static inline void accumulate(const audio_bus<const T>& src, audio_bus<T>& dst, value_type gain, size_type offset,
+      size_type n, bool written) noexcept {
+    const size_type n_src = src.channel_size();
+    const size_type n_dst = dst.channel_size();
+
+    for (size_type c = 0; c < std::max(n_src, n_dst); c++) {
+      const value_type* s = src[c % n_src] + offset;
+      value_type* d = dst[c % n_dst] + offset;
+
+      if (written || c >= n_dst) {
+        vec::mul_sum(s, 1, gain, d, 1, d, 1, n);
+      }
+      else {
+        vec::mul(s, 1, gain, d, 1, n);
+      }
+    }
+  }
+};
+MTS_END_NAMESPACE
@@ -0,0 +1,348 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/audio/buffer.h"
+#include "mts/audio/bus.h"
+#include "mts/audio/vector_operations.h"
+#include "mts/audio/detail/kaiser_filter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+MTS_BEGIN_NAMESPACE
+
+enum class resampler_quality { low, medium, high };
+
+template <typename T>
+class resampler;
+
+template <typename T>
+inline audio_buffer<T> resample(const audio_bus<const T>& input, double source_rate, double target_rate,
+    resampler_quality quality = resampler_quality::high);
+
+///
+/// Streaming polyphase resampler with a kaiser windowed sinc.
+///
+/// When both rates are integers with a reduced ratio of at most max_exact_phases
+/// phases (e.g. 44100 to 48000), every output uses its exact phase. Any other
+/// ratio steps through a table of phases with a linear interpolation between
+/// the two closest ones. When downsampling, the filter gets longer so that the
+/// cutoff follows the target nyquist.
+///
+/// The stream starts with zeros, an output sample k is the input at
+/// k * source_rate / target_rate - latency().
+///
+/// Allocation only happens in reset().
+///
+template <typename T>
+class resampler {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::resampler only works with floating point value type.");
+
+  static constexpr size_type max_exact_phases = 1024;
+
+  /// Number of input frames buffered per channel on top of the filter size.
+  static constexpr size_type input_block_size = 512;
+
+  struct result {
+    size_type input_size;
+    size_type output_size;
+  };
+
+  resampler() noexcept = default;
+
+  inline resampler(size_type n_channels, double source_rate, double target_rate,
+      resampler_quality quality = resampler_quality::high) {
+    reset(n_channels, source_rate, target_rate, quality);
+  }
+
+  inline void reset(size_type n_channels, double source_rate, double target_rate,
+      resampler_quality quality = resampler_quality::high) {
+    mts_assert(source_rate > 0 && target_rate > 0, "Invalid sample rate");
+    _n_channels = n_channels;
+    _source_rate = source_rate;
+    _target_rate = target_rate;
+
+    const quality_settings q = get_quality_settings(quality);
+    const double ratio = source_rate / target_rate;
+
+    if (source_rate == std::floor(source_rate) && target_rate == std::floor(target_rate)
+        && (std::uint64_t)target_rate / std::gcd((std::uint64_t)source_rate, (std::uint64_t)target_rate)
+            <= max_exact_phases) {
+      const std::uint64_t g = std::gcd((std::uint64_t)source_rate, (std::uint64_t)target_rate);
+      _exact = true;
+      _denominator = (std::uint64_t)target_rate / g;
+      _step = (std::uint64_t)source_rate / g;
+      _n_phases = (size_type)_denominator;
+    }
+    else {
+      _exact = false;
+      _denominator = std::uint64_t(1) << 32;
+      _step = (std::uint64_t)std::llround(ratio * (double)_denominator);
+      _n_phases = q.interpolated_phases;
+    }
+
+    _half_size = (size_type)std::ceil((double)q.half_size * std::max(1.0, ratio));
+    _filter_size = 2 * _half_size;
+    _capacity = _filter_size + input_block_size;
+    _buffer.assign(n_channels * _capacity, T(0));
+
+    design_filter(q.cutoff * std::min(1.0, 1.0 / ratio), q.beta);
+    clear();
+  }
+
+  /// Restarts the stream with zeros.
+  inline void clear() noexcept { restart(_filter_size - 1); }
+
+  inline size_type channel_size() const noexcept { return _n_channels; }
+  inline double source_rate() const noexcept { return _source_rate; }
+  inline double target_rate() const noexcept { return _target_rate; }
+  inline size_type filter_size() const noexcept { return _filter_size; }
+
+  /// Delay in input frames.
+  inline size_type latency() const noexcept { return _half_size; }
+
+  /// Number of input frames needed for the next output_size frames.
+  inline size_type input_size(size_type output_size) const noexcept {
+    if (output_size == 0) {
+      return 0;
+    }
+
+    const size_type last = _index + (size_type)((_phase + (output_size - 1) * _step) / _denominator);
+    return last + _filter_size > _fill ? last + _filter_size - _fill : 0;
+  }
+
+  /// Number of output frames available after input_size more input frames.
+  inline size_type output_size(size_type input_size) const noexcept {
+    const size_type fill = _fill + input_size;
+    if (_index + _filter_size > fill) {
+      return 0;
+    }
+
+    // Outputs k with index + (phase + k * step) / denominator <= fill - filter_size.
+    const std::uint64_t room = (std::uint64_t)(fill - _filter_size - _index + 1) * _denominator;
+    return room > _phase ? (size_type)((room - _phase - 1) / _step + 1) : 0;
+  }
+
+  /// Consumes as much of the input and writes as many output frames as possible,
+  /// output may not be input.
+  inline result process(const audio_bus<const T>& input, audio_bus<T> output) noexcept {
+    mts_assert(input.channel_size() >= _n_channels && output.channel_size() >= _n_channels, "Invalid channel size");
+    return process_channels(input.data(), input.buffer_size(), output.data(), output.buffer_size());
+  }
+
+  /// Single channel resampler only.
+  inline result process(wire<const T> input, wire<T> output) noexcept {
+    mts_assert(_n_channels == 1, "Invalid channel size");
+    const T* in = input.data();
+    T* out = output.data();
+    return process_channels(&in, input.size(), &out, output.size());
+  }
+
+private:
+  struct quality_settings {
+    size_type half_size;
+    size_type interpolated_phases;
+    double cutoff;
+    double beta;
+  };
+
+  size_type _n_channels = 0;
+  double _source_rate = 0;
+  double _target_rate = 0;
+  bool _exact = true;
+  std::uint64_t _denominator = 1;
+  std::uint64_t _step = 1;
+  size_type _n_phases = 1;
+  size_type _half_size = 0;
+  size_type _filter_size = 0;
+  size_type _capacity = 0;
+
+  // Position of the next output: the window start in the buffer and its phase in [0, denominator).
+  size_type _index = 0;
+  std::uint64_t _phase = 0;
+  size_type _fill = 0;
+
+  // (n_phases + 1) * filter_size, the last phase is the first one shifted by a sample.
+  std::vector<T> _filter;
+
+  // n_channels * capacity.
+  std::vector<T> _buffer;
+
+  friend audio_buffer<T> resample<T>(const audio_bus<const T>&, double, double, resampler_quality);
+
+  static inline quality_settings get_quality_settings(resampler_quality quality) noexcept {
+    switch (quality) {
+    case resampler_quality::low:
+      return { 8, 128, 0.85, 6.0 };
+    case resampler_quality::medium:
+      return { 16, 256, 0.91, 8.0 };
+    case resampler_quality::high:
+      return { 32, 512, 0.95, 10.0 };
+    }
+
+    return { 32, 512, 0.95, 10.0 };
+  }
+
+  /// The last phase is the first one shifted by a sample.
+  inline void design_filter(double cutoff, double beta) {
+    const double half = (double)_half_size;
+    _filter.assign((_n_phases + 1) * _filter_size, T(0));
+    detail::design_kaiser_polyphase(
+        _filter.data(), _n_phases + 1, _filter_size, half - 1, 1.0 / (double)_n_phases, half, cutoff, beta);
+  }
+
+  inline void restart(size_type n_zeros) noexcept {
+    std::fill(_buffer.begin(), _buffer.end(), T(0));
+    _index = 0;
+    _phase = 0;
+    _fill = n_zeros;
+  }
+
+  inline T interpolate(const T* x, std::uint64_t phase) const noexcept {
+    const std::uint64_t scaled = phase * _n_phases;
+    const size_type p = (size_type)(scaled / _denominator);
+    const T* h = _filter.data() + p * _filter_size;
+    const T y0 = vec::dot(x, 1, h, 1, _filter_size);
+
+    if (_exact) {
+      return y0;
+    }
+
+    const T w = (T)((double)(scaled % _denominator) / (double)_denominator);
+    const T y1 = vec::dot(x, 1, h + _filter_size, 1, _filter_size);
+    return y0 + w * (y1 - y0);
+  }
+
+  inline result process_channels(
+      const T* const* input, size_type input_size, T* const* output, size_type output_size) noexcept {
+    result r{ 0, 0 };
+
+    for (;;) {
+      // Outputs whose window is in the buffer.
+      const size_type n = std::min(output_size - r.output_size, this->output_size(0));
+
+      if (n) {
+        for (size_type ch = 0; ch < _n_channels; ch++) {
+          const T* x = _buffer.data() + ch * _capacity;
+          T* y = output[ch] + r.output_size;
+          size_type index = _index;
+          std::uint64_t phase = _phase;
+
+          for (size_type k = 0; k < n; k++) {
+            y[k] = interpolate(x + index, phase);
+            phase += _step;
+            index += (size_type)(phase / _denominator);
+            phase %= _denominator;
+          }
+        }
+
+        const std::uint64_t phase = _phase + n * _step;
+        _index += (size_type)(phase / _denominator);
+        _phase = phase % _denominator;
+        r.output_size += n;
+      }
+
+      if (r.output_size == output_size || r.input_size == input_size) {
+        return r;
+      }
+
+      // Drops the frames before the next window, which may start past the buffered ones.
+      const size_type drop = std::min(_index, _fill);
+      const size_type skip = std::min(_index - drop, input_size - r.input_size);
+
+      for (size_type ch = 0; ch < _n_channels; ch++) {
+        T* x = _buffer.data() + ch * _capacity;
+        std::copy(x + drop, x + _fill, x);
+      }
+
+      _fill -= drop;
+      _index -= drop + skip;
+      r.input_size += skip;
+
+      const size_type m = std::min(input_size - r.input_size, _capacity - _fill);
+
+      for (size_type ch = 0; ch < _n_channels; ch++) {
+        std::copy_n(input[ch] + r.input_size, m, _buffer.data() + ch * _capacity + _fill);
+      }
+
+      _fill += m;
+      r.input_size += m;
+    }
+  }
+};
+
+///
+/// Resamples a whole signal without latency, the output has
+/// ceil(input size * target_rate / source_rate) frames.
+///
+template <typename T>
+inline audio_buffer<T> resample(
+    const audio_bus<const T>& input, double source_rate, double target_rate, resampler_quality quality) {
+  using size_type = std::size_t;
+  const size_type n_channels = input.channel_size();
+
+  resampler<T> r(n_channels, source_rate, target_rate, quality);
+  r.restart(r._half_size - 1);
+
+  const size_type output_size = r._exact
+      ? (size_type)((input.buffer_size() * r._denominator + r._step - 1) / r._step)
+      : (size_type)std::ceil((double)input.buffer_size() * target_rate / source_rate);
+
+  audio_buffer<T> output(output_size, n_channels);
+  size_type written = r.process(input, output).output_size;
+
+  // The last outputs need half a filter of zeros past the input.
+  audio_buffer<T> zeros(r.filter_size(), n_channels);
+  std::vector<T*> outputs(n_channels);
+
+  while (written < output_size) {
+    for (size_type ch = 0; ch < n_channels; ch++) {
+      outputs[ch] = output[ch] + written;
+    }
+
+    written += r.process(zeros, audio_bus<T>(outputs.data(), output_size - written, n_channels)).output_size;
+  }
+
+  return output;
+}
+MTS_END_NAMESPACE
@@ -0,0 +1,205 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/math.h"
+#include "mts/audio/buffer.h"
+#include "mts/audio/bus.h"
+#include "mts/audio/vector_operations.h"
+#include <algorithm>
+#include <atomic>
+
+MTS_BEGIN_NAMESPACE
+
+///
+/// Single producer single consumer ring buffer of planar audio.
+///
+/// write() is only called from the producer thread and read() from the
+/// consumer one, both are wait free and never allocate. Each channel is
+/// copied in at most two vec::copy calls when the frames wrap around.
+///
+/// The capacity is rounded up to a power of two and the channels are
+/// allocated by the audio buffer allocator, so a policy locking the buffers
+/// keeps the ring resident.
+///
+/// reset() is not thread safe, neither thread may use the ring buffer
+/// meanwhile.
+///
+template <typename T>
+class audio_ring_buffer {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static_assert(
+      std::is_floating_point_v<value_type>, "mts::audio_ring_buffer only works with floating point value type.");
+
+  audio_ring_buffer() noexcept = default;
+
+  inline audio_ring_buffer(size_type capacity, size_type channel_size) { reset(capacity, channel_size); }
+
+  inline audio_ring_buffer(size_type capacity, size_type channel_size, const buffer_allocation_policy& policy) {
+    reset(capacity, channel_size, policy);
+  }
+
+  audio_ring_buffer(const audio_ring_buffer&) = delete;
+  audio_ring_buffer(audio_ring_buffer&&) = delete;
+
+  ~audio_ring_buffer() = default;
+
+  audio_ring_buffer& operator=(const audio_ring_buffer&) = delete;
+  audio_ring_buffer& operator=(audio_ring_buffer&&) = delete;
+
+  inline void reset(size_type capacity, size_type channel_size) {
+    reset(capacity, channel_size, get_default_buffer_allocation_policy());
+  }
+
+  /// The ring buffer is left empty if the allocation fails.
+  inline void reset(size_type capacity, size_type channel_size, const buffer_allocation_policy& policy) {
+    const size_type size = capacity ? math::round_to_power_of_two(capacity) : 0;
+    _buffer.reset(size, channel_size, policy);
+    _mask = _buffer.is_valid() ? size - 1 : 0;
+
+    _write_index.store(0, std::memory_order_relaxed);
+    _read_index.store(0, std::memory_order_relaxed);
+    _producer_read_index = 0;
+    _consumer_write_index = 0;
+  }
+
+  inline bool is_valid() const noexcept { return _buffer.is_valid(); }
+
+  inline size_type capacity() const noexcept { return _buffer.buffer_size(); }
+  inline size_type channel_size() const noexcept { return _buffer.channel_size(); }
+
+  /// Frames that can be read, exact from the consumer thread and a lower
+  /// bound from the producer one.
+  inline size_type read_available() const noexcept {
+    return _write_index.load(std::memory_order_acquire) - _read_index.load(std::memory_order_relaxed);
+  }
+
+  /// Frames that can be written, exact from the producer thread and a lower
+  /// bound from the consumer one.
+  inline size_type write_available() const noexcept {
+    return capacity() - (_write_index.load(std::memory_order_relaxed) - _read_index.load(std::memory_order_acquire));
+  }
+
+  /// Fill level between 0 and 1.
+  inline double fill_ratio() const noexcept { return capacity() ? (double)read_available() / (double)capacity() : 0.0; }
+
+  /// Writes as many frames of bus as there is room for and returns their
+  /// number. The bus must have at least channel_size() channels.
+  inline size_type write(const audio_bus<const T>& bus) noexcept {
+    mts_assert(bus.channel_size() >= channel_size(), "Invalid channel size");
+
+    const size_type write_index = _write_index.load(std::memory_order_relaxed);
+
+    // The read index is only reloaded when the cached one says it's full.
+    size_type available = capacity() - (write_index - _producer_read_index);
+    if (available < bus.buffer_size()) {
+      _producer_read_index = _read_index.load(std::memory_order_acquire);
+      available = capacity() - (write_index - _producer_read_index);
+    }
+
+    const size_type frames = std::min(available, bus.buffer_size());
+    const size_type offset = write_index & _mask;
+    const size_type head = std::min(frames, capacity() - offset);
+
+    for (size_type c = 0; c < channel_size(); c++) {
+      vec::copy(bus[c], 1, _buffer[c] + offset, 1, head);
+
+      if (head < frames) {
+        vec::copy(bus[c] + head, 1, _buffer[c], 1, frames - head);
+      }
+    }
+
+    _write_index.store(write_index + frames, std::memory_order_release);
+    return frames;
+  }
+
+  /// Reads as many frames as are available into bus and returns their
+  /// number, the remaining frames of bus are left untouched. The bus must
+  /// have at least channel_size() channels.
+  inline size_type read(audio_bus<T> bus) noexcept {
+    mts_assert(bus.channel_size() >= channel_size(), "Invalid channel size");
+
+    const size_type read_index = _read_index.load(std::memory_order_relaxed);
+
+    size_type available = _consumer_write_index - read_index;
+    if (available < bus.buffer_size()) {
+      _consumer_write_index = _write_index.load(std::memory_order_acquire);
+      available = _consumer_write_index - read_index;
+    }
+
+    const size_type frames = std::min(available, bus.buffer_size());
+    const size_type offset = read_index & _mask;
+    const size_type head = std::min(frames, capacity() - offset);
+
+    for (size_type c = 0; c < channel_size(); c++) {
+      vec::copy(_buffer[c] + offset, 1, bus[c], 1, head);
+
+      if (head < frames) {
+        vec::copy(_buffer[c], 1, bus[c] + head, 1, frames - head);
+      }
+    }
+
+    _read_index.store(read_index + frames, std::memory_order_release);
+    return frames;
+  }
+
+  /// Drops up to frames frames from the consumer thread and returns their
+  /// number.
+  inline size_type skip(size_type frames) noexcept {
+    const size_type read_index = _read_index.load(std::memory_order_relaxed);
+    _consumer_write_index = _write_index.load(std::memory_order_acquire);
+    frames = std::min(frames, _consumer_write_index - read_index);
+    _read_index.store(read_index + frames, std::memory_order_release);
+    return frames;
+  }
+
+private:
+  // Each index is written by a single thread, they live on their own cache
+  // line with the copy of the other index cached by that thread.
+  static constexpr size_type cache_line_size = 64;
+
+  audio_buffer<T> _buffer;
+  size_type _mask = 0;
+
+  alignas(cache_line_size) std::atomic<size_type> _write_index = 0;
+  size_type _producer_read_index = 0;
+
+  alignas(cache_line_size) std::atomic<size_type> _read_index = 0;
+  size_type _consumer_write_index = 0;
+};
+MTS_END_NAMESPACE
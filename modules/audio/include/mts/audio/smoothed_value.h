@@ -0,0 +1,191 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/assert.h"
+#include "mts/audio/wire.h"
+#include "mts/audio/vector_operations.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+MTS_BEGIN_NAMESPACE
+
+enum class smoothing_type { linear, exponential };
+
+///
+/// Parameter value moving to its target over smoothing_size() samples.
+///
+/// The block methods apply the ramp with the vec ramp operations and the
+/// remaining samples with the target. Value i of a block matches the value
+/// next() would return on the i-th call up to rounding: next() accumulates
+/// the step sample by sample while the ramps compute each value from its
+/// index. Both land exactly on the target at the end of the ramp.
+///
+/// An exponential ramp needs a current and target value of the same sign,
+/// any other ramp is linear.
+///
+template <typename T, smoothing_type Type = smoothing_type::linear>
+class smoothed_value {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static_assert(std::is_floating_point_v<value_type>, "mts::smoothed_value only works with floating point value type.");
+
+  smoothed_value() noexcept = default;
+
+  inline smoothed_value(value_type value, size_type smoothing_size = 0) noexcept
+      : _current(value)
+      , _target(value)
+      , _smoothing_size(smoothing_size) {}
+
+  /// Jumps to value.
+  inline void reset(value_type value) noexcept {
+    _current = value;
+    _target = value;
+    _remaining = 0;
+  }
+
+  /// Applies to the next set_target().
+  inline void set_smoothing(size_type n_samples) noexcept { _smoothing_size = n_samples; }
+  inline size_type smoothing_size() const noexcept { return _smoothing_size; }
+
+  inline void set_target(value_type target) noexcept {
+    _target = target;
+
+    if (_smoothing_size == 0 || target == _current) {
+      reset(target);
+      return;
+    }
+
+    _remaining = _smoothing_size;
+    _exponential = Type == smoothing_type::exponential && _current * target > 0;
+    _step = _exponential ? (value_type)std::pow((double)target / (double)_current, 1.0 / (double)_remaining)
+                         : (target - _current) / (value_type)_remaining;
+  }
+
+  inline value_type current() const noexcept { return _current; }
+  inline value_type target() const noexcept { return _target; }
+  inline bool is_smoothing() const noexcept { return _remaining != 0; }
+
+  inline value_type next() noexcept {
+    if (_remaining) {
+      _current = --_remaining ? (_exponential ? _current * _step : _current + _step) : _target;
+    }
+
+    return _current;
+  }
+
+  inline void skip(size_type n) noexcept { advance(std::min(n, _remaining)); }
+
+  // output[i] = value
+  inline void fill(wire<T> output) noexcept {
+    const size_type n = ramp_size(output.size());
+
+    if (_exponential) {
+      vec::exp_ramp(output.data(), 1, _current * _step, _step, n);
+    }
+    else {
+      vec::ramp(output.data(), 1, _current + _step, _step, n);
+    }
+
+    advance(n);
+    vec::fill(output.data() + n, 1, _current, output.size() - n);
+  }
+
+  // data[i] *= value
+  inline void apply(wire<T> data) noexcept { apply(wire<const T>(data), data); }
+
+  // output[i] = input[i] * value, output may be input.
+  inline void apply(wire<const T> input, wire<T> output) noexcept {
+    mts_assert(input.size() >= output.size(), "Invalid wire size");
+    const size_type n = ramp_size(output.size());
+
+    if (_exponential) {
+      vec::mul_exp_ramp(input.data(), 1, _current * _step, _step, output.data(), 1, n);
+    }
+    else {
+      vec::mul_ramp(input.data(), 1, _current + _step, _step, output.data(), 1, n);
+    }
+
+    advance(n);
+    vec::mul(input.data() + n, 1, _current, output.data() + n, 1, output.size() - n);
+  }
+
+  // output[i] += input[i] * value
+  inline void apply_add(wire<const T> input, wire<T> output) noexcept {
+    mts_assert(input.size() >= output.size(), "Invalid wire size");
+    const size_type n = ramp_size(output.size());
+
+    if (_exponential) {
+      vec::mul_exp_ramp_add(input.data(), 1, _current * _step, _step, output.data(), 1, output.data(), 1, n);
+    }
+    else {
+      vec::mul_ramp_add(input.data(), 1, _current + _step, _step, output.data(), 1, output.data(), 1, n);
+    }
+
+    advance(n);
+    vec::mul_sum(input.data() + n, 1, _current, output.data() + n, 1, output.data() + n, 1, output.size() - n);
+  }
+
+private:
+  value_type _current = 0;
+  value_type _target = 0;
+  value_type _step = 0;
+  size_type _smoothing_size = 0;
+  size_type _remaining = 0;
+  bool _exponential = false;
+
+  inline size_type ramp_size(size_type size) const noexcept { return std::min(size, _remaining); }
+
+  inline void advance(size_type n) noexcept {
+    if (n == 0) {
+      return;
+    }
+
+    _remaining -= n;
+
+    if (_remaining == 0) {
+      _current = _target;
+    }
+    else if (_exponential) {
+      _current *= (value_type)std::pow((double)_step, (double)n);
+    }
+    else {
+      _current += (value_type)n * _step;
+    }
+  }
+};
+MTS_END_NAMESPACE
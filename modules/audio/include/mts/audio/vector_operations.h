@@ -35,15 +35,43 @@
 #include "mts/config.h"
 #include "mts/traits.h"
 #include "mts/audio/detail/vector_operations_vdsp.h"
+#include "mts/audio/detail/vector_operations_simd.h"
+#include "mts/audio/detail/vector_operations_approx.h"
+#include "mts/audio/detail/vector_operations_fixed.h"
 
 MTS_BEGIN_SUB_NAMESPACE(vec)
 struct optimized_op {};
 struct default_op {};
 
+/// optimized_op with sin, cos, tan and tanh approximated to about 1e-6 (see approx_ops).
+struct approx_op {};
+
+/// optimized_op with sin, cos, tan and tanh approximated to about 1e-3 (see fast_approx_ops).
+struct fast_approx_op {};
+
 namespace detail {
 template <typename O>
-using op = std::conditional_t<std::is_same_v<O, optimized_op>,
-    std::conditional_t<mts::is_defined_v<ops_type>, ops_type, base_ops>, base_ops>;
+struct op_selector {
+  using type = base_ops;
+};
+
+template <>
+struct op_selector<optimized_op> {
+  using type = optimized_ops;
+};
+
+template <>
+struct op_selector<approx_op> {
+  using type = approx_ops;
+};
+
+template <>
+struct op_selector<fast_approx_op> {
+  using type = fast_approx_ops;
+};
+
+template <typename O>
+using op = typename op_selector<O>::type;
 } // namespace detail.
 
 template <typename O = optimized_op, typename T>
@@ -96,6 +124,129 @@ inline void vdiv(T value, const T* s1, stride_t s_s1, T* d1, stride_t s_d1, leng
   detail::op<O>::vdiv(value, s1, s_s1, d1, s_d1, length);
 }
 
+template <typename O = optimized_op, typename T>
+inline void sum(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::sum(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void sub(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::sub(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void mul(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::mul(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void div(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::div(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void sum_mul(
+    const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T value, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::sum_mul(s1, s_s1, s2, s_s2, value, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void sum_mul(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, const T* s3, stride_t s_s3, T* d1,
+    stride_t s_d1, length_t length) {
+  detail::op<O>::sum_mul(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void sum_mul(
+    const T* s1, stride_t s_s1, T value, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::sum_mul(s1, s_s1, value, s2, s_s2, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void mul_sum(
+    const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T value, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::mul_sum(s1, s_s1, s2, s_s2, value, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void mul_sum(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, const T* s3, stride_t s_s3, T* d1,
+    stride_t s_d1, length_t length) {
+  detail::op<O>::mul_sum(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void mul_sum(
+    const T* s1, stride_t s_s1, T value, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::mul_sum(s1, s_s1, value, s2, s_s2, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void ramp(T* d1, stride_t s_d1, T start, T increment, length_t length) {
+  detail::op<O>::ramp(d1, s_d1, start, increment, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void mul_ramp(const T* s1, stride_t s_s1, T start, T increment, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::mul_ramp(s1, s_s1, start, increment, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void mul_ramp_add(const T* s1, stride_t s_s1, T start, T increment, const T* s2, stride_t s_s2, T* d1,
+    stride_t s_d1, length_t length) {
+  detail::op<O>::mul_ramp_add(s1, s_s1, start, increment, s2, s_s2, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void exp_ramp(T* d1, stride_t s_d1, T start, T ratio, length_t length) {
+  detail::op<O>::exp_ramp(d1, s_d1, start, ratio, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void mul_exp_ramp(const T* s1, stride_t s_s1, T start, T ratio, T* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::mul_exp_ramp(s1, s_s1, start, ratio, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void mul_exp_ramp_add(const T* s1, stride_t s_s1, T start, T ratio, const T* s2, stride_t s_s2, T* d1,
+    stride_t s_d1, length_t length) {
+  detail::op<O>::mul_exp_ramp_add(s1, s_s1, start, ratio, s2, s_s2, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+MTS_NODISCARD inline T sum(const T* s1, stride_t s_s1, length_t length) {
+  return detail::op<O>::sum(s1, s_s1, length);
+}
+
+template <typename O = optimized_op, typename T>
+MTS_NODISCARD inline T sum_of_squares(const T* s1, stride_t s_s1, length_t length) {
+  return detail::op<O>::sum_of_squares(s1, s_s1, length);
+}
+
+template <typename O = optimized_op, typename T>
+MTS_NODISCARD inline T rms(const T* s1, stride_t s_s1, length_t length) {
+  return detail::op<O>::rms(s1, s_s1, length);
+}
+
+template <typename O = optimized_op, typename T>
+MTS_NODISCARD inline T max_abs(const T* s1, stride_t s_s1, length_t length) {
+  return detail::op<O>::max_abs(s1, s_s1, length);
+}
+
+template <typename O = optimized_op, typename T>
+MTS_NODISCARD inline indexed_value<T> min_index(const T* s1, stride_t s_s1, length_t length) {
+  return detail::op<O>::min_index(s1, s_s1, length);
+}
+
+template <typename O = optimized_op, typename T>
+MTS_NODISCARD inline indexed_value<T> max_index(const T* s1, stride_t s_s1, length_t length) {
+  return detail::op<O>::max_index(s1, s_s1, length);
+}
+
+template <typename O = optimized_op, typename T>
+MTS_NODISCARD inline T dot(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, length_t length) {
+  return detail::op<O>::dot(s1, s_s1, s2, s_s2, length);
+}
+
 template <typename O = optimized_op, typename T>
 inline void sqrt(const T* s1, T* d1, length_t length) {
   detail::op<O>::sqrt(s1, d1, length);
@@ -150,4 +301,99 @@ template <typename O = optimized_op, typename T>
 inline void convert_from_double(const double* input, stride_t input_stride, T* output, length_t size) {
   detail::op<O>::convert_from_double(input, input_stride, output, size);
 }
+
+template <typename O = optimized_op, typename T>
+inline void deinterleave_from_int8(
+    const std::int8_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+  detail::op<O>::deinterleave_from_int8(s1, s_s1, d, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void deinterleave_from_int16(
+    const std::int16_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+  detail::op<O>::deinterleave_from_int16(s1, s_s1, d, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void deinterleave_from_int24(
+    const mts::int24_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+  detail::op<O>::deinterleave_from_int24(s1, s_s1, d, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void deinterleave_from_int32(
+    const std::int32_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+  detail::op<O>::deinterleave_from_int32(s1, s_s1, d, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void deinterleave_from_float(const float* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+  detail::op<O>::deinterleave_from_float(s1, s_s1, d, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void deinterleave_from_double(
+    const double* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length) {
+  detail::op<O>::deinterleave_from_double(s1, s_s1, d, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void interleave_from_float(const float* const* s, T* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  detail::op<O>::interleave_from_float(s, d1, s_d1, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void interleave_from_double(const double* const* s, T* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  detail::op<O>::interleave_from_double(s, d1, s_d1, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void convert_to_int8(const T* s1, stride_t s_s1, std::int8_t* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::convert_to_int8(s1, s_s1, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void convert_to_int16(const T* s1, stride_t s_s1, std::int16_t* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::convert_to_int16(s1, s_s1, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void convert_to_int24(const T* s1, stride_t s_s1, mts::int24_t* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::convert_to_int24(s1, s_s1, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void convert_to_int32(const T* s1, stride_t s_s1, std::int32_t* d1, stride_t s_d1, length_t length) {
+  detail::op<O>::convert_to_int32(s1, s_s1, d1, s_d1, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void interleave_to_int8(
+    const T* const* s, std::int8_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  detail::op<O>::interleave_to_int8(s, d1, s_d1, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void interleave_to_int16(
+    const T* const* s, std::int16_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  detail::op<O>::interleave_to_int16(s, d1, s_d1, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void interleave_to_int24(
+    const T* const* s, mts::int24_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  detail::op<O>::interleave_to_int24(s, d1, s_d1, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void interleave_to_int32(
+    const T* const* s, std::int32_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  detail::op<O>::interleave_to_int32(s, d1, s_d1, n_channels, length);
+}
+
+template <typename O = optimized_op, typename T>
+inline void biquad(const T* const* s, T* const* d, length_t n_channels, length_t length, const T* c, T* z,
+    length_t n_stages) {
+  detail::op<O>::biquad(s, d, n_channels, length, c, z, n_stages);
+}
 MTS_END_SUB_NAMESPACE(vec)
@@ -347,6 +347,209 @@ private:
   pointer _buffer = nullptr;
   size_type _size = 0;
 };
+
+//
+// Expressions.
+//
+// Arithmetic operators on wires build a lazy expression tree which is evaluated
+// in a single loop when assigned to a wire (see wire::operator=).
+//
+template <class E>
+struct wire_expression {};
+
+template <class _Tp>
+struct is_wire_expression : public std::is_base_of<wire_expression<_Tp>, _Tp> {};
+
+template <class _Tp, std::size_t _Extent>
+std::true_type is_wire_base_derived_impl(const wire_base<_Tp, _Extent>*);
+std::false_type is_wire_base_derived_impl(const void*);
+
+template <class _Tp>
+using is_wire_base_derived = decltype(is_wire_base_derived_impl(std::declval<const _Tp*>()));
+
+template <class _Tp>
+inline constexpr bool is_wire_operand_v = is_wire_base_derived<_Tp>::value || is_wire_expression<_Tp>::value;
+
+/// The static extent of an expression is the smallest static extent of its operands,
+/// or wire_dynamic_extent if they are all dynamic.
+inline constexpr std::size_t wire_expression_extent(std::size_t a, std::size_t b) noexcept {
+  return a < b ? a : b;
+}
+
+template <typename T, std::size_t Extent>
+class wire_terminal : public wire_expression<wire_terminal<T, Extent>> {
+public:
+  using value_type = std::remove_cv_t<T>;
+  static constexpr std::size_t extent = Extent;
+
+  inline wire_terminal(const wire_base<T, Extent>& w) noexcept
+      : _data(w.data())
+      , _size(w.size()) {}
+
+  inline value_type operator[](std::size_t index) const noexcept { return _data[index]; }
+  inline std::size_t size() const noexcept { return _size; }
+
+private:
+  const value_type* _data;
+  std::size_t _size;
+};
+
+/// A scalar operand, it has no size of its own.
+template <typename T>
+class wire_scalar : public wire_expression<wire_scalar<T>> {
+public:
+  using value_type = T;
+  static constexpr std::size_t extent = wire_dynamic_extent;
+
+  inline wire_scalar(value_type value) noexcept
+      : _value(value) {}
+
+  inline value_type operator[](std::size_t) const noexcept { return _value; }
+  inline std::size_t size() const noexcept { return wire_dynamic_extent; }
+
+private:
+  value_type _value;
+};
+
+template <class Op, class E>
+class wire_unary_expression : public wire_expression<wire_unary_expression<Op, E>> {
+public:
+  using value_type = typename E::value_type;
+  static constexpr std::size_t extent = E::extent;
+
+  inline wire_unary_expression(const E& e) noexcept
+      : _e(e) {}
+
+  inline value_type operator[](std::size_t index) const noexcept { return Op::apply(_e[index]); }
+  inline std::size_t size() const noexcept { return _e.size(); }
+
+private:
+  E _e;
+};
+
+template <class Op, class L, class R>
+class wire_binary_expression : public wire_expression<wire_binary_expression<Op, L, R>> {
+public:
+  using value_type = std::common_type_t<typename L::value_type, typename R::value_type>;
+  static constexpr std::size_t extent = wire_expression_extent(L::extent, R::extent);
+
+  inline wire_binary_expression(const L& lhs, const R& rhs) noexcept
+      : _lhs(lhs)
+      , _rhs(rhs) {
+    mts_assert(_lhs.size() >= size() && _rhs.size() >= size(), "Expression operand size out of bounds");
+  }
+
+  inline value_type operator[](std::size_t index) const noexcept { return Op::apply(_lhs[index], _rhs[index]); }
+
+  inline std::size_t size() const noexcept {
+    if constexpr (extent != wire_dynamic_extent) {
+      return extent;
+    }
+    else {
+      return mts::minimum(_lhs.size(), _rhs.size());
+    }
+  }
+
+private:
+  L _lhs;
+  R _rhs;
+};
+
+struct wire_plus {
+  template <typename A, typename B>
+  static inline auto apply(A a, B b) noexcept {
+    return a + b;
+  }
+};
+
+struct wire_minus {
+  template <typename A, typename B>
+  static inline auto apply(A a, B b) noexcept {
+    return a - b;
+  }
+};
+
+struct wire_multiplies {
+  template <typename A, typename B>
+  static inline auto apply(A a, B b) noexcept {
+    return a * b;
+  }
+};
+
+struct wire_divides {
+  template <typename A, typename B>
+  static inline auto apply(A a, B b) noexcept {
+    return a / b;
+  }
+};
+
+struct wire_negate {
+  template <typename A>
+  static inline A apply(A a) noexcept {
+    return -a;
+  }
+};
+
+template <class _Tp>
+struct wire_operand_value_type {
+  using type = typename _Tp::value_type;
+};
+
+/// Wires become terminals, scalars are converted to the value type of the other operand.
+template <typename T, class _Tp>
+inline auto make_wire_operand(const _Tp& x) noexcept {
+  if constexpr (is_wire_expression<_Tp>::value) {
+    return x;
+  }
+  else if constexpr (is_wire_base_derived<_Tp>::value) {
+    return wire_terminal<typename _Tp::element_type, _Tp::extent>(x);
+  }
+  else {
+    return wire_scalar<T>((T)x);
+  }
+}
+
+template <class Op, class L, class R>
+inline auto make_wire_expression(const L& lhs, const R& rhs) noexcept {
+  using value_type = typename std::conditional_t<is_wire_operand_v<L>, wire_operand_value_type<L>,
+      wire_operand_value_type<R>>::type;
+
+  auto l = make_wire_operand<value_type>(lhs);
+  auto r = make_wire_operand<value_type>(rhs);
+  return wire_binary_expression<Op, decltype(l), decltype(r)>(l, r);
+}
+
+template <class L, class R>
+using enable_if_wire_operands_t
+    = std::enable_if_t<(is_wire_operand_v<L> && (is_wire_operand_v<R> || std::is_arithmetic_v<R>))
+            || (std::is_arithmetic_v<L> && is_wire_operand_v<R>),
+        std::nullptr_t>;
+
+template <class L, class R, enable_if_wire_operands_t<L, R> = nullptr>
+inline auto operator+(const L& lhs, const R& rhs) noexcept {
+  return make_wire_expression<wire_plus>(lhs, rhs);
+}
+
+template <class L, class R, enable_if_wire_operands_t<L, R> = nullptr>
+inline auto operator-(const L& lhs, const R& rhs) noexcept {
+  return make_wire_expression<wire_minus>(lhs, rhs);
+}
+
+template <class L, class R, enable_if_wire_operands_t<L, R> = nullptr>
+inline auto operator*(const L& lhs, const R& rhs) noexcept {
+  return make_wire_expression<wire_multiplies>(lhs, rhs);
+}
+
+template <class L, class R, enable_if_wire_operands_t<L, R> = nullptr>
+inline auto operator/(const L& lhs, const R& rhs) noexcept {
+  return make_wire_expression<wire_divides>(lhs, rhs);
+}
+
+template <class E, std::enable_if_t<is_wire_operand_v<E>, std::nullptr_t> = nullptr>
+inline auto operator-(const E& e) noexcept {
+  auto x = make_wire_operand<typename E::value_type>(e);
+  return wire_unary_expression<wire_negate, decltype(x)>(x);
+}
 } // namespace detail.
 
 template <typename T, std::size_t Extent = wire_dynamic_extent>
@@ -373,6 +576,16 @@ private:
   using enable_if_convertible_t
       = std::enable_if_t<std::is_convertible_v<OtherElementType (*)[], element_type (*)[]>, std::nullptr_t>;
 
+  // Fixed extents up to vec::fixed_ops_max_extent use the unrolled vec::fixed_ops kernels.
+  static constexpr bool is_fixed = extent <= vec::fixed_ops_max_extent;
+  using fixed = vec::fixed_ops<is_fixed ? extent : 0>;
+
+  // The unchecked fixed_ops kernels are only used with inputs of a static extent covering this one,
+  // other inputs go through op_size().
+  template <std::size_t... OtherSizes>
+  static constexpr bool is_fixed_with
+      = is_fixed && ((OtherSizes != wire_dynamic_extent && OtherSizes >= extent) && ...);
+
   template <class OtherElementType>
   using enable_if_const_convertible_t
       = std::enable_if_t<std::is_convertible_v<const OtherElementType (*)[], const element_type (*)[]>, std::nullptr_t>;
@@ -441,7 +654,12 @@ public:
 
   template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
   inline void clear() noexcept {
-    vec::clear(data(), 1, size());
+    if constexpr (is_fixed) {
+      fixed::clear(data());
+    }
+    else {
+      vec::clear(data(), 1, size());
+    }
   }
 
   template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
@@ -459,7 +677,12 @@ public:
 
   template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
   inline void fill(value_type value) noexcept {
-    vec::fill(data(), 1, value, size());
+    if constexpr (is_fixed) {
+      fixed::fill(data(), value);
+    }
+    else {
+      vec::fill(data(), 1, value, size());
+    }
   }
 
   template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
@@ -491,34 +714,81 @@ public:
         "");
 
     mts_assert(input.size() <= size(), "copy() size out of bounds");
-    vec::copy(input.data(), 1, data(), 1, mts::minimum(size(), input.size()));
+
+    if constexpr (extent != wire_dynamic_extent && OtherSize <= vec::fixed_ops_max_extent) {
+      vec::fixed_ops<OtherSize>::copy(input.data(), data());
+    }
+    else {
+      vec::copy(input.data(), 1, data(), 1, mts::minimum(size(), input.size()));
+    }
+  }
+
+  //
+  // Expressions.
+  //
+
+  // wire[i] = e[i]
+  // Evaluated in a single pass without temporaries. Assigning a wire rebinds it instead, use copy() for that.
+  // Element i of the expression may only alias element i of this wire.
+  template <class E, bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& operator=(const detail::wire_expression<E>& e) noexcept {
+    evaluate(static_cast<const E&>(e), [](value_type, value_type x) { return x; });
+    return *this;
+  }
+
+  // wire[i] += e[i]
+  template <class E, bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& operator+=(const detail::wire_expression<E>& e) noexcept {
+    evaluate(static_cast<const E&>(e), [](value_type d, value_type x) { return d + x; });
+    return *this;
+  }
+
+  // wire[i] -= e[i]
+  template <class E, bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& operator-=(const detail::wire_expression<E>& e) noexcept {
+    evaluate(static_cast<const E&>(e), [](value_type d, value_type x) { return d - x; });
+    return *this;
+  }
+
+  // wire[i] *= e[i]
+  template <class E, bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& operator*=(const detail::wire_expression<E>& e) noexcept {
+    evaluate(static_cast<const E&>(e), [](value_type d, value_type x) { return d * x; });
+    return *this;
+  }
+
+  // wire[i] /= e[i]
+  template <class E, bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& operator/=(const detail::wire_expression<E>& e) noexcept {
+    evaluate(static_cast<const E&>(e), [](value_type d, value_type x) { return d / x; });
+    return *this;
   }
 
   //
   // Convert.
   //
   inline wire& assign_from_int16(const std::int16_t* input, std::size_t input_stride = 1) {
-    vec::convert_from_int16<value_type>(input, input_stride, data(), size());
+    vec::convert_from_int16(input, (vec::stride_t)input_stride, data(), size());
     return *this;
   }
 
   inline wire& assign_from_int24(const mts::int24_t* input, std::size_t input_stride = 1) {
-    vec::convert_from_int24<value_type>(input, input_stride, data(), size());
+    vec::convert_from_int24(input, (vec::stride_t)input_stride, data(), size());
     return *this;
   }
 
   inline wire& assign_from_int32(const std::int32_t* input, std::size_t input_stride = 1) {
-    vec::convert_from_int32<value_type>(input, input_stride, data(), size());
+    vec::convert_from_int32(input, (vec::stride_t)input_stride, data(), size());
     return *this;
   }
 
   inline wire& assign_from_float(const float* input, std::size_t input_stride = 1) {
-    vec::convert_from_float<value_type>(input, input_stride, data(), size());
+    vec::convert_from_float(input, (vec::stride_t)input_stride, data(), size());
     return *this;
   }
 
   inline wire& assign_from_double(const double* input, std::size_t input_stride = 1) {
-    vec::convert_from_double<value_type>(input, input_stride, data(), size());
+    vec::convert_from_double(input, (vec::stride_t)input_stride, data(), size());
     return *this;
   }
 
@@ -554,13 +824,361 @@ public:
   }
   // wire[i] *= value
   inline wire& operator*=(value_type value) noexcept {
-    vec::mul(data(), 1, value, data(), 1, size());
+    if constexpr (is_fixed) {
+      fixed::mul(data(), value, data());
+    }
+    else {
+      vec::mul(data(), 1, value, data(), 1, size());
+    }
     //      vec::mul_value_with_vector(data(), data(), value, size());
     //        for (std::size_t i = 0; i < size(); i++) {
     //          data()[i] *= value;
     //        }
     return *this;
   }
+
+  // wire[i] /= value
+  template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& operator/=(value_type value) noexcept {
+    if constexpr (is_fixed) {
+      fixed::div(data(), value, data());
+    }
+    else {
+      vec::div(data(), 1, value, data(), 1, size());
+    }
+    return *this;
+  }
+
+  // wire[i] += value
+  template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& operator+=(value_type value) noexcept {
+    if constexpr (is_fixed) {
+      fixed::add(data(), value, data());
+    }
+    else {
+      vec::add(data(), 1, value, data(), 1, size());
+    }
+    return *this;
+  }
+
+  // wire[i] -= value
+  template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& operator-=(value_type value) noexcept {
+    if constexpr (is_fixed) {
+      fixed::add(data(), -value, data());
+    }
+    else {
+      vec::add(data(), 1, -value, data(), 1, size());
+    }
+    return *this;
+  }
+
+  // wire[i] += input[i]
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& operator+=(const detail::wire_base<U, OtherSize>& input) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::sum(data(), input.data(), data());
+    }
+    else {
+      vec::sum(data(), 1, input.data(), 1, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  // wire[i] -= input[i]
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& operator-=(const detail::wire_base<U, OtherSize>& input) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::sub(data(), input.data(), data());
+    }
+    else {
+      vec::sub(data(), 1, input.data(), 1, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  // wire[i] *= input[i]
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& operator*=(const detail::wire_base<U, OtherSize>& input) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::mul(data(), input.data(), data());
+    }
+    else {
+      vec::mul(data(), 1, input.data(), 1, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  // wire[i] /= input[i]
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& operator/=(const detail::wire_base<U, OtherSize>& input) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::div(data(), input.data(), data());
+    }
+    else {
+      vec::div(data(), 1, input.data(), 1, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  //
+  // Fused operations.
+  //
+
+  // wire[i] += input[i] * gain
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& add_scaled(const detail::wire_base<U, OtherSize>& input, value_type gain) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::mul_sum(input.data(), gain, data(), data());
+    }
+    else {
+      vec::mul_sum(input.data(), 1, gain, data(), 1, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  // wire[i] = (wire[i] + input[i]) * value
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& add_mul(const detail::wire_base<U, OtherSize>& input, value_type value) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::sum_mul(data(), input.data(), value, data());
+    }
+    else {
+      vec::sum_mul(data(), 1, input.data(), 1, value, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  // wire[i] = (wire[i] + input1[i]) * input2[i]
+  template <class U1, std::size_t OtherSize1, class U2, std::size_t OtherSize2, bool _Dummy = true,
+      class = enable_if_writable<_Dummy>, enable_if_const_convertible_t<U1> = nullptr,
+      enable_if_const_convertible_t<U2> = nullptr>
+  inline wire& add_mul(
+      const detail::wire_base<U1, OtherSize1>& input1, const detail::wire_base<U2, OtherSize2>& input2) noexcept {
+    if constexpr (is_fixed_with<OtherSize1, OtherSize2>) {
+      fixed::sum_mul(data(), input1.data(), input2.data(), data());
+    }
+    else {
+      vec::sum_mul(data(), 1, input1.data(), 1, input2.data(), 1, data(), 1, op_size(input1, input2));
+    }
+    return *this;
+  }
+
+  // wire[i] = (wire[i] + value) * input[i]
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& add_mul(value_type value, const detail::wire_base<U, OtherSize>& input) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::sum_mul(data(), value, input.data(), data());
+    }
+    else {
+      vec::sum_mul(data(), 1, value, input.data(), 1, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  // wire[i] = wire[i] * input[i] + value
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& mul_add(const detail::wire_base<U, OtherSize>& input, value_type value) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::mul_sum(data(), input.data(), value, data());
+    }
+    else {
+      vec::mul_sum(data(), 1, input.data(), 1, value, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  // wire[i] = wire[i] * input1[i] + input2[i]
+  template <class U1, std::size_t OtherSize1, class U2, std::size_t OtherSize2, bool _Dummy = true,
+      class = enable_if_writable<_Dummy>, enable_if_const_convertible_t<U1> = nullptr,
+      enable_if_const_convertible_t<U2> = nullptr>
+  inline wire& mul_add(
+      const detail::wire_base<U1, OtherSize1>& input1, const detail::wire_base<U2, OtherSize2>& input2) noexcept {
+    if constexpr (is_fixed_with<OtherSize1, OtherSize2>) {
+      fixed::mul_sum(data(), input1.data(), input2.data(), data());
+    }
+    else {
+      vec::mul_sum(data(), 1, input1.data(), 1, input2.data(), 1, data(), 1, op_size(input1, input2));
+    }
+    return *this;
+  }
+
+  // wire[i] = wire[i] * value + input[i]
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& mul_add(value_type value, const detail::wire_base<U, OtherSize>& input) noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      fixed::mul_sum(data(), value, input.data(), data());
+    }
+    else {
+      vec::mul_sum(data(), 1, value, input.data(), 1, data(), 1, op_size(input));
+    }
+    return *this;
+  }
+
+  //
+  // Ramps.
+  //
+
+  // wire[i] = start + i * increment
+  template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& ramp(value_type start, value_type increment) noexcept {
+    vec::ramp(data(), 1, start, increment, size());
+    return *this;
+  }
+
+  // wire[i] = start * ratio^i
+  template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& exp_ramp(value_type start, value_type ratio) noexcept {
+    vec::exp_ramp(data(), 1, start, ratio, size());
+    return *this;
+  }
+
+  // wire[i] *= start + i * increment
+  template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& mul_ramp(value_type start, value_type increment) noexcept {
+    vec::mul_ramp(data(), 1, start, increment, data(), 1, size());
+    return *this;
+  }
+
+  // wire[i] *= start * ratio^i
+  template <bool _Dummy = true, class = enable_if_writable<_Dummy>>
+  inline wire& mul_exp_ramp(value_type start, value_type ratio) noexcept {
+    vec::mul_exp_ramp(data(), 1, start, ratio, data(), 1, size());
+    return *this;
+  }
+
+  // wire[i] = wire[i] * (start + i * increment) + input[i]
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& mul_ramp_add(
+      value_type start, value_type increment, const detail::wire_base<U, OtherSize>& input) noexcept {
+    vec::mul_ramp_add(data(), 1, start, increment, input.data(), 1, data(), 1, op_size(input));
+    return *this;
+  }
+
+  // wire[i] = wire[i] * start * ratio^i + input[i]
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& mul_exp_ramp_add(
+      value_type start, value_type ratio, const detail::wire_base<U, OtherSize>& input) noexcept {
+    vec::mul_exp_ramp_add(data(), 1, start, ratio, input.data(), 1, data(), 1, op_size(input));
+    return *this;
+  }
+
+  // wire[i] += input[i] * (start + i * increment)
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& add_ramped(
+      const detail::wire_base<U, OtherSize>& input, value_type start, value_type increment) noexcept {
+    vec::mul_ramp_add(input.data(), 1, start, increment, data(), 1, data(), 1, op_size(input));
+    return *this;
+  }
+
+  // wire[i] += input[i] * start * ratio^i
+  template <class U, std::size_t OtherSize, bool _Dummy = true, class = enable_if_writable<_Dummy>,
+      enable_if_const_convertible_t<U> = nullptr>
+  inline wire& add_exp_ramped(
+      const detail::wire_base<U, OtherSize>& input, value_type start, value_type ratio) noexcept {
+    vec::mul_exp_ramp_add(input.data(), 1, start, ratio, data(), 1, data(), 1, op_size(input));
+    return *this;
+  }
+
+  //
+  // Reductions.
+  //
+
+  MTS_NODISCARD inline value_type sum() const noexcept {
+    if constexpr (is_fixed) {
+      return fixed::sum(data());
+    }
+    else {
+      return vec::sum(data(), 1, size());
+    }
+  }
+
+  MTS_NODISCARD inline value_type sum_of_squares() const noexcept {
+    if constexpr (is_fixed) {
+      return fixed::sum_of_squares(data());
+    }
+    else {
+      return vec::sum_of_squares(data(), 1, size());
+    }
+  }
+
+  MTS_NODISCARD inline value_type rms() const noexcept {
+    if constexpr (is_fixed) {
+      return fixed::rms(data());
+    }
+    else {
+      return vec::rms(data(), 1, size());
+    }
+  }
+
+  MTS_NODISCARD inline value_type max_abs() const noexcept {
+    if constexpr (is_fixed) {
+      return fixed::max_abs(data());
+    }
+    else {
+      return vec::max_abs(data(), 1, size());
+    }
+  }
+
+  MTS_NODISCARD inline vec::indexed_value<value_type> min_index() const noexcept {
+    return vec::min_index(data(), 1, size());
+  }
+
+  MTS_NODISCARD inline vec::indexed_value<value_type> max_index() const noexcept {
+    return vec::max_index(data(), 1, size());
+  }
+
+  // sum(wire[i] * input[i])
+  template <class U, std::size_t OtherSize, enable_if_const_convertible_t<U> = nullptr>
+  MTS_NODISCARD inline value_type dot(const detail::wire_base<U, OtherSize>& input) const noexcept {
+    if constexpr (is_fixed_with<OtherSize>) {
+      return fixed::dot(data(), input.data());
+    }
+    else {
+      return vec::dot(data(), 1, input.data(), 1, op_size(input));
+    }
+  }
+
+private:
+  template <class E, class Fct>
+  inline void evaluate(const E& e, Fct fct) noexcept {
+    if constexpr (extent != wire_dynamic_extent && E::extent != wire_dynamic_extent) {
+      static_assert(E::extent >= extent, "Expression extent out of bounds");
+    }
+
+    mts_assert(e.size() >= size(), "expression size out of bounds");
+    value_type* d = data();
+
+    if constexpr (extent != wire_dynamic_extent) {
+      for (size_type i = 0; i < extent; i++) {
+        d[i] = fct(d[i], (value_type)e[i]);
+      }
+    }
+    else {
+      const size_type n = size();
+      for (size_type i = 0; i < n; i++) {
+        d[i] = fct(d[i], (value_type)e[i]);
+      }
+    }
+  }
+
+  template <class... Inputs>
+  inline size_type op_size(const Inputs&... inputs) const noexcept {
+    mts_assert(((inputs.size() >= size()) && ...), "input size out of bounds");
+    return mts::minimum(size(), inputs.size()...);
+  }
 };
 
 MTS_END_NAMESPACE
@@ -1,33 +1,199 @@
 #include "mts/audio/detail/buffer_allocator.h"
 #include "mts/assert.h"
 #include "mts/memory.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#if __MTS_UNISTD__
+  #include <sys/mman.h>
+#endif // __MTS_UNISTD__
 
 MTS_BEGIN_NAMESPACE
+namespace {
+std::mutex default_policy_mutex;
+buffer_allocation_policy default_policy;
+
+std::atomic<std::size_t> locked_bytes = 0;
+std::atomic<std::size_t> huge_page_bytes = 0;
+std::atomic<std::size_t> lock_failures = 0;
+std::atomic<std::size_t> huge_page_failures = 0;
+} // namespace.
+
+void set_default_buffer_allocation_policy(const buffer_allocation_policy& policy) {
+  std::scoped_lock lock(default_policy_mutex);
+  default_policy = policy;
+}
+
+buffer_allocation_policy get_default_buffer_allocation_policy() {
+  std::scoped_lock lock(default_policy_mutex);
+  return default_policy;
+}
+
+buffer_allocation_statistics get_buffer_allocation_statistics() {
+  return buffer_allocation_statistics{ locked_bytes.load(), huge_page_bytes.load(), lock_failures.load(),
+    huge_page_failures.load() };
+}
+
+buffer_layout get_buffer_layout(
+    std::size_t buffer_size, std::size_t channel_size, std::size_t value_size, const buffer_allocation_policy& policy) {
+  const std::size_t cache_size = memory::get_cache_size();
+  const std::size_t channel_buffer_size = buffer_size * value_size;
+  const std::size_t channel_stride
+      = (channel_buffer_size + cache_size - 1) / cache_size * cache_size + policy.channel_stagger * cache_size;
+
+  return buffer_layout{ cache_size, channel_stride, channel_stride - channel_buffer_size,
+    channel_size * sizeof(void*) + channel_size * channel_stride + cache_size - 1 };
+}
+
 namespace detail {
 namespace {
+  // Every allocation starts with a header telling how to release it, the
+  // pointer table follows.
+  struct allocation_header {
+    // Mapped size, 0 when allocated with memory::malloc.
+    std::size_t size;
+    bool locked;
+    bool huge_pages;
+  };
+
+  inline constexpr std::size_t header_size
+      = (sizeof(allocation_header) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+  inline constexpr std::size_t reserved_huge_page_size = 2 * 1024 * 1024;
+
+  inline std::size_t round_up(std::size_t size, std::size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  void* allocate_bytes(std::size_t size, const buffer_allocation_policy& policy) {
+    allocation_header header = { 0, false, false };
+    std::size_t total_size = header_size + size;
+    void* bytes = nullptr;
+
+#if __MTS_UNISTD__
+    const bool huge_pages = policy.huge_pages != huge_page_mode::none && size >= policy.huge_page_threshold;
+
+    if (policy.lock || huge_pages) {
+      const int prot = PROT_READ | PROT_WRITE;
+      const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+  #if __MTS_LINUX__
+      if (huge_pages && policy.huge_pages == huge_page_mode::reserved) {
+        const std::size_t map_size = round_up(total_size, reserved_huge_page_size);
+        void* ptr = mmap(nullptr, map_size, prot, flags | MAP_HUGETLB, -1, 0);
+
+        if (ptr != MAP_FAILED) {
+          bytes = ptr;
+          header.size = map_size;
+          header.huge_pages = true;
+        }
+      }
+  #endif // __MTS_LINUX__
+
+      if (!bytes) {
+        const std::size_t map_size = round_up(total_size, memory::get_page_size());
+        void* ptr = mmap(nullptr, map_size, prot, flags, -1, 0);
+
+        if (ptr == MAP_FAILED) {
+          return nullptr;
+        }
+
+        bytes = ptr;
+        header.size = map_size;
+
+  #if __MTS_LINUX__
+        header.huge_pages = huge_pages && madvise(ptr, map_size, MADV_HUGEPAGE) == 0;
+  #endif // __MTS_LINUX__
+      }
+
+      total_size = header.size;
+
+      if (huge_pages && header.huge_pages) {
+        huge_page_bytes += total_size;
+      }
+      else if (huge_pages) {
+        huge_page_failures++;
+      }
+
+      if (policy.lock && mlock(bytes, total_size) == 0) {
+        header.locked = true;
+        locked_bytes += total_size;
+      }
+      else if (policy.lock) {
+        lock_failures++;
+      }
+    }
+#else
+    if (policy.lock) {
+      lock_failures++;
+    }
+
+    if (policy.huge_pages != huge_page_mode::none && size >= policy.huge_page_threshold) {
+      huge_page_failures++;
+    }
+#endif // __MTS_UNISTD__
+
+    if (!bytes) {
+      bytes = memory::malloc(total_size);
+
+      if (bytes == nullptr) {
+        return nullptr;
+      }
+    }
+
+    // A locked mapping is already resident.
+    if (policy.prefault && !header.locked) {
+      std::memset(bytes, 0, total_size);
+    }
+
+    std::memcpy(bytes, &header, sizeof(allocation_header));
+    return static_cast<std::uint8_t*>(bytes) + header_size;
+  }
+
+  void deallocate_bytes(void* ptr) {
+    void* bytes = static_cast<std::uint8_t*>(ptr) - header_size;
+
+    allocation_header header;
+    std::memcpy(&header, bytes, sizeof(allocation_header));
+
+    if (!header.size) {
+      memory::free(bytes);
+      return;
+    }
+
+#if __MTS_UNISTD__
+    if (header.locked) {
+      munlock(bytes, header.size);
+      locked_bytes -= header.size;
+    }
+
+    if (header.huge_pages) {
+      huge_page_bytes -= header.size;
+    }
+
+    munmap(bytes, header.size);
+#endif // __MTS_UNISTD__
+  }
+
   template <typename T>
   void __deallocate_buffer(T* const* buffers) {
     if (buffers) {
-      memory::free((void*)buffers);
+      deallocate_bytes((void*)buffers);
     }
   }
 
   template <typename T>
-  T** __allocate_buffer(std::size_t buffer_size, std::size_t channel_size) {
+  T** __allocate_buffer(std::size_t buffer_size, std::size_t channel_size, const buffer_allocation_policy& policy) {
 
     if (!buffer_size || !channel_size) {
       return nullptr;
     }
 
-    const std::size_t cache_size = memory::get_cache_size();
+    const buffer_layout layout = get_buffer_layout(buffer_size, channel_size, sizeof(T), policy);
 
-    const std::size_t buffer_ptr_size = channel_size * sizeof(T*);
-    const std::size_t channel_buffer_size = buffer_size * sizeof(T);
-
-    const std::size_t total_buffer_size = channel_size * channel_buffer_size + channel_size * (cache_size - 1);
-    const std::size_t total_size = buffer_ptr_size + total_buffer_size;
-
-    void* bytes = memory::malloc(total_size);
+    void* bytes = allocate_bytes(layout.size, policy);
 
     if (bytes == nullptr) {
       return nullptr;
@@ -35,32 +201,27 @@ namespace {
 
     T** buffers = (T**)bytes;
 
-    void* raw_ptr = ((std::uint8_t*)bytes) + buffer_ptr_size;
-    const std::uint8_t* raw_ptr_end = static_cast<std::uint8_t*>(raw_ptr) + total_buffer_size;
-
-    std::size_t space = total_buffer_size;
-
-    for (std::size_t i = 0; i < channel_size; i++) {
-      void* ptr = std::align(cache_size, channel_buffer_size, raw_ptr, space);
-
-      mts_assert(ptr != nullptr, "Can't align buffer with cache size.");
+    void* raw_ptr = ((std::uint8_t*)bytes) + channel_size * sizeof(T*);
+    std::size_t space = layout.size - channel_size * sizeof(T*);
+    void* ptr = std::align(layout.cache_size, layout.channel_stride * channel_size, raw_ptr, space);
 
-      if (ptr == nullptr) {
-        __deallocate_buffer(buffers);
-        return nullptr;
-      }
+    mts_assert(ptr != nullptr, "Can't align buffer with cache size.");
 
-      buffers[i] = static_cast<T*>(ptr);
+    if (ptr == nullptr) {
+      __deallocate_buffer(buffers);
+      return nullptr;
+    }
 
-      raw_ptr = static_cast<std::uint8_t*>(ptr) + channel_buffer_size;
-      space = raw_ptr_end - static_cast<std::uint8_t*>(static_cast<void*>(buffers[i]));
+    for (std::size_t i = 0; i < channel_size; i++) {
+      buffers[i] = reinterpret_cast<T*>(static_cast<std::uint8_t*>(ptr) + i * layout.channel_stride);
     }
 
     return buffers;
   }
 
   template <typename T>
-  T** __allocate_interleaved_buffer(std::size_t buffer_size, std::size_t channel_size) {
+  T** __allocate_interleaved_buffer(
+      std::size_t buffer_size, std::size_t channel_size, const buffer_allocation_policy& policy) {
 
     if (!buffer_size || !channel_size) {
       return nullptr;
@@ -72,7 +233,7 @@ namespace {
     const std::size_t total_buffer_size = channel_size * buffer_size * sizeof(T) + cache_size - 1;
     const std::size_t total_size = buffer_ptr_size + total_buffer_size;
 
-    void* bytes = memory::malloc(total_size);
+    void* bytes = allocate_bytes(total_size, policy);
 
     if (bytes == nullptr) {
       return nullptr;
@@ -95,31 +256,44 @@ namespace {
 
     return buffers;
   }
+
+  template <typename T>
+  T** __allocate(std::size_t buffer_size, std::size_t channel_size, const buffer_allocation_policy* policy,
+      bool interleaved) {
+    const buffer_allocation_policy p = policy ? *policy : get_default_buffer_allocation_policy();
+    return interleaved ? __allocate_interleaved_buffer<T>(buffer_size, channel_size, p)
+                       : __allocate_buffer<T>(buffer_size, channel_size, p);
+  }
 } // namespace.
 
-void allocate_audio_buffer(float* const*& buffers, std::size_t buffer_size, std::size_t channel_size) {
-  buffers = __allocate_buffer<float>(buffer_size, channel_size);
+void allocate_audio_buffer(float* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy) {
+  buffers = __allocate<float>(buffer_size, channel_size, policy, false);
 }
 
-void allocate_audio_buffer(double* const*& buffers, std::size_t buffer_size, std::size_t channel_size) {
-  buffers = __allocate_buffer<double>(buffer_size, channel_size);
+void allocate_audio_buffer(double* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy) {
+  buffers = __allocate<double>(buffer_size, channel_size, policy, false);
 }
 
-void allocate_audio_buffer(long double* const*& buffers, std::size_t buffer_size, std::size_t channel_size) {
-  buffers = __allocate_buffer<long double>(buffer_size, channel_size);
+void allocate_audio_buffer(long double* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy) {
+  buffers = __allocate<long double>(buffer_size, channel_size, policy, false);
 }
 
-void allocate_interleaved_audio_buffer(float* const*& buffers, std::size_t buffer_size, std::size_t channel_size) {
-  buffers = __allocate_interleaved_buffer<float>(buffer_size, channel_size);
+void allocate_interleaved_audio_buffer(float* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy) {
+  buffers = __allocate<float>(buffer_size, channel_size, policy, true);
 }
 
-void allocate_interleaved_audio_buffer(double* const*& buffers, std::size_t buffer_size, std::size_t channel_size) {
-  buffers = __allocate_interleaved_buffer<double>(buffer_size, channel_size);
+void allocate_interleaved_audio_buffer(double* const*& buffers, std::size_t buffer_size, std::size_t channel_size,
+    const buffer_allocation_policy* policy) {
+  buffers = __allocate<double>(buffer_size, channel_size, policy, true);
 }
 
-void allocate_interleaved_audio_buffer(
-    long double* const*& buffers, std::size_t buffer_size, std::size_t channel_size) {
-  buffers = __allocate_interleaved_buffer<long double>(buffer_size, channel_size);
+void allocate_interleaved_audio_buffer(long double* const*& buffers, std::size_t buffer_size,
+    std::size_t channel_size, const buffer_allocation_policy* policy) {
+  buffers = __allocate<long double>(buffer_size, channel_size, policy, true);
 }
 
 void deallocate_audio_buffer(float* const* buffers) { __deallocate_buffer(buffers); }
@@ -2,6 +2,7 @@
 #include "mts/assert.h"
 #include "mts/int24_t.h"
 #include "mts/util.h"
+#include "mts/audio/vector_operations.h"
 
 MTS_BEGIN_NAMESPACE
 audio_device_manager::engine::engine() { clear_stream_info(); }
@@ -124,6 +125,167 @@ void audio_device_manager::engine::setConvertInfo(stream_mode mode, std::size_t
   }
 }
 
+namespace {
+// Channels converted per vector operation, their pointers are kept on the stack.
+constexpr int max_vectorized_channels = 32;
+
+// Number of channels starting at j whose offsets follow each other.
+int consecutive_channels(const std::vector<int>& offsets, int j, int channels) {
+  int n = 1;
+  while (j + n < channels && n < max_vectorized_channels && offsets[j + n] == offsets[j] + n) {
+    n++;
+  }
+
+  return n;
+}
+
+template <typename T, typename S>
+void deinterleave(const S* in, int inJump, T* const* out, int channels, std::size_t length) {
+  const mts::vec::stride_t stride = inJump;
+
+  if constexpr (std::is_same_v<S, std::int8_t>) {
+    mts::vec::deinterleave_from_int8(in, stride, out, channels, length);
+  }
+  else if constexpr (std::is_same_v<S, std::int16_t>) {
+    mts::vec::deinterleave_from_int16(in, stride, out, channels, length);
+  }
+  else if constexpr (std::is_same_v<S, mts::int24_t>) {
+    mts::vec::deinterleave_from_int24(in, stride, out, channels, length);
+  }
+  else if constexpr (std::is_same_v<S, std::int32_t>) {
+    mts::vec::deinterleave_from_int32(in, stride, out, channels, length);
+  }
+  else if constexpr (std::is_same_v<S, float>) {
+    mts::vec::deinterleave_from_float(in, stride, out, channels, length);
+  }
+  else {
+    mts::vec::deinterleave_from_double(in, stride, out, channels, length);
+  }
+}
+
+// Integer outputs are rounded and saturated.
+template <typename T, typename S>
+void interleave(const S* const* in, T* out, int outJump, int channels, std::size_t length) {
+  const mts::vec::stride_t stride = outJump;
+
+  if constexpr (std::is_same_v<T, std::int8_t>) {
+    mts::vec::interleave_to_int8(in, out, stride, channels, length);
+  }
+  else if constexpr (std::is_same_v<T, std::int16_t>) {
+    mts::vec::interleave_to_int16(in, out, stride, channels, length);
+  }
+  else if constexpr (std::is_same_v<T, mts::int24_t>) {
+    mts::vec::interleave_to_int24(in, out, stride, channels, length);
+  }
+  else if constexpr (std::is_same_v<T, std::int32_t>) {
+    mts::vec::interleave_to_int32(in, out, stride, channels, length);
+  }
+  else if constexpr (std::is_same_v<S, float>) {
+    mts::vec::interleave_from_float(in, out, stride, channels, length);
+  }
+  else {
+    mts::vec::interleave_from_double(in, out, stride, channels, length);
+  }
+}
+
+// Input channels whose samples follow each other in a frame into separate output channels.
+template <typename T, typename S>
+void deinterleaveBuffer(T* out, const S* in, int inJump, const std::vector<int>& inOffset,
+    const std::vector<int>& outOffset, int channels, std::size_t length) {
+  T* outChannels[max_vectorized_channels];
+
+  for (int j = 0; j < channels;) {
+    const int n = consecutive_channels(inOffset, j, channels);
+    for (int k = 0; k < n; k++) {
+      outChannels[k] = out + outOffset[j + k];
+    }
+
+    deinterleave(in + inOffset[j], inJump, outChannels, n, length);
+    j += n;
+  }
+}
+
+// Separate input channels into output channels whose samples follow each other in a frame.
+template <typename T, typename S>
+void interleaveBuffer(T* out, int outJump, const S* in, const std::vector<int>& inOffset,
+    const std::vector<int>& outOffset, int channels, std::size_t length) {
+  const S* inChannels[max_vectorized_channels];
+
+  for (int j = 0; j < channels;) {
+    const int n = consecutive_channels(outOffset, j, channels);
+    for (int k = 0; k < n; k++) {
+      inChannels[k] = in + inOffset[j + k];
+    }
+
+    interleave(inChannels, out + outOffset[j], outJump, n, length);
+    j += n;
+  }
+}
+} // namespace.
+
+template <typename T>
+bool audio_device_manager::engine::convertBufferVectorized(T* outBuffer, void* inBuffer, const convert_info& info) {
+  const std::size_t length = _stream.bufferSize;
+
+  // Deinterleaving is only vectorized into floating point outputs.
+  if constexpr (std::is_floating_point_v<T>) {
+    if (info.outJump == 1) {
+      // Non interleaved output, the input channels are (de)interleaved and converted in one pass.
+      switch (info.inFormat) {
+      case audio_device_format::sint8:
+        deinterleaveBuffer(outBuffer, (const std::int8_t*)inBuffer, info.inJump, info.inOffset, info.outOffset,
+            info.channels, length);
+        return true;
+
+      case audio_device_format::sint16:
+        deinterleaveBuffer(outBuffer, (const std::int16_t*)inBuffer, info.inJump, info.inOffset, info.outOffset,
+            info.channels, length);
+        return true;
+
+      case audio_device_format::sint24:
+        deinterleaveBuffer(outBuffer, (const mts::int24_t*)inBuffer, info.inJump, info.inOffset, info.outOffset,
+            info.channels, length);
+        return true;
+
+      case audio_device_format::sint32:
+        deinterleaveBuffer(outBuffer, (const std::int32_t*)inBuffer, info.inJump, info.inOffset, info.outOffset,
+            info.channels, length);
+        return true;
+
+      case audio_device_format::float32:
+        deinterleaveBuffer(outBuffer, (const float*)inBuffer, info.inJump, info.inOffset, info.outOffset,
+            info.channels, length);
+        return true;
+
+      case audio_device_format::float64:
+        deinterleaveBuffer(outBuffer, (const double*)inBuffer, info.inJump, info.inOffset, info.outOffset,
+            info.channels, length);
+        return true;
+
+      default:
+        return false;
+      }
+    }
+  }
+
+  if (info.inJump == 1) {
+    // Non interleaved input into an interleaved output.
+    if (info.inFormat == audio_device_format::float32) {
+      interleaveBuffer(outBuffer, info.outJump, (const float*)inBuffer, info.inOffset, info.outOffset,
+          info.channels, length);
+      return true;
+    }
+
+    if (info.inFormat == audio_device_format::float64) {
+      interleaveBuffer(outBuffer, info.outJump, (const double*)inBuffer, info.inOffset, info.outOffset,
+          info.channels, length);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void audio_device_manager::engine::convertBuffer(void* outBuffer, void* inBuffer, convert_info& info) {
   // This function does format conversion, input/output channel compensation, and
   // data interleaving/deinterleaving.  24-bit integers are assumed to occupy
@@ -134,6 +296,37 @@ void audio_device_manager::engine::convertBuffer(void* outBuffer, void* inBuffer
     memset(outBuffer, 0, _stream.bufferSize * info.outJump * format_bytes(info.outFormat));
   }
 
+  if (info.outFormat == audio_device_format::float64) {
+    if (convertBufferVectorized((double*)outBuffer, inBuffer, info)) {
+      return;
+    }
+  }
+  else if (info.outFormat == audio_device_format::float32) {
+    if (convertBufferVectorized((float*)outBuffer, inBuffer, info)) {
+      return;
+    }
+  }
+  else if (info.outFormat == audio_device_format::sint32) {
+    if (convertBufferVectorized((std::int32_t*)outBuffer, inBuffer, info)) {
+      return;
+    }
+  }
+  else if (info.outFormat == audio_device_format::sint24) {
+    if (convertBufferVectorized((mts::int24_t*)outBuffer, inBuffer, info)) {
+      return;
+    }
+  }
+  else if (info.outFormat == audio_device_format::sint16) {
+    if (convertBufferVectorized((std::int16_t*)outBuffer, inBuffer, info)) {
+      return;
+    }
+  }
+  else if (info.outFormat == audio_device_format::sint8) {
+    if (convertBufferVectorized((std::int8_t*)outBuffer, inBuffer, info)) {
+      return;
+    }
+  }
+
   int j;
   if (info.outFormat == audio_device_format::float64) {
     double* out = (double*)outBuffer;
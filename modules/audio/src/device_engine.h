@@ -162,6 +162,13 @@ protected:
   */
   void convertBuffer(void* outBuffer, void* inBuffer, convert_info& info);
 
+  //! Vectorized part of convertBuffer(). Deinterleaves any input format into
+  //! float32 and float64 outputs, and interleaves float32 and float64 inputs
+  //! into any output format, integers included.
+  //! Returns false if the layout or formats are left to the generic loops.
+  template <typename T>
+  bool convertBufferVectorized(T* outBuffer, void* inBuffer, const convert_info& info);
+
   //! Protected common method used to perform byte-swapping on buffers.
   void byteSwapBuffer(void* buffer, std::size_t samples, audio_device_format format);
 
@@ -0,0 +1,35 @@
+#include "mts/audio/graph.h"
+
+MTS_BEGIN_NAMESPACE
+namespace {
+class audio_graph_error_category : public std::error_category {
+public:
+  audio_graph_error_category() noexcept = default;
+  virtual ~audio_graph_error_category() noexcept override = default;
+  virtual const char* name() const noexcept override { return "mts::audio_graph"; }
+
+  virtual std::string message(int ev) const override {
+    switch (static_cast<_VMTS::audio_graph_error>(ev)) {
+    case audio_graph_error::invalid_node:
+      return "invalid_node";
+    case audio_graph_error::invalid_port:
+      return "invalid_port";
+    case audio_graph_error::channel_mismatch:
+      return "channel_mismatch";
+    case audio_graph_error::already_connected:
+      return "already_connected";
+    case audio_graph_error::cycle:
+      return "cycle";
+    case audio_graph_error::memory_error:
+      return "memory_error";
+    default:
+      mts_error("Unrecognized error");
+      return "Unrecognized error";
+    }
+  }
+};
+inline static const audio_graph_error_category s_error_code_category;
+} // namespace.
+
+const std::error_category& audio_graph_error_category() noexcept { return s_error_code_category; }
+MTS_END_NAMESPACE
@@ -0,0 +1,209 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/math.h"
+#include "mts/audio/detail/vector_operations_base.h"
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+
+///
+/// Polynomial and rational approximations of sin, cos, tan and tanh for any
+/// register type R, in two accuracy tiers.
+///
+/// Max absolute error of the *_approx kernels is below 1e-6 for float and
+/// double (sin and cos ~5e-9 in double, tanh ~3e-7). The *_fast ones stay
+/// below 1e-3 (sin and cos ~1.2e-4, tanh ~8e-4). tan has the same bounds
+/// relative to max(1, |tan(x)|), at least 0.2 from its poles. Closer to a
+/// pole the float tan_approx error grows like 1e-7 / distance (~2e-6 at
+/// 0.05), the one of the reduced argument.
+///
+/// sin, cos and tan reduce their input modulo pi with a three part Cody-Waite
+/// split which stays accurate for |x| < 8192 * pi. Past that the error grows
+/// linearly with |x|.
+///
+/// The reduction needs a real round to nearest instruction (R::round), the
+/// usual 1.5 * 2^23 magic number trick gets folded away by -ffast-math. For
+/// the same reason the files including this one are built with
+/// -fno-associative-math.
+///
+/// Like simd::kernels, everything in here must depend on R.
+///
+template <typename R>
+struct approx_kernels {
+  using value_type = typename R::value_type;
+  using reg = typename R::type;
+  static constexpr length_t size = R::size;
+
+  /// c0 + t * (c1 + t * (c2 + ...))
+  static MTS_ALWAYS_INLINE reg horner(reg, value_type c) { return R::set1(c); }
+
+  template <typename... Cs>
+  static MTS_ALWAYS_INLINE reg horner(reg t, value_type c, Cs... cs) {
+    return R::fmadd(horner(t, cs...), t, R::set1(c));
+  }
+
+  /// sin(r) for r in [-pi/2, pi/2].
+  template <bool Fast>
+  static MTS_ALWAYS_INLINE reg sin_poly(reg r) {
+    const reg t = R::mul(r, r);
+    reg p;
+
+    if constexpr (Fast) {
+      p = horner(t, (value_type)-0.1660786204690408, (value_type)0.007633771692024216);
+    }
+    else {
+      p = horner(t, (value_type)-0.16666657096389192, (value_type)0.008333017289413486,
+          (value_type)-0.00019806615076136964, (value_type)2.6000545356546267e-06);
+    }
+
+    // r + r^3 * p(r^2)
+    return R::fmadd(R::mul(p, t), r, r);
+  }
+
+  /// x - k * pi.
+  static MTS_ALWAYS_INLINE reg reduce(reg x, reg k) {
+    x = R::fmadd(k, R::set1((value_type)-3.140625), x);
+    x = R::fmadd(k, R::set1((value_type)-9.67502593994140625e-4), x);
+    return R::fmadd(k, R::set1((value_type)-1.509957990978376432e-7), x);
+  }
+
+  /// (-1)^k for an integral k.
+  static MTS_ALWAYS_INLINE reg alternate(reg k) {
+    const reg half_k = R::round(R::mul(k, R::set1((value_type)0.5)));
+    const reg parity = R::abs(R::fmadd(half_k, R::set1((value_type)-2), k));
+    return R::fmadd(parity, R::set1((value_type)-2), R::set1((value_type)1));
+  }
+
+  template <bool Fast>
+  static MTS_ALWAYS_INLINE reg sin(reg x) {
+    const reg k = R::round(R::mul(x, R::set1(mts::math::one_over_pi<value_type>)));
+    return R::mul(sin_poly<Fast>(reduce(x, k)), alternate(k));
+  }
+
+  template <bool Fast>
+  static MTS_ALWAYS_INLINE reg cos(reg x) {
+    // cos(x) = -(-1)^k * sin(x - (k + 1/2) * pi)
+    const reg k = R::round(R::fmadd(x, R::set1(mts::math::one_over_pi<value_type>), R::set1((value_type)-0.5)));
+    const reg r = reduce(x, R::add(k, R::set1((value_type)0.5)));
+    return R::mul(sin_poly<Fast>(r), R::sub(R::set1((value_type)0), alternate(k)));
+  }
+
+  template <bool Fast>
+  static MTS_ALWAYS_INLINE reg tan(reg x) {
+    // tan(r) = sin(r) / cos(r) with cos(r) = sin(pi/2 - |r|) on [-pi/2, pi/2].
+    const reg k = R::round(R::mul(x, R::set1(mts::math::one_over_pi<value_type>)));
+    const reg r = reduce(x, k);
+    const reg c = sin_poly<Fast>(R::sub(R::set1(mts::math::half_pi<value_type>), R::abs(r)));
+    return R::div(sin_poly<Fast>(r), c);
+  }
+
+  template <bool Fast>
+  static MTS_ALWAYS_INLINE reg tanh(reg x) {
+    // x * p(x^2) / q(x^2), clamped where the fit reaches +-1.
+    if constexpr (Fast) {
+      x = R::min(R::max(x, R::set1((value_type)-4.3)), R::set1((value_type)4.3));
+      const reg t = R::mul(x, x);
+      const reg p = horner(t, (value_type)0.9983305076305449, (value_type)0.07954948818156761);
+      const reg q = horner(t, (value_type)1, (value_type)0.4087701859961866, (value_type)0.006047879048904563);
+      return R::div(R::mul(x, p), q);
+    }
+    else {
+      x = R::min(R::max(x, R::set1((value_type)-8.5)), R::set1((value_type)8.5));
+      const reg t = R::mul(x, x);
+      const reg p = horner(t, (value_type)0.9999989540649349, (value_type)0.1286755267905081,
+          (value_type)0.0028899479033784757, (value_type)1.0795924665161018e-05);
+      const reg q = horner(t, (value_type)1, (value_type)0.4620051466764569, (value_type)0.02356220908835219,
+          (value_type)0.0002302005955520332, (value_type)2.2623132626677904e-07);
+      return R::div(R::mul(x, p), q);
+    }
+  }
+
+  /// Runs op over full registers and the tail through a zero padded one.
+  template <typename Op>
+  static MTS_ALWAYS_INLINE void apply(const value_type* s1, value_type* d1, length_t length, Op op) {
+    length_t i = 0;
+    for (; i + size <= length; i += size) {
+      R::store(d1 + i, op(R::load(s1 + i)));
+    }
+
+    if (i < length) {
+      value_type buffer[size] = {};
+      for (length_t j = 0; j < length - i; j++) {
+        buffer[j] = s1[i + j];
+      }
+
+      R::store(buffer, op(R::load(buffer)));
+
+      for (length_t j = 0; j < length - i; j++) {
+        d1[i + j] = buffer[j];
+      }
+    }
+  }
+
+  static void sin_approx(const value_type* s1, value_type* d1, length_t length) {
+    apply(s1, d1, length, [](reg x) { return sin<false>(x); });
+  }
+
+  static void cos_approx(const value_type* s1, value_type* d1, length_t length) {
+    apply(s1, d1, length, [](reg x) { return cos<false>(x); });
+  }
+
+  static void tan_approx(const value_type* s1, value_type* d1, length_t length) {
+    apply(s1, d1, length, [](reg x) { return tan<false>(x); });
+  }
+
+  static void tanh_approx(const value_type* s1, value_type* d1, length_t length) {
+    apply(s1, d1, length, [](reg x) { return tanh<false>(x); });
+  }
+
+  static void sin_fast(const value_type* s1, value_type* d1, length_t length) {
+    apply(s1, d1, length, [](reg x) { return sin<true>(x); });
+  }
+
+  static void cos_fast(const value_type* s1, value_type* d1, length_t length) {
+    apply(s1, d1, length, [](reg x) { return cos<true>(x); });
+  }
+
+  static void tan_fast(const value_type* s1, value_type* d1, length_t length) {
+    apply(s1, d1, length, [](reg x) { return tan<true>(x); });
+  }
+
+  static void tanh_fast(const value_type* s1, value_type* d1, length_t length) {
+    apply(s1, d1, length, [](reg x) { return tanh<true>(x); });
+  }
+};
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
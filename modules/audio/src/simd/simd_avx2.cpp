@@ -0,0 +1,22 @@
+#include "simd_dispatch.h"
+
+#if __MTS_USE_SIMD__
+  #if __MTS_ARCH_X86_64__ && defined(__AVX2__)
+    #include "simd_kernels.h"
+    #include "simd_avx2.h"
+  #endif
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+const table* get_avx2_table() noexcept {
+  #if __MTS_ARCH_X86_64__ && defined(__AVX2__)
+  static constexpr table t = { simd_isa::avx2, make_table<kernels<avx2::reg<float>>, float>(),
+    make_table<kernels<avx2::reg<double>>, double>() };
+  return &t;
+  #else
+  return nullptr;
+  #endif
+}
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
+#endif // __MTS_USE_SIMD__
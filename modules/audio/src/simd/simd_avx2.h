@@ -0,0 +1,333 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/int24_t.h"
+#include <immintrin.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+
+///
+/// avx2 registers.
+///
+/// Only usable in translation units compiled with avx2 (and fma) enabled.
+///
+struct avx2 {
+  template <typename T>
+  struct reg;
+
+  // Moves packed sample k of each 128 bit lane to the top 3 bytes of int32 k.
+  static MTS_ALWAYS_INLINE __m128i unpack_int24_mask() {
+    return _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+  }
+
+  // Inverse of unpack_int24_mask for sign extended int32, packed in the low 12 bytes.
+  static MTS_ALWAYS_INLINE __m128i pack_int24_mask() {
+    return _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  }
+
+  // Loads exactly 4 packed 24 bit samples (12 bytes) as sign extended int32.
+  static MTS_ALWAYS_INLINE __m128i load_int24x4(const mts::int24_t* s) {
+    std::int32_t tail;
+    std::memcpy(&tail, (const std::uint8_t*)(const void*)s + 8, sizeof(tail));
+    const __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)s), _mm_cvtsi32_si128(tail));
+    return _mm_srai_epi32(_mm_shuffle_epi8(v, unpack_int24_mask()), 8);
+  }
+
+  // Loads exactly 8 packed 24 bit samples (24 bytes) as sign extended int32.
+  static MTS_ALWAYS_INLINE __m256i load_int24x8(const mts::int24_t* s) {
+    const __m128i a = _mm_loadu_si128((const __m128i*)s);
+    const __m128i b = _mm_loadl_epi64((const __m128i*)((const std::uint8_t*)(const void*)s + 16));
+    const __m256i v = _mm256_set_m128i(_mm_alignr_epi8(b, a, 12), a);
+    return _mm256_srai_epi32(_mm256_shuffle_epi8(v, _mm256_broadcastsi128_si256(unpack_int24_mask())), 8);
+  }
+
+  // Stores exactly 4 packed 24 bit samples (12 bytes).
+  static MTS_ALWAYS_INLINE void store_int24x4(mts::int24_t* d, __m128i v) {
+    v = _mm_shuffle_epi8(v, pack_int24_mask());
+    const std::int32_t tail = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+    _mm_storel_epi64((__m128i*)d, v);
+    std::memcpy((std::uint8_t*)(void*)d + 8, &tail, sizeof(tail));
+  }
+
+  // Stores exactly 8 packed 24 bit samples (24 bytes).
+  static MTS_ALWAYS_INLINE void store_int24x8(mts::int24_t* d, __m256i v) {
+    v = _mm256_shuffle_epi8(v, _mm256_broadcastsi128_si256(pack_int24_mask()));
+    const __m128i lo = _mm256_castsi256_si128(v);
+    const __m128i hi = _mm256_extracti128_si256(v, 1);
+    _mm_storeu_si128((__m128i*)d, _mm_or_si128(lo, _mm_slli_si128(hi, 12)));
+    _mm_storel_epi64((__m128i*)((std::uint8_t*)(void*)d + 16), _mm_srli_si128(hi, 4));
+  }
+};
+
+template <>
+struct avx2::reg<float> {
+  using value_type = float;
+  using type = __m256;
+  static constexpr std::size_t size = 8;
+
+  static MTS_ALWAYS_INLINE type load(const float* s) { return _mm256_loadu_ps(s); }
+  static MTS_ALWAYS_INLINE void store(float* d, type v) { _mm256_storeu_ps(d, v); }
+  static MTS_ALWAYS_INLINE type set1(float v) { return _mm256_set1_ps(v); }
+  static MTS_ALWAYS_INLINE type zero() { return _mm256_setzero_ps(); }
+
+  static MTS_ALWAYS_INLINE type add(type a, type b) { return _mm256_add_ps(a, b); }
+  static MTS_ALWAYS_INLINE type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+  static MTS_ALWAYS_INLINE type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+  static MTS_ALWAYS_INLINE type div(type a, type b) { return _mm256_div_ps(a, b); }
+  static MTS_ALWAYS_INLINE type min(type a, type b) { return _mm256_min_ps(a, b); }
+  static MTS_ALWAYS_INLINE type max(type a, type b) { return _mm256_max_ps(a, b); }
+  static MTS_ALWAYS_INLINE type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+  static MTS_ALWAYS_INLINE type sqrt(type a) { return _mm256_sqrt_ps(a); }
+
+  // Round to nearest.
+  static MTS_ALWAYS_INLINE type round(type a) {
+    return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+
+  // a * b + c
+  static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) {
+#if defined(__FMA__) || __MTS_MSVC__
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+  }
+
+  // Horizontal reductions.
+  static MTS_ALWAYS_INLINE float hsum(type a) {
+    __m128 v = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(v, _mm_shuffle_ps(v, v, 1)));
+  }
+
+  static MTS_ALWAYS_INLINE float hmin(type a) {
+    __m128 v = _mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_min_ss(v, _mm_shuffle_ps(v, v, 1)));
+  }
+
+  static MTS_ALWAYS_INLINE float hmax(type a) {
+    __m128 v = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_max_ss(v, _mm_shuffle_ps(v, v, 1)));
+  }
+
+  // Bit i is set when a[i] == b[i].
+  static MTS_ALWAYS_INLINE unsigned eq_mask(type a, type b) {
+    return (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+  }
+
+  // In place transpose of size registers.
+  static MTS_ALWAYS_INLINE void transpose(type* m) {
+    const type t0 = _mm256_unpacklo_ps(m[0], m[1]);
+    const type t1 = _mm256_unpackhi_ps(m[0], m[1]);
+    const type t2 = _mm256_unpacklo_ps(m[2], m[3]);
+    const type t3 = _mm256_unpackhi_ps(m[2], m[3]);
+    const type t4 = _mm256_unpacklo_ps(m[4], m[5]);
+    const type t5 = _mm256_unpackhi_ps(m[4], m[5]);
+    const type t6 = _mm256_unpacklo_ps(m[6], m[7]);
+    const type t7 = _mm256_unpackhi_ps(m[6], m[7]);
+
+    const type u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const type u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const type u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const type u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const type u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const type u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const type u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const type u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    m[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+    m[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+    m[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+    m[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+    m[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+    m[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+    m[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+    m[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+  }
+
+  static MTS_ALWAYS_INLINE type from_int8(const std::int8_t* s) {
+    return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int16(const std::int16_t* s) {
+    return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int32(const std::int32_t* s) {
+    return _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)s));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int24(const mts::int24_t* s) { return _mm256_cvtepi32_ps(avx2::load_int24x8(s)); }
+
+  static MTS_ALWAYS_INLINE type from_float(const float* s) { return _mm256_loadu_ps(s); }
+
+  static MTS_ALWAYS_INLINE type from_double(const double* s) {
+    return _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm256_cvtpd_ps(_mm256_loadu_pd(s))), _mm256_cvtpd_ps(_mm256_loadu_pd(s + 4)), 1);
+  }
+
+  // Rounds to nearest and stores size samples (v must be in the range of the integer type).
+  static MTS_ALWAYS_INLINE void to_int8(std::int8_t* d, type v) {
+    const __m256i x = _mm256_cvtps_epi32(v);
+    const __m128i p = _mm_packs_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+    _mm_storel_epi64((__m128i*)d, _mm_packs_epi16(p, p));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int16(std::int16_t* d, type v) {
+    const __m256i x = _mm256_cvtps_epi32(v);
+    _mm_storeu_si128((__m128i*)d, _mm_packs_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1)));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int24(mts::int24_t* d, type v) { avx2::store_int24x8(d, _mm256_cvtps_epi32(v)); }
+
+  static MTS_ALWAYS_INLINE void to_int32(std::int32_t* d, type v) {
+    _mm256_storeu_si256((__m256i*)d, _mm256_cvtps_epi32(v));
+  }
+};
+
+template <>
+struct avx2::reg<double> {
+  using value_type = double;
+  using type = __m256d;
+  static constexpr std::size_t size = 4;
+
+  static MTS_ALWAYS_INLINE type load(const double* s) { return _mm256_loadu_pd(s); }
+  static MTS_ALWAYS_INLINE void store(double* d, type v) { _mm256_storeu_pd(d, v); }
+  static MTS_ALWAYS_INLINE type set1(double v) { return _mm256_set1_pd(v); }
+  static MTS_ALWAYS_INLINE type zero() { return _mm256_setzero_pd(); }
+
+  static MTS_ALWAYS_INLINE type add(type a, type b) { return _mm256_add_pd(a, b); }
+  static MTS_ALWAYS_INLINE type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+  static MTS_ALWAYS_INLINE type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+  static MTS_ALWAYS_INLINE type div(type a, type b) { return _mm256_div_pd(a, b); }
+  static MTS_ALWAYS_INLINE type min(type a, type b) { return _mm256_min_pd(a, b); }
+  static MTS_ALWAYS_INLINE type max(type a, type b) { return _mm256_max_pd(a, b); }
+  static MTS_ALWAYS_INLINE type abs(type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+  static MTS_ALWAYS_INLINE type sqrt(type a) { return _mm256_sqrt_pd(a); }
+
+  // Round to nearest.
+  static MTS_ALWAYS_INLINE type round(type a) {
+    return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+
+  // a * b + c
+  static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) {
+#if defined(__FMA__) || __MTS_MSVC__
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+  }
+
+  // Horizontal reductions.
+  static MTS_ALWAYS_INLINE double hsum(type a) {
+    const __m128d v = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+  }
+
+  static MTS_ALWAYS_INLINE double hmin(type a) {
+    const __m128d v = _mm_min_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+    return _mm_cvtsd_f64(_mm_min_sd(v, _mm_unpackhi_pd(v, v)));
+  }
+
+  static MTS_ALWAYS_INLINE double hmax(type a) {
+    const __m128d v = _mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+    return _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v)));
+  }
+
+  // Bit i is set when a[i] == b[i].
+  static MTS_ALWAYS_INLINE unsigned eq_mask(type a, type b) {
+    return (unsigned)_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+  }
+
+  // In place transpose of size registers.
+  static MTS_ALWAYS_INLINE void transpose(type* m) {
+    const type t0 = _mm256_unpacklo_pd(m[0], m[1]);
+    const type t1 = _mm256_unpackhi_pd(m[0], m[1]);
+    const type t2 = _mm256_unpacklo_pd(m[2], m[3]);
+    const type t3 = _mm256_unpackhi_pd(m[2], m[3]);
+
+    m[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+    m[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+    m[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+    m[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+  }
+
+  static MTS_ALWAYS_INLINE type from_int8(const std::int8_t* s) {
+    std::int32_t bits;
+    std::memcpy(&bits, s, sizeof(bits));
+    return _mm256_cvtepi32_pd(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(bits)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int16(const std::int16_t* s) {
+    return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int32(const std::int32_t* s) {
+    return _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)s));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int24(const mts::int24_t* s) { return _mm256_cvtepi32_pd(avx2::load_int24x4(s)); }
+
+  static MTS_ALWAYS_INLINE type from_float(const float* s) { return _mm256_cvtps_pd(_mm_loadu_ps(s)); }
+
+  static MTS_ALWAYS_INLINE type from_double(const double* s) { return _mm256_loadu_pd(s); }
+
+  // Rounds to nearest and stores size samples (v must be in the range of the integer type).
+  static MTS_ALWAYS_INLINE void to_int8(std::int8_t* d, type v) {
+    __m128i x = _mm256_cvtpd_epi32(v);
+    x = _mm_packs_epi16(_mm_packs_epi32(x, x), x);
+    const std::int32_t bits = _mm_cvtsi128_si32(x);
+    std::memcpy(d, &bits, sizeof(bits));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int16(std::int16_t* d, type v) {
+    const __m128i x = _mm256_cvtpd_epi32(v);
+    _mm_storel_epi64((__m128i*)d, _mm_packs_epi32(x, x));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int24(mts::int24_t* d, type v) { avx2::store_int24x4(d, _mm256_cvtpd_epi32(v)); }
+  static MTS_ALWAYS_INLINE void to_int32(std::int32_t* d, type v) {
+    _mm_storeu_si128((__m128i*)d, _mm256_cvtpd_epi32(v));
+  }
+};
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
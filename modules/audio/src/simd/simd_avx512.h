@@ -0,0 +1,312 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/int24_t.h"
+#include <immintrin.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+
+///
+/// avx512 registers.
+///
+/// Only usable in translation units compiled with avx512f enabled.
+///
+struct avx512 {
+  template <typename T>
+  struct reg;
+
+  // avx512f has no byte shuffle, packed 24 bit samples go through 256 bit
+  // (avx2) shuffles. See avx2::unpack_int24_mask and avx2::pack_int24_mask.
+  static MTS_ALWAYS_INLINE __m256i unpack_int24_mask() {
+    return _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, //
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+  }
+
+  static MTS_ALWAYS_INLINE __m256i pack_int24_mask() {
+    return _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, //
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  }
+
+  // Loads exactly 8 packed 24 bit samples (24 bytes) as sign extended int32.
+  static MTS_ALWAYS_INLINE __m256i load_int24x8(const mts::int24_t* s) {
+    const __m128i a = _mm_loadu_si128((const __m128i*)s);
+    const __m128i b = _mm_loadl_epi64((const __m128i*)((const std::uint8_t*)(const void*)s + 16));
+    const __m256i v = _mm256_set_m128i(_mm_alignr_epi8(b, a, 12), a);
+    return _mm256_srai_epi32(_mm256_shuffle_epi8(v, unpack_int24_mask()), 8);
+  }
+
+  // Loads exactly 16 packed 24 bit samples (48 bytes) as sign extended int32.
+  static MTS_ALWAYS_INLINE __m512i load_int24x16(const mts::int24_t* s) {
+    const __m128i a = _mm_loadu_si128((const __m128i*)s);
+    const __m128i b = _mm_loadu_si128((const __m128i*)s + 1);
+    const __m128i c = _mm_loadu_si128((const __m128i*)s + 2);
+    __m256i lo = _mm256_set_m128i(_mm_alignr_epi8(b, a, 12), a);
+    __m256i hi = _mm256_set_m128i(_mm_srli_si128(c, 4), _mm_alignr_epi8(c, b, 8));
+    lo = _mm256_srai_epi32(_mm256_shuffle_epi8(lo, unpack_int24_mask()), 8);
+    hi = _mm256_srai_epi32(_mm256_shuffle_epi8(hi, unpack_int24_mask()), 8);
+    return _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1);
+  }
+
+  // Stores exactly 8 packed 24 bit samples (24 bytes).
+  static MTS_ALWAYS_INLINE void store_int24x8(mts::int24_t* d, __m256i v) {
+    v = _mm256_shuffle_epi8(v, pack_int24_mask());
+    const __m128i lo = _mm256_castsi256_si128(v);
+    const __m128i hi = _mm256_extracti128_si256(v, 1);
+    _mm_storeu_si128((__m128i*)d, _mm_or_si128(lo, _mm_slli_si128(hi, 12)));
+    _mm_storel_epi64((__m128i*)((std::uint8_t*)(void*)d + 16), _mm_srli_si128(hi, 4));
+  }
+
+  // Stores exactly 16 packed 24 bit samples (48 bytes).
+  static MTS_ALWAYS_INLINE void store_int24x16(mts::int24_t* d, __m512i v) {
+    const __m256i lo = _mm256_shuffle_epi8(_mm512_castsi512_si256(v), pack_int24_mask());
+    const __m256i hi = _mm256_shuffle_epi8(_mm512_extracti64x4_epi64(v, 1), pack_int24_mask());
+    const __m128i c0 = _mm256_castsi256_si128(lo);
+    const __m128i c1 = _mm256_extracti128_si256(lo, 1);
+    const __m128i c2 = _mm256_castsi256_si128(hi);
+    const __m128i c3 = _mm256_extracti128_si256(hi, 1);
+    _mm_storeu_si128((__m128i*)d, _mm_or_si128(c0, _mm_slli_si128(c1, 12)));
+    _mm_storeu_si128((__m128i*)d + 1, _mm_or_si128(_mm_srli_si128(c1, 4), _mm_slli_si128(c2, 8)));
+    _mm_storeu_si128((__m128i*)d + 2, _mm_or_si128(_mm_srli_si128(c2, 8), _mm_slli_si128(c3, 4)));
+  }
+};
+
+template <>
+struct avx512::reg<float> {
+  using value_type = float;
+  using type = __m512;
+  static constexpr std::size_t size = 16;
+
+  static MTS_ALWAYS_INLINE type load(const float* s) { return _mm512_loadu_ps(s); }
+  static MTS_ALWAYS_INLINE void store(float* d, type v) { _mm512_storeu_ps(d, v); }
+  static MTS_ALWAYS_INLINE type set1(float v) { return _mm512_set1_ps(v); }
+  static MTS_ALWAYS_INLINE type zero() { return _mm512_setzero_ps(); }
+
+  static MTS_ALWAYS_INLINE type add(type a, type b) { return _mm512_add_ps(a, b); }
+  static MTS_ALWAYS_INLINE type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+  static MTS_ALWAYS_INLINE type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+  static MTS_ALWAYS_INLINE type div(type a, type b) { return _mm512_div_ps(a, b); }
+  static MTS_ALWAYS_INLINE type min(type a, type b) { return _mm512_min_ps(a, b); }
+  static MTS_ALWAYS_INLINE type max(type a, type b) { return _mm512_max_ps(a, b); }
+  static MTS_ALWAYS_INLINE type abs(type a) { return _mm512_abs_ps(a); }
+  static MTS_ALWAYS_INLINE type sqrt(type a) { return _mm512_sqrt_ps(a); }
+
+  // Round to nearest.
+  static MTS_ALWAYS_INLINE type round(type a) {
+    return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+
+  // a * b + c
+  static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+
+  // Horizontal reductions.
+  static MTS_ALWAYS_INLINE float hsum(type a) { return _mm512_reduce_add_ps(a); }
+  static MTS_ALWAYS_INLINE float hmin(type a) { return _mm512_reduce_min_ps(a); }
+  static MTS_ALWAYS_INLINE float hmax(type a) { return _mm512_reduce_max_ps(a); }
+
+  // Bit i is set when a[i] == b[i].
+  static MTS_ALWAYS_INLINE unsigned eq_mask(type a, type b) { return (unsigned)_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+
+  // In place transpose of size registers, one stage per bit of the row index.
+  // Each stage swaps that bit between the row and column indices.
+  static MTS_ALWAYS_INLINE void transpose(type* m) {
+    transpose_stage<8>(m);
+    transpose_stage<4>(m);
+    transpose_stage<2>(m);
+    transpose_stage<1>(m);
+  }
+
+  template <int B>
+  static MTS_ALWAYS_INLINE void transpose_stage(type* m) {
+    alignas(64) std::int32_t lo[size];
+    alignas(64) std::int32_t hi[size];
+    for (int j = 0; j < (int)size; j++) {
+      lo[j] = (j & B) ? (int)size + j - B : j;
+      hi[j] = (j & B) ? (int)size + j : j + B;
+    }
+
+    const __m512i lo_index = _mm512_load_si512(lo);
+    const __m512i hi_index = _mm512_load_si512(hi);
+
+    for (int i = 0; i < (int)size; i++) {
+      if (!(i & B)) {
+        const type a = m[i];
+        m[i] = _mm512_permutex2var_ps(a, lo_index, m[i + B]);
+        m[i + B] = _mm512_permutex2var_ps(a, hi_index, m[i + B]);
+      }
+    }
+  }
+
+  static MTS_ALWAYS_INLINE type from_int8(const std::int8_t* s) {
+    return _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int16(const std::int16_t* s) {
+    return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i*)s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int32(const std::int32_t* s) {
+    return _mm512_cvtepi32_ps(_mm512_loadu_si512((const void*)s));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int24(const mts::int24_t* s) {
+    return _mm512_cvtepi32_ps(avx512::load_int24x16(s));
+  }
+
+  static MTS_ALWAYS_INLINE type from_float(const float* s) { return _mm512_loadu_ps(s); }
+
+  static MTS_ALWAYS_INLINE type from_double(const double* s) {
+    const __m256 lo = _mm512_cvtpd_ps(_mm512_loadu_pd(s));
+    const __m256 hi = _mm512_cvtpd_ps(_mm512_loadu_pd(s + 8));
+    return _mm512_castpd_ps(
+        _mm512_insertf64x4(_mm512_castps_pd(_mm512_castps256_ps512(lo)), _mm256_castps_pd(hi), 1));
+  }
+
+  // Rounds to nearest and stores size samples (v must be in the range of the integer type).
+  static MTS_ALWAYS_INLINE void to_int8(std::int8_t* d, type v) {
+    _mm_storeu_si128((__m128i*)d, _mm512_cvtsepi32_epi8(_mm512_cvtps_epi32(v)));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int16(std::int16_t* d, type v) {
+    _mm256_storeu_si256((__m256i*)d, _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(v)));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int24(mts::int24_t* d, type v) { avx512::store_int24x16(d, _mm512_cvtps_epi32(v)); }
+  static MTS_ALWAYS_INLINE void to_int32(std::int32_t* d, type v) { _mm512_storeu_si512(d, _mm512_cvtps_epi32(v)); }
+};
+
+template <>
+struct avx512::reg<double> {
+  using value_type = double;
+  using type = __m512d;
+  static constexpr std::size_t size = 8;
+
+  static MTS_ALWAYS_INLINE type load(const double* s) { return _mm512_loadu_pd(s); }
+  static MTS_ALWAYS_INLINE void store(double* d, type v) { _mm512_storeu_pd(d, v); }
+  static MTS_ALWAYS_INLINE type set1(double v) { return _mm512_set1_pd(v); }
+  static MTS_ALWAYS_INLINE type zero() { return _mm512_setzero_pd(); }
+
+  static MTS_ALWAYS_INLINE type add(type a, type b) { return _mm512_add_pd(a, b); }
+  static MTS_ALWAYS_INLINE type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+  static MTS_ALWAYS_INLINE type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+  static MTS_ALWAYS_INLINE type div(type a, type b) { return _mm512_div_pd(a, b); }
+  static MTS_ALWAYS_INLINE type min(type a, type b) { return _mm512_min_pd(a, b); }
+  static MTS_ALWAYS_INLINE type max(type a, type b) { return _mm512_max_pd(a, b); }
+  static MTS_ALWAYS_INLINE type abs(type a) { return _mm512_abs_pd(a); }
+  static MTS_ALWAYS_INLINE type sqrt(type a) { return _mm512_sqrt_pd(a); }
+
+  // Round to nearest.
+  static MTS_ALWAYS_INLINE type round(type a) {
+    return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+
+  // a * b + c
+  static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+
+  // Horizontal reductions.
+  static MTS_ALWAYS_INLINE double hsum(type a) { return _mm512_reduce_add_pd(a); }
+  static MTS_ALWAYS_INLINE double hmin(type a) { return _mm512_reduce_min_pd(a); }
+  static MTS_ALWAYS_INLINE double hmax(type a) { return _mm512_reduce_max_pd(a); }
+
+  // Bit i is set when a[i] == b[i].
+  static MTS_ALWAYS_INLINE unsigned eq_mask(type a, type b) { return (unsigned)_mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+
+  // In place transpose of size registers (see reg<float>::transpose).
+  static MTS_ALWAYS_INLINE void transpose(type* m) {
+    transpose_stage<4>(m);
+    transpose_stage<2>(m);
+    transpose_stage<1>(m);
+  }
+
+  template <int B>
+  static MTS_ALWAYS_INLINE void transpose_stage(type* m) {
+    alignas(64) std::int64_t lo[size];
+    alignas(64) std::int64_t hi[size];
+    for (int j = 0; j < (int)size; j++) {
+      lo[j] = (j & B) ? (int)size + j - B : j;
+      hi[j] = (j & B) ? (int)size + j : j + B;
+    }
+
+    const __m512i lo_index = _mm512_load_si512(lo);
+    const __m512i hi_index = _mm512_load_si512(hi);
+
+    for (int i = 0; i < (int)size; i++) {
+      if (!(i & B)) {
+        const type a = m[i];
+        m[i] = _mm512_permutex2var_pd(a, lo_index, m[i + B]);
+        m[i + B] = _mm512_permutex2var_pd(a, hi_index, m[i + B]);
+      }
+    }
+  }
+
+  static MTS_ALWAYS_INLINE type from_int8(const std::int8_t* s) {
+    return _mm512_cvtepi32_pd(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int16(const std::int16_t* s) {
+    return _mm512_cvtepi32_pd(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int32(const std::int32_t* s) {
+    return _mm512_cvtepi32_pd(_mm256_loadu_si256((const __m256i*)s));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int24(const mts::int24_t* s) {
+    return _mm512_cvtepi32_pd(avx512::load_int24x8(s));
+  }
+
+  static MTS_ALWAYS_INLINE type from_float(const float* s) { return _mm512_cvtps_pd(_mm256_loadu_ps(s)); }
+
+  static MTS_ALWAYS_INLINE type from_double(const double* s) { return _mm512_loadu_pd(s); }
+
+  // Rounds to nearest and stores size samples (v must be in the range of the integer type).
+  static MTS_ALWAYS_INLINE void to_int8(std::int8_t* d, type v) {
+    _mm_storel_epi64((__m128i*)d, _mm512_cvtsepi32_epi8(_mm512_castsi256_si512(_mm512_cvtpd_epi32(v))));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int16(std::int16_t* d, type v) {
+    _mm_storeu_si128((__m128i*)d, _mm512_cvtsepi64_epi16(_mm512_cvtepi32_epi64(_mm512_cvtpd_epi32(v))));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int24(mts::int24_t* d, type v) { avx512::store_int24x8(d, _mm512_cvtpd_epi32(v)); }
+  static MTS_ALWAYS_INLINE void to_int32(std::int32_t* d, type v) {
+    _mm256_storeu_si256((__m256i*)d, _mm512_cvtpd_epi32(v));
+  }
+};
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
@@ -0,0 +1,253 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/int24_t.h"
+#include "mts/audio/detail/vector_operations_simd.h"
+
+#if __MTS_USE_SIMD__
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+
+///
+/// Function table of every simd_ops operation for a given value type.
+///
+template <typename T>
+struct table_t {
+  void (*fill)(T* sd, stride_t s_sd, T value, length_t length);
+  void (*clip)(const T* s1, stride_t s_s1, T min, T max, T* d1, stride_t s_d1, length_t length);
+  void (*abs)(const T* s1, stride_t s_s1, T* d1, stride_t s_d1, length_t length);
+  void (*sqrt)(const T* s1, T* d1, length_t length);
+
+  void (*s_add)(const T* s1, stride_t s_s1, T value, T* d1, stride_t s_d1, length_t length);
+  void (*s_mul)(const T* s1, stride_t s_s1, T value, T* d1, stride_t s_d1, length_t length);
+  void (*s_div)(const T* s1, stride_t s_s1, T value, T* d1, stride_t s_d1, length_t length);
+  void (*s_vdiv)(T value, const T* s1, stride_t s_s1, T* d1, stride_t s_d1, length_t length);
+
+  void (*v_sum)(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length);
+  void (*v_sub)(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length);
+  void (*v_mul)(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length);
+  void (*v_div)(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length);
+
+  void (*sum_s_mul)(
+      const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T value, T* d1, stride_t s_d1, length_t length);
+  void (*sum_v_mul)(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, const T* s3, stride_t s_s3, T* d1,
+      stride_t s_d1, length_t length);
+  void (*sum_mul)(
+      const T* s1, stride_t s_s1, T value, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length);
+  void (*mul_s_sum)(
+      const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, T value, T* d1, stride_t s_d1, length_t length);
+  void (*mul_v_sum)(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, const T* s3, stride_t s_s3, T* d1,
+      stride_t s_d1, length_t length);
+  void (*mul_sum)(
+      const T* s1, stride_t s_s1, T value, const T* s2, stride_t s_s2, T* d1, stride_t s_d1, length_t length);
+
+  void (*ramp)(T* d1, stride_t s_d1, T start, T increment, length_t length);
+  void (*mul_ramp)(const T* s1, stride_t s_s1, T start, T increment, T* d1, stride_t s_d1, length_t length);
+  void (*mul_ramp_add)(const T* s1, stride_t s_s1, T start, T increment, const T* s2, stride_t s_s2, T* d1,
+      stride_t s_d1, length_t length);
+  void (*exp_ramp)(T* d1, stride_t s_d1, T start, T ratio, length_t length);
+  void (*mul_exp_ramp)(const T* s1, stride_t s_s1, T start, T ratio, T* d1, stride_t s_d1, length_t length);
+  void (*mul_exp_ramp_add)(const T* s1, stride_t s_s1, T start, T ratio, const T* s2, stride_t s_s2, T* d1,
+      stride_t s_d1, length_t length);
+
+  T (*sum)(const T* s1, stride_t s_s1, length_t length);
+  T (*sum_of_squares)(const T* s1, stride_t s_s1, length_t length);
+  T (*rms)(const T* s1, stride_t s_s1, length_t length);
+  T (*max_abs)(const T* s1, stride_t s_s1, length_t length);
+  indexed_value<T> (*min_index)(const T* s1, stride_t s_s1, length_t length);
+  indexed_value<T> (*max_index)(const T* s1, stride_t s_s1, length_t length);
+  T (*dot)(const T* s1, stride_t s_s1, const T* s2, stride_t s_s2, length_t length);
+
+  void (*convert_from_int8)(const std::int8_t* s1, stride_t s_s1, T* d1, length_t length);
+  void (*convert_from_int16)(const std::int16_t* s1, stride_t s_s1, T* d1, length_t length);
+  void (*convert_from_int24)(const mts::int24_t* s1, stride_t s_s1, T* d1, length_t length);
+  void (*convert_from_int32)(const std::int32_t* s1, stride_t s_s1, T* d1, length_t length);
+  void (*convert_from_float)(const float* s1, stride_t s_s1, T* d1, length_t length);
+  void (*convert_from_double)(const double* s1, stride_t s_s1, T* d1, length_t length);
+
+  void (*deinterleave_from_int8)(
+      const std::int8_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length);
+  void (*deinterleave_from_int16)(
+      const std::int16_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length);
+  void (*deinterleave_from_int24)(
+      const mts::int24_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length);
+  void (*deinterleave_from_int32)(
+      const std::int32_t* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length);
+  void (*deinterleave_from_float)(
+      const float* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length);
+  void (*deinterleave_from_double)(
+      const double* s1, stride_t s_s1, T* const* d, length_t n_channels, length_t length);
+  void (*interleave_from_float)(const float* const* s, T* d1, stride_t s_d1, length_t n_channels, length_t length);
+  void (*interleave_from_double)(const double* const* s, T* d1, stride_t s_d1, length_t n_channels, length_t length);
+  void (*convert_to_int8)(const T* s1, stride_t s_s1, std::int8_t* d1, stride_t s_d1, length_t length);
+  void (*convert_to_int16)(const T* s1, stride_t s_s1, std::int16_t* d1, stride_t s_d1, length_t length);
+  void (*convert_to_int24)(const T* s1, stride_t s_s1, mts::int24_t* d1, stride_t s_d1, length_t length);
+  void (*convert_to_int32)(const T* s1, stride_t s_s1, std::int32_t* d1, stride_t s_d1, length_t length);
+  void (*interleave_to_int8)(
+      const T* const* s, std::int8_t* d1, stride_t s_d1, length_t n_channels, length_t length);
+  void (*interleave_to_int16)(
+      const T* const* s, std::int16_t* d1, stride_t s_d1, length_t n_channels, length_t length);
+  void (*interleave_to_int24)(
+      const T* const* s, mts::int24_t* d1, stride_t s_d1, length_t n_channels, length_t length);
+  void (*interleave_to_int32)(
+      const T* const* s, std::int32_t* d1, stride_t s_d1, length_t n_channels, length_t length);
+  void (*biquad)(const T* const* s, T* const* d, length_t n_channels, length_t length, const T* c, T* z,
+      length_t n_stages);
+
+  // approx_ops and fast_approx_ops (see simd::approx_kernels).
+  void (*sin_approx)(const T* s1, T* d1, length_t length);
+  void (*cos_approx)(const T* s1, T* d1, length_t length);
+  void (*tan_approx)(const T* s1, T* d1, length_t length);
+  void (*tanh_approx)(const T* s1, T* d1, length_t length);
+  void (*sin_fast)(const T* s1, T* d1, length_t length);
+  void (*cos_fast)(const T* s1, T* d1, length_t length);
+  void (*tan_fast)(const T* s1, T* d1, length_t length);
+  void (*tanh_fast)(const T* s1, T* d1, length_t length);
+};
+
+// Every entry of table_t with the name of the operation it points to.
+// Overloaded operations get one entry per overload, named after the
+// MTS_AUDIO_OP_* macro declaring it.
+#define __MTS_SIMD_TABLE_ENTRIES(X)                     \
+  X(fill, fill)                                         \
+  X(clip, clip)                                         \
+  X(abs, abs)                                           \
+  X(sqrt, sqrt)                                         \
+  X(s_add, add)                                         \
+  X(s_mul, mul)                                         \
+  X(s_div, div)                                         \
+  X(s_vdiv, vdiv)                                       \
+  X(v_sum, sum)                                         \
+  X(v_sub, sub)                                         \
+  X(v_mul, mul)                                         \
+  X(v_div, div)                                         \
+  X(sum_s_mul, sum_mul)                                 \
+  X(sum_v_mul, sum_mul)                                 \
+  X(sum_mul, sum_mul)                                   \
+  X(mul_s_sum, mul_sum)                                 \
+  X(mul_v_sum, mul_sum)                                 \
+  X(mul_sum, mul_sum)                                   \
+  X(ramp, ramp)                                         \
+  X(mul_ramp, mul_ramp)                                 \
+  X(mul_ramp_add, mul_ramp_add)                         \
+  X(exp_ramp, exp_ramp)                                 \
+  X(mul_exp_ramp, mul_exp_ramp)                         \
+  X(mul_exp_ramp_add, mul_exp_ramp_add)                 \
+  X(sum, sum)                                           \
+  X(sum_of_squares, sum_of_squares)                     \
+  X(rms, rms)                                           \
+  X(max_abs, max_abs)                                   \
+  X(min_index, min_index)                               \
+  X(max_index, max_index)                               \
+  X(dot, dot)                                           \
+  X(convert_from_int8, convert_from_int8)               \
+  X(convert_from_int16, convert_from_int16)             \
+  X(convert_from_int24, convert_from_int24)             \
+  X(convert_from_int32, convert_from_int32)             \
+  X(convert_from_float, convert_from_float)             \
+  X(convert_from_double, convert_from_double)           \
+  X(deinterleave_from_int8, deinterleave_from_int8)     \
+  X(deinterleave_from_int16, deinterleave_from_int16)   \
+  X(deinterleave_from_int24, deinterleave_from_int24)   \
+  X(deinterleave_from_int32, deinterleave_from_int32)   \
+  X(deinterleave_from_float, deinterleave_from_float)   \
+  X(deinterleave_from_double, deinterleave_from_double) \
+  X(interleave_from_float, interleave_from_float)       \
+  X(interleave_from_double, interleave_from_double)     \
+  X(convert_to_int8, convert_to_int8)                   \
+  X(convert_to_int16, convert_to_int16)                 \
+  X(convert_to_int24, convert_to_int24)                 \
+  X(convert_to_int32, convert_to_int32)                 \
+  X(interleave_to_int8, interleave_to_int8)             \
+  X(interleave_to_int16, interleave_to_int16)           \
+  X(interleave_to_int24, interleave_to_int24)           \
+  X(interleave_to_int32, interleave_to_int32)           \
+  X(biquad, biquad)                                     \
+  X(sin_approx, sin_approx)                             \
+  X(cos_approx, cos_approx)                             \
+  X(tan_approx, tan_approx)                             \
+  X(tanh_approx, tanh_approx)                           \
+  X(sin_fast, sin_fast)                                 \
+  X(cos_fast, cos_fast)                                 \
+  X(tan_fast, tan_fast)                                 \
+  X(tanh_fast, tanh_fast)
+
+///
+/// Builds a table_t from any type exposing the operations as static members
+/// (e.g. simd::kernels<R>). Assigning to the typed entries picks the right
+/// overload.
+///
+template <typename Ops, typename T>
+constexpr table_t<T> make_table() noexcept {
+  table_t<T> t = {};
+#define __MTS_SIMD_TABLE_ASSIGN(ENTRY, NAME) t.ENTRY = &Ops::NAME;
+  __MTS_SIMD_TABLE_ENTRIES(__MTS_SIMD_TABLE_ASSIGN)
+#undef __MTS_SIMD_TABLE_ASSIGN
+  return t;
+}
+
+///
+/// Float and double function tables for one instruction set.
+///
+struct table {
+  simd_isa isa;
+  table_t<float> f32;
+  table_t<double> f64;
+
+  template <typename T>
+  inline const table_t<T>& get() const noexcept {
+    if constexpr (std::is_same_v<T, float>) {
+      return f32;
+    }
+    else {
+      return f64;
+    }
+  }
+};
+
+// Each of these is defined in its own translation unit (see simd_*.cpp) and
+// returns nullptr when that instruction set wasn't compiled in.
+const table* get_sse2_table() noexcept;
+const table* get_avx2_table() noexcept;
+const table* get_avx512_table() noexcept;
+const table* get_neon_table() noexcept;
+
+/// Returns the table currently used by simd_ops (see set_simd_isa()).
+const table& get_current_table() noexcept;
+
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
+#endif // __MTS_USE_SIMD__
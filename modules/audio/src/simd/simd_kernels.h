@@ -0,0 +1,1055 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/int24_t.h"
+#include "mts/audio/detail/vector_operations_base.h"
+#include "simd_approx.h"
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+
+///
+/// Kernels written once for any register type R (e.g. sse2::reg<float>).
+///
+/// Every kernel has a stride 1 fast path processing R::size elements at a time
+/// (unrolled twice) followed by a scalar tail. Any other stride falls back to
+/// a plain scalar loop.
+///
+/// Each instruction set is compiled in its own translation unit with its own
+/// flags. Everything in here must therefore depend on R so that no inline
+/// function compiled for one instruction set gets shared with another one.
+///
+template <typename R>
+struct kernels : approx_kernels<R> {
+  using value_type = typename R::value_type;
+  using reg = typename R::type;
+  static constexpr length_t size = R::size;
+
+  /// Reads a packed little endian 24 bit sample and sign extends it.
+  static MTS_ALWAYS_INLINE std::int32_t load_int24(const mts::int24_t* s) {
+    const std::uint8_t* b = (const std::uint8_t*)(const void*)s;
+    const std::uint32_t v = (std::uint32_t)b[0] | ((std::uint32_t)b[1] << 8) | ((std::uint32_t)b[2] << 16);
+    return (std::int32_t)(v << 8) >> 8;
+  }
+
+  /// Saturates v to the range of D, rounds it to nearest and stores it.
+  template <typename D>
+  static MTS_ALWAYS_INLINE void store_int(D* d, value_type v) {
+    using range = int_sample_range<D, value_type>;
+    v = v < range::min ? range::min : (v > range::max ? range::max : v);
+    *d = (D)(std::int32_t)std::nearbyint(v);
+  }
+
+  template <typename D>
+  static MTS_ALWAYS_INLINE void store_int(D* d, reg v) {
+    using range = int_sample_range<D, value_type>;
+    v = R::min(R::max(v, R::set1(range::min)), R::set1(range::max));
+
+    if constexpr (std::is_same_v<D, std::int8_t>) {
+      R::to_int8(d, v);
+    }
+    else if constexpr (std::is_same_v<D, std::int16_t>) {
+      R::to_int16(d, v);
+    }
+    else if constexpr (std::is_same_v<D, mts::int24_t>) {
+      R::to_int24(d, v);
+    }
+    else {
+      R::to_int32(d, v);
+    }
+  }
+
+  template <typename VOp, typename SOp>
+  static MTS_ALWAYS_INLINE void transform(
+      const value_type* s1, stride_t s_s1, value_type* d1, stride_t s_d1, length_t length, VOp vop, SOp sop) {
+
+    if (s_s1 == 1 && s_d1 == 1) {
+      length_t i = 0;
+      for (; i + 2 * size <= length; i += 2 * size) {
+        reg a = R::load(s1 + i);
+        reg b = R::load(s1 + i + size);
+        R::store(d1 + i, vop(a));
+        R::store(d1 + i + size, vop(b));
+      }
+
+      for (; i + size <= length; i += size) {
+        R::store(d1 + i, vop(R::load(s1 + i)));
+      }
+
+      for (; i < length; i++) {
+        d1[i] = sop(s1[i]);
+      }
+      return;
+    }
+
+    while (length--) {
+      *d1 = sop(*s1);
+      s1 += s_s1;
+      d1 += s_d1;
+    }
+  }
+
+  template <typename VOp, typename SOp>
+  static MTS_ALWAYS_INLINE void transform(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2,
+      value_type* d1, stride_t s_d1, length_t length, VOp vop, SOp sop) {
+
+    if (s_s1 == 1 && s_s2 == 1 && s_d1 == 1) {
+      length_t i = 0;
+      for (; i + 2 * size <= length; i += 2 * size) {
+        reg a = vop(R::load(s1 + i), R::load(s2 + i));
+        reg b = vop(R::load(s1 + i + size), R::load(s2 + i + size));
+        R::store(d1 + i, a);
+        R::store(d1 + i + size, b);
+      }
+
+      for (; i + size <= length; i += size) {
+        R::store(d1 + i, vop(R::load(s1 + i), R::load(s2 + i)));
+      }
+
+      for (; i < length; i++) {
+        d1[i] = sop(s1[i], s2[i]);
+      }
+      return;
+    }
+
+    while (length--) {
+      *d1 = sop(*s1, *s2);
+      s1 += s_s1;
+      s2 += s_s2;
+      d1 += s_d1;
+    }
+  }
+
+  template <typename VOp, typename SOp>
+  static MTS_ALWAYS_INLINE void transform(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2,
+      const value_type* s3, stride_t s_s3, value_type* d1, stride_t s_d1, length_t length, VOp vop, SOp sop) {
+
+    if (s_s1 == 1 && s_s2 == 1 && s_s3 == 1 && s_d1 == 1) {
+      length_t i = 0;
+      for (; i + 2 * size <= length; i += 2 * size) {
+        reg a = vop(R::load(s1 + i), R::load(s2 + i), R::load(s3 + i));
+        reg b = vop(R::load(s1 + i + size), R::load(s2 + i + size), R::load(s3 + i + size));
+        R::store(d1 + i, a);
+        R::store(d1 + i + size, b);
+      }
+
+      for (; i + size <= length; i += size) {
+        R::store(d1 + i, vop(R::load(s1 + i), R::load(s2 + i), R::load(s3 + i)));
+      }
+
+      for (; i < length; i++) {
+        d1[i] = sop(s1[i], s2[i], s3[i]);
+      }
+      return;
+    }
+
+    while (length--) {
+      *d1 = sop(*s1, *s2, *s3);
+      s1 += s_s1;
+      s2 += s_s2;
+      s3 += s_s3;
+      d1 += s_d1;
+    }
+  }
+
+  ///
+  /// Reduces s1 with four independent accumulators so consecutive vector
+  /// operations don't wait on each other.
+  ///
+  /// vop(acc, x) accumulates a vector, cop(acc, acc) merges two accumulators,
+  /// hop(acc) reduces the last one to a scalar and sop(result, x) handles the
+  /// scalar tail (and any other stride).
+  ///
+  template <typename VOp, typename COp, typename HOp, typename SOp>
+  static MTS_ALWAYS_INLINE value_type reduce(
+      const value_type* s1, stride_t s_s1, length_t length, value_type init, VOp vop, COp cop, HOp hop, SOp sop) {
+    value_type result = init;
+    length_t i = 0;
+
+    if (s_s1 == 1 && length >= size) {
+      reg acc0 = R::set1(init);
+      reg acc1 = acc0;
+      reg acc2 = acc0;
+      reg acc3 = acc0;
+
+      for (; i + 4 * size <= length; i += 4 * size) {
+        acc0 = vop(acc0, R::load(s1 + i));
+        acc1 = vop(acc1, R::load(s1 + i + size));
+        acc2 = vop(acc2, R::load(s1 + i + 2 * size));
+        acc3 = vop(acc3, R::load(s1 + i + 3 * size));
+      }
+
+      for (; i + size <= length; i += size) {
+        acc0 = vop(acc0, R::load(s1 + i));
+      }
+
+      result = hop(cop(cop(acc0, acc1), cop(acc2, acc3)));
+    }
+
+    for (; i < length; i++) {
+      result = sop(result, s1[(stride_t)i * s_s1]);
+    }
+
+    return result;
+  }
+
+  /// Returns the index of the first element equal to value.
+  static MTS_ALWAYS_INLINE length_t find(const value_type* s1, stride_t s_s1, length_t length, value_type value) {
+    length_t i = 0;
+
+    if (s_s1 == 1) {
+      const reg v = R::set1(value);
+      for (; i + size <= length; i += size) {
+        if (const unsigned mask = R::eq_mask(R::load(s1 + i), v)) {
+          return i + (length_t)std::countr_zero(mask);
+        }
+      }
+    }
+
+    for (; i < length; i++) {
+      if (s1[(stride_t)i * s_s1] == value) {
+        return i;
+      }
+    }
+
+    return 0;
+  }
+
+  template <typename S, typename Load>
+  static MTS_ALWAYS_INLINE void convert(const S* s1, stride_t s_s1, value_type* d1, length_t length, Load load) {
+    length_t i = 0;
+
+    if (s_s1 == 1) {
+      for (; i + size <= length; i += size) {
+        R::store(d1 + i, load(s1 + i));
+      }
+    }
+
+    for (; i < length; i++) {
+      d1[i] = (value_type)s1[(stride_t)i * s_s1];
+    }
+  }
+
+  static inline void fill(value_type* sd, stride_t s_sd, value_type value, length_t length) {
+    if (s_sd == 1) {
+      const reg v = R::set1(value);
+      length_t i = 0;
+      for (; i + size <= length; i += size) {
+        R::store(sd + i, v);
+      }
+
+      for (; i < length; i++) {
+        sd[i] = value;
+      }
+      return;
+    }
+
+    while (length--) {
+      *sd = value;
+      sd += s_sd;
+    }
+  }
+
+  static inline void clip(const value_type* s1, stride_t s_s1, value_type min, value_type max, value_type* d1,
+      stride_t s_d1, length_t length) {
+    const reg vmin = R::set1(min);
+    const reg vmax = R::set1(max);
+    transform(
+        s1, s_s1, d1, s_d1, length, [=](reg a) { return R::min(R::max(a, vmin), vmax); },
+        [=](value_type a) { return a < min ? min : (max < a ? max : a); });
+  }
+
+  static inline void abs(const value_type* s1, stride_t s_s1, value_type* d1, stride_t s_d1, length_t length) {
+    transform(
+        s1, s_s1, d1, s_d1, length, [](reg a) { return R::abs(a); }, [](value_type a) { return std::abs(a); });
+  }
+
+  static inline void sqrt(const value_type* s1, value_type* d1, length_t length) {
+    transform(
+        s1, 1, d1, 1, length, [](reg a) { return R::sqrt(a); }, [](value_type a) { return std::sqrt(a); });
+  }
+
+  static inline void add(
+      const value_type* s1, stride_t s_s1, value_type value, value_type* d1, stride_t s_d1, length_t length) {
+    const reg v = R::set1(value);
+    transform(
+        s1, s_s1, d1, s_d1, length, [=](reg a) { return R::add(a, v); }, [=](value_type a) { return a + value; });
+  }
+
+  static inline void mul(
+      const value_type* s1, stride_t s_s1, value_type value, value_type* d1, stride_t s_d1, length_t length) {
+    const reg v = R::set1(value);
+    transform(
+        s1, s_s1, d1, s_d1, length, [=](reg a) { return R::mul(a, v); }, [=](value_type a) { return a * value; });
+  }
+
+  static inline void div(
+      const value_type* s1, stride_t s_s1, value_type value, value_type* d1, stride_t s_d1, length_t length) {
+    const reg v = R::set1(value);
+    transform(
+        s1, s_s1, d1, s_d1, length, [=](reg a) { return R::div(a, v); }, [=](value_type a) { return a / value; });
+  }
+
+  static inline void vdiv(
+      value_type value, const value_type* s1, stride_t s_s1, value_type* d1, stride_t s_d1, length_t length) {
+    const reg v = R::set1(value);
+    transform(
+        s1, s_s1, d1, s_d1, length, [=](reg a) { return R::div(v, a); }, [=](value_type a) { return value / a; });
+  }
+
+  static inline void sum(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2, value_type* d1,
+      stride_t s_d1, length_t length) {
+    transform(
+        s1, s_s1, s2, s_s2, d1, s_d1, length, [](reg a, reg b) { return R::add(a, b); },
+        [](value_type a, value_type b) { return a + b; });
+  }
+
+  static inline void sub(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2, value_type* d1,
+      stride_t s_d1, length_t length) {
+    transform(
+        s1, s_s1, s2, s_s2, d1, s_d1, length, [](reg a, reg b) { return R::sub(a, b); },
+        [](value_type a, value_type b) { return a - b; });
+  }
+
+  static inline void mul(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2, value_type* d1,
+      stride_t s_d1, length_t length) {
+    transform(
+        s1, s_s1, s2, s_s2, d1, s_d1, length, [](reg a, reg b) { return R::mul(a, b); },
+        [](value_type a, value_type b) { return a * b; });
+  }
+
+  static inline void div(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2, value_type* d1,
+      stride_t s_d1, length_t length) {
+    transform(
+        s1, s_s1, s2, s_s2, d1, s_d1, length, [](reg a, reg b) { return R::div(a, b); },
+        [](value_type a, value_type b) { return a / b; });
+  }
+
+  // (s1 + s2) * value
+  static inline void sum_mul(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2,
+      value_type value, value_type* d1, stride_t s_d1, length_t length) {
+    const reg v = R::set1(value);
+    transform(
+        s1, s_s1, s2, s_s2, d1, s_d1, length, [=](reg a, reg b) { return R::mul(R::add(a, b), v); },
+        [=](value_type a, value_type b) { return (a + b) * value; });
+  }
+
+  // (s1 + s2) * s3
+  static inline void sum_mul(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2,
+      const value_type* s3, stride_t s_s3, value_type* d1, stride_t s_d1, length_t length) {
+    transform(
+        s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length, [](reg a, reg b, reg c) { return R::mul(R::add(a, b), c); },
+        [](value_type a, value_type b, value_type c) { return (a + b) * c; });
+  }
+
+  // (s1 + value) * s2
+  static inline void sum_mul(const value_type* s1, stride_t s_s1, value_type value, const value_type* s2,
+      stride_t s_s2, value_type* d1, stride_t s_d1, length_t length) {
+    const reg v = R::set1(value);
+    transform(
+        s1, s_s1, s2, s_s2, d1, s_d1, length, [=](reg a, reg b) { return R::mul(R::add(a, v), b); },
+        [=](value_type a, value_type b) { return (a + value) * b; });
+  }
+
+  // s1 * s2 + value
+  static inline void mul_sum(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2,
+      value_type value, value_type* d1, stride_t s_d1, length_t length) {
+    const reg v = R::set1(value);
+    transform(
+        s1, s_s1, s2, s_s2, d1, s_d1, length, [=](reg a, reg b) { return R::fmadd(a, b, v); },
+        [=](value_type a, value_type b) { return a * b + value; });
+  }
+
+  // s1 * s2 + s3
+  static inline void mul_sum(const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2,
+      const value_type* s3, stride_t s_s3, value_type* d1, stride_t s_d1, length_t length) {
+    transform(
+        s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length, [](reg a, reg b, reg c) { return R::fmadd(a, b, c); },
+        [](value_type a, value_type b, value_type c) { return a * b + c; });
+  }
+
+  // s1 * value + s2
+  static inline void mul_sum(const value_type* s1, stride_t s_s1, value_type value, const value_type* s2,
+      stride_t s_s2, value_type* d1, stride_t s_d1, length_t length) {
+    const reg v = R::set1(value);
+    transform(
+        s1, s_s1, s2, s_s2, d1, s_d1, length, [=](reg a, reg b) { return R::fmadd(a, v, b); },
+        [=](value_type a, value_type b) { return a * value + b; });
+  }
+
+
+  ///
+  /// Calls vop(g, i) on the lanes of g[i] = start + i * step, or start * step^i
+  /// when Exponential, and sop(g, i) on the tail (and on any other stride).
+  ///
+  /// The linear ramp is computed from i so it doesn't drift, the exponential
+  /// one multiplies a vector of consecutive powers by step^size.
+  ///
+  template <bool Exponential, typename VOp, typename SOp>
+  static MTS_ALWAYS_INLINE void ramp_transform(
+      value_type start, value_type step, length_t length, bool contiguous, VOp vop, SOp sop) {
+    length_t i = 0;
+    value_type g = start;
+
+    if (contiguous && length >= size) {
+      alignas(64) value_type lanes[size];
+
+      if constexpr (Exponential) {
+        value_type power = 1;
+        for (length_t k = 0; k < size; k++) {
+          lanes[k] = g;
+          g *= step;
+          power *= step;
+        }
+
+        const reg vpower = R::set1(power);
+        reg v = R::load(lanes);
+
+        for (; i + size <= length; i += size) {
+          vop(v, i);
+          v = R::mul(v, vpower);
+        }
+
+        R::store(lanes, v);
+        g = lanes[0];
+      }
+      else {
+        for (length_t k = 0; k < size; k++) {
+          lanes[k] = (value_type)k;
+        }
+
+        const reg index = R::load(lanes);
+        const reg vstart = R::set1(start);
+        const reg vstep = R::set1(step);
+
+        for (; i + size <= length; i += size) {
+          vop(R::fmadd(R::add(index, R::set1((value_type)i)), vstep, vstart), i);
+        }
+      }
+    }
+
+    for (; i < length; i++) {
+      if constexpr (Exponential) {
+        sop(g, i);
+        g *= step;
+      }
+      else {
+        sop(start + (value_type)i * step, i);
+      }
+    }
+  }
+
+  // start + i * increment
+  static inline void ramp(value_type* d1, stride_t s_d1, value_type start, value_type increment, length_t length) {
+    ramp_transform<false>(
+        start, increment, length, s_d1 == 1, [=](reg g, length_t i) { R::store(d1 + i, g); },
+        [=](value_type g, length_t i) { d1[(stride_t)i * s_d1] = g; });
+  }
+
+  // s1 * (start + i * increment)
+  static inline void mul_ramp(const value_type* s1, stride_t s_s1, value_type start, value_type increment,
+      value_type* d1, stride_t s_d1, length_t length) {
+    ramp_transform<false>(
+        start, increment, length, s_s1 == 1 && s_d1 == 1,
+        [=](reg g, length_t i) { R::store(d1 + i, R::mul(R::load(s1 + i), g)); },
+        [=](value_type g, length_t i) { d1[(stride_t)i * s_d1] = s1[(stride_t)i * s_s1] * g; });
+  }
+
+  // s1 * (start + i * increment) + s2
+  static inline void mul_ramp_add(const value_type* s1, stride_t s_s1, value_type start, value_type increment,
+      const value_type* s2, stride_t s_s2, value_type* d1, stride_t s_d1, length_t length) {
+    ramp_transform<false>(
+        start, increment, length, s_s1 == 1 && s_s2 == 1 && s_d1 == 1,
+        [=](reg g, length_t i) { R::store(d1 + i, R::fmadd(R::load(s1 + i), g, R::load(s2 + i))); },
+        [=](value_type g, length_t i) {
+          d1[(stride_t)i * s_d1] = s1[(stride_t)i * s_s1] * g + s2[(stride_t)i * s_s2];
+        });
+  }
+
+  // start * ratio^i
+  static inline void exp_ramp(value_type* d1, stride_t s_d1, value_type start, value_type ratio, length_t length) {
+    ramp_transform<true>(
+        start, ratio, length, s_d1 == 1, [=](reg g, length_t i) { R::store(d1 + i, g); },
+        [=](value_type g, length_t i) { d1[(stride_t)i * s_d1] = g; });
+  }
+
+  // s1 * start * ratio^i
+  static inline void mul_exp_ramp(const value_type* s1, stride_t s_s1, value_type start, value_type ratio,
+      value_type* d1, stride_t s_d1, length_t length) {
+    ramp_transform<true>(
+        start, ratio, length, s_s1 == 1 && s_d1 == 1,
+        [=](reg g, length_t i) { R::store(d1 + i, R::mul(R::load(s1 + i), g)); },
+        [=](value_type g, length_t i) { d1[(stride_t)i * s_d1] = s1[(stride_t)i * s_s1] * g; });
+  }
+
+  // s1 * start * ratio^i + s2
+  static inline void mul_exp_ramp_add(const value_type* s1, stride_t s_s1, value_type start, value_type ratio,
+      const value_type* s2, stride_t s_s2, value_type* d1, stride_t s_d1, length_t length) {
+    ramp_transform<true>(
+        start, ratio, length, s_s1 == 1 && s_s2 == 1 && s_d1 == 1,
+        [=](reg g, length_t i) { R::store(d1 + i, R::fmadd(R::load(s1 + i), g, R::load(s2 + i))); },
+        [=](value_type g, length_t i) {
+          d1[(stride_t)i * s_d1] = s1[(stride_t)i * s_s1] * g + s2[(stride_t)i * s_s2];
+        });
+  }
+
+  static inline value_type sum(const value_type* s1, stride_t s_s1, length_t length) {
+    return reduce(
+        s1, s_s1, length, value_type(0), [](reg acc, reg x) { return R::add(acc, x); },
+        [](reg a, reg b) { return R::add(a, b); }, [](reg a) { return R::hsum(a); },
+        [](value_type acc, value_type x) { return acc + x; });
+  }
+
+  static inline value_type sum_of_squares(const value_type* s1, stride_t s_s1, length_t length) {
+    return reduce(
+        s1, s_s1, length, value_type(0), [](reg acc, reg x) { return R::fmadd(x, x, acc); },
+        [](reg a, reg b) { return R::add(a, b); }, [](reg a) { return R::hsum(a); },
+        [](value_type acc, value_type x) { return acc + x * x; });
+  }
+
+  static inline value_type rms(const value_type* s1, stride_t s_s1, length_t length) {
+    return length ? std::sqrt(sum_of_squares(s1, s_s1, length) / (value_type)length) : value_type(0);
+  }
+
+  static inline value_type max_abs(const value_type* s1, stride_t s_s1, length_t length) {
+    return reduce(
+        s1, s_s1, length, value_type(0), [](reg acc, reg x) { return R::max(acc, R::abs(x)); },
+        [](reg a, reg b) { return R::max(a, b); }, [](reg a) { return R::hmax(a); },
+        [](value_type acc, value_type x) {
+          x = x < 0 ? -x : x;
+          return acc < x ? x : acc;
+        });
+  }
+
+  // The extremum is found first, then the index of its first occurrence.
+  // Both passes are vectorized and the second one usually stops early.
+  static inline indexed_value<value_type> min_index(const value_type* s1, stride_t s_s1, length_t length) {
+    if (!length) {
+      return { 0, 0 };
+    }
+
+    const value_type value = reduce(
+        s1, s_s1, length, *s1, [](reg acc, reg x) { return R::min(acc, x); },
+        [](reg a, reg b) { return R::min(a, b); }, [](reg a) { return R::hmin(a); },
+        [](value_type acc, value_type x) { return x < acc ? x : acc; });
+
+    const length_t index = find(s1, s_s1, length, value);
+    return { index, s1[(stride_t)index * s_s1] };
+  }
+
+  static inline indexed_value<value_type> max_index(const value_type* s1, stride_t s_s1, length_t length) {
+    if (!length) {
+      return { 0, 0 };
+    }
+
+    const value_type value = reduce(
+        s1, s_s1, length, *s1, [](reg acc, reg x) { return R::max(acc, x); },
+        [](reg a, reg b) { return R::max(a, b); }, [](reg a) { return R::hmax(a); },
+        [](value_type acc, value_type x) { return acc < x ? x : acc; });
+
+    const length_t index = find(s1, s_s1, length, value);
+    return { index, s1[(stride_t)index * s_s1] };
+  }
+
+  static inline value_type dot(
+      const value_type* s1, stride_t s_s1, const value_type* s2, stride_t s_s2, length_t length) {
+    value_type result = 0;
+    length_t i = 0;
+
+    if (s_s1 == 1 && s_s2 == 1 && length >= size) {
+      reg acc0 = R::zero();
+      reg acc1 = acc0;
+      reg acc2 = acc0;
+      reg acc3 = acc0;
+
+      for (; i + 4 * size <= length; i += 4 * size) {
+        acc0 = R::fmadd(R::load(s1 + i), R::load(s2 + i), acc0);
+        acc1 = R::fmadd(R::load(s1 + i + size), R::load(s2 + i + size), acc1);
+        acc2 = R::fmadd(R::load(s1 + i + 2 * size), R::load(s2 + i + 2 * size), acc2);
+        acc3 = R::fmadd(R::load(s1 + i + 3 * size), R::load(s2 + i + 3 * size), acc3);
+      }
+
+      for (; i + size <= length; i += size) {
+        acc0 = R::fmadd(R::load(s1 + i), R::load(s2 + i), acc0);
+      }
+
+      result = R::hsum(R::add(R::add(acc0, acc1), R::add(acc2, acc3)));
+    }
+
+    for (; i < length; i++) {
+      result += s1[(stride_t)i * s_s1] * s2[(stride_t)i * s_s2];
+    }
+
+    return result;
+  }
+
+  ///
+  /// Splits frames s_s1 values apart into n_channels channels, size channels
+  /// at a time: size frames are loaded (and converted) into size registers,
+  /// transposed and stored as size channels.
+  ///
+  /// The loads of the last group of channels may read past n_channels into the
+  /// next frame. These values are never stored, the last frames are left to the
+  /// scalar tail so that nothing is read past the last frame.
+  ///
+  template <bool Scale, typename S, typename Load, typename SLoad>
+  static MTS_ALWAYS_INLINE void deinterleave(const S* s1, stride_t s_s1, value_type* const* d, length_t n_channels,
+      length_t length, value_type scale, Load load, SLoad sload) {
+    length_t i = 0;
+    const reg vscale = R::set1(scale);
+
+    if (n_channels == 1 && s_s1 == 1) {
+      for (; i + size <= length; i += size) {
+        reg v = load(s1 + i);
+        if constexpr (Scale) {
+          v = R::mul(v, vscale);
+        }
+
+        R::store(d[0] + i, v);
+      }
+    }
+    else if (n_channels && s_s1 >= (stride_t)n_channels) {
+      const length_t stride = (length_t)s_s1;
+      const length_t over = (n_channels + size - 1) / size * size - n_channels;
+      const length_t extra_frames = (over + stride - 1) / stride;
+
+      for (; i + size + extra_frames <= length; i += size) {
+        for (length_t c = 0; c < n_channels; c += size) {
+          reg m[size];
+          for (length_t f = 0; f < size; f++) {
+            m[f] = load(s1 + (i + f) * stride + c);
+          }
+
+          R::transpose(m);
+
+          const length_t n = n_channels - c < size ? n_channels - c : size;
+          for (length_t k = 0; k < n; k++) {
+            if constexpr (Scale) {
+              m[k] = R::mul(m[k], vscale);
+            }
+
+            R::store(d[c + k] + i, m[k]);
+          }
+        }
+      }
+    }
+
+    for (; i < length; i++) {
+      const S* frame = s1 + (stride_t)i * s_s1;
+      for (length_t c = 0; c < n_channels; c++) {
+        d[c][i] = Scale ? (value_type)sload(frame + c) * scale : (value_type)sload(frame + c);
+      }
+    }
+  }
+
+  ///
+  /// Inverse of deinterleave. A group of less than size channels is stored
+  /// through a temporary buffer to leave the rest of the frames untouched.
+  ///
+  template <typename S, typename D, typename Load, typename Store, typename SStore>
+  static MTS_ALWAYS_INLINE void interleave(const S* const* s, D* d1, stride_t s_d1, length_t n_channels,
+      length_t length, Load load, Store store, SStore sstore) {
+    length_t i = 0;
+
+    if (n_channels == 1 && s_d1 == 1) {
+      for (; i + size <= length; i += size) {
+        store(d1 + i, load(s[0] + i));
+      }
+    }
+    else if (n_channels && s_d1 >= (stride_t)n_channels) {
+      const length_t stride = (length_t)s_d1;
+
+      for (; i + size <= length; i += size) {
+        for (length_t c = 0; c < n_channels; c += size) {
+          const length_t n = n_channels - c < size ? n_channels - c : size;
+
+          reg m[size];
+          for (length_t k = 0; k < size; k++) {
+            m[k] = k < n ? load(s[c + k] + i) : R::zero();
+          }
+
+          R::transpose(m);
+
+          if (n == size) {
+            for (length_t f = 0; f < size; f++) {
+              store(d1 + (i + f) * stride + c, m[f]);
+            }
+          }
+          else {
+            D buffer[size];
+            for (length_t f = 0; f < size; f++) {
+              store(buffer, m[f]);
+              std::memcpy(d1 + (i + f) * stride + c, buffer, n * sizeof(D));
+            }
+          }
+        }
+      }
+    }
+
+    for (; i < length; i++) {
+      D* frame = d1 + (stride_t)i * s_d1;
+      for (length_t c = 0; c < n_channels; c++) {
+        sstore(frame + c, s[c] + i);
+      }
+    }
+  }
+
+  static inline void convert_from_int8(const std::int8_t* s1, stride_t s_s1, value_type* d1, length_t length) {
+    convert(s1, s_s1, d1, length, [](const std::int8_t* s) { return R::from_int8(s); });
+  }
+
+  static inline void convert_from_int16(const std::int16_t* s1, stride_t s_s1, value_type* d1, length_t length) {
+    convert(s1, s_s1, d1, length, [](const std::int16_t* s) { return R::from_int16(s); });
+  }
+
+  static inline void convert_from_int24(const mts::int24_t* s1, stride_t s_s1, value_type* d1, length_t length) {
+    length_t i = 0;
+
+    if (s_s1 == 1) {
+      for (; i + size <= length; i += size) {
+        R::store(d1 + i, R::from_int24(s1 + i));
+      }
+    }
+    else {
+      std::int32_t buffer[size];
+      for (; i + size <= length; i += size) {
+        for (length_t k = 0; k < size; k++) {
+          buffer[k] = load_int24(s1 + (stride_t)(i + k) * s_s1);
+        }
+
+        R::store(d1 + i, R::from_int32(buffer));
+      }
+    }
+
+    for (; i < length; i++) {
+      d1[i] = (value_type)load_int24(s1 + (stride_t)i * s_s1);
+    }
+  }
+
+  static inline void convert_from_int32(const std::int32_t* s1, stride_t s_s1, value_type* d1, length_t length) {
+    convert(s1, s_s1, d1, length, [](const std::int32_t* s) { return R::from_int32(s); });
+  }
+
+  static inline void convert_from_float(const float* s1, stride_t s_s1, value_type* d1, length_t length) {
+    convert(s1, s_s1, d1, length, [](const float* s) { return R::from_float(s); });
+  }
+
+  static inline void convert_from_double(const double* s1, stride_t s_s1, value_type* d1, length_t length) {
+    convert(s1, s_s1, d1, length, [](const double* s) { return R::from_double(s); });
+  }
+
+  static inline void deinterleave_from_int8(
+      const std::int8_t* s1, stride_t s_s1, value_type* const* d, length_t n_channels, length_t length) {
+    deinterleave<true>(s1, s_s1, d, n_channels, length, (value_type)(1.0 / 128.0),
+        [](const std::int8_t* s) { return R::from_int8(s); }, [](const std::int8_t* s) { return *s; });
+  }
+
+  static inline void deinterleave_from_int16(
+      const std::int16_t* s1, stride_t s_s1, value_type* const* d, length_t n_channels, length_t length) {
+    deinterleave<true>(s1, s_s1, d, n_channels, length, (value_type)(1.0 / 32768.0),
+        [](const std::int16_t* s) { return R::from_int16(s); }, [](const std::int16_t* s) { return *s; });
+  }
+
+  static inline void deinterleave_from_int24(
+      const mts::int24_t* s1, stride_t s_s1, value_type* const* d, length_t n_channels, length_t length) {
+    deinterleave<true>(s1, s_s1, d, n_channels, length, (value_type)(1.0 / 8388608.0),
+        [](const mts::int24_t* s) { return R::from_int24(s); }, [](const mts::int24_t* s) { return load_int24(s); });
+  }
+
+  static inline void deinterleave_from_int32(
+      const std::int32_t* s1, stride_t s_s1, value_type* const* d, length_t n_channels, length_t length) {
+    deinterleave<true>(s1, s_s1, d, n_channels, length, (value_type)(1.0 / 2147483648.0),
+        [](const std::int32_t* s) { return R::from_int32(s); }, [](const std::int32_t* s) { return *s; });
+  }
+
+  static inline void deinterleave_from_float(
+      const float* s1, stride_t s_s1, value_type* const* d, length_t n_channels, length_t length) {
+    deinterleave<false>(s1, s_s1, d, n_channels, length, (value_type)1,
+        [](const float* s) { return R::from_float(s); }, [](const float* s) { return *s; });
+  }
+
+  static inline void deinterleave_from_double(
+      const double* s1, stride_t s_s1, value_type* const* d, length_t n_channels, length_t length) {
+    deinterleave<false>(s1, s_s1, d, n_channels, length, (value_type)1,
+        [](const double* s) { return R::from_double(s); }, [](const double* s) { return *s; });
+  }
+
+  static inline void interleave_from_float(
+      const float* const* s, value_type* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave(
+        s, d1, s_d1, n_channels, length, [](const float* p) { return R::from_float(p); },
+        [](value_type* d, reg v) { R::store(d, v); }, [](value_type* d, const float* p) { *d = (value_type)*p; });
+  }
+
+  static inline void interleave_from_double(
+      const double* const* s, value_type* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave(
+        s, d1, s_d1, n_channels, length, [](const double* p) { return R::from_double(p); },
+        [](value_type* d, reg v) { R::store(d, v); }, [](value_type* d, const double* p) { *d = (value_type)*p; });
+  }
+
+  template <typename D>
+  static MTS_ALWAYS_INLINE void convert_to_int(
+      const value_type* s1, stride_t s_s1, D* d1, stride_t s_d1, length_t length) {
+    length_t i = 0;
+
+    if (s_s1 == 1 && s_d1 == 1) {
+      for (; i + size <= length; i += size) {
+        store_int(d1 + i, R::load(s1 + i));
+      }
+    }
+
+    for (; i < length; i++) {
+      store_int(d1 + (stride_t)i * s_d1, s1[(stride_t)i * s_s1]);
+    }
+  }
+
+  template <typename D>
+  static MTS_ALWAYS_INLINE void interleave_to_int(
+      const value_type* const* s, D* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    constexpr value_type scale = int_sample_range<D, value_type>::scale;
+
+    interleave(
+        s, d1, s_d1, n_channels, length, [](const value_type* p) { return R::mul(R::load(p), R::set1(scale)); },
+        [](D* d, reg v) { store_int(d, v); }, [](D* d, const value_type* p) { store_int(d, *p * scale); });
+  }
+
+  static inline void convert_to_int8(
+      const value_type* s1, stride_t s_s1, std::int8_t* d1, stride_t s_d1, length_t length) {
+    convert_to_int(s1, s_s1, d1, s_d1, length);
+  }
+
+  static inline void convert_to_int16(
+      const value_type* s1, stride_t s_s1, std::int16_t* d1, stride_t s_d1, length_t length) {
+    convert_to_int(s1, s_s1, d1, s_d1, length);
+  }
+
+  static inline void convert_to_int24(
+      const value_type* s1, stride_t s_s1, mts::int24_t* d1, stride_t s_d1, length_t length) {
+    convert_to_int(s1, s_s1, d1, s_d1, length);
+  }
+
+  static inline void convert_to_int32(
+      const value_type* s1, stride_t s_s1, std::int32_t* d1, stride_t s_d1, length_t length) {
+    convert_to_int(s1, s_s1, d1, s_d1, length);
+  }
+
+  static inline void interleave_to_int8(
+      const value_type* const* s, std::int8_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave_to_int(s, d1, s_d1, n_channels, length);
+  }
+
+  static inline void interleave_to_int16(
+      const value_type* const* s, std::int16_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave_to_int(s, d1, s_d1, n_channels, length);
+  }
+
+  static inline void interleave_to_int24(
+      const value_type* const* s, mts::int24_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave_to_int(s, d1, s_d1, n_channels, length);
+  }
+
+  static inline void interleave_to_int32(
+      const value_type* const* s, std::int32_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+    interleave_to_int(s, d1, s_d1, n_channels, length);
+  }
+
+  ///
+  /// Groups of size channels are filtered together with one channel per lane,
+  /// the last group is padded with silent lanes. A single remaining channel is
+  /// filtered with the scalar transposed direct form II.
+  ///
+  static inline void biquad(const value_type* const* s, value_type* const* d, length_t n_channels, length_t length,
+      const value_type* c, value_type* z, length_t n_stages) {
+    if (n_stages == 0) {
+      for (length_t ch = 0; ch < n_channels; ch++) {
+        if (d[ch] != s[ch]) {
+          std::memmove(d[ch], s[ch], length * sizeof(value_type));
+        }
+      }
+      return;
+    }
+
+    length_t ch = 0;
+    for (; ch + size <= n_channels; ch += size) {
+      biquad_group(s + ch, d + ch, size, length, c + ch, z + ch, n_channels, n_stages);
+    }
+
+    const length_t n_active = n_channels - ch;
+
+    if (n_active == 1) {
+      biquad_channel(s[ch], d[ch], length, c + ch, z + ch, n_channels, n_stages);
+    }
+    else if (n_active) {
+      // Padded lanes have zero coefficients, biquad_group_stages at a time.
+      for (length_t k = 0; k < n_stages; k += biquad_group_stages) {
+        const length_t g_stages = n_stages - k < biquad_group_stages ? n_stages - k : biquad_group_stages;
+        alignas(64) value_type gc[biquad_group_stages * 5 * size] = {};
+        alignas(64) value_type gz[biquad_group_stages * 2 * size] = {};
+
+        for (length_t l = 0; l < n_active; l++) {
+          for (length_t j = 0; j < g_stages * 5; j++) {
+            gc[j * size + l] = c[(k * 5 + j) * n_channels + ch + l];
+          }
+
+          for (length_t j = 0; j < g_stages * 2; j++) {
+            gz[j * size + l] = z[(k * 2 + j) * n_channels + ch + l];
+          }
+        }
+
+        const value_type* const* input = k ? (const value_type* const*)d + ch : s + ch;
+        biquad_group(input, d + ch, n_active, length, gc, gz, size, g_stages);
+
+        for (length_t l = 0; l < n_active; l++) {
+          for (length_t j = 0; j < g_stages * 2; j++) {
+            z[(k * 2 + j) * n_channels + ch + l] = gz[j * size + l];
+          }
+        }
+      }
+    }
+  }
+
+  static constexpr length_t biquad_group_stages = 8;
+  static constexpr length_t biquad_block_size = 64;
+
+  /// Filters n_active <= size channels, the coefficients and states of channel k
+  /// are at c[(stage * 5 + j) * c_stride + k] and z[(stage * 2 + j) * c_stride + k].
+  static inline void biquad_group(const value_type* const* s, value_type* const* d, length_t n_active, length_t length,
+      const value_type* c, value_type* z, length_t c_stride, length_t n_stages) {
+    alignas(64) value_type buffer[biquad_block_size * size];
+
+    // Padded lanes stay silent.
+    if (n_active < size) {
+      std::memset(buffer, 0, sizeof(buffer));
+    }
+
+    for (length_t i = 0; i < length; i += biquad_block_size) {
+      const length_t n = length - i < biquad_block_size ? length - i : biquad_block_size;
+      const length_t nv = n_active == size ? n / size * size : 0;
+
+      // Channels to lanes.
+      for (length_t f = 0; f < nv; f += size) {
+        reg m[size];
+        for (length_t k = 0; k < size; k++) {
+          m[k] = R::load(s[k] + i + f);
+        }
+
+        R::transpose(m);
+
+        for (length_t k = 0; k < size; k++) {
+          R::store(buffer + (f + k) * size, m[k]);
+        }
+      }
+
+      for (length_t f = nv; f < n; f++) {
+        for (length_t k = 0; k < n_active; k++) {
+          buffer[f * size + k] = s[k][i + f];
+        }
+      }
+
+      for (length_t k = 0; k < n_stages; k++) {
+        const value_type* kc = c + k * 5 * c_stride;
+        value_type* kz = z + k * 2 * c_stride;
+        const reg b0 = R::load(kc);
+        const reg b1 = R::load(kc + c_stride);
+        const reg b2 = R::load(kc + 2 * c_stride);
+        const reg a1 = R::load(kc + 3 * c_stride);
+        const reg a2 = R::load(kc + 4 * c_stride);
+        reg z1 = R::load(kz);
+        reg z2 = R::load(kz + c_stride);
+
+        for (length_t f = 0; f < n; f++) {
+          const reg x = R::load(buffer + f * size);
+          const reg y = R::fmadd(b0, x, z1);
+          z1 = R::sub(R::fmadd(b1, x, z2), R::mul(a1, y));
+          z2 = R::sub(R::mul(b2, x), R::mul(a2, y));
+          R::store(buffer + f * size, y);
+        }
+
+        R::store(kz, z1);
+        R::store(kz + c_stride, z2);
+      }
+
+      // Lanes to channels.
+      for (length_t f = 0; f < nv; f += size) {
+        reg m[size];
+        for (length_t k = 0; k < size; k++) {
+          m[k] = R::load(buffer + (f + k) * size);
+        }
+
+        R::transpose(m);
+
+        for (length_t k = 0; k < size; k++) {
+          R::store(d[k] + i + f, m[k]);
+        }
+      }
+
+      for (length_t f = nv; f < n; f++) {
+        for (length_t k = 0; k < n_active; k++) {
+          d[k][i + f] = buffer[f * size + k];
+        }
+      }
+    }
+  }
+
+  static inline void biquad_channel(const value_type* s, value_type* d, length_t length, const value_type* c,
+      value_type* z, length_t c_stride, length_t n_stages) {
+    for (length_t k = 0; k < n_stages; k++) {
+      const value_type* kc = c + k * 5 * c_stride;
+      value_type* kz = z + k * 2 * c_stride;
+      const value_type b0 = kc[0], b1 = kc[c_stride], b2 = kc[2 * c_stride];
+      const value_type a1 = kc[3 * c_stride], a2 = kc[4 * c_stride];
+      value_type z1 = kz[0], z2 = kz[c_stride];
+
+      // Only the last product depends on y, which keeps the recursion short.
+      for (length_t i = 0; i < length; i++) {
+        const value_type x = s[i];
+        const value_type y = b0 * x + z1;
+        z1 = (b1 * x + z2) - a1 * y;
+        z2 = b2 * x - a2 * y;
+        d[i] = y;
+      }
+
+      kz[0] = z1;
+      kz[c_stride] = z2;
+      s = d;
+    }
+  }
+};
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
@@ -0,0 +1,22 @@
+#include "simd_dispatch.h"
+
+#if __MTS_USE_SIMD__
+  #if __MTS_ARCH_ARM_64__
+    #include "simd_kernels.h"
+    #include "simd_neon.h"
+  #endif
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+const table* get_neon_table() noexcept {
+  #if __MTS_ARCH_ARM_64__
+  static constexpr table t = { simd_isa::neon, make_table<kernels<neon::reg<float>>, float>(),
+    make_table<kernels<neon::reg<double>>, double>() };
+  return &t;
+  #else
+  return nullptr;
+  #endif
+}
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
+#endif // __MTS_USE_SIMD__
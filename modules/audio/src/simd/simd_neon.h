@@ -0,0 +1,227 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/int24_t.h"
+#include <arm_neon.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+
+///
+/// neon registers.
+///
+/// Advanced simd is part of the aarch64 baseline and is always available.
+///
+struct neon {
+  template <typename T>
+  struct reg;
+};
+
+template <>
+struct neon::reg<float> {
+  using value_type = float;
+  using type = float32x4_t;
+  static constexpr std::size_t size = 4;
+
+  static MTS_ALWAYS_INLINE type load(const float* s) { return vld1q_f32(s); }
+  static MTS_ALWAYS_INLINE void store(float* d, type v) { vst1q_f32(d, v); }
+  static MTS_ALWAYS_INLINE type set1(float v) { return vdupq_n_f32(v); }
+  static MTS_ALWAYS_INLINE type zero() { return vdupq_n_f32(0.0f); }
+
+  static MTS_ALWAYS_INLINE type add(type a, type b) { return vaddq_f32(a, b); }
+  static MTS_ALWAYS_INLINE type sub(type a, type b) { return vsubq_f32(a, b); }
+  static MTS_ALWAYS_INLINE type mul(type a, type b) { return vmulq_f32(a, b); }
+  static MTS_ALWAYS_INLINE type div(type a, type b) { return vdivq_f32(a, b); }
+  static MTS_ALWAYS_INLINE type min(type a, type b) { return vminq_f32(a, b); }
+  static MTS_ALWAYS_INLINE type max(type a, type b) { return vmaxq_f32(a, b); }
+  static MTS_ALWAYS_INLINE type abs(type a) { return vabsq_f32(a); }
+  static MTS_ALWAYS_INLINE type sqrt(type a) { return vsqrtq_f32(a); }
+
+  // Round to nearest.
+  static MTS_ALWAYS_INLINE type round(type a) { return vrndnq_f32(a); }
+
+  // a * b + c
+  static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) { return vfmaq_f32(c, a, b); }
+
+  // Horizontal reductions.
+  static MTS_ALWAYS_INLINE float hsum(type a) { return vaddvq_f32(a); }
+  static MTS_ALWAYS_INLINE float hmin(type a) { return vminvq_f32(a); }
+  static MTS_ALWAYS_INLINE float hmax(type a) { return vmaxvq_f32(a); }
+
+  // Bit i is set when a[i] == b[i].
+  static MTS_ALWAYS_INLINE unsigned eq_mask(type a, type b) {
+    const std::uint32_t bits[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(vceqq_f32(a, b), vld1q_u32(bits)));
+  }
+
+  // In place transpose of size registers.
+  static MTS_ALWAYS_INLINE void transpose(type* m) {
+    const float32x4x2_t t01 = vtrnq_f32(m[0], m[1]);
+    const float32x4x2_t t23 = vtrnq_f32(m[2], m[3]);
+    m[0] = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    m[1] = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    m[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    m[3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int8(const std::int8_t* s) {
+    std::int32_t bits;
+    std::memcpy(&bits, s, sizeof(bits));
+    int16x8_t v = vmovl_s8(vreinterpret_s8_s32(vdup_n_s32(bits)));
+    return vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int16(const std::int16_t* s) { return vcvtq_f32_s32(vmovl_s16(vld1_s16(s))); }
+  static MTS_ALWAYS_INLINE type from_int32(const std::int32_t* s) { return vcvtq_f32_s32(vld1q_s32(s)); }
+
+  // Reads exactly 12 bytes and moves packed sample k to the top 3 bytes of lane k.
+  static MTS_ALWAYS_INLINE type from_int24(const mts::int24_t* s) {
+    static const std::uint8_t mask[16] = { 255, 0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 255, 9, 10, 11 };
+    const std::uint8_t* b = (const std::uint8_t*)(const void*)s;
+    std::uint32_t tail;
+    std::memcpy(&tail, b + 8, sizeof(tail));
+    const uint8x16_t v = vqtbl1q_u8(vcombine_u8(vld1_u8(b), vcreate_u8(tail)), vld1q_u8(mask));
+    return vcvtq_f32_s32(vshrq_n_s32(vreinterpretq_s32_u8(v), 8));
+  }
+
+  static MTS_ALWAYS_INLINE type from_float(const float* s) { return vld1q_f32(s); }
+
+  static MTS_ALWAYS_INLINE type from_double(const double* s) {
+    return vcombine_f32(vcvt_f32_f64(vld1q_f64(s)), vcvt_f32_f64(vld1q_f64(s + 2)));
+  }
+
+  // Rounds to nearest and stores size samples (v must be in the range of the integer type).
+  static MTS_ALWAYS_INLINE void to_int8(std::int8_t* d, type v) {
+    const int16x4_t x = vqmovn_s32(vcvtnq_s32_f32(v));
+    const std::int32_t bits = vget_lane_s32(vreinterpret_s32_s8(vqmovn_s16(vcombine_s16(x, x))), 0);
+    std::memcpy(d, &bits, sizeof(bits));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int16(std::int16_t* d, type v) { vst1_s16(d, vqmovn_s32(vcvtnq_s32_f32(v))); }
+  static MTS_ALWAYS_INLINE void to_int32(std::int32_t* d, type v) { vst1q_s32(d, vcvtnq_s32_f32(v)); }
+
+  static MTS_ALWAYS_INLINE void to_int24(mts::int24_t* d, type v) {
+    static const std::uint8_t mask[16] = { 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 255, 255, 255, 255 };
+    std::uint8_t* b = (std::uint8_t*)(void*)d;
+    const uint8x16_t p = vqtbl1q_u8(vreinterpretq_u8_s32(vcvtnq_s32_f32(v)), vld1q_u8(mask));
+    const std::uint32_t tail = vgetq_lane_u32(vreinterpretq_u32_u8(p), 2);
+    vst1_u8(b, vget_low_u8(p));
+    std::memcpy(b + 8, &tail, sizeof(tail));
+  }
+};
+
+template <>
+struct neon::reg<double> {
+  using value_type = double;
+  using type = float64x2_t;
+  static constexpr std::size_t size = 2;
+
+  static MTS_ALWAYS_INLINE type load(const double* s) { return vld1q_f64(s); }
+  static MTS_ALWAYS_INLINE void store(double* d, type v) { vst1q_f64(d, v); }
+  static MTS_ALWAYS_INLINE type set1(double v) { return vdupq_n_f64(v); }
+  static MTS_ALWAYS_INLINE type zero() { return vdupq_n_f64(0.0); }
+
+  static MTS_ALWAYS_INLINE type add(type a, type b) { return vaddq_f64(a, b); }
+  static MTS_ALWAYS_INLINE type sub(type a, type b) { return vsubq_f64(a, b); }
+  static MTS_ALWAYS_INLINE type mul(type a, type b) { return vmulq_f64(a, b); }
+  static MTS_ALWAYS_INLINE type div(type a, type b) { return vdivq_f64(a, b); }
+  static MTS_ALWAYS_INLINE type min(type a, type b) { return vminq_f64(a, b); }
+  static MTS_ALWAYS_INLINE type max(type a, type b) { return vmaxq_f64(a, b); }
+  static MTS_ALWAYS_INLINE type abs(type a) { return vabsq_f64(a); }
+  static MTS_ALWAYS_INLINE type sqrt(type a) { return vsqrtq_f64(a); }
+
+  // Round to nearest.
+  static MTS_ALWAYS_INLINE type round(type a) { return vrndnq_f64(a); }
+
+  // a * b + c
+  static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) { return vfmaq_f64(c, a, b); }
+
+  // Horizontal reductions.
+  static MTS_ALWAYS_INLINE double hsum(type a) { return vaddvq_f64(a); }
+  static MTS_ALWAYS_INLINE double hmin(type a) { return vminvq_f64(a); }
+  static MTS_ALWAYS_INLINE double hmax(type a) { return vmaxvq_f64(a); }
+
+  // Bit i is set when a[i] == b[i].
+  static MTS_ALWAYS_INLINE unsigned eq_mask(type a, type b) {
+    const std::uint64_t bits[2] = { 1, 2 };
+    return (unsigned)vaddvq_u64(vandq_u64(vceqq_f64(a, b), vld1q_u64(bits)));
+  }
+
+  // In place transpose of size registers.
+  static MTS_ALWAYS_INLINE void transpose(type* m) {
+    const type t = m[0];
+    m[0] = vzip1q_f64(t, m[1]);
+    m[1] = vzip2q_f64(t, m[1]);
+  }
+
+  static MTS_ALWAYS_INLINE type from_int8(const std::int8_t* s) {
+    const std::int32_t v[2] = { s[0], s[1] };
+    return vcvtq_f64_s64(vmovl_s32(vld1_s32(v)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int16(const std::int16_t* s) {
+    const std::int32_t v[2] = { s[0], s[1] };
+    return vcvtq_f64_s64(vmovl_s32(vld1_s32(v)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int32(const std::int32_t* s) { return vcvtq_f64_s64(vmovl_s32(vld1_s32(s))); }
+
+  static MTS_ALWAYS_INLINE type from_int24(const mts::int24_t* s) {
+    const std::int32_t v[2] = { s[0], s[1] };
+    return vcvtq_f64_s64(vmovl_s32(vld1_s32(v)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_float(const float* s) { return vcvt_f64_f32(vld1_f32(s)); }
+  static MTS_ALWAYS_INLINE type from_double(const double* s) { return vld1q_f64(s); }
+
+  // Rounds to nearest and stores size samples (v must be in the range of the integer type).
+  template <typename D>
+  static MTS_ALWAYS_INLINE void to_int(D* d, type v) {
+    std::int32_t w[2];
+    vst1_s32(w, vmovn_s64(vcvtnq_s64_f64(v)));
+    d[0] = (D)w[0];
+    d[1] = (D)w[1];
+  }
+
+  static MTS_ALWAYS_INLINE void to_int8(std::int8_t* d, type v) { to_int(d, v); }
+  static MTS_ALWAYS_INLINE void to_int16(std::int16_t* d, type v) { to_int(d, v); }
+  static MTS_ALWAYS_INLINE void to_int24(mts::int24_t* d, type v) { to_int(d, v); }
+  static MTS_ALWAYS_INLINE void to_int32(std::int32_t* d, type v) { vst1_s32(d, vmovn_s64(vcvtnq_s64_f64(v))); }
+};
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
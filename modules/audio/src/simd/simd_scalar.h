@@ -0,0 +1,76 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include <cmath>
+#include <cstddef>
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+
+///
+/// Single lane "register" with the same interface as the simd ones.
+///
+/// Lets kernels written for R (e.g. simd::approx_kernels) also run as plain
+/// scalar code, for simd_isa::none and when the simd backend isn't compiled in.
+///
+struct scalar {
+  template <typename T>
+  struct reg {
+    using value_type = T;
+    using type = T;
+    static constexpr std::size_t size = 1;
+
+    static MTS_ALWAYS_INLINE type load(const T* s) { return *s; }
+    static MTS_ALWAYS_INLINE void store(T* d, type v) { *d = v; }
+    static MTS_ALWAYS_INLINE type set1(T v) { return v; }
+    static MTS_ALWAYS_INLINE type zero() { return T(0); }
+
+    static MTS_ALWAYS_INLINE type add(type a, type b) { return a + b; }
+    static MTS_ALWAYS_INLINE type sub(type a, type b) { return a - b; }
+    static MTS_ALWAYS_INLINE type mul(type a, type b) { return a * b; }
+    static MTS_ALWAYS_INLINE type div(type a, type b) { return a / b; }
+    static MTS_ALWAYS_INLINE type min(type a, type b) { return b < a ? b : a; }
+    static MTS_ALWAYS_INLINE type max(type a, type b) { return a < b ? b : a; }
+    static MTS_ALWAYS_INLINE type abs(type a) { return std::abs(a); }
+
+    // Round to nearest.
+    static MTS_ALWAYS_INLINE type round(type a) { return std::nearbyint(a); }
+
+    // a * b + c
+    static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) { return a * b + c; }
+  };
+};
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
@@ -0,0 +1,268 @@
+///
+/// BSD 3-Clause License
+///
+/// Copyright (c) 2022, Alexandre Arsenault
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// * Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+/// * Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// * Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+#include "mts/config.h"
+#include "mts/int24_t.h"
+#include <emmintrin.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace simd {
+
+///
+/// sse2 registers.
+///
+/// sse2 is part of the x86-64 baseline and is always available.
+///
+struct sse2 {
+  template <typename T>
+  struct reg;
+
+  // Loads exactly 4 packed 24 bit samples (12 bytes).
+  static MTS_ALWAYS_INLINE __m128i load_int24x4(const mts::int24_t* s) {
+    std::int32_t tail;
+    std::memcpy(&tail, (const std::uint8_t*)(const void*)s + 8, sizeof(tail));
+    return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)s), _mm_cvtsi32_si128(tail));
+  }
+
+  // Moves packed sample k to lane k and sign extends it. There is no byte
+  // shuffle in sse2, the lanes are gathered with byte shifts instead.
+  static MTS_ALWAYS_INLINE __m128i unpack_int24(__m128i v) {
+    const __m128i lo = _mm_unpacklo_epi32(v, _mm_srli_si128(v, 3));
+    const __m128i hi = _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9));
+    return _mm_srai_epi32(_mm_slli_epi32(_mm_unpacklo_epi64(lo, hi), 8), 8);
+  }
+
+  // Inverse of unpack_int24, the 12 packed bytes are left in the low bytes.
+  static MTS_ALWAYS_INLINE __m128i pack_int24(__m128i v) {
+    const __m128i even = _mm_and_si128(v, _mm_set_epi32(0, 0xFFFFFF, 0, 0xFFFFFF));
+    const __m128i odd = _mm_and_si128(v, _mm_set_epi32(0xFFFFFF, 0, 0xFFFFFF, 0));
+    const __m128i p = _mm_or_si128(even, _mm_srli_epi64(odd, 8));
+    return _mm_or_si128(_mm_move_epi64(p), _mm_slli_si128(_mm_srli_si128(p, 8), 6));
+  }
+
+  // Stores exactly 4 packed 24 bit samples (12 bytes).
+  static MTS_ALWAYS_INLINE void store_int24x4(mts::int24_t* d, __m128i v) {
+    v = pack_int24(v);
+    const std::int32_t tail = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+    _mm_storel_epi64((__m128i*)d, v);
+    std::memcpy((std::uint8_t*)(void*)d + 8, &tail, sizeof(tail));
+  }
+};
+
+template <>
+struct sse2::reg<float> {
+  using value_type = float;
+  using type = __m128;
+  static constexpr std::size_t size = 4;
+
+  static MTS_ALWAYS_INLINE type load(const float* s) { return _mm_loadu_ps(s); }
+  static MTS_ALWAYS_INLINE void store(float* d, type v) { _mm_storeu_ps(d, v); }
+  static MTS_ALWAYS_INLINE type set1(float v) { return _mm_set1_ps(v); }
+  static MTS_ALWAYS_INLINE type zero() { return _mm_setzero_ps(); }
+
+  static MTS_ALWAYS_INLINE type add(type a, type b) { return _mm_add_ps(a, b); }
+  static MTS_ALWAYS_INLINE type sub(type a, type b) { return _mm_sub_ps(a, b); }
+  static MTS_ALWAYS_INLINE type mul(type a, type b) { return _mm_mul_ps(a, b); }
+  static MTS_ALWAYS_INLINE type div(type a, type b) { return _mm_div_ps(a, b); }
+  static MTS_ALWAYS_INLINE type min(type a, type b) { return _mm_min_ps(a, b); }
+  static MTS_ALWAYS_INLINE type max(type a, type b) { return _mm_max_ps(a, b); }
+  static MTS_ALWAYS_INLINE type abs(type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  static MTS_ALWAYS_INLINE type sqrt(type a) { return _mm_sqrt_ps(a); }
+
+  // Round to nearest (valid for |a| < 2^31).
+  static MTS_ALWAYS_INLINE type round(type a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+
+  // a * b + c
+  static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+  // Horizontal reductions.
+  static MTS_ALWAYS_INLINE float hsum(type a) {
+    a = _mm_add_ps(a, _mm_movehl_ps(a, a));
+    return _mm_cvtss_f32(_mm_add_ss(a, _mm_shuffle_ps(a, a, 1)));
+  }
+
+  static MTS_ALWAYS_INLINE float hmin(type a) {
+    a = _mm_min_ps(a, _mm_movehl_ps(a, a));
+    return _mm_cvtss_f32(_mm_min_ss(a, _mm_shuffle_ps(a, a, 1)));
+  }
+
+  static MTS_ALWAYS_INLINE float hmax(type a) {
+    a = _mm_max_ps(a, _mm_movehl_ps(a, a));
+    return _mm_cvtss_f32(_mm_max_ss(a, _mm_shuffle_ps(a, a, 1)));
+  }
+
+  // Bit i is set when a[i] == b[i].
+  static MTS_ALWAYS_INLINE unsigned eq_mask(type a, type b) { return (unsigned)_mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+
+  // In place transpose of size registers.
+  static MTS_ALWAYS_INLINE void transpose(type* m) { _MM_TRANSPOSE4_PS(m[0], m[1], m[2], m[3]); }
+
+  static MTS_ALWAYS_INLINE type from_int8(const std::int8_t* s) {
+    std::int32_t bits;
+    std::memcpy(&bits, s, sizeof(bits));
+    __m128i v = _mm_cvtsi32_si128(bits);
+    v = _mm_unpacklo_epi8(v, v);
+    v = _mm_unpacklo_epi16(v, v);
+    return _mm_cvtepi32_ps(_mm_srai_epi32(v, 24));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int16(const std::int16_t* s) {
+    __m128i v = _mm_loadl_epi64((const __m128i*)s);
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int32(const std::int32_t* s) {
+    return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)s));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int24(const mts::int24_t* s) {
+    return _mm_cvtepi32_ps(sse2::unpack_int24(sse2::load_int24x4(s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_float(const float* s) { return _mm_loadu_ps(s); }
+
+  // Rounds to nearest and stores size samples (v must be in the range of the integer type).
+  static MTS_ALWAYS_INLINE void to_int8(std::int8_t* d, type v) {
+    __m128i x = _mm_cvtps_epi32(v);
+    x = _mm_packs_epi16(_mm_packs_epi32(x, x), x);
+    const std::int32_t bits = _mm_cvtsi128_si32(x);
+    std::memcpy(d, &bits, sizeof(bits));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int16(std::int16_t* d, type v) {
+    const __m128i x = _mm_cvtps_epi32(v);
+    _mm_storel_epi64((__m128i*)d, _mm_packs_epi32(x, x));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int24(mts::int24_t* d, type v) { sse2::store_int24x4(d, _mm_cvtps_epi32(v)); }
+  static MTS_ALWAYS_INLINE void to_int32(std::int32_t* d, type v) { _mm_storeu_si128((__m128i*)d, _mm_cvtps_epi32(v)); }
+
+  static MTS_ALWAYS_INLINE type from_double(const double* s) {
+    return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(s)), _mm_cvtpd_ps(_mm_loadu_pd(s + 2)));
+  }
+};
+
+template <>
+struct sse2::reg<double> {
+  using value_type = double;
+  using type = __m128d;
+  static constexpr std::size_t size = 2;
+
+  static MTS_ALWAYS_INLINE type load(const double* s) { return _mm_loadu_pd(s); }
+  static MTS_ALWAYS_INLINE void store(double* d, type v) { _mm_storeu_pd(d, v); }
+  static MTS_ALWAYS_INLINE type set1(double v) { return _mm_set1_pd(v); }
+  static MTS_ALWAYS_INLINE type zero() { return _mm_setzero_pd(); }
+
+  static MTS_ALWAYS_INLINE type add(type a, type b) { return _mm_add_pd(a, b); }
+  static MTS_ALWAYS_INLINE type sub(type a, type b) { return _mm_sub_pd(a, b); }
+  static MTS_ALWAYS_INLINE type mul(type a, type b) { return _mm_mul_pd(a, b); }
+  static MTS_ALWAYS_INLINE type div(type a, type b) { return _mm_div_pd(a, b); }
+  static MTS_ALWAYS_INLINE type min(type a, type b) { return _mm_min_pd(a, b); }
+  static MTS_ALWAYS_INLINE type max(type a, type b) { return _mm_max_pd(a, b); }
+  static MTS_ALWAYS_INLINE type abs(type a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+  static MTS_ALWAYS_INLINE type sqrt(type a) { return _mm_sqrt_pd(a); }
+
+  // Round to nearest (valid for |a| < 2^31).
+  static MTS_ALWAYS_INLINE type round(type a) { return _mm_cvtepi32_pd(_mm_cvtpd_epi32(a)); }
+
+  // a * b + c
+  static MTS_ALWAYS_INLINE type fmadd(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+  // Horizontal reductions.
+  static MTS_ALWAYS_INLINE double hsum(type a) { return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a))); }
+  static MTS_ALWAYS_INLINE double hmin(type a) { return _mm_cvtsd_f64(_mm_min_sd(a, _mm_unpackhi_pd(a, a))); }
+  static MTS_ALWAYS_INLINE double hmax(type a) { return _mm_cvtsd_f64(_mm_max_sd(a, _mm_unpackhi_pd(a, a))); }
+
+  // Bit i is set when a[i] == b[i].
+  static MTS_ALWAYS_INLINE unsigned eq_mask(type a, type b) { return (unsigned)_mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+
+  // In place transpose of size registers.
+  static MTS_ALWAYS_INLINE void transpose(type* m) {
+    const type t = m[0];
+    m[0] = _mm_unpacklo_pd(t, m[1]);
+    m[1] = _mm_unpackhi_pd(t, m[1]);
+  }
+
+  static MTS_ALWAYS_INLINE type from_int8(const std::int8_t* s) { return _mm_set_pd((double)s[1], (double)s[0]); }
+
+  static MTS_ALWAYS_INLINE type from_int16(const std::int16_t* s) {
+    std::int32_t bits;
+    std::memcpy(&bits, s, sizeof(bits));
+    __m128i v = _mm_cvtsi32_si128(bits);
+    return _mm_cvtepi32_pd(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int32(const std::int32_t* s) {
+    return _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)s));
+  }
+
+  static MTS_ALWAYS_INLINE type from_float(const float* s) {
+    return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)s)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_int24(const mts::int24_t* s) {
+    std::int64_t bits = 0;
+    std::memcpy(&bits, s, 2 * sizeof(mts::int24_t));
+    return _mm_cvtepi32_pd(sse2::unpack_int24(_mm_loadl_epi64((const __m128i*)&bits)));
+  }
+
+  static MTS_ALWAYS_INLINE type from_double(const double* s) { return _mm_loadu_pd(s); }
+
+  // Rounds to nearest and stores size samples (v must be in the range of the integer type).
+  static MTS_ALWAYS_INLINE void to_int8(std::int8_t* d, type v) {
+    __m128i x = _mm_cvtpd_epi32(v);
+    x = _mm_packs_epi16(_mm_packs_epi32(x, x), x);
+    const std::int16_t bits = (std::int16_t)_mm_cvtsi128_si32(x);
+    std::memcpy(d, &bits, sizeof(bits));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int16(std::int16_t* d, type v) {
+    const __m128i x = _mm_cvtpd_epi32(v);
+    const std::int32_t bits = _mm_cvtsi128_si32(_mm_packs_epi32(x, x));
+    std::memcpy(d, &bits, sizeof(bits));
+  }
+
+  static MTS_ALWAYS_INLINE void to_int32(std::int32_t* d, type v) { _mm_storel_epi64((__m128i*)d, _mm_cvtpd_epi32(v)); }
+
+  static MTS_ALWAYS_INLINE void to_int24(mts::int24_t* d, type v) {
+    std::int64_t bits;
+    _mm_storel_epi64((__m128i*)&bits, sse2::pack_int24(_mm_cvtpd_epi32(v)));
+    std::memcpy((void*)d, &bits, 2 * sizeof(mts::int24_t));
+  }
+};
+} // namespace simd.
+MTS_END_SUB_NAMESPACE(vec)
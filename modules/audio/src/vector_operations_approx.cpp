@@ -0,0 +1,93 @@
+#include "mts/audio/detail/vector_operations_approx.h"
+#include "simd/simd_approx.h"
+
+#if __MTS_USE_SIMD__
+  #include "simd/simd_dispatch.h"
+#else
+  #include "simd/simd_scalar.h"
+#endif
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace {
+#if __MTS_USE_SIMD__
+template <typename T>
+inline const simd::table_t<T>& table() noexcept {
+  return simd::get_current_table().get<T>();
+}
+
+  #define __MTS_APPROX_CALL(T, NAME, ...) table<T>().NAME(__VA_ARGS__)
+#else
+// Without the simd backend (e.g. with Accelerate) the kernels run one sample at a time.
+template <typename T>
+using kernels = simd::approx_kernels<simd::scalar::reg<T>>;
+
+  #define __MTS_APPROX_CALL(T, NAME, ...) kernels<T>::NAME(__VA_ARGS__)
+#endif
+} // namespace.
+
+void approx_ops::sin(const float* s1, float* d1, length_t length) {
+  __MTS_APPROX_CALL(float, sin_approx, s1, d1, length);
+}
+
+void approx_ops::sin(const double* s1, double* d1, length_t length) {
+  __MTS_APPROX_CALL(double, sin_approx, s1, d1, length);
+}
+
+void approx_ops::cos(const float* s1, float* d1, length_t length) {
+  __MTS_APPROX_CALL(float, cos_approx, s1, d1, length);
+}
+
+void approx_ops::cos(const double* s1, double* d1, length_t length) {
+  __MTS_APPROX_CALL(double, cos_approx, s1, d1, length);
+}
+
+void approx_ops::tan(const float* s1, float* d1, length_t length) {
+  __MTS_APPROX_CALL(float, tan_approx, s1, d1, length);
+}
+
+void approx_ops::tan(const double* s1, double* d1, length_t length) {
+  __MTS_APPROX_CALL(double, tan_approx, s1, d1, length);
+}
+
+void approx_ops::tanh(const float* s1, float* d1, length_t length) {
+  __MTS_APPROX_CALL(float, tanh_approx, s1, d1, length);
+}
+
+void approx_ops::tanh(const double* s1, double* d1, length_t length) {
+  __MTS_APPROX_CALL(double, tanh_approx, s1, d1, length);
+}
+
+void fast_approx_ops::sin(const float* s1, float* d1, length_t length) {
+  __MTS_APPROX_CALL(float, sin_fast, s1, d1, length);
+}
+
+void fast_approx_ops::sin(const double* s1, double* d1, length_t length) {
+  __MTS_APPROX_CALL(double, sin_fast, s1, d1, length);
+}
+
+void fast_approx_ops::cos(const float* s1, float* d1, length_t length) {
+  __MTS_APPROX_CALL(float, cos_fast, s1, d1, length);
+}
+
+void fast_approx_ops::cos(const double* s1, double* d1, length_t length) {
+  __MTS_APPROX_CALL(double, cos_fast, s1, d1, length);
+}
+
+void fast_approx_ops::tan(const float* s1, float* d1, length_t length) {
+  __MTS_APPROX_CALL(float, tan_fast, s1, d1, length);
+}
+
+void fast_approx_ops::tan(const double* s1, double* d1, length_t length) {
+  __MTS_APPROX_CALL(double, tan_fast, s1, d1, length);
+}
+
+void fast_approx_ops::tanh(const float* s1, float* d1, length_t length) {
+  __MTS_APPROX_CALL(float, tanh_fast, s1, d1, length);
+}
+
+void fast_approx_ops::tanh(const double* s1, double* d1, length_t length) {
+  __MTS_APPROX_CALL(double, tanh_fast, s1, d1, length);
+}
+
+#undef __MTS_APPROX_CALL
+MTS_END_SUB_NAMESPACE(vec)
@@ -0,0 +1,672 @@
+#include "mts/audio/detail/vector_operations_simd.h"
+
+#if __MTS_USE_SIMD__
+  #include "simd/simd_dispatch.h"
+  #include "simd/simd_approx.h"
+  #include "simd/simd_scalar.h"
+  #include <atomic>
+  #include <cstdlib>
+  #include <string_view>
+  #include <utility>
+
+  #if __MTS_ARCH_X86_64__ && __MTS_MSVC__
+    #include <intrin.h>
+  #endif
+
+MTS_BEGIN_SUB_NAMESPACE(vec)
+namespace {
+template <typename T>
+struct scalar_ops : base_ops, simd::approx_kernels<simd::scalar::reg<T>> {};
+
+constexpr simd::table scalar_table
+    = { simd_isa::none, simd::make_table<scalar_ops<float>, float>(), simd::make_table<scalar_ops<double>, double>() };
+
+bool cpu_supports(simd_isa isa) noexcept {
+  #if __MTS_ARCH_X86_64__
+    #if __MTS_MSVC__
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+
+  __cpuid(info, 1);
+  const bool has_fma = (info[2] & (1 << 12)) != 0;
+  const bool has_osxsave = (info[2] & (1 << 27)) != 0;
+  const bool has_avx = (info[2] & (1 << 28)) != 0;
+
+  if (!has_osxsave || !has_avx || max_leaf < 7) {
+    return isa == simd_isa::sse2;
+  }
+
+  const unsigned long long xcr0 = _xgetbv(0);
+  __cpuidex(info, 7, 0);
+
+  switch (isa) {
+  case simd_isa::sse2:
+    return true;
+
+  case simd_isa::avx2:
+    // The os has to save the ymm registers.
+    return (xcr0 & 0x6) == 0x6 && has_fma && (info[1] & (1 << 5)) != 0;
+
+  case simd_isa::avx512:
+    // The os has to save the opmask and zmm registers.
+    return (xcr0 & 0xE6) == 0xE6 && has_fma && (info[1] & (1 << 16)) != 0;
+
+  default:
+    return false;
+  }
+    #else
+  __builtin_cpu_init();
+
+  switch (isa) {
+  case simd_isa::sse2:
+    return true;
+
+  case simd_isa::avx2:
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+  case simd_isa::avx512:
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma");
+
+  default:
+    return false;
+  }
+    #endif
+
+  #elif __MTS_ARCH_ARM_64__
+  // neon is part of the armv8 baseline.
+  return isa == simd_isa::neon;
+
+  #else
+  return false;
+  #endif
+}
+
+/// Returns the table for the given instruction set or nullptr if it can't run.
+const simd::table* find_table(simd_isa isa) noexcept {
+  const simd::table* t = nullptr;
+
+  switch (isa) {
+  case simd_isa::none:
+    return &scalar_table;
+
+  case simd_isa::sse2:
+    t = simd::get_sse2_table();
+    break;
+
+  case simd_isa::avx2:
+    t = simd::get_avx2_table();
+    break;
+
+  case simd_isa::avx512:
+    t = simd::get_avx512_table();
+    break;
+
+  case simd_isa::neon:
+    t = simd::get_neon_table();
+    break;
+  }
+
+  return t && cpu_supports(isa) ? t : nullptr;
+}
+
+const simd::table* find_best_table() noexcept {
+  for (simd_isa isa : { simd_isa::avx512, simd_isa::avx2, simd_isa::sse2, simd_isa::neon }) {
+    if (const simd::table* t = find_table(isa)) {
+      return t;
+    }
+  }
+
+  return &scalar_table;
+}
+
+/// Returns the instruction set requested by the MTS_SIMD_ISA environment variable.
+bool get_env_isa(simd_isa& isa) noexcept {
+  const char* env = std::getenv("MTS_SIMD_ISA");
+  if (!env) {
+    return false;
+  }
+
+  constexpr std::pair<std::string_view, simd_isa> names[] = { { "none", simd_isa::none }, { "sse2", simd_isa::sse2 },
+    { "avx2", simd_isa::avx2 }, { "avx512", simd_isa::avx512 }, { "neon", simd_isa::neon } };
+
+  for (const auto& n : names) {
+    if (n.first == env) {
+      isa = n.second;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::atomic<const simd::table*> current_table = nullptr;
+
+const simd::table& init_table() noexcept {
+  const simd::table* t = nullptr;
+
+  if (simd_isa isa; get_env_isa(isa)) {
+    t = find_table(isa);
+  }
+
+  if (!t) {
+    t = find_best_table();
+  }
+
+  // Keep whatever set_simd_isa() may have stored in the meantime.
+  const simd::table* expected = nullptr;
+  return current_table.compare_exchange_strong(expected, t, std::memory_order_acq_rel) ? *t : *expected;
+}
+
+inline const simd::table& get_table() noexcept {
+  const simd::table* t = current_table.load(std::memory_order_acquire);
+  return __MTS_LIKELY(t) ? *t : init_table();
+}
+
+template <typename T>
+inline const simd::table_t<T>& table() noexcept {
+  return get_table().get<T>();
+}
+} // namespace.
+
+const simd::table& simd::get_current_table() noexcept { return get_table(); }
+
+simd_isa get_simd_isa() noexcept { return get_table().isa; }
+
+bool is_simd_isa_supported(simd_isa isa) noexcept { return find_table(isa) != nullptr; }
+
+bool set_simd_isa(simd_isa isa) noexcept {
+  if (const simd::table* t = find_table(isa)) {
+    current_table.store(t, std::memory_order_release);
+    return true;
+  }
+
+  return false;
+}
+
+void simd_ops::fill(float* sd, stride_t s_sd, float value, length_t length) {
+  table<float>().fill(sd, s_sd, value, length);
+}
+
+void simd_ops::fill(double* sd, stride_t s_sd, double value, length_t length) {
+  table<double>().fill(sd, s_sd, value, length);
+}
+
+void simd_ops::clip(const float* s1, stride_t s_s1, float min, float max, float* d1, stride_t s_d1, length_t length) {
+  table<float>().clip(s1, s_s1, min, max, d1, s_d1, length);
+}
+
+void simd_ops::clip(
+    const double* s1, stride_t s_s1, double min, double max, double* d1, stride_t s_d1, length_t length) {
+  table<double>().clip(s1, s_s1, min, max, d1, s_d1, length);
+}
+
+void simd_ops::abs(const float* s1, stride_t s_s1, float* d1, stride_t s_d1, length_t length) {
+  table<float>().abs(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::abs(const double* s1, stride_t s_s1, double* d1, stride_t s_d1, length_t length) {
+  table<double>().abs(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::sqrt(const float* s1, float* d1, length_t length) { table<float>().sqrt(s1, d1, length); }
+
+void simd_ops::sqrt(const double* s1, double* d1, length_t length) { table<double>().sqrt(s1, d1, length); }
+
+void simd_ops::add(const float* s1, stride_t s_s1, float value, float* d1, stride_t s_d1, length_t length) {
+  table<float>().s_add(s1, s_s1, value, d1, s_d1, length);
+}
+
+void simd_ops::add(const double* s1, stride_t s_s1, double value, double* d1, stride_t s_d1, length_t length) {
+  table<double>().s_add(s1, s_s1, value, d1, s_d1, length);
+}
+
+void simd_ops::mul(const float* s1, stride_t s_s1, float value, float* d1, stride_t s_d1, length_t length) {
+  table<float>().s_mul(s1, s_s1, value, d1, s_d1, length);
+}
+
+void simd_ops::mul(const double* s1, stride_t s_s1, double value, double* d1, stride_t s_d1, length_t length) {
+  table<double>().s_mul(s1, s_s1, value, d1, s_d1, length);
+}
+
+void simd_ops::div(const float* s1, stride_t s_s1, float value, float* d1, stride_t s_d1, length_t length) {
+  table<float>().s_div(s1, s_s1, value, d1, s_d1, length);
+}
+
+void simd_ops::div(const double* s1, stride_t s_s1, double value, double* d1, stride_t s_d1, length_t length) {
+  table<double>().s_div(s1, s_s1, value, d1, s_d1, length);
+}
+
+void simd_ops::vdiv(float value, const float* s1, stride_t s_s1, float* d1, stride_t s_d1, length_t length) {
+  table<float>().s_vdiv(value, s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::vdiv(double value, const double* s1, stride_t s_s1, double* d1, stride_t s_d1, length_t length) {
+  table<double>().s_vdiv(value, s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::sum(
+    const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  table<float>().v_sum(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::sum(
+    const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  table<double>().v_sum(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::sub(
+    const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  table<float>().v_sub(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::sub(
+    const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  table<double>().v_sub(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::mul(
+    const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  table<float>().v_mul(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::mul(
+    const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  table<double>().v_mul(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::div(
+    const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  table<float>().v_div(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::div(
+    const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  table<double>().v_div(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::sum_mul(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float value, float* d1,
+    stride_t s_d1, length_t length) {
+  table<float>().sum_s_mul(s1, s_s1, s2, s_s2, value, d1, s_d1, length);
+}
+
+void simd_ops::sum_mul(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double value, double* d1,
+    stride_t s_d1, length_t length) {
+  table<double>().sum_s_mul(s1, s_s1, s2, s_s2, value, d1, s_d1, length);
+}
+
+void simd_ops::sum_mul(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, const float* s3, stride_t s_s3,
+    float* d1, stride_t s_d1, length_t length) {
+  table<float>().sum_v_mul(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+void simd_ops::sum_mul(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, const double* s3,
+    stride_t s_s3, double* d1, stride_t s_d1, length_t length) {
+  table<double>().sum_v_mul(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+void simd_ops::sum_mul(const float* s1, stride_t s_s1, float value, const float* s2, stride_t s_s2, float* d1,
+    stride_t s_d1, length_t length) {
+  table<float>().sum_mul(s1, s_s1, value, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::sum_mul(const double* s1, stride_t s_s1, double value, const double* s2, stride_t s_s2, double* d1,
+    stride_t s_d1, length_t length) {
+  table<double>().sum_mul(s1, s_s1, value, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::mul_sum(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float value, float* d1,
+    stride_t s_d1, length_t length) {
+  table<float>().mul_s_sum(s1, s_s1, s2, s_s2, value, d1, s_d1, length);
+}
+
+void simd_ops::mul_sum(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double value, double* d1,
+    stride_t s_d1, length_t length) {
+  table<double>().mul_s_sum(s1, s_s1, s2, s_s2, value, d1, s_d1, length);
+}
+
+void simd_ops::mul_sum(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, const float* s3, stride_t s_s3,
+    float* d1, stride_t s_d1, length_t length) {
+  table<float>().mul_v_sum(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+void simd_ops::mul_sum(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, const double* s3,
+    stride_t s_s3, double* d1, stride_t s_d1, length_t length) {
+  table<double>().mul_v_sum(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+void simd_ops::mul_sum(const float* s1, stride_t s_s1, float value, const float* s2, stride_t s_s2, float* d1,
+    stride_t s_d1, length_t length) {
+  table<float>().mul_sum(s1, s_s1, value, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::mul_sum(const double* s1, stride_t s_s1, double value, const double* s2, stride_t s_s2, double* d1,
+    stride_t s_d1, length_t length) {
+  table<double>().mul_sum(s1, s_s1, value, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::ramp(float* d1, stride_t s_d1, float start, float increment, length_t length) {
+  table<float>().ramp(d1, s_d1, start, increment, length);
+}
+
+void simd_ops::ramp(double* d1, stride_t s_d1, double start, double increment, length_t length) {
+  table<double>().ramp(d1, s_d1, start, increment, length);
+}
+
+void simd_ops::mul_ramp(
+    const float* s1, stride_t s_s1, float start, float increment, float* d1, stride_t s_d1, length_t length) {
+  table<float>().mul_ramp(s1, s_s1, start, increment, d1, s_d1, length);
+}
+
+void simd_ops::mul_ramp(
+    const double* s1, stride_t s_s1, double start, double increment, double* d1, stride_t s_d1, length_t length) {
+  table<double>().mul_ramp(s1, s_s1, start, increment, d1, s_d1, length);
+}
+
+void simd_ops::mul_ramp_add(const float* s1, stride_t s_s1, float start, float increment, const float* s2,
+    stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  table<float>().mul_ramp_add(s1, s_s1, start, increment, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::mul_ramp_add(const double* s1, stride_t s_s1, double start, double increment, const double* s2,
+    stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  table<double>().mul_ramp_add(s1, s_s1, start, increment, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::exp_ramp(float* d1, stride_t s_d1, float start, float ratio, length_t length) {
+  table<float>().exp_ramp(d1, s_d1, start, ratio, length);
+}
+
+void simd_ops::exp_ramp(double* d1, stride_t s_d1, double start, double ratio, length_t length) {
+  table<double>().exp_ramp(d1, s_d1, start, ratio, length);
+}
+
+void simd_ops::mul_exp_ramp(
+    const float* s1, stride_t s_s1, float start, float ratio, float* d1, stride_t s_d1, length_t length) {
+  table<float>().mul_exp_ramp(s1, s_s1, start, ratio, d1, s_d1, length);
+}
+
+void simd_ops::mul_exp_ramp(
+    const double* s1, stride_t s_s1, double start, double ratio, double* d1, stride_t s_d1, length_t length) {
+  table<double>().mul_exp_ramp(s1, s_s1, start, ratio, d1, s_d1, length);
+}
+
+void simd_ops::mul_exp_ramp_add(const float* s1, stride_t s_s1, float start, float ratio, const float* s2,
+    stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  table<float>().mul_exp_ramp_add(s1, s_s1, start, ratio, s2, s_s2, d1, s_d1, length);
+}
+
+void simd_ops::mul_exp_ramp_add(const double* s1, stride_t s_s1, double start, double ratio, const double* s2,
+    stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  table<double>().mul_exp_ramp_add(s1, s_s1, start, ratio, s2, s_s2, d1, s_d1, length);
+}
+
+float simd_ops::sum(const float* s1, stride_t s_s1, length_t length) { return table<float>().sum(s1, s_s1, length); }
+
+double simd_ops::sum(const double* s1, stride_t s_s1, length_t length) { return table<double>().sum(s1, s_s1, length); }
+
+float simd_ops::sum_of_squares(const float* s1, stride_t s_s1, length_t length) {
+  return table<float>().sum_of_squares(s1, s_s1, length);
+}
+
+double simd_ops::sum_of_squares(const double* s1, stride_t s_s1, length_t length) {
+  return table<double>().sum_of_squares(s1, s_s1, length);
+}
+
+float simd_ops::rms(const float* s1, stride_t s_s1, length_t length) { return table<float>().rms(s1, s_s1, length); }
+
+double simd_ops::rms(const double* s1, stride_t s_s1, length_t length) { return table<double>().rms(s1, s_s1, length); }
+
+float simd_ops::max_abs(const float* s1, stride_t s_s1, length_t length) {
+  return table<float>().max_abs(s1, s_s1, length);
+}
+
+double simd_ops::max_abs(const double* s1, stride_t s_s1, length_t length) {
+  return table<double>().max_abs(s1, s_s1, length);
+}
+
+indexed_value<float> simd_ops::min_index(const float* s1, stride_t s_s1, length_t length) {
+  return table<float>().min_index(s1, s_s1, length);
+}
+
+indexed_value<double> simd_ops::min_index(const double* s1, stride_t s_s1, length_t length) {
+  return table<double>().min_index(s1, s_s1, length);
+}
+
+indexed_value<float> simd_ops::max_index(const float* s1, stride_t s_s1, length_t length) {
+  return table<float>().max_index(s1, s_s1, length);
+}
+
+indexed_value<double> simd_ops::max_index(const double* s1, stride_t s_s1, length_t length) {
+  return table<double>().max_index(s1, s_s1, length);
+}
+
+float simd_ops::dot(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, length_t length) {
+  return table<float>().dot(s1, s_s1, s2, s_s2, length);
+}
+
+double simd_ops::dot(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, length_t length) {
+  return table<double>().dot(s1, s_s1, s2, s_s2, length);
+}
+
+void simd_ops::convert_from_int8(const std::int8_t* s1, stride_t s_s1, float* d1, length_t length) {
+  table<float>().convert_from_int8(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_int8(const std::int8_t* s1, stride_t s_s1, double* d1, length_t length) {
+  table<double>().convert_from_int8(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_int16(const std::int16_t* s1, stride_t s_s1, float* d1, length_t length) {
+  table<float>().convert_from_int16(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_int16(const std::int16_t* s1, stride_t s_s1, double* d1, length_t length) {
+  table<double>().convert_from_int16(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_int24(const mts::int24_t* s1, stride_t s_s1, float* d1, length_t length) {
+  table<float>().convert_from_int24(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_int24(const mts::int24_t* s1, stride_t s_s1, double* d1, length_t length) {
+  table<double>().convert_from_int24(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_int32(const std::int32_t* s1, stride_t s_s1, float* d1, length_t length) {
+  table<float>().convert_from_int32(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_int32(const std::int32_t* s1, stride_t s_s1, double* d1, length_t length) {
+  table<double>().convert_from_int32(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_float(const float* s1, stride_t s_s1, float* d1, length_t length) {
+  table<float>().convert_from_float(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_float(const float* s1, stride_t s_s1, double* d1, length_t length) {
+  table<double>().convert_from_float(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_double(const double* s1, stride_t s_s1, float* d1, length_t length) {
+  table<float>().convert_from_double(s1, s_s1, d1, length);
+}
+
+void simd_ops::convert_from_double(const double* s1, stride_t s_s1, double* d1, length_t length) {
+  table<double>().convert_from_double(s1, s_s1, d1, length);
+}
+
+void simd_ops::deinterleave_from_int8(
+    const std::int8_t* s1, stride_t s_s1, float* const* d, length_t n_channels, length_t length) {
+  table<float>().deinterleave_from_int8(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_int8(
+    const std::int8_t* s1, stride_t s_s1, double* const* d, length_t n_channels, length_t length) {
+  table<double>().deinterleave_from_int8(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_int16(
+    const std::int16_t* s1, stride_t s_s1, float* const* d, length_t n_channels, length_t length) {
+  table<float>().deinterleave_from_int16(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_int16(
+    const std::int16_t* s1, stride_t s_s1, double* const* d, length_t n_channels, length_t length) {
+  table<double>().deinterleave_from_int16(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_int24(
+    const mts::int24_t* s1, stride_t s_s1, float* const* d, length_t n_channels, length_t length) {
+  table<float>().deinterleave_from_int24(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_int24(
+    const mts::int24_t* s1, stride_t s_s1, double* const* d, length_t n_channels, length_t length) {
+  table<double>().deinterleave_from_int24(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_int32(
+    const std::int32_t* s1, stride_t s_s1, float* const* d, length_t n_channels, length_t length) {
+  table<float>().deinterleave_from_int32(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_int32(
+    const std::int32_t* s1, stride_t s_s1, double* const* d, length_t n_channels, length_t length) {
+  table<double>().deinterleave_from_int32(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_float(
+    const float* s1, stride_t s_s1, float* const* d, length_t n_channels, length_t length) {
+  table<float>().deinterleave_from_float(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_float(
+    const float* s1, stride_t s_s1, double* const* d, length_t n_channels, length_t length) {
+  table<double>().deinterleave_from_float(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_double(
+    const double* s1, stride_t s_s1, float* const* d, length_t n_channels, length_t length) {
+  table<float>().deinterleave_from_double(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::deinterleave_from_double(
+    const double* s1, stride_t s_s1, double* const* d, length_t n_channels, length_t length) {
+  table<double>().deinterleave_from_double(s1, s_s1, d, n_channels, length);
+}
+
+void simd_ops::interleave_from_float(
+    const float* const* s, float* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<float>().interleave_from_float(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_from_float(
+    const float* const* s, double* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<double>().interleave_from_float(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_from_double(
+    const double* const* s, float* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<float>().interleave_from_double(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_from_double(
+    const double* const* s, double* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<double>().interleave_from_double(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::convert_to_int8(const float* s1, stride_t s_s1, std::int8_t* d1, stride_t s_d1, length_t length) {
+  table<float>().convert_to_int8(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::convert_to_int8(const double* s1, stride_t s_s1, std::int8_t* d1, stride_t s_d1, length_t length) {
+  table<double>().convert_to_int8(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::convert_to_int16(const float* s1, stride_t s_s1, std::int16_t* d1, stride_t s_d1, length_t length) {
+  table<float>().convert_to_int16(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::convert_to_int16(const double* s1, stride_t s_s1, std::int16_t* d1, stride_t s_d1, length_t length) {
+  table<double>().convert_to_int16(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::convert_to_int24(const float* s1, stride_t s_s1, mts::int24_t* d1, stride_t s_d1, length_t length) {
+  table<float>().convert_to_int24(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::convert_to_int24(const double* s1, stride_t s_s1, mts::int24_t* d1, stride_t s_d1, length_t length) {
+  table<double>().convert_to_int24(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::convert_to_int32(const float* s1, stride_t s_s1, std::int32_t* d1, stride_t s_d1, length_t length) {
+  table<float>().convert_to_int32(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::convert_to_int32(const double* s1, stride_t s_s1, std::int32_t* d1, stride_t s_d1, length_t length) {
+  table<double>().convert_to_int32(s1, s_s1, d1, s_d1, length);
+}
+
+void simd_ops::interleave_to_int8(
+    const float* const* s, std::int8_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<float>().interleave_to_int8(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_to_int8(
+    const double* const* s, std::int8_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<double>().interleave_to_int8(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_to_int16(
+    const float* const* s, std::int16_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<float>().interleave_to_int16(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_to_int16(
+    const double* const* s, std::int16_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<double>().interleave_to_int16(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_to_int24(
+    const float* const* s, mts::int24_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<float>().interleave_to_int24(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_to_int24(
+    const double* const* s, mts::int24_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<double>().interleave_to_int24(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_to_int32(
+    const float* const* s, std::int32_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<float>().interleave_to_int32(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::interleave_to_int32(
+    const double* const* s, std::int32_t* d1, stride_t s_d1, length_t n_channels, length_t length) {
+  table<double>().interleave_to_int32(s, d1, s_d1, n_channels, length);
+}
+
+void simd_ops::biquad(const float* const* s, float* const* d, length_t n_channels, length_t length, const float* c,
+    float* z, length_t n_stages) {
+  table<float>().biquad(s, d, n_channels, length, c, z, n_stages);
+}
+
+void simd_ops::biquad(const double* const* s, double* const* d, length_t n_channels, length_t length,
+    const double* c, double* z, length_t n_stages) {
+  table<double>().biquad(s, d, n_channels, length, c, z, n_stages);
+}
+
+MTS_END_SUB_NAMESPACE(vec)
+
+#else
+MTS_BEGIN_SUB_NAMESPACE(vec)
+simd_isa get_simd_isa() noexcept { return simd_isa::none; }
+
+bool is_simd_isa_supported(simd_isa isa) noexcept { return isa == simd_isa::none; }
+
+bool set_simd_isa(simd_isa isa) noexcept { return isa == simd_isa::none; }
+MTS_END_SUB_NAMESPACE(vec)
+#endif // __MTS_USE_SIMD__
@@ -71,6 +71,205 @@ void vdsp_ops::vdiv(double value, const double* s1, stride_t s_s1, double* d1, s
   vDSP_svdivD(&value, s1, s_s1, d1, s_d1, length);
 }
 
+void vdsp_ops::sum(
+    const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  vDSP_vadd(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void vdsp_ops::sum(
+    const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  vDSP_vaddD(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+// vDSP_vsub and vDSP_vdiv take the second operand first.
+void vdsp_ops::sub(
+    const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  vDSP_vsub(s2, s_s2, s1, s_s1, d1, s_d1, length);
+}
+
+void vdsp_ops::sub(
+    const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  vDSP_vsubD(s2, s_s2, s1, s_s1, d1, s_d1, length);
+}
+
+void vdsp_ops::mul(
+    const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  vDSP_vmul(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void vdsp_ops::mul(
+    const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  vDSP_vmulD(s1, s_s1, s2, s_s2, d1, s_d1, length);
+}
+
+void vdsp_ops::div(
+    const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float* d1, stride_t s_d1, length_t length) {
+  vDSP_vdiv(s2, s_s2, s1, s_s1, d1, s_d1, length);
+}
+
+void vdsp_ops::div(
+    const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double* d1, stride_t s_d1, length_t length) {
+  vDSP_vdivD(s2, s_s2, s1, s_s1, d1, s_d1, length);
+}
+
+void vdsp_ops::sum_mul(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float value, float* d1,
+    stride_t s_d1, length_t length) {
+  vDSP_vasm(s1, s_s1, s2, s_s2, &value, d1, s_d1, length);
+}
+
+void vdsp_ops::sum_mul(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double value, double* d1,
+    stride_t s_d1, length_t length) {
+  vDSP_vasmD(s1, s_s1, s2, s_s2, &value, d1, s_d1, length);
+}
+
+void vdsp_ops::sum_mul(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, const float* s3, stride_t s_s3,
+    float* d1, stride_t s_d1, length_t length) {
+  vDSP_vam(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+void vdsp_ops::sum_mul(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, const double* s3,
+    stride_t s_s3, double* d1, stride_t s_d1, length_t length) {
+  vDSP_vamD(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+void vdsp_ops::mul_sum(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, float value, float* d1,
+    stride_t s_d1, length_t length) {
+  vDSP_vmsa(s1, s_s1, s2, s_s2, &value, d1, s_d1, length);
+}
+
+void vdsp_ops::mul_sum(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, double value, double* d1,
+    stride_t s_d1, length_t length) {
+  vDSP_vmsaD(s1, s_s1, s2, s_s2, &value, d1, s_d1, length);
+}
+
+void vdsp_ops::mul_sum(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, const float* s3, stride_t s_s3,
+    float* d1, stride_t s_d1, length_t length) {
+  vDSP_vma(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+void vdsp_ops::mul_sum(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, const double* s3,
+    stride_t s_s3, double* d1, stride_t s_d1, length_t length) {
+  vDSP_vmaD(s1, s_s1, s2, s_s2, s3, s_s3, d1, s_d1, length);
+}
+
+void vdsp_ops::mul_sum(const float* s1, stride_t s_s1, float value, const float* s2, stride_t s_s2, float* d1,
+    stride_t s_d1, length_t length) {
+  vDSP_vsma(s1, s_s1, &value, s2, s_s2, d1, s_d1, length);
+}
+
+void vdsp_ops::mul_sum(const double* s1, stride_t s_s1, double value, const double* s2, stride_t s_s2, double* d1,
+    stride_t s_d1, length_t length) {
+  vDSP_vsmaD(s1, s_s1, &value, s2, s_s2, d1, s_d1, length);
+}
+
+float vdsp_ops::sum(const float* s1, stride_t s_s1, length_t length) {
+  float result = 0;
+  vDSP_sve(s1, s_s1, &result, length);
+  return result;
+}
+
+double vdsp_ops::sum(const double* s1, stride_t s_s1, length_t length) {
+  double result = 0;
+  vDSP_sveD(s1, s_s1, &result, length);
+  return result;
+}
+
+float vdsp_ops::sum_of_squares(const float* s1, stride_t s_s1, length_t length) {
+  float result = 0;
+  vDSP_svesq(s1, s_s1, &result, length);
+  return result;
+}
+
+double vdsp_ops::sum_of_squares(const double* s1, stride_t s_s1, length_t length) {
+  double result = 0;
+  vDSP_svesqD(s1, s_s1, &result, length);
+  return result;
+}
+
+float vdsp_ops::rms(const float* s1, stride_t s_s1, length_t length) {
+  float result = 0;
+  vDSP_rmsqv(s1, s_s1, &result, length);
+  return result;
+}
+
+double vdsp_ops::rms(const double* s1, stride_t s_s1, length_t length) {
+  double result = 0;
+  vDSP_rmsqvD(s1, s_s1, &result, length);
+  return result;
+}
+
+float vdsp_ops::max_abs(const float* s1, stride_t s_s1, length_t length) {
+  float result = 0;
+  vDSP_maxmgv(s1, s_s1, &result, length);
+  return result;
+}
+
+double vdsp_ops::max_abs(const double* s1, stride_t s_s1, length_t length) {
+  double result = 0;
+  vDSP_maxmgvD(s1, s_s1, &result, length);
+  return result;
+}
+
+indexed_value<float> vdsp_ops::min_index(const float* s1, stride_t s_s1, length_t length) {
+  if (!length) {
+    return { 0, 0 };
+  }
+
+  // The returned index is an offset in s1 (i.e. multiplied by the stride).
+  float value = 0;
+  vDSP_Length index = 0;
+  vDSP_minvi(s1, s_s1, &value, &index, length);
+  return { (index_t)(index / (vDSP_Length)s_s1), value };
+}
+
+indexed_value<double> vdsp_ops::min_index(const double* s1, stride_t s_s1, length_t length) {
+  if (!length) {
+    return { 0, 0 };
+  }
+
+  // The returned index is an offset in s1 (i.e. multiplied by the stride).
+  double value = 0;
+  vDSP_Length index = 0;
+  vDSP_minviD(s1, s_s1, &value, &index, length);
+  return { (index_t)(index / (vDSP_Length)s_s1), value };
+}
+
+indexed_value<float> vdsp_ops::max_index(const float* s1, stride_t s_s1, length_t length) {
+  if (!length) {
+    return { 0, 0 };
+  }
+
+  // The returned index is an offset in s1 (i.e. multiplied by the stride).
+  float value = 0;
+  vDSP_Length index = 0;
+  vDSP_maxvi(s1, s_s1, &value, &index, length);
+  return { (index_t)(index / (vDSP_Length)s_s1), value };
+}
+
+indexed_value<double> vdsp_ops::max_index(const double* s1, stride_t s_s1, length_t length) {
+  if (!length) {
+    return { 0, 0 };
+  }
+
+  // The returned index is an offset in s1 (i.e. multiplied by the stride).
+  double value = 0;
+  vDSP_Length index = 0;
+  vDSP_maxviD(s1, s_s1, &value, &index, length);
+  return { (index_t)(index / (vDSP_Length)s_s1), value };
+}
+
+float vdsp_ops::dot(const float* s1, stride_t s_s1, const float* s2, stride_t s_s2, length_t length) {
+  float result = 0;
+  vDSP_dotpr(s1, s_s1, s2, s_s2, &result, length);
+  return result;
+}
+
+double vdsp_ops::dot(const double* s1, stride_t s_s1, const double* s2, stride_t s_s2, length_t length) {
+  double result = 0;
+  vDSP_dotprD(s1, s_s1, s2, s_s2, &result, length);
+  return result;
+}
+
 void vdsp_ops::sin(const float* s1, float* d1, length_t length) {
   int i_size = (int)length;
   vvsinf(d1, s1, &i_size);
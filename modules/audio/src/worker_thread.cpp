@@ -0,0 +1,57 @@
+#include "mts/audio/detail/worker_thread.h"
+#include "mts/util.h"
+#include <algorithm>
+
+#if __MTS_UNISTD__ && !__MTS_WINDOWS__
+  #include <pthread.h>
+  #include <sched.h>
+#endif // __MTS_UNISTD__ && !__MTS_WINDOWS__
+
+#if __MTS_WINDOWS__
+  #include <windows.h>
+#endif // __MTS_WINDOWS__
+
+MTS_BEGIN_NAMESPACE
+namespace detail {
+bool set_worker_thread_realtime(std::thread::native_handle_type handle, int priority) {
+#if __MTS_WINDOWS__
+  _VMTS::unused(priority);
+  return SetThreadPriority(static_cast<HANDLE>(handle), THREAD_PRIORITY_TIME_CRITICAL);
+
+#elif __MTS_UNISTD__
+  sched_param param = {};
+  param.sched_priority = std::clamp(priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+  return pthread_setschedparam((pthread_t)handle, SCHED_FIFO, &param) == 0;
+
+#else
+  _VMTS::unused(handle, priority);
+  return false;
+#endif
+}
+
+bool set_worker_thread_affinity(std::thread::native_handle_type handle, std::size_t cpu) {
+#if __MTS_WINDOWS__
+  if (cpu >= sizeof(DWORD_PTR) * 8) {
+    return false;
+  }
+
+  return SetThreadAffinityMask(static_cast<HANDLE>(handle), DWORD_PTR(1) << cpu) != 0;
+
+#elif __MTS_LINUX__
+  if (cpu >= CPU_SETSIZE) {
+    return false;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np((pthread_t)handle, sizeof(cpu_set_t), &set) == 0;
+
+#else
+  // Thread affinity is only a hint on macos.
+  _VMTS::unused(handle, cpu);
+  return false;
+#endif
+}
+} // namespace detail.
+MTS_END_NAMESPACE
@@ -2,6 +2,9 @@
 #include "mts/print.h"
 #include "mts/audio/buffer.h"
 #include "mts/audio/audio_file.h"
+#include "mts/audio/dither.h"
+#include <cmath>
+#include <vector>
 
 namespace {
 TEST(audio_interleaved_buffer, simple) {
@@ -20,4 +23,98 @@ TEST(audio_interleaved_buffer, simple) {
   mts::wav::save(MTS_TEST_RESOURCES_DIRECTORY "/trumpet2.wav", data, mts::wav::format::ieee_32_bit);
 }
 
+template <typename _Tp>
+double max_difference(const mts::audio_data<_Tp>& a, const mts::audio_data<_Tp>& b) {
+  double diff = 0;
+  for (std::size_t c = 0; c < a.buffer.channel_size(); c++) {
+    for (std::size_t i = 0; i < a.buffer.buffer_size(); i++) {
+      diff = std::max(diff, std::abs((double)a.buffer[c][i] - (double)b.buffer[c][i]));
+    }
+  }
+
+  return diff;
+}
+
+mts::wav::load_error load_file(const mts::filesystem::path& path, mts::audio_data<float>& data, mts::wav::format& f) {
+  mts::file_view fdata;
+  fdata.open(path);
+  return mts::wav::load(fdata.content(), data, f);
+}
+
+TEST(audio_wav, save_pcm) {
+  mts::audio_data<float> data;
+  mts::wav::format data_format;
+  ASSERT_EQ(load_file(MTS_TEST_RESOURCES_DIRECTORY "/trumpet.wav", data, data_format), mts::wav::load_error::no_error);
+
+  const mts::filesystem::path path = MTS_TEST_RESOURCES_DIRECTORY "/trumpet_save_pcm.wav";
+
+  struct test_case {
+    mts::wav::format format;
+    mts::dither_type d_type;
+    double tolerance;
+  };
+
+  const test_case cases[] = {
+    { mts::wav::format::pcm_24_bit, mts::dither_type::none, 0.0 },
+    { mts::wav::format::pcm_32_bit, mts::dither_type::none, 1.0 / 16777216.0 },
+    { mts::wav::format::pcm_16_bit, mts::dither_type::none, 0.5 / 32768.0 },
+    { mts::wav::format::pcm_16_bit, mts::dither_type::tpdf, 1.5 / 32768.0 },
+    { mts::wav::format::pcm_16_bit, mts::dither_type::shaped, 3.0 / 32768.0 },
+    { mts::wav::format::pcm_8_bit, mts::dither_type::none, 0.5 / 128.0 },
+  };
+
+  for (const test_case& c : cases) {
+    ASSERT_EQ(mts::wav::save(path, data, c.format, c.d_type), mts::wav::save_error::no_error);
+
+    mts::audio_data<float> loaded;
+    mts::wav::format format;
+    ASSERT_EQ(load_file(path, loaded, format), mts::wav::load_error::no_error);
+    EXPECT_EQ(format, c.format);
+    ASSERT_EQ(loaded.buffer.channel_size(), data.buffer.channel_size());
+    ASSERT_EQ(loaded.buffer.buffer_size(), data.buffer.buffer_size());
+    EXPECT_LE(max_difference(data, loaded), c.tolerance + 1e-7) << (int)c.format << " " << (int)c.d_type;
+  }
+
+  mts::filesystem::remove(path);
+}
+
+TEST(audio_dither, none) {
+  std::vector<float> input(1000);
+  for (std::size_t i = 0; i < input.size(); i++) {
+    input[i] = std::sin((float)i * 0.01f) * 1.2f;
+  }
+
+  const float* channels[] = { input.data() };
+  std::vector<std::int16_t> expected(input.size());
+  std::vector<std::int16_t> output(input.size());
+  mts::vec::interleave_to_int16(channels, expected.data(), 1, 1, input.size());
+  mts::dither(mts::dither_type::none).interleave(channels, output.data(), 1, 1, input.size());
+  EXPECT_EQ(output, expected);
+}
+
+TEST(audio_dither, unbiased) {
+  // A constant below half an lsb rounds to zero without dither, dither preserves its mean.
+  const std::size_t size = 1 << 16;
+  const double value = 0.3;
+  std::vector<float> input(size, (float)(value / 32768.0));
+  const float* channels[] = { input.data() };
+  std::vector<std::int16_t> output(size);
+
+  for (mts::dither_type d_type : { mts::dither_type::tpdf, mts::dither_type::shaped }) {
+    mts::dither(d_type).interleave(channels, output.data(), 1, 1, size);
+
+    double sum = 0;
+    for (std::int16_t v : output) {
+      sum += v;
+    }
+
+    EXPECT_NEAR(sum / size, value, 0.02) << (int)d_type;
+
+    if (d_type == mts::dither_type::shaped) {
+      // With first order error feedback the accumulated error stays bounded.
+      EXPECT_LE(std::abs(sum - value * size), 2.0);
+    }
+  }
+}
+
 } // namespace
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "mts/audio/biquad.h"
+#include "mts/audio/buffer.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+template <typename T>
+struct reference_biquad {
+  std::vector<mts::biquad_coefficients<T>> stages;
+  std::vector<T> z1;
+  std::vector<T> z2;
+
+  inline T process(T x) {
+    for (std::size_t k = 0; k < stages.size(); k++) {
+      const mts::biquad_coefficients<T>& c = stages[k];
+      const T y = c.b0 * x + z1[k];
+      z1[k] = c.b1 * x - c.a1 * y + z2[k];
+      z2[k] = c.b2 * x - c.a2 * y;
+      x = y;
+    }
+    return x;
+  }
+};
+
+template <typename T>
+void check_biquad_bank(std::size_t n_channels, std::size_t n_stages, bool in_place) {
+  constexpr std::size_t length = 301;
+  const double sample_rate = 44100;
+
+  mts::audio_buffer<T> input(length, n_channels);
+  mts::audio_buffer<T> output(length, n_channels);
+  mts::biquad_bank<T> bank(n_channels, n_stages);
+  std::vector<reference_biquad<T>> refs(n_channels);
+
+  for (std::size_t ch = 0; ch < n_channels; ch++) {
+    refs[ch].z1.assign(n_stages, T(0));
+    refs[ch].z2.assign(n_stages, T(0));
+
+    for (std::size_t k = 0; k < n_stages; k++) {
+      const double frequency = 200.0 * (double)(ch + 1) + 1000.0 * (double)k;
+      const mts::biquad_coefficients<T> c = k % 2
+          ? mts::biquad_coefficients<T>::peak(frequency, 0.7, 6.0, sample_rate)
+          : mts::biquad_coefficients<T>::lowpass(frequency, 0.9, sample_rate);
+      bank.set_coefficients(k, ch, c);
+      refs[ch].stages.push_back(c);
+    }
+
+    for (std::size_t i = 0; i < length; i++) {
+      input[ch][i] = (T)std::sin(0.05 * (double)(i * (ch + 1))) + (i % 7 == 0 ? T(0.5) : T(0));
+    }
+  }
+
+  // Two calls to check that the state is carried between blocks.
+  for (std::size_t block = 0; block < 2; block++) {
+    if (in_place) {
+      for (std::size_t ch = 0; ch < n_channels; ch++) {
+        mts::vec::copy(input[ch], 1, output[ch], 1, length);
+      }
+      bank.process(output);
+    }
+    else {
+      bank.process(input, output);
+    }
+
+    for (std::size_t ch = 0; ch < n_channels; ch++) {
+      for (std::size_t i = 0; i < length; i++) {
+        const T expected = refs[ch].process(input[ch][i]);
+        EXPECT_NEAR(output[ch][i], expected, 1e-4) << "channel " << ch << " index " << i;
+      }
+    }
+  }
+}
+
+TEST(audio_biquad, bank) {
+  const mts::vec::simd_isa current = mts::vec::get_simd_isa();
+
+  for (mts::vec::simd_isa isa : { mts::vec::simd_isa::none, mts::vec::simd_isa::sse2, mts::vec::simd_isa::avx2,
+           mts::vec::simd_isa::avx512, mts::vec::simd_isa::neon }) {
+    if (!mts::vec::set_simd_isa(isa)) {
+      continue;
+    }
+
+    for (std::size_t n_channels : { 1, 3, 4, 8, 13, 17 }) {
+      for (std::size_t n_stages : { 0, 1, 3 }) {
+        check_biquad_bank<float>(n_channels, n_stages, false);
+        check_biquad_bank<float>(n_channels, n_stages, true);
+        check_biquad_bank<double>(n_channels, n_stages, false);
+      }
+    }
+  }
+
+  EXPECT_TRUE(mts::vec::set_simd_isa(current));
+}
+
+TEST(audio_biquad, coefficients) {
+  using coefficients = mts::biquad_coefficients<double>;
+
+  // Gain at dc is (b0 + b1 + b2) / (1 + a1 + a2).
+  auto dc_gain = [](const coefficients& c) { return (c.b0 + c.b1 + c.b2) / (1 + c.a1 + c.a2); };
+
+  EXPECT_NEAR(dc_gain(coefficients::lowpass(1000, 0.707, 44100)), 1, 1e-9);
+  EXPECT_NEAR(dc_gain(coefficients::highpass(1000, 0.707, 44100)), 0, 1e-9);
+  EXPECT_NEAR(dc_gain(coefficients::bandpass(1000, 0.707, 44100)), 0, 1e-9);
+  EXPECT_NEAR(dc_gain(coefficients::notch(1000, 0.707, 44100)), 1, 1e-9);
+  EXPECT_NEAR(dc_gain(coefficients::allpass(1000, 0.707, 44100)), 1, 1e-9);
+  EXPECT_NEAR(dc_gain(coefficients::peak(1000, 0.707, 6, 44100)), 1, 1e-9);
+  EXPECT_NEAR(dc_gain(coefficients::low_shelf(1000, 0.707, 6, 44100)), std::pow(10.0, 6.0 / 20), 1e-9);
+  EXPECT_NEAR(dc_gain(coefficients::high_shelf(1000, 0.707, 6, 44100)), 1, 1e-9);
+}
+
+TEST(audio_biquad, smoothing) {
+  constexpr std::size_t length = 1000;
+  using coefficients = mts::biquad_coefficients<float>;
+  const coefficients target = coefficients::lowpass(2000, 0.707f, 44100);
+
+  mts::biquad_bank<float> bank(2, 1);
+  bank.set_smoothing(300);
+  bank.set_coefficients(0, target);
+
+  mts::audio_buffer<float> buffer(length, 2);
+  auto fill = [&]() {
+    mts::vec::fill(buffer[0], 1, 1.0f, length);
+    mts::vec::fill(buffer[1], 1, 1.0f, length);
+  };
+
+  fill();
+
+  // Halfway through the ramp, the coefficients are between pass through and the target.
+  bank.process(mts::audio_bus<float>(buffer.data(), 150, 2));
+  const coefficients half = bank.get_coefficients(0, 1);
+  EXPECT_NEAR(half.b0, (1 + target.b0) / 2, 1e-5);
+  EXPECT_NEAR(half.a1, target.a1 / 2, 1e-5);
+
+  fill();
+  bank.process(mts::audio_bus<float>(buffer.data(), length, 2));
+  const coefficients c = bank.get_coefficients(0, 0);
+  EXPECT_EQ(c.b0, target.b0);
+  EXPECT_EQ(c.b1, target.b1);
+  EXPECT_EQ(c.b2, target.b2);
+  EXPECT_EQ(c.a1, target.a1);
+  EXPECT_EQ(c.a2, target.a2);
+
+  // Unit dc gain once settled.
+  EXPECT_NEAR(buffer[0][length - 1], 1.0f, 1e-3);
+  EXPECT_NEAR(buffer[1][length - 1], 1.0f, 1e-3);
+
+  bank.clear();
+  fill();
+  bank.process(mts::audio_bus<float>(buffer.data(), length, 2));
+  EXPECT_NEAR(buffer[0][length - 1], 1.0f, 1e-3);
+}
+
+TEST(audio_biquad, wire) {
+  std::vector<float> data(64, 1.0f);
+  mts::biquad_bank<float> bank(1, 1);
+  bank.set_coefficients(0, mts::biquad_coefficients<float>::highpass(100, 0.707f, 44100));
+  bank.process(mts::wire<const float>(data), mts::wire<float>(data));
+
+  EXPECT_FLOAT_EQ(data[0], mts::biquad_coefficients<float>::highpass(100, 0.707f, 44100).b0);
+  EXPECT_LT(data[63], data[0]);
+}
+} // namespace
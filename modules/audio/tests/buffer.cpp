@@ -1,10 +1,14 @@
 #include <gtest/gtest.h>
 #include "mts/audio/buffer.h"
 #include "mts/audio/bus.h"
+#include "mts/memory.h"
+#include <algorithm>
 #include <array>
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <list>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -86,6 +90,203 @@ TEST(audio_buffer, ccc) {
   //  EXPECT_EQ(data[1][2], 6);
 }
 
+TEST(audio_buffer_pool, acquire) {
+  mts::audio_buffer_pool<float> pool(2, 512, 4);
+  EXPECT_EQ(pool.capacity(), 2);
+  EXPECT_EQ(pool.max_buffer_size(), 512);
+  EXPECT_EQ(pool.max_channel_size(), 4);
+
+  mts::audio_buffer<float> a = pool.acquire(256, 2);
+  EXPECT_TRUE(a.is_valid());
+  EXPECT_TRUE(a.is_pooled());
+  EXPECT_EQ(a.buffer_size(), 256);
+  EXPECT_EQ(a.channel_size(), 2);
+  EXPECT_EQ(a[1][255], 0.0f);
+
+  for (std::size_t c = 0; c < a.channel_size(); c++) {
+    EXPECT_EQ((std::uintptr_t)a[c] % mts::memory::get_cache_size(), 0);
+  }
+
+  // Shapes that don't fit.
+  EXPECT_FALSE(pool.acquire(1024, 1).is_valid());
+  EXPECT_FALSE(pool.acquire(16, 8).is_valid());
+  EXPECT_FALSE(pool.acquire(0, 1).is_valid());
+
+  mts::audio_buffer<float> b = pool.acquire(512, 4);
+  EXPECT_TRUE(b.is_valid());
+  EXPECT_NE(a.data(), b.data());
+
+  // Empty pool.
+  EXPECT_FALSE(pool.acquire(1, 1).is_valid());
+
+  mts::audio_buffer_pool<float>::statistics stats = pool.get_statistics();
+  EXPECT_EQ(stats.capacity, 2);
+  EXPECT_EQ(stats.in_use, 2);
+  EXPECT_EQ(stats.peak_in_use, 2);
+  EXPECT_EQ(stats.acquired, 2);
+  EXPECT_EQ(stats.failed, 4);
+
+  // Reshaping in place.
+  mts::audio_buffer<float>::buffer_pointer buffers = a.data();
+  a[0][0] = 1;
+  a.reset(512, 4);
+  EXPECT_EQ(a.data(), buffers);
+  EXPECT_EQ(a.buffer_size(), 512);
+  EXPECT_EQ(a.channel_size(), 4);
+  EXPECT_EQ(a[0][0], 0.0f);
+
+  // Released on move assignment and reset.
+  b = std::move(a);
+  EXPECT_EQ(pool.get_statistics().in_use, 1);
+  EXPECT_EQ(b.data(), buffers);
+
+  b.reset();
+  EXPECT_FALSE(b.is_valid());
+  EXPECT_EQ(pool.get_statistics().in_use, 0);
+
+  // A shape larger than the pool goes back to the pool and is allocated.
+  mts::audio_buffer<float> c = pool.acquire(8, 1);
+  c.reset(2048, 2);
+  EXPECT_TRUE(c.is_valid());
+  EXPECT_FALSE(c.is_pooled());
+  EXPECT_EQ(pool.get_statistics().in_use, 0);
+  EXPECT_EQ(pool.get_statistics().peak_in_use, 2);
+}
+
+TEST(audio_buffer_pool, threads) {
+  constexpr std::size_t n_threads = 4;
+  constexpr std::size_t n_iterations = 20000;
+  mts::audio_buffer_pool<double> pool(3, 64, 2);
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < n_threads; t++) {
+    threads.emplace_back([&pool, t]() {
+      for (std::size_t i = 0; i < n_iterations; i++) {
+        mts::audio_buffer<double> buffer = pool.acquire(64, 2);
+        if (!buffer.is_valid()) {
+          continue;
+        }
+
+        // Nobody else writes to this buffer.
+        std::fill_n(buffer[1], 64, (double)t);
+        for (std::size_t k = 0; k < 64; k++) {
+          ASSERT_EQ(buffer[1][k], (double)t);
+        }
+      }
+    });
+  }
+
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  const mts::audio_buffer_pool<double>::statistics stats = pool.get_statistics();
+  EXPECT_EQ(stats.in_use, 0);
+  EXPECT_LE(stats.peak_in_use, 3);
+  EXPECT_EQ(stats.acquired + stats.failed, n_threads * n_iterations);
+}
+
+TEST(audio_buffer, allocation_policy) {
+  const mts::buffer_allocation_policy default_policy = mts::get_default_buffer_allocation_policy();
+  EXPECT_FALSE(default_policy.prefault);
+  EXPECT_FALSE(default_policy.lock);
+  EXPECT_EQ(default_policy.huge_pages, mts::huge_page_mode::none);
+
+  const mts::buffer_allocation_statistics stats = mts::get_buffer_allocation_statistics();
+
+  // Locking can fail (RLIMIT_MEMLOCK), the buffer is allocated either way.
+  mts::buffer_allocation_policy policy;
+  policy.prefault = true;
+  policy.lock = true;
+  policy.huge_pages = mts::huge_page_mode::transparent;
+  policy.huge_page_threshold = 1024 * 1024;
+
+  {
+    mts::audio_buffer<float> small(512, 2, policy);
+    mts::audio_buffer<float> large(1 << 16, 8, policy);
+    mts::interleaved_audio_buffer<double> interleaved(512, 2, policy);
+    ASSERT_TRUE(small.is_valid());
+    ASSERT_TRUE(large.is_valid());
+    ASSERT_TRUE(interleaved.is_valid());
+
+    for (std::size_t c = 0; c < large.channel_size(); c++) {
+      EXPECT_EQ((std::uintptr_t)large[c] % mts::memory::get_cache_size(), 0);
+      EXPECT_EQ(mts::vec::max_abs(large[c], 1, large.buffer_size()), 0.0f);
+      large[c][large.buffer_size() - 1] = 1.0f;
+    }
+
+    const mts::buffer_allocation_statistics locked = mts::get_buffer_allocation_statistics();
+    const std::size_t lock_failures = locked.lock_failures - stats.lock_failures;
+    const std::size_t huge_page_failures = locked.huge_page_failures - stats.huge_page_failures;
+    EXPECT_LE(lock_failures, 3);
+    EXPECT_EQ(locked.locked_bytes > stats.locked_bytes, lock_failures < 3);
+    EXPECT_LE(huge_page_failures, 1);
+    EXPECT_EQ(locked.huge_page_bytes > stats.huge_page_bytes, huge_page_failures == 0);
+
+    // Reserved huge pages fall back to transparent ones.
+    policy.huge_pages = mts::huge_page_mode::reserved;
+    large.reset(1 << 17, 8, policy);
+    ASSERT_TRUE(large.is_valid());
+    large[7][(1 << 17) - 1] = 1.0f;
+  }
+
+  // Everything is unlocked on deallocation.
+  EXPECT_EQ(mts::get_buffer_allocation_statistics().locked_bytes, stats.locked_bytes);
+  EXPECT_EQ(mts::get_buffer_allocation_statistics().huge_page_bytes, stats.huge_page_bytes);
+
+  // The default policy applies to the pools.
+  mts::set_default_buffer_allocation_policy(policy);
+  EXPECT_TRUE(mts::get_default_buffer_allocation_policy().lock);
+
+  mts::audio_buffer_pool<float> pool(4, 256, 2);
+  EXPECT_EQ(pool.capacity(), 4);
+  EXPECT_TRUE(pool.acquire(256, 2).is_valid());
+
+  mts::set_default_buffer_allocation_policy(default_policy);
+}
+
+TEST(audio_buffer, channel_stagger) {
+  const std::size_t cache_size = mts::memory::get_cache_size();
+  mts::buffer_allocation_policy policy;
+
+  // Packed channels of a page each start at the same page offset.
+  mts::buffer_layout layout = mts::get_buffer_layout(1024, 16, sizeof(float), policy);
+  EXPECT_EQ(layout.channel_stride, 4096);
+  EXPECT_EQ(layout.channel_padding, 0);
+
+  // Odd sizes are padded to the cache line.
+  layout = mts::get_buffer_layout(1000, 16, sizeof(float), policy);
+  EXPECT_EQ(layout.channel_stride % cache_size, 0);
+  EXPECT_EQ(layout.channel_stride - layout.channel_padding, 4000);
+
+  policy.channel_stagger = 1;
+  layout = mts::get_buffer_layout(1024, 16, sizeof(float), policy);
+  EXPECT_EQ(layout.channel_stride, 4096 + cache_size);
+  EXPECT_EQ(layout.channel_padding, cache_size);
+
+  mts::audio_buffer<float> buffer(1024, 16, policy);
+  ASSERT_TRUE(buffer.is_valid());
+
+  std::set<std::uintptr_t> page_offsets;
+  for (std::size_t c = 0; c < buffer.channel_size(); c++) {
+    const std::uintptr_t address = (std::uintptr_t)buffer[c];
+    EXPECT_EQ(address % cache_size, 0);
+    page_offsets.insert(address % 4096);
+
+    if (c) {
+      EXPECT_EQ(address - (std::uintptr_t)buffer[c - 1], layout.channel_stride);
+    }
+
+    mts::vec::fill(buffer[c], 1, (float)c, buffer.buffer_size());
+  }
+
+  EXPECT_EQ(page_offsets.size(), 16);
+
+  for (std::size_t c = 0; c < buffer.channel_size(); c++) {
+    EXPECT_EQ(std::count(buffer[c], buffer[c] + buffer.buffer_size(), (float)c), 1024);
+  }
+}
+
 TEST(audio_bus, fixed_size) {
   using buffer_type = mts::audio_buffer<float>;
   buffer_type data(3, 2);
@@ -200,4 +401,80 @@ TEST(audio_bus, assign) {
   EXPECT_EQ(data[1][2], -6);
 }
 
+TEST(audio_bus, subbus) {
+  mts::audio_buffer<float> data(64, 4);
+  for (std::size_t c = 0; c < data.channel_size(); c++) {
+    for (std::size_t i = 0; i < data.buffer_size(); i++) {
+      data[c][i] = (float)(c * 100 + i);
+    }
+  }
+
+  // Split at an event in the middle of the block.
+  mts::audio_bus<float, 4> fixed(data);
+  mts::audio_bus<float, 4> fixed_tail = fixed.subbus(10, 54);
+  EXPECT_EQ(fixed_tail.buffer_size(), 54);
+  EXPECT_EQ(fixed_tail[3], data[3] + 10);
+  EXPECT_EQ(fixed_tail.subbus(4, 2)[1][0], 114.0f);
+
+  float* pointers[4];
+  mts::audio_bus<float> bus(data);
+  mts::audio_bus<float> tail = bus.subbus(10, 54, pointers);
+  EXPECT_EQ(tail.channel_size(), 4);
+  EXPECT_EQ(tail.buffer_size(), 54);
+  EXPECT_EQ(tail[2][0], 210.0f);
+
+  // Writes go to the buffer.
+  tail[1][53] = -1.0f;
+  EXPECT_EQ(data[1][63], -1.0f);
+
+  const float* const_pointers[4];
+  mts::audio_bus<const float> ctail = mts::audio_bus<const float>(data).subbus(63, 1, const_pointers);
+  EXPECT_EQ(ctail[0][0], 63.0f);
+
+  mts::interleaved_audio_buffer<float> interleaved(8, 2);
+  mts::interleaved_audio_bus<float> interleaved_tail = mts::interleaved_audio_bus<float>(interleaved).subbus(6, 2);
+  EXPECT_EQ(interleaved_tail.data(), interleaved.data() + 12);
+  EXPECT_EQ(interleaved_tail.buffer_size(), 2);
+}
+
+TEST(audio_bus, select) {
+  mts::audio_buffer<double> data(16, 16);
+  for (std::size_t c = 0; c < data.channel_size(); c++) {
+    data[c][0] = (double)c;
+  }
+
+  // Channels 3 and 4 of a 16 channel bus.
+  mts::audio_bus<double> bus(data);
+  mts::audio_bus<double, 2> stereo = bus.select<2>({ 3, 4 });
+  EXPECT_EQ(stereo[0], data[3]);
+  EXPECT_EQ(stereo[1], data[4]);
+  EXPECT_EQ(stereo.buffer_size(), 16);
+
+  mts::audio_bus<double> range = bus.channels(3, 2);
+  EXPECT_EQ(range.channel_size(), 2);
+  EXPECT_EQ(range[1][0], 4.0);
+
+  // Remap.
+  const std::size_t indices[3] = { 15, 0, 7 };
+  double* pointers[3];
+  mts::audio_bus<double> remapped = bus.select(indices, 3, pointers);
+  EXPECT_EQ(remapped.channel_size(), 3);
+  EXPECT_EQ(remapped[0][0], 15.0);
+  EXPECT_EQ(remapped[1][0], 0.0);
+  EXPECT_EQ(remapped[2][0], 7.0);
+
+  mts::audio_bus<double, 16> fixed(data);
+  mts::audio_bus<double, 2> swapped = fixed.select<2>({ 1, 0 });
+  EXPECT_EQ(swapped[0][0], 1.0);
+  EXPECT_EQ(swapped[1][0], 0.0);
+
+  mts::audio_bus<double, 3> surround = fixed.channels<13, 3>();
+  EXPECT_EQ(surround[2][0], 15.0);
+
+  // Views compose, without copy.
+  mts::audio_bus<const double, 1> mono = fixed.select<2>({ 5, 9 }).subbus(1, 3).channels<1, 1>();
+  EXPECT_EQ(mono[0], data[9] + 1);
+  EXPECT_EQ(mono.buffer_size(), 3);
+}
+
 } // namespace
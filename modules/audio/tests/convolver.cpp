@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "mts/audio/convolver.h"
+#include "mts/audio/audio_file.h"
+#include "mts/audio/buffer.h"
+#include "mts/file_view.h"
+#include "test_signals.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+using test::fill_noise;
+
+template <typename T>
+std::vector<double> direct_convolution(const T* x, std::size_t length, const T* h, std::size_t ir_size) {
+  std::vector<double> y(length, 0.0);
+  for (std::size_t i = 0; i < length; i++) {
+    const std::size_t n = std::min(i + 1, ir_size);
+    for (std::size_t k = 0; k < n; k++) {
+      y[i] += (double)h[k] * (double)x[i - k];
+    }
+  }
+  return y;
+}
+
+// Host blocks of varying sizes, some larger than the convolver block size.
+const std::size_t host_blocks[] = { 37, 1, 64, 300, 128, 5, 999, 256 };
+
+template <typename T>
+void check_convolver(std::size_t ir_size, std::size_t ir_channels, std::size_t n_channels, std::size_t block_size,
+    bool background, std::size_t max_partition_size, bool in_place) {
+  constexpr std::size_t length = 6000;
+
+  mts::audio_buffer<T> ir(ir_size, ir_channels);
+  mts::audio_buffer<T> input(length, n_channels);
+  mts::audio_buffer<T> output(length, n_channels);
+
+  for (std::size_t c = 0; c < ir_channels; c++) {
+    fill_noise(ir[c], ir_size, 7 + (std::uint32_t)c);
+    for (std::size_t i = 0; i < ir_size; i++) {
+      ir[c][i] *= (T)std::exp(-3.0 * (double)i / (double)ir_size);
+    }
+  }
+
+  for (std::size_t ch = 0; ch < n_channels; ch++) {
+    fill_noise(input[ch], length, 100 + (std::uint32_t)ch);
+  }
+
+  mts::convolver<T> conv(ir, n_channels, block_size, background, max_partition_size);
+
+  std::vector<T*> in_ptrs(n_channels);
+  std::vector<T*> out_ptrs(n_channels);
+
+  for (std::size_t i = 0, b = 0; i < length; b++) {
+    const std::size_t n = std::min(host_blocks[b % std::size(host_blocks)], length - i);
+
+    for (std::size_t ch = 0; ch < n_channels; ch++) {
+      in_ptrs[ch] = input[ch] + i;
+      out_ptrs[ch] = output[ch] + i;
+    }
+
+    if (in_place) {
+      for (std::size_t ch = 0; ch < n_channels; ch++) {
+        std::copy_n(in_ptrs[ch], n, out_ptrs[ch]);
+      }
+
+      conv.process(mts::audio_bus<T>(out_ptrs.data(), n, n_channels));
+    }
+    else {
+      conv.process(mts::audio_bus<const T>(in_ptrs.data(), n, n_channels),
+          mts::audio_bus<T>(out_ptrs.data(), n, n_channels));
+    }
+
+    i += n;
+  }
+
+  const double tolerance = std::is_same_v<T, float> ? 2e-4 : 1e-10;
+
+  for (std::size_t ch = 0; ch < n_channels; ch++) {
+    const std::vector<double> expected = direct_convolution(input[ch], length, ir[ch % ir_channels], ir_size);
+    double max_error = 0;
+    for (std::size_t i = 0; i < length; i++) {
+      max_error = std::max(max_error, std::abs(expected[i] - (double)output[ch][i]));
+    }
+
+    EXPECT_LT(max_error, tolerance * std::sqrt((double)ir_size))
+        << "ir " << ir_size << " channel " << ch << " block " << block_size << " background " << background;
+  }
+}
+
+TEST(audio_convolver, impulse_response_sizes) {
+  for (std::size_t ir_size : { 1, 20, 64, 65, 700, 2500, 5000 }) {
+    check_convolver<float>(ir_size, 1, 1, 64, true, 8192, false);
+    check_convolver<double>(ir_size, 1, 1, 64, false, 8192, false);
+  }
+}
+
+TEST(audio_convolver, block_sizes) {
+  for (std::size_t block_size : { 1, 16, 48, 128, 1024 }) {
+    check_convolver<float>(3000, 2, 2, block_size, true, 8192, false);
+    check_convolver<float>(3000, 2, 2, block_size, false, 8192, true);
+  }
+}
+
+TEST(audio_convolver, max_partition_size) {
+  for (std::size_t max_partition_size : { 16, 64, 100, 256 }) {
+    check_convolver<double>(4000, 1, 3, 16, true, max_partition_size, false);
+    check_convolver<float>(4000, 2, 3, 16, false, max_partition_size, true);
+  }
+}
+
+TEST(audio_convolver, background_matches_foreground) {
+  constexpr std::size_t length = 4096;
+  mts::audio_buffer<float> ir(3000, 1);
+  mts::audio_buffer<float> a(length, 1);
+  mts::audio_buffer<float> b(length, 1);
+  fill_noise(ir[0], 3000, 3);
+  fill_noise(a[0], length, 4);
+  std::copy_n(a[0], length, b[0]);
+
+  mts::convolver<float> foreground(ir, 1, 32, false);
+  mts::convolver<float> background(ir, 1, 32, true);
+  EXPECT_GT(background.segment_size(), 1u);
+
+  for (std::size_t i = 0; i < length; i += 32) {
+    foreground.process(mts::wire<const float>(a[0] + i, 32), mts::wire<float>(a[0] + i, 32));
+    background.process(mts::wire<const float>(b[0] + i, 32), mts::wire<float>(b[0] + i, 32));
+  }
+
+  for (std::size_t i = 0; i < length; i++) {
+    EXPECT_NEAR(a[0][i], b[0][i], 1e-4f);
+  }
+
+  // Waits for a late background job are counted, there are none without.
+  EXPECT_EQ(foreground.late_job_count(), 0u);
+  EXPECT_LE(background.late_job_count(), length / 32);
+
+  background.clear();
+  std::fill_n(b[0], length, 0.0f);
+  b[0][0] = 1;
+  background.process(mts::wire<const float>(b[0], length), mts::wire<float>(b[0], length));
+
+  for (std::size_t i = 0; i < 3000; i++) {
+    EXPECT_NEAR(b[0][i], ir[0][i], 1e-5f);
+  }
+}
+
+TEST(audio_convolver, wav_impulse_response) {
+  mts::file_view file;
+  ASSERT_FALSE(file.open(MTS_TEST_RESOURCES_DIRECTORY "/trumpet.wav"));
+
+  mts::audio_data<float> data;
+  mts::wav::format format;
+  ASSERT_EQ(mts::wav::load(file.content(), data, format), mts::wav::load_error::no_error);
+
+  // First 2000 frames as a multichannel impulse response.
+  const std::size_t ir_size = std::min<std::size_t>(2000, data.buffer.buffer_size());
+  const std::size_t ir_channels = data.buffer.channel_size();
+  mts::audio_bus<const float> ir(data.buffer.data(), ir_size, ir_channels);
+
+  constexpr std::size_t length = 3000;
+  mts::audio_buffer<float> buffer(length, 2);
+  fill_noise(buffer[0], length, 11);
+  fill_noise(buffer[1], length, 12);
+
+  std::vector<std::vector<double>> expected;
+  for (std::size_t ch = 0; ch < 2; ch++) {
+    expected.push_back(direct_convolution(buffer[ch], length, ir[ch % ir_channels], ir_size));
+  }
+
+  mts::convolver<float> conv(ir, 2, 128);
+  for (std::size_t i = 0; i < length; i += 100) {
+    float* ptrs[2] = { buffer[0] + i, buffer[1] + i };
+    conv.process(mts::audio_bus<float>(ptrs, std::min<std::size_t>(100, length - i), 2));
+  }
+
+  for (std::size_t ch = 0; ch < 2; ch++) {
+    for (std::size_t i = 0; i < length; i++) {
+      ASSERT_NEAR(buffer[ch][i], expected[ch][i], 1e-3) << "channel " << ch << " index " << i;
+    }
+  }
+}
+} // namespace
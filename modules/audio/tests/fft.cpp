@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "mts/audio/fft.h"
+#include "mts/audio/buffer.h"
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace {
+std::vector<std::complex<double>> naive_dft(const std::vector<std::complex<double>>& x, bool inverse) {
+  const std::size_t n = x.size();
+  std::vector<std::complex<double>> y(n);
+  const double sign = inverse ? 1.0 : -1.0;
+
+  for (std::size_t k = 0; k < n; k++) {
+    std::complex<double> sum = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      const double angle = sign * 2.0 * 3.14159265358979323846 * (double)((i * k) % n) / (double)n;
+      sum += x[i] * std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+    y[k] = sum;
+  }
+
+  return y;
+}
+
+template <typename T>
+std::vector<std::complex<T>> make_signal(std::size_t n) {
+  std::vector<std::complex<T>> x(n);
+  for (std::size_t i = 0; i < n; i++) {
+    x[i] = std::complex<T>((T)std::sin(0.3 * (double)i + 0.1), (T)std::cos(0.71 * (double)(i * i % 13)));
+  }
+  return x;
+}
+
+template <typename T>
+void check_complex_fft(std::size_t n, double tolerance) {
+  const std::vector<std::complex<T>> x = make_signal<T>(n);
+  const std::vector<std::complex<double>> xd(x.begin(), x.end());
+  const std::vector<std::complex<double>> expected = naive_dft(xd, false);
+  const std::vector<std::complex<double>> expected_inverse = naive_dft(xd, true);
+
+  mts::fft<T> plan(n);
+  EXPECT_EQ(plan.size(), n);
+
+  std::vector<std::complex<T>> y(n);
+  plan.forward(x.data(), y.data());
+
+  std::vector<std::complex<T>> z(x);
+  plan.forward(z.data(), z.data());
+
+  std::vector<std::complex<T>> w(n);
+  plan.inverse(x.data(), w.data());
+
+  const double scale = tolerance * std::max(1.0, (double)n);
+  for (std::size_t k = 0; k < n; k++) {
+    EXPECT_NEAR(y[k].real(), expected[k].real(), scale) << "size " << n << " bin " << k;
+    EXPECT_NEAR(y[k].imag(), expected[k].imag(), scale) << "size " << n << " bin " << k;
+    EXPECT_EQ(z[k], y[k]);
+    EXPECT_NEAR(w[k].real(), expected_inverse[k].real(), scale) << "size " << n << " bin " << k;
+    EXPECT_NEAR(w[k].imag(), expected_inverse[k].imag(), scale) << "size " << n << " bin " << k;
+  }
+
+  // Round trip in place.
+  plan.inverse(z.data(), z.data());
+  for (std::size_t k = 0; k < n; k++) {
+    EXPECT_NEAR(z[k].real() / (T)n, x[k].real(), tolerance * 10);
+    EXPECT_NEAR(z[k].imag() / (T)n, x[k].imag(), tolerance * 10);
+  }
+}
+
+template <typename T>
+void check_real_fft(std::size_t n, double tolerance) {
+  std::vector<T> x(n);
+  std::vector<std::complex<double>> xd(n);
+  for (std::size_t i = 0; i < n; i++) {
+    x[i] = (T)(std::sin(0.37 * (double)i) + 0.25 * std::cos(1.3 * (double)i) + 0.1);
+    xd[i] = x[i];
+  }
+
+  const std::vector<std::complex<double>> expected = naive_dft(xd, false);
+  const double scale = tolerance * std::max(1.0, (double)n);
+  const std::size_t h = n / 2;
+
+  mts::real_fft<T> plan(n);
+  std::vector<std::complex<T>> y(h + 1);
+  plan.forward(mts::wire<const T>(x), y.data());
+
+  for (std::size_t k = 0; k <= h; k++) {
+    EXPECT_NEAR(y[k].real(), expected[k].real(), scale) << "size " << n << " bin " << k;
+    EXPECT_NEAR(y[k].imag(), expected[k].imag(), scale) << "size " << n << " bin " << k;
+  }
+
+  std::vector<T> r(n);
+  plan.inverse(y.data(), r.data());
+  for (std::size_t i = 0; i < n; i++) {
+    EXPECT_NEAR(r[i] / (T)n, x[i], tolerance * 10) << "size " << n << " index " << i;
+  }
+
+  // Packed in place on an audio_buffer channel.
+  mts::audio_buffer<T> buffer(n, 1);
+  std::copy(x.begin(), x.end(), buffer[0]);
+  plan.forward(buffer.channel_wire(0));
+
+  EXPECT_NEAR(buffer[0][0], expected[0].real(), scale);
+  EXPECT_NEAR(buffer[0][1], expected[h].real(), scale);
+  for (std::size_t k = 1; k < h; k++) {
+    EXPECT_NEAR(buffer[0][2 * k], expected[k].real(), scale);
+    EXPECT_NEAR(buffer[0][2 * k + 1], expected[k].imag(), scale);
+  }
+
+  plan.inverse(buffer.channel_wire(0));
+  for (std::size_t i = 0; i < n; i++) {
+    EXPECT_NEAR(buffer[0][i] / (T)n, x[i], tolerance * 10);
+  }
+}
+
+TEST(audio_fft, complex) {
+  for (std::size_t n : { 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 17, 30, 32, 64, 100, 128, 210, 243, 256, 1024, 1536 }) {
+    check_complex_fft<double>(n, 1e-12);
+    check_complex_fft<float>(n, 2e-6);
+  }
+}
+
+TEST(audio_fft, real) {
+  for (std::size_t n : { 2, 4, 6, 8, 10, 16, 34, 64, 100, 256, 480, 1024 }) {
+    check_real_fft<double>(n, 1e-12);
+    check_real_fft<float>(n, 2e-6);
+  }
+}
+} // namespace
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include "mts/audio/graph.h"
+#include "test_nodes.h"
+#include <thread>
+
+namespace {
+using test::gain_node;
+
+template <typename T>
+class constant_node : public mts::audio_node<T> {
+public:
+  constant_node(std::size_t channel_size, T value)
+      : mts::audio_node<T>({}, { channel_size })
+      , _value(value) {}
+
+  void process(const mts::audio_bus<const T>*, mts::audio_bus<T>* outputs, std::size_t buffer_size) noexcept override {
+    for (std::size_t c = 0; c < outputs[0].channel_size(); c++) {
+      mts::vec::fill(outputs[0][c], 1, _value + (T)c, buffer_size);
+    }
+  }
+
+private:
+  T _value;
+};
+
+TEST(audio_graph, connect) {
+  mts::audio_graph<float> graph({ 2 }, { 2 });
+  const std::size_t stereo = graph.add_node(std::make_shared<gain_node<float>>(2, 1.0f));
+  const std::size_t mono = graph.add_node(std::make_shared<gain_node<float>>(1, 1.0f));
+
+  EXPECT_EQ(graph.node_size(), 4);
+  EXPECT_FALSE(graph.connect(graph.input_node, 0, stereo, 0));
+  EXPECT_EQ(graph.connect(graph.input_node, 0, stereo, 0), mts::audio_graph_error::already_connected);
+  EXPECT_EQ(graph.connect(graph.input_node, 0, mono, 0), mts::audio_graph_error::channel_mismatch);
+  EXPECT_EQ(graph.connect(stereo, 1, graph.output_node, 0), mts::audio_graph_error::invalid_port);
+  EXPECT_EQ(graph.connect(stereo, 0, graph.input_node, 0), mts::audio_graph_error::invalid_node);
+  EXPECT_EQ(graph.connect(stereo, 0, 12, 0), mts::audio_graph_error::invalid_node);
+  EXPECT_EQ(graph.connections().size(), 1);
+
+  graph.disconnect(graph.input_node, 0, stereo, 0);
+  EXPECT_TRUE(graph.connections().empty());
+
+  // Cycle.
+  const std::size_t other = graph.add_node(std::make_shared<gain_node<float>>(2, 1.0f));
+  EXPECT_FALSE(graph.connect(stereo, 0, other, 0));
+  EXPECT_FALSE(graph.connect(other, 0, stereo, 0));
+
+  std::error_code ec;
+  EXPECT_EQ(graph.compile(64, ec), nullptr);
+  EXPECT_EQ(ec, mts::audio_graph_error::cycle);
+}
+
+TEST(audio_graph, process) {
+  // input -> a (x2) -> b (x3) -> output
+  //       \-> c (x5) ---------/
+  // d (constant) -> e (x0.5) -> output 1
+  mts::audio_graph<double> graph({ 2 }, { 2, 1 });
+  const std::size_t a = graph.add_node(std::make_shared<gain_node<double>>(2, 2.0));
+  const std::size_t b = graph.add_node(std::make_shared<gain_node<double>>(2, 3.0));
+  const std::size_t c = graph.add_node(std::make_shared<gain_node<double>>(2, 5.0));
+  const std::size_t d = graph.add_node(std::make_shared<constant_node<double>>(1, 4.0));
+  const std::size_t e = graph.add_node(std::make_shared<gain_node<double>>(1, 0.5));
+  const std::size_t unused = graph.add_node(std::make_shared<gain_node<double>>(1, 1.0));
+
+  // Added out of order.
+  EXPECT_FALSE(graph.connect(b, 0, graph.output_node, 0));
+  EXPECT_FALSE(graph.connect(a, 0, b, 0));
+  EXPECT_FALSE(graph.connect(graph.input_node, 0, a, 0));
+  EXPECT_FALSE(graph.connect(graph.input_node, 0, c, 0));
+  EXPECT_FALSE(graph.connect(c, 0, graph.output_node, 0));
+  EXPECT_FALSE(graph.connect(d, 0, e, 0));
+  EXPECT_FALSE(graph.connect(e, 0, graph.output_node, 1));
+  EXPECT_FALSE(graph.connect(d, 0, unused, 0));
+
+  std::error_code ec;
+  std::unique_ptr<mts::audio_graph_program<double>> program = graph.compile(32, ec);
+  ASSERT_TRUE(program);
+  EXPECT_FALSE(ec);
+  EXPECT_EQ(program->step_size(), 6);
+
+  mts::audio_buffer<double> input(32, 2);
+  mts::audio_buffer<double> output(32, 2);
+  mts::audio_buffer<double> output1(32, 1);
+  for (std::size_t i = 0; i < 32; i++) {
+    input[0][i] = (double)i;
+    input[1][i] = -(double)i;
+  }
+
+  const mts::audio_bus<const double> inputs[] = { input };
+  mts::audio_bus<double> outputs[] = { output, output1 };
+  program->process(inputs, outputs, 24);
+
+  for (std::size_t i = 0; i < 24; i++) {
+    EXPECT_EQ(output[0][i], 11.0 * (double)i);
+    EXPECT_EQ(output[1][i], -11.0 * (double)i);
+    EXPECT_EQ(output1[0][i], 2.0);
+  }
+
+  EXPECT_EQ(output[0][24], 0.0);
+}
+
+TEST(audio_graph, buffer_reuse) {
+  constexpr std::size_t n_nodes = 16;
+  mts::audio_graph<float> graph({ 2 }, { 2 });
+
+  std::size_t previous = graph.input_node;
+  for (std::size_t i = 0; i < n_nodes; i++) {
+    const std::size_t node = graph.add_node(std::make_shared<gain_node<float>>(2, 2.0f));
+    EXPECT_FALSE(graph.connect(previous, 0, node, 0));
+    previous = node;
+  }
+
+  EXPECT_FALSE(graph.connect(previous, 0, graph.output_node, 0));
+
+  // A chain only needs two buffers.
+  std::error_code ec;
+  std::unique_ptr<mts::audio_graph_program<float>> program = graph.compile(16, ec);
+  ASSERT_TRUE(program);
+  EXPECT_EQ(program->buffer_size(), 2);
+  EXPECT_EQ(program->buffer_channel_size(), 4);
+
+  mts::audio_buffer<float> input(16, 2);
+  mts::audio_buffer<float> output(16, 2);
+  input[0][3] = 1.0f;
+  input[1][5] = -1.0f;
+
+  const mts::audio_bus<const float> inputs[] = { input };
+  mts::audio_bus<float> outputs[] = { output };
+  program->process(inputs, outputs, 16);
+
+  EXPECT_EQ(output[0][3], 65536.0f);
+  EXPECT_EQ(output[1][5], -65536.0f);
+  EXPECT_EQ(output[0][4], 0.0f);
+}
+
+TEST(audio_graph, fan_in) {
+  // Four constants summed into a gain node input, and with the graph input
+  // into the graph output.
+  mts::audio_graph<float> graph({ 1 }, { 1 });
+  const std::size_t g = graph.add_node(std::make_shared<gain_node<float>>(1, 10.0f));
+
+  for (std::size_t i = 0; i < 4; i++) {
+    const std::size_t k = graph.add_node(std::make_shared<constant_node<float>>(1, (float)(i + 1)));
+    EXPECT_FALSE(graph.connect(k, 0, g, 0));
+  }
+
+  EXPECT_FALSE(graph.connect(g, 0, graph.output_node, 0));
+  EXPECT_FALSE(graph.connect(graph.input_node, 0, graph.output_node, 0));
+
+  std::error_code ec;
+  std::unique_ptr<mts::audio_graph_program<float>> program = graph.compile(8, ec);
+  ASSERT_TRUE(program);
+
+  // The four outputs, the sum and the gain output.
+  EXPECT_EQ(program->buffer_size(), 6);
+
+  mts::audio_buffer<float> input(8, 1);
+  mts::audio_buffer<float> output(8, 1);
+  mts::vec::fill(input[0], 1, 0.5f, 8);
+
+  const mts::audio_bus<const float> inputs[] = { input };
+  mts::audio_bus<float> outputs[] = { output };
+  program->process(inputs, outputs, 8);
+
+  for (std::size_t i = 0; i < 8; i++) {
+    EXPECT_EQ(output[0][i], 100.5f);
+  }
+}
+
+TEST(audio_graph_engine, set_program) {
+  mts::audio_graph_engine<float> engine;
+  mts::audio_buffer<float> input(16, 1);
+  mts::audio_buffer<float> output(16, 1);
+  mts::vec::fill(input[0], 1, 1.0f, 16);
+  mts::vec::fill(output[0], 1, 1.0f, 16);
+
+  const mts::audio_bus<const float> inputs[] = { input };
+  mts::audio_bus<float> outputs[] = { output };
+
+  // No program.
+  engine.process(inputs, outputs, 1, 16);
+  EXPECT_EQ(output[0][0], 0.0f);
+
+  auto compile = [](float gain) {
+    mts::audio_graph<float> graph({ 1 }, { 1 });
+    const std::size_t g = graph.add_node(std::make_shared<gain_node<float>>(1, gain));
+    graph.connect(graph.input_node, 0, g, 0);
+    graph.connect(g, 0, graph.output_node, 0);
+
+    std::error_code ec;
+    return graph.compile(16, ec);
+  };
+
+  engine.set_program(compile(2.0f));
+  EXPECT_TRUE(engine.is_pending());
+  engine.process(inputs, outputs, 1, 16);
+  EXPECT_FALSE(engine.is_pending());
+  EXPECT_EQ(output[0][15], 2.0f);
+
+  // Swapped while the audio thread runs.
+  std::atomic<bool> stop = false;
+  std::thread audio([&]() {
+    while (!stop.load()) {
+      engine.process(inputs, outputs, 1, 16);
+      std::this_thread::yield();
+    }
+  });
+
+  for (std::size_t i = 0; i < 64; i++) {
+    engine.set_program(compile((float)i));
+    std::this_thread::yield();
+  }
+
+  while (engine.is_pending()) {
+    engine.collect();
+    std::this_thread::yield();
+  }
+
+  stop = true;
+  audio.join();
+  engine.collect();
+
+  EXPECT_EQ(output[0][0], 63.0f);
+}
+} // namespace
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "mts/audio/graph_executor.h"
+#include "test_nodes.h"
+
+namespace {
+using test::gain_node;
+
+mts::audio_graph_executor<float>::options test_options(std::size_t n_workers) {
+  mts::audio_graph_executor<float>::options opts;
+  opts.n_workers = n_workers;
+  opts.spin_size = 100;
+  return opts;
+}
+
+// n_tracks chains of n_nodes gain nodes from the graph input, summed into the
+// graph output.
+std::unique_ptr<mts::audio_graph_program<float>> make_tracks(std::size_t n_tracks, std::size_t n_nodes) {
+  mts::audio_graph<float> graph({ 2 }, { 2 });
+
+  for (std::size_t t = 0; t < n_tracks; t++) {
+    std::size_t previous = graph.input_node;
+
+    for (std::size_t i = 0; i < n_nodes; i++) {
+      const float gain = i == 0 ? (float)(t + 1) : (i % 2 ? 0.5f : 2.0f);
+      const std::size_t node = graph.add_node(std::make_shared<gain_node<float>>(2, gain));
+      graph.connect(previous, 0, node, 0);
+      previous = node;
+    }
+
+    graph.connect(previous, 0, graph.output_node, 0);
+  }
+
+  std::error_code ec;
+  return graph.compile(256, ec);
+}
+
+TEST(audio_graph_executor, dependencies) {
+  mts::audio_graph<float> graph({ 1 }, { 1 });
+  const std::size_t a = graph.add_node(std::make_shared<gain_node<float>>(1, 1.0f));
+  const std::size_t b = graph.add_node(std::make_shared<gain_node<float>>(1, 1.0f));
+  const std::size_t c = graph.add_node(std::make_shared<gain_node<float>>(1, 1.0f));
+  const std::size_t d = graph.add_node(std::make_shared<gain_node<float>>(1, 1.0f));
+  graph.connect(graph.input_node, 0, a, 0);
+  graph.connect(a, 0, b, 0);
+  graph.connect(b, 0, c, 0);
+  graph.connect(c, 0, graph.output_node, 0);
+  graph.connect(graph.input_node, 0, d, 0);
+
+  std::error_code ec;
+  std::unique_ptr<mts::audio_graph_program<float>> program = graph.compile(16, ec);
+  ASSERT_TRUE(program);
+
+  // a, d, b, c: b reuses the buffer of d and c the one of a, which b must
+  // have read.
+  EXPECT_EQ(program->step_size(), 4);
+  EXPECT_EQ(program->step_dependency_size(0), 0);
+  EXPECT_EQ(program->step_dependency_size(1), 0);
+  EXPECT_EQ(program->step_dependency_size(2), 2);
+  EXPECT_EQ(program->step_dependency_size(3), 2);
+}
+
+TEST(audio_graph_executor, process) {
+  constexpr std::size_t buffer_size = 256;
+  std::unique_ptr<mts::audio_graph_program<float>> program = make_tracks(24, 6);
+  std::unique_ptr<mts::audio_graph_program<float>> reference = make_tracks(24, 6);
+  ASSERT_TRUE(program && reference);
+
+  mts::audio_graph_executor<float> executor(test_options(3));
+  EXPECT_EQ(executor.worker_size(), 3);
+
+  mts::audio_buffer<float> input(buffer_size, 2);
+  mts::audio_buffer<float> output(buffer_size, 2);
+  mts::audio_buffer<float> expected(buffer_size, 2);
+  const mts::audio_bus<const float> inputs[] = { input };
+  mts::audio_bus<float> outputs[] = { output };
+  mts::audio_bus<float> expected_outputs[] = { expected };
+
+  for (std::size_t n = 0; n < 200; n++) {
+    for (std::size_t i = 0; i < buffer_size; i++) {
+      input[0][i] = (float)((n + i) % 7);
+      input[1][i] = -(float)((n * i) % 5);
+    }
+
+    executor.process(*program, inputs, outputs, buffer_size - n % 3, std::chrono::nanoseconds(0));
+    reference->process(inputs, expected_outputs, buffer_size - n % 3);
+
+    for (std::size_t c = 0; c < 2; c++) {
+      for (std::size_t i = 0; i < buffer_size - n % 3; i++) {
+        ASSERT_EQ(output[c][i], expected[c][i]);
+      }
+    }
+  }
+
+  mts::audio_graph_executor<float>::statistics stats = executor.get_statistics();
+  EXPECT_EQ(stats.callbacks, 200);
+  EXPECT_EQ(stats.fallback_callbacks, 0);
+  EXPECT_GE(stats.peak_time, stats.last_time);
+
+  for (std::size_t s = 0; s < program->step_size(); s++) {
+    EXPECT_GE(program->step_time(s).peak, program->step_time(s).last);
+  }
+}
+
+TEST(audio_graph_executor, fallback) {
+  std::unique_ptr<mts::audio_graph_program<float>> program = make_tracks(8, 4);
+  ASSERT_TRUE(program);
+
+  mts::audio_graph_executor<float>::options opts = test_options(2);
+  opts.fallback_size = 10;
+  mts::audio_graph_executor<float> executor(opts);
+
+  mts::audio_buffer<float> input(256, 2);
+  mts::audio_buffer<float> output(256, 2);
+  const mts::audio_bus<const float> inputs[] = { input };
+  mts::audio_bus<float> outputs[] = { output };
+  mts::vec::fill(input[0], 1, 1.0f, 256);
+
+  // Always at risk, every parallel callback is followed by 10 single threaded
+  // ones.
+  for (std::size_t n = 0; n < 22; n++) {
+    executor.process(*program, inputs, outputs, 256, std::chrono::nanoseconds(1));
+  }
+
+  mts::audio_graph_executor<float>::statistics stats = executor.get_statistics();
+  EXPECT_EQ(stats.callbacks, 22);
+  EXPECT_EQ(stats.deadlines_at_risk, 2);
+  EXPECT_EQ(stats.fallback_callbacks, 20);
+  EXPECT_EQ(output[0][255], 18.0f);
+  EXPECT_EQ(output[1][0], 0.0f);
+}
+
+TEST(audio_graph_executor, engine) {
+  mts::audio_graph_engine<float> engine;
+  mts::audio_graph_executor<float> executor(test_options(1));
+  engine.set_program(make_tracks(4, 3));
+
+  mts::audio_buffer<float> input(64, 2);
+  mts::audio_buffer<float> output(64, 2);
+  const mts::audio_bus<const float> inputs[] = { input };
+  mts::audio_bus<float> outputs[] = { output };
+  mts::vec::fill(input[1], 1, 2.0f, 64);
+
+  engine.process(executor, inputs, outputs, 1, 64, std::chrono::milliseconds(10));
+
+  // 2 * (1 + 2 + 3 + 4).
+  EXPECT_EQ(output[1][63], 20.0f);
+  EXPECT_EQ(executor.get_statistics().callbacks, 1);
+}
+} // namespace
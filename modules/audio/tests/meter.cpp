@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "mts/audio/meter.h"
+#include "mts/audio/buffer.h"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr double pi = 3.14159265358979323846;
+
+// Feeds seconds of a sine with amplitude in dBFS to the given channels, in host blocks of 512.
+template <typename T>
+void feed_sine(mts::meter<T>& m, double seconds, double db, std::vector<std::size_t> channels, double phase = 0) {
+  const std::size_t length = (std::size_t)(seconds * m.sample_rate());
+  const double amplitude = std::pow(10.0, db / 20);
+  mts::audio_buffer<T> buffer(512, m.channel_size());
+
+  for (std::size_t i = 0; i < length; i += 512) {
+    const std::size_t n = std::min<std::size_t>(512, length - i);
+    buffer.clear();
+
+    for (std::size_t ch : channels) {
+      for (std::size_t k = 0; k < n; k++) {
+        buffer[ch][k] = (T)(amplitude * std::sin(2 * pi * 997 * (double)(i + k) / m.sample_rate() + phase));
+      }
+    }
+
+    m.process(mts::audio_bus<const T>(buffer.data(), n, m.channel_size()));
+  }
+}
+
+TEST(audio_meter, k_weighting) {
+  // BS.1770 coefficients at 48 kHz.
+  const mts::biquad_coefficients<double> shelf = mts::meter<double>::k_weighting_shelf(48000);
+  EXPECT_NEAR(shelf.b0, 1.53512485958697, 1e-12);
+  EXPECT_NEAR(shelf.b1, -2.69169618940638, 1e-12);
+  EXPECT_NEAR(shelf.b2, 1.19839281085285, 1e-12);
+  EXPECT_NEAR(shelf.a1, -1.69065929318241, 1e-12);
+  EXPECT_NEAR(shelf.a2, 0.73248077421585, 1e-12);
+
+  const mts::biquad_coefficients<double> highpass = mts::meter<double>::k_weighting_highpass(48000);
+  EXPECT_NEAR(highpass.a1, -1.99004745483398, 1e-12);
+  EXPECT_NEAR(highpass.a2, 0.99007225036621, 1e-12);
+}
+
+TEST(audio_meter, loudness) {
+  for (double sample_rate : { 44100.0, 48000.0 }) {
+    // 0 dBFS 997 Hz sine on one channel is -3.01 LUFS.
+    mts::meter<float> m(2, sample_rate);
+    EXPECT_LT(m.integrated_loudness(), -100.0f);
+
+    feed_sine(m, 5, 0, { 0 });
+    EXPECT_NEAR(m.momentary_loudness(), -3.01f, 0.05f);
+    EXPECT_NEAR(m.short_term_loudness(), -3.01f, 0.05f);
+    EXPECT_NEAR(m.integrated_loudness(), -3.01f, 0.05f);
+
+    // On both channels.
+    m.clear();
+    feed_sine(m, 5, -20, { 0, 1 });
+    EXPECT_NEAR(m.momentary_loudness(), -20.0f, 0.05f);
+    EXPECT_NEAR(m.integrated_loudness(), -20.0f, 0.05f);
+  }
+}
+
+TEST(audio_meter, gating) {
+  mts::meter<float> m(1, 48000);
+
+  // Silence is below the absolute gate, the 3 gating blocks fading out have 1.5 blocks of power.
+  const float integrated = -23.01f + 10 * std::log10(98.5f / 100);
+  feed_sine(m, 10, -20, { 0 });
+  feed_sine(m, 10, -200, { 0 });
+  EXPECT_LT(m.momentary_loudness(), -100.0f);
+  EXPECT_NEAR(m.integrated_loudness(), integrated, 0.01f);
+
+  // -43 LUFS is below the relative gate of -33 LUFS.
+  feed_sine(m, 10, -40, { 0 });
+  EXPECT_NEAR(m.short_term_loudness(), -43.01f, 0.05f);
+  EXPECT_NEAR(m.integrated_loudness(), integrated, 0.01f);
+
+  // Channel weights.
+  m.clear();
+  m.set_channel_weight(0, 0.5f);
+  feed_sine(m, 2, -20, { 0 });
+  EXPECT_NEAR(m.momentary_loudness(), -26.02f, 0.05f);
+}
+
+TEST(audio_meter, peaks) {
+  mts::meter<double> m(2, 48000);
+
+  // A quarter sample rate sine at 45 degrees only has samples at +-0.707.
+  // 300 ms, the default rms window.
+  mts::audio_buffer<double> buffer(14400, 2);
+  for (std::size_t i = 0; i < buffer.buffer_size(); i++) {
+    buffer[0][i] = std::sin(pi / 2 * (double)i + pi / 4);
+    buffer[1][i] = 0.5 * std::sin(2 * pi * 997 * (double)i / 48000);
+  }
+
+  m.process(buffer);
+  EXPECT_NEAR(m.peak(0), std::sqrt(0.5), 1e-9);
+  EXPECT_NEAR(m.true_peak(0), 1.0, 0.02);
+  EXPECT_NEAR(m.max_true_peak(0), 1.0, 0.02);
+  EXPECT_NEAR(m.rms(0), std::sqrt(0.5), 1e-3);
+
+  EXPECT_NEAR(m.peak(1), 0.5, 1e-3);
+  EXPECT_NEAR(m.true_peak(1), 0.5, 1e-2);
+  EXPECT_NEAR(m.rms(1), 0.5 * std::sqrt(0.5), 1e-3);
+
+  // The max true peak is held, the oversampled signal is a few samples late.
+  buffer.clear();
+  m.process(buffer);
+  m.process(buffer);
+  EXPECT_EQ(m.peak(0), 0.0);
+  EXPECT_LT(m.true_peak(0), 0.01);
+  EXPECT_NEAR(m.max_true_peak(0), 1.0, 0.02);
+}
+
+TEST(audio_meter, publication) {
+  mts::meter<float> m(2, 48000);
+  const std::uint64_t count = m.update_count();
+
+  // Reads while the audio thread publishes.
+  std::atomic<bool> done = false;
+  std::atomic<float> sum = 0;
+  std::thread reader([&]() {
+    while (!done.load()) {
+      sum.store(m.momentary_loudness() + m.peak(0) + m.rms(1) + m.max_true_peak(1));
+    }
+  });
+
+  feed_sine(m, 2, -10, { 0, 1 });
+  done.store(true);
+  reader.join();
+
+  // One update per 100 ms.
+  EXPECT_EQ(m.update_count() - count, 20);
+}
+} // namespace
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "mts/audio/mixer.h"
+#include "mts/audio/buffer.h"
+#include "test_signals.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+using test::fill_noise;
+
+template <typename T>
+void check_mixer(std::size_t buffer_size, std::size_t cache_size) {
+  // Mono, stereo and quad sources into mono, stereo and unused busses.
+  const std::size_t source_channels[] = { 1, 2, 2, 4, 2, 1, 2 };
+  const std::size_t destination_channels[] = { 2, 1, 2, 2 };
+  constexpr std::size_t n_sources = std::size(source_channels);
+  constexpr std::size_t n_destinations = std::size(destination_channels);
+
+  std::vector<mts::audio_buffer<T>> src_buffers;
+  std::vector<mts::audio_buffer<T>> dst_buffers;
+  std::vector<mts::audio_bus<const T>> sources;
+  std::vector<mts::audio_bus<T>> destinations;
+
+  for (std::size_t s = 0; s < n_sources; s++) {
+    src_buffers.emplace_back(buffer_size, source_channels[s]);
+    for (std::size_t c = 0; c < source_channels[s]; c++) {
+      fill_noise(src_buffers[s][c], buffer_size, (std::uint32_t)(s * 8 + c));
+    }
+  }
+
+  for (std::size_t d = 0; d < n_destinations; d++) {
+    dst_buffers.emplace_back(buffer_size, destination_channels[d]);
+    for (std::size_t c = 0; c < destination_channels[d]; c++) {
+      std::fill_n(dst_buffers[d][c], buffer_size, T(100));
+    }
+  }
+
+  for (std::size_t s = 0; s < n_sources; s++) {
+    sources.emplace_back(src_buffers[s]);
+  }
+
+  for (std::size_t d = 0; d < n_destinations; d++) {
+    destinations.emplace_back(dst_buffers[d]);
+  }
+
+  mts::mixer<T> mix(n_sources, n_destinations);
+  mix.set_cache_size(cache_size);
+
+  for (std::size_t s = 0; s < n_sources; s++) {
+    for (std::size_t d = 0; d + 1 < n_destinations; d++) {
+      // Leave a few zero gains.
+      if ((s + d) % 3 != 2) {
+        mix.set_gain(s, d, (T)(0.1 * (double)(s + 1) - 0.05 * (double)d));
+      }
+    }
+  }
+
+  mix.process(sources, destinations, buffer_size);
+
+  for (std::size_t d = 0; d < n_destinations; d++) {
+    const std::size_t n_dst = destination_channels[d];
+    std::vector<double> expected(n_dst * buffer_size, 0.0);
+
+    for (std::size_t s = 0; s < n_sources; s++) {
+      const std::size_t n_src = source_channels[s];
+      const double g = (double)mix.gain(s, d);
+
+      for (std::size_t c = 0; c < std::max(n_src, n_dst); c++) {
+        for (std::size_t i = 0; i < buffer_size; i++) {
+          expected[(c % n_dst) * buffer_size + i] += g * (double)src_buffers[s][c % n_src][i];
+        }
+      }
+    }
+
+    for (std::size_t c = 0; c < n_dst; c++) {
+      for (std::size_t i = 0; i < buffer_size; i++) {
+        EXPECT_NEAR(dst_buffers[d][c][i], expected[c * buffer_size + i], 1e-5) << "bus " << d << " channel " << c;
+      }
+    }
+  }
+}
+
+TEST(audio_mixer, mix) {
+  for (std::size_t buffer_size : { 1, 63, 512, 3000 }) {
+    check_mixer<float>(buffer_size, mts::mixer<float>::default_cache_size);
+    check_mixer<double>(buffer_size, mts::mixer<double>::default_cache_size);
+
+    // Smallest tiles.
+    check_mixer<float>(buffer_size, 0);
+  }
+}
+
+TEST(audio_mixer, empty_busses) {
+  mts::audio_buffer<float> src(16, 2);
+  mts::audio_buffer<float> dst(16, 1);
+  std::fill_n(src[0], 16, 1.0f);
+  std::fill_n(src[1], 16, 2.0f);
+  std::fill_n(dst[0], 16, 100.0f);
+
+  const mts::audio_bus<const float> sources[] = { mts::audio_bus<const float>(nullptr, 16, 0), src };
+  mts::audio_bus<float> destinations[] = { dst, mts::audio_bus<float>(nullptr, 16, 0) };
+
+  mts::mixer<float> mix(2, 2);
+  mix.set_gain(0, 0, 1.0f);
+  mix.set_gain(1, 1, 1.0f);
+  mix.process(sources, destinations, 16);
+  EXPECT_EQ(dst[0][15], 0.0f);
+
+  mix.set_gain(1, 0, 0.5f);
+  mix.process(sources, destinations, 16);
+  EXPECT_EQ(dst[0][15], 1.5f);
+}
+
+TEST(audio_mixer, gains) {
+  mts::mixer<float> mix(3, 2);
+  EXPECT_EQ(mix.source_size(), 3);
+  EXPECT_EQ(mix.destination_size(), 2);
+  EXPECT_EQ(mix.gain(2, 1), 0.0f);
+
+  mix.set_gain(2, 1, 0.5f);
+  EXPECT_EQ(mix.gain(2, 1), 0.5f);
+  EXPECT_EQ(mix.gain(1, 1), 0.0f);
+
+  mix.clear_gains();
+  EXPECT_EQ(mix.gain(2, 1), 0.0f);
+
+  EXPECT_EQ(mix.tile_size(0) % 16, 0);
+  EXPECT_GE(mix.tile_size(1000), 64);
+}
+} // namespace
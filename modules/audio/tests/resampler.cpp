@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "mts/audio/resampler.h"
+#include "mts/audio/buffer.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+constexpr double pi = 3.14159265358979323846;
+
+template <typename T>
+void fill_sine(T* data, std::size_t size, double frequency, double sample_rate, double offset = 0) {
+  for (std::size_t i = 0; i < size; i++) {
+    data[i] = (T)(0.5 * std::sin(2 * pi * frequency * ((double)i + offset) / sample_rate));
+  }
+}
+
+template <typename T>
+void check_resample(double source_rate, double target_rate, mts::resampler_quality quality, double tolerance) {
+  constexpr std::size_t length = 4000;
+  constexpr double frequency = 1000;
+
+  mts::audio_buffer<T> input(length, 2);
+  fill_sine(input[0], length, frequency, source_rate);
+  fill_sine(input[1], length, frequency * 2, source_rate);
+
+  mts::audio_buffer<T> output = mts::resample<T>(input, source_rate, target_rate, quality);
+  EXPECT_EQ(output.buffer_size(), (std::size_t)std::ceil(length * target_rate / source_rate - 1e-9));
+  ASSERT_EQ(output.channel_size(), 2);
+
+  // The edges see the zeros around the signal.
+  const std::size_t margin = (std::size_t)(100 * std::max(1.0, target_rate / source_rate));
+  for (std::size_t ch = 0; ch < 2; ch++) {
+    std::vector<T> expected(output.buffer_size());
+    fill_sine(expected.data(), expected.size(), frequency * (double)(ch + 1), target_rate);
+
+    double max_error = 0;
+    for (std::size_t i = margin; i + margin < output.buffer_size(); i++) {
+      max_error = std::max(max_error, std::abs((double)output[ch][i] - (double)expected[i]));
+    }
+
+    EXPECT_LT(max_error, tolerance) << source_rate << " to " << target_rate << " channel " << ch;
+  }
+}
+
+TEST(audio_resampler, rational_ratios) {
+  check_resample<float>(44100, 48000, mts::resampler_quality::high, 1e-4);
+  check_resample<float>(48000, 44100, mts::resampler_quality::high, 1e-4);
+  check_resample<double>(22050, 48000, mts::resampler_quality::high, 1e-5);
+  check_resample<double>(96000, 44100, mts::resampler_quality::high, 1e-5);
+  check_resample<float>(44100, 44100, mts::resampler_quality::low, 1e-3);
+  check_resample<float>(44100, 48000, mts::resampler_quality::medium, 1e-3);
+  check_resample<float>(44100, 48000, mts::resampler_quality::low, 1e-2);
+}
+
+TEST(audio_resampler, arbitrary_ratios) {
+  check_resample<float>(44100, 47123.4, mts::resampler_quality::high, 1e-4);
+  check_resample<double>(48000, 44099.9, mts::resampler_quality::high, 1e-5);
+  check_resample<double>(44100, 7 * 8191, mts::resampler_quality::medium, 1e-3);
+}
+
+TEST(audio_resampler, streaming_blocks) {
+  constexpr std::size_t length = 5000;
+  const std::size_t input_blocks[] = { 1, 37, 512, 3, 900, 64 };
+  const std::size_t output_blocks[] = { 128, 5, 700, 1, 33 };
+
+  std::vector<float> input(length);
+  fill_sine(input.data(), length, 440, 44100);
+
+  for (double target_rate : { 48000.0, 22050.0, 47999.5 }) {
+    mts::resampler<float> reference(1, 44100, target_rate);
+    std::vector<float> expected(2 * length);
+    const auto all = reference.process(mts::wire<const float>(input), mts::wire<float>(expected));
+    EXPECT_EQ(all.input_size, length);
+
+    mts::resampler<float> r(1, 44100, target_rate);
+    std::vector<float> output(2 * length);
+    std::size_t i = 0;
+    std::size_t o = 0;
+
+    for (std::size_t b = 0; i < length; b++) {
+      const std::size_t n_in = std::min(input_blocks[b % std::size(input_blocks)], length - i);
+      const std::size_t n_out = output_blocks[b % std::size(output_blocks)];
+      const auto res
+          = r.process(mts::wire<const float>(input.data() + i, n_in), mts::wire<float>(output.data() + o, n_out));
+      EXPECT_LE(res.input_size, n_in);
+      EXPECT_LE(res.output_size, n_out);
+      i += res.input_size;
+      o += res.output_size;
+    }
+
+    // Drains what the buffered input still gives.
+    o += r.process(mts::wire<const float>(input.data(), 0), mts::wire<float>(output.data() + o, length)).output_size;
+
+    ASSERT_EQ(o, all.output_size) << target_rate;
+    for (std::size_t k = 0; k < o; k++) {
+      ASSERT_EQ(output[k], expected[k]) << target_rate << " index " << k;
+    }
+  }
+}
+
+TEST(audio_resampler, realtime_pull) {
+  constexpr std::size_t block_size = 256;
+  constexpr double source_rate = 44100;
+  constexpr double target_rate = 48000;
+
+  mts::resampler<double> r(1, source_rate, target_rate);
+  std::vector<double> input(20000);
+  std::vector<double> output(block_size);
+  fill_sine(input.data(), input.size(), 500, source_rate);
+
+  std::size_t i = 0;
+  for (std::size_t b = 0; b < 50; b++) {
+    const std::size_t n_in = r.input_size(block_size);
+    ASSERT_EQ(r.output_size(n_in), block_size);
+
+    const auto res = r.process(mts::wire<const double>(input.data() + i, n_in), mts::wire<double>(output));
+    ASSERT_EQ(res.input_size, n_in);
+    ASSERT_EQ(res.output_size, block_size);
+
+    // Output k is the input at k * source_rate / target_rate - latency().
+    if (b > 0) {
+      for (std::size_t k = 0; k < block_size; k++) {
+        const double t = (double)(b * block_size + k) * source_rate / target_rate - (double)r.latency();
+        EXPECT_NEAR(output[k], 0.5 * std::sin(2 * pi * 500 * t / source_rate), 1e-5);
+      }
+    }
+
+    i += n_in;
+  }
+}
+} // namespace
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "mts/audio/ring_buffer.h"
+#include <thread>
+
+namespace {
+TEST(audio_ring_buffer, wraparound) {
+  mts::audio_ring_buffer<float> ring(12, 2);
+  EXPECT_TRUE(ring.is_valid());
+  EXPECT_EQ(ring.capacity(), 16);
+  EXPECT_EQ(ring.channel_size(), 2);
+  EXPECT_EQ(ring.read_available(), 0);
+  EXPECT_EQ(ring.write_available(), 16);
+
+  mts::audio_buffer<float> src(10, 2);
+  mts::audio_buffer<float> dst(10, 2);
+  float value = 0;
+
+  for (std::size_t n = 0; n < 8; n++) {
+    for (std::size_t i = 0; i < 10; i++) {
+      src[0][i] = value + (float)i;
+      src[1][i] = -(value + (float)i);
+    }
+
+    EXPECT_EQ(ring.write(src), 10);
+    EXPECT_EQ(ring.read_available(), 10);
+    EXPECT_EQ(ring.write_available(), 6);
+    EXPECT_DOUBLE_EQ(ring.fill_ratio(), 10.0 / 16.0);
+
+    EXPECT_EQ(ring.read(dst), 10);
+    EXPECT_EQ(ring.read_available(), 0);
+
+    for (std::size_t i = 0; i < 10; i++) {
+      EXPECT_EQ(dst[0][i], value + (float)i);
+      EXPECT_EQ(dst[1][i], -(value + (float)i));
+    }
+
+    value += 10;
+  }
+}
+
+TEST(audio_ring_buffer, partial) {
+  mts::audio_ring_buffer<double> ring(8, 1);
+  mts::audio_buffer<double> src(6, 1);
+  mts::audio_buffer<double> dst(6, 1);
+
+  for (std::size_t i = 0; i < 6; i++) {
+    src[0][i] = (double)i;
+  }
+
+  // Full.
+  EXPECT_EQ(ring.write(src), 6);
+  EXPECT_EQ(ring.write(src), 2);
+  EXPECT_EQ(ring.write(src), 0);
+  EXPECT_EQ(ring.write_available(), 0);
+
+  EXPECT_EQ(ring.skip(3), 3);
+  EXPECT_EQ(ring.read_available(), 5);
+
+  // The remaining frames are left untouched.
+  dst[0][5] = -1;
+  EXPECT_EQ(ring.read(dst), 5);
+  EXPECT_EQ(dst[0][0], 3.0);
+  EXPECT_EQ(dst[0][2], 5.0);
+  EXPECT_EQ(dst[0][3], 0.0);
+  EXPECT_EQ(dst[0][4], 1.0);
+  EXPECT_EQ(dst[0][5], -1.0);
+  EXPECT_EQ(ring.read(dst), 0);
+
+  // Into a sub bus.
+  double* pointers[1];
+  EXPECT_EQ(ring.write(src), 6);
+  EXPECT_EQ(ring.read(mts::audio_bus<double>(dst).subbus(4, 2, pointers)), 2);
+  EXPECT_EQ(dst[0][4], 0.0);
+  EXPECT_EQ(dst[0][5], 1.0);
+}
+
+TEST(audio_ring_buffer, threads) {
+  constexpr std::size_t n_frames = 1 << 18;
+  mts::audio_ring_buffer<float> ring(256, 2);
+
+  std::thread producer([&ring]() {
+    mts::audio_buffer<float> src(48, 2);
+    std::size_t frame = 0;
+
+    while (frame < n_frames) {
+      const std::size_t n = std::min<std::size_t>(48, n_frames - frame);
+      for (std::size_t i = 0; i < n; i++) {
+        src[0][i] = (float)((frame + i) % 4096);
+        src[1][i] = -src[0][i];
+      }
+
+      float* pointers[2];
+      std::size_t written = 0;
+      while (written < n) {
+        const std::size_t w = ring.write(mts::audio_bus<float>(src).subbus(written, n - written, pointers));
+        if (!w) {
+          std::this_thread::yield();
+        }
+
+        written += w;
+      }
+
+      frame += n;
+    }
+  });
+
+  mts::audio_buffer<float> dst(37, 2);
+  std::size_t frame = 0;
+  bool valid = true;
+
+  while (frame < n_frames) {
+    const std::size_t n = ring.read(dst);
+    if (!n) {
+      std::this_thread::yield();
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+      valid = valid && dst[0][i] == (float)((frame + i) % 4096) && dst[1][i] == -dst[0][i];
+    }
+
+    frame += n;
+  }
+
+  producer.join();
+  EXPECT_TRUE(valid);
+  EXPECT_EQ(ring.read_available(), 0);
+}
+} // namespace
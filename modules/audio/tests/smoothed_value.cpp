@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "mts/audio/smoothed_value.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+template <mts::smoothing_type Type>
+void check_block_matches_next(float from, float to) {
+  constexpr std::size_t smoothing_size = 100;
+  constexpr std::size_t block_size = 32;
+
+  mts::smoothed_value<float, Type> block(from, smoothing_size);
+  mts::smoothed_value<float, Type> scalar(from, smoothing_size);
+  block.set_target(to);
+  scalar.set_target(to);
+
+  std::vector<float> input(block_size);
+  for (std::size_t i = 0; i < input.size(); i++) {
+    input[i] = 1.0f - (float)i * 0.05f;
+  }
+
+  std::vector<float> output(block_size);
+  std::vector<float> added(block_size);
+
+  // Four blocks cover the ramp and the first samples at the target.
+  for (std::size_t b = 0; b < 4; b++) {
+    mts::smoothed_value<float, Type> add = block;
+    mts::smoothed_value<float, Type> fill = block;
+    std::vector<float> filled(block_size);
+    std::fill(added.begin(), added.end(), 0.5f);
+
+    block.apply(mts::wire<const float>(input), mts::wire<float>(output));
+    add.apply_add(mts::wire<const float>(input), mts::wire<float>(added));
+    fill.fill(mts::wire<float>(filled));
+
+    // Same values up to rounding, next() accumulates the step.
+    for (std::size_t i = 0; i < block_size; i++) {
+      const float value = scalar.next();
+      const float tolerance = 1e-4f * std::max(1.0f, std::abs(value));
+      EXPECT_NEAR(filled[i], value, tolerance) << "block " << b << " i " << i;
+      EXPECT_NEAR(output[i], input[i] * value, tolerance) << "block " << b << " i " << i;
+      EXPECT_NEAR(added[i], input[i] * value + 0.5f, tolerance) << "block " << b << " i " << i;
+    }
+
+    EXPECT_NEAR(block.current(), scalar.current(), 1e-4f);
+    EXPECT_EQ(block.is_smoothing(), scalar.is_smoothing());
+  }
+
+  EXPECT_FALSE(block.is_smoothing());
+  EXPECT_EQ(block.current(), to);
+}
+
+TEST(audio_smoothed_value, linear) {
+  check_block_matches_next<mts::smoothing_type::linear>(0.0f, 1.0f);
+  check_block_matches_next<mts::smoothing_type::linear>(1.0f, -0.5f);
+}
+
+TEST(audio_smoothed_value, exponential) {
+  check_block_matches_next<mts::smoothing_type::exponential>(0.001f, 1.0f);
+  check_block_matches_next<mts::smoothing_type::exponential>(2.0f, 0.25f);
+
+  // Crossing zero falls back to a linear ramp.
+  check_block_matches_next<mts::smoothing_type::exponential>(1.0f, -1.0f);
+}
+
+TEST(audio_smoothed_value, target) {
+  mts::smoothed_value<double> value(0.0, 10);
+  value.set_target(1.0);
+  EXPECT_TRUE(value.is_smoothing());
+  EXPECT_DOUBLE_EQ(value.next(), 0.1);
+
+  value.skip(8);
+  EXPECT_NEAR(value.current(), 0.9, 1e-12);
+  EXPECT_EQ(value.next(), 1.0);
+  EXPECT_FALSE(value.is_smoothing());
+  EXPECT_EQ(value.next(), 1.0);
+
+  value.set_smoothing(0);
+  value.set_target(2.0);
+  EXPECT_FALSE(value.is_smoothing());
+  EXPECT_EQ(value.current(), 2.0);
+}
+} // namespace
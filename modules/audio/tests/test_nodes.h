@@ -0,0 +1,25 @@
+#pragma once
+#include "mts/audio/graph.h"
+#include "mts/audio/vector_operations.h"
+#include <cstddef>
+
+namespace test {
+/// Multiplies its input by a constant gain.
+template <typename T>
+class gain_node : public mts::audio_node<T> {
+public:
+  gain_node(std::size_t channel_size, T gain)
+      : mts::audio_node<T>({ channel_size }, { channel_size })
+      , _gain(gain) {}
+
+  void process(const mts::audio_bus<const T>* inputs, mts::audio_bus<T>* outputs, std::size_t buffer_size) noexcept
+      override {
+    for (std::size_t c = 0; c < outputs[0].channel_size(); c++) {
+      mts::vec::mul(inputs[0][c], 1, _gain, outputs[0][c], 1, buffer_size);
+    }
+  }
+
+private:
+  T _gain;
+};
+} // namespace test.
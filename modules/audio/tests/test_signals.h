@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace test {
+/// Deterministic uniform noise in [-1, 1).
+template <typename T>
+void fill_noise(T* data, std::size_t size, std::uint32_t seed) {
+  for (std::size_t i = 0; i < size; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    data[i] = (T)((double)(seed >> 8) / (double)(1u << 24) * 2.0 - 1.0);
+  }
+}
+} // namespace test.
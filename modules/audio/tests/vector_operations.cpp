@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "mts/audio/vector_operations.h"
+#include "mts/math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
 namespace {
@@ -194,4 +198,752 @@ TEST(audio_vector_operations, sin) {
   }
 }
 
+TEST(audio_vector_operations, optimized) {
+  // Odd sizes go through both the simd loops and the scalar tail.
+  for (std::size_t size : { 1, 3, 7, 16, 33, 130 }) {
+    std::vector<float> a(size * 2);
+    for (std::size_t i = 0; i < a.size(); i++) {
+      a[i] = (float)i * 0.25f - 8.0f;
+    }
+
+    std::vector<float> b(size * 2, 0);
+    std::vector<float> c(size * 2, 0);
+
+    mts::vec::mul<mts::vec::optimized_op>(a.data(), 1, 3.0f, b.data(), 1, size);
+    mts::vec::mul<mts::vec::default_op>(a.data(), 1, 3.0f, c.data(), 1, size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::add<mts::vec::optimized_op>(a.data(), 2, 3.0f, b.data(), 2, size);
+    mts::vec::add<mts::vec::default_op>(a.data(), 2, 3.0f, c.data(), 2, size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::clip<mts::vec::optimized_op>(a.data(), 1, -2.0f, 2.0f, b.data(), 1, size);
+    mts::vec::clip<mts::vec::default_op>(a.data(), 1, -2.0f, 2.0f, c.data(), 1, size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::abs<mts::vec::optimized_op>(a.data(), 1, b.data(), 1, size);
+    mts::vec::abs<mts::vec::default_op>(a.data(), 1, c.data(), 1, size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::fill<mts::vec::optimized_op>(b.data(), 1, 5.0f, size);
+    mts::vec::fill<mts::vec::default_op>(c.data(), 1, 5.0f, size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::div<mts::vec::optimized_op>(a.data(), 1, 2.0f, b.data(), 1, size);
+    mts::vec::div<mts::vec::default_op>(a.data(), 1, 2.0f, c.data(), 1, size);
+    EXPECT_EQ(b, c);
+  }
+}
+
+TEST(audio_vector_operations, optimized_double) {
+  for (std::size_t size : { 1, 3, 7, 16, 33, 130 }) {
+    std::vector<double> a(size);
+    for (std::size_t i = 0; i < a.size(); i++) {
+      a[i] = (double)i * 0.5 + 1.0;
+    }
+
+    std::vector<double> b(size, 0);
+    std::vector<double> c(size, 0);
+
+    mts::vec::vdiv<mts::vec::optimized_op>(2.0, a.data(), 1, b.data(), 1, size);
+    mts::vec::vdiv<mts::vec::default_op>(2.0, a.data(), 1, c.data(), 1, size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::sqrt<mts::vec::optimized_op>(a.data(), b.data(), size);
+    mts::vec::sqrt<mts::vec::default_op>(a.data(), c.data(), size);
+    EXPECT_EQ(b, c);
+  }
+}
+
+TEST(audio_vector_operations, convert) {
+  constexpr std::size_t size = 37;
+  std::vector<std::int8_t> i8(size * 2);
+  std::vector<std::int16_t> i16(size * 2);
+  std::vector<mts::int24_t> i24(size * 2);
+  std::vector<std::int32_t> i32(size * 2);
+  std::vector<double> f64(size * 2);
+
+  for (std::size_t i = 0; i < size * 2; i++) {
+    int v = (int)i * 3 - 100;
+    i8[i] = (std::int8_t)v;
+    i16[i] = (std::int16_t)(v * 300);
+    i24[i] = v * 60000;
+    i32[i] = v * 10000000;
+    f64[i] = v * 0.125;
+  }
+
+  for (mts::vec::stride_t stride : { 1, 2 }) {
+    std::vector<float> b(size, 0);
+    std::vector<float> c(size, 0);
+
+    mts::vec::convert_from_int8<mts::vec::optimized_op>(i8.data(), stride, b.data(), size);
+    mts::vec::convert_from_int8<mts::vec::default_op>(i8.data(), stride, c.data(), size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::convert_from_int16<mts::vec::optimized_op>(i16.data(), stride, b.data(), size);
+    mts::vec::convert_from_int16<mts::vec::default_op>(i16.data(), stride, c.data(), size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::convert_from_int24<mts::vec::optimized_op>(i24.data(), stride, b.data(), size);
+    mts::vec::convert_from_int24<mts::vec::default_op>(i24.data(), stride, c.data(), size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::convert_from_int32<mts::vec::optimized_op>(i32.data(), stride, b.data(), size);
+    mts::vec::convert_from_int32<mts::vec::default_op>(i32.data(), stride, c.data(), size);
+    EXPECT_EQ(b, c);
+
+    mts::vec::convert_from_double<mts::vec::optimized_op>(f64.data(), stride, b.data(), size);
+    mts::vec::convert_from_double<mts::vec::default_op>(f64.data(), stride, c.data(), size);
+    EXPECT_EQ(b, c);
+
+    std::vector<double> bd(size, 0);
+    std::vector<double> cd(size, 0);
+
+    mts::vec::convert_from_int16<mts::vec::optimized_op>(i16.data(), stride, bd.data(), size);
+    mts::vec::convert_from_int16<mts::vec::default_op>(i16.data(), stride, cd.data(), size);
+    EXPECT_EQ(bd, cd);
+
+    mts::vec::convert_from_int24<mts::vec::optimized_op>(i24.data(), stride, bd.data(), size);
+    mts::vec::convert_from_int24<mts::vec::default_op>(i24.data(), stride, cd.data(), size);
+    EXPECT_EQ(bd, cd);
+
+    mts::vec::convert_from_float<mts::vec::optimized_op>(b.data(), stride, bd.data(), size / 2);
+    mts::vec::convert_from_float<mts::vec::default_op>(b.data(), stride, cd.data(), size / 2);
+    EXPECT_EQ(bd, cd);
+  }
+}
+
+TEST(audio_vector_operations, simd_isa) {
+  const mts::vec::simd_isa current = mts::vec::get_simd_isa();
+  EXPECT_TRUE(mts::vec::is_simd_isa_supported(current));
+  EXPECT_TRUE(mts::vec::is_simd_isa_supported(mts::vec::simd_isa::none));
+
+  constexpr std::size_t size = 75;
+  std::vector<float> a(size);
+  std::vector<std::int16_t> i16(size);
+  for (std::size_t i = 0; i < size; i++) {
+    a[i] = (float)i * 0.5f - 10.0f;
+    i16[i] = (std::int16_t)(i * 400 - 15000);
+  }
+
+  std::vector<float> expected_clip(size);
+  std::vector<float> expected_conv(size);
+  mts::vec::clip<mts::vec::default_op>(a.data(), 1, -4.0f, 4.0f, expected_clip.data(), 1, size);
+  mts::vec::convert_from_int16<mts::vec::default_op>(i16.data(), 1, expected_conv.data(), size);
+
+  for (mts::vec::simd_isa isa : { mts::vec::simd_isa::none, mts::vec::simd_isa::sse2, mts::vec::simd_isa::avx2,
+           mts::vec::simd_isa::avx512, mts::vec::simd_isa::neon }) {
+    if (!mts::vec::set_simd_isa(isa)) {
+      EXPECT_FALSE(mts::vec::is_simd_isa_supported(isa));
+      continue;
+    }
+
+    EXPECT_EQ(mts::vec::get_simd_isa(), isa);
+
+    std::vector<float> b(size, 0);
+    mts::vec::clip<mts::vec::optimized_op>(a.data(), 1, -4.0f, 4.0f, b.data(), 1, size);
+    EXPECT_EQ(b, expected_clip);
+
+    mts::vec::convert_from_int16<mts::vec::optimized_op>(i16.data(), 1, b.data(), size);
+    EXPECT_EQ(b, expected_conv);
+  }
+
+  EXPECT_TRUE(mts::vec::set_simd_isa(current));
+}
+
+TEST(audio_vector_operations, fused) {
+  for (std::size_t size : { 1, 5, 16, 37 }) {
+    std::vector<double> a(size * 2);
+    std::vector<double> b(size * 2);
+    std::vector<double> c(size * 2);
+    for (std::size_t i = 0; i < a.size(); i++) {
+      a[i] = (double)i * 0.25 - 3.0;
+      b[i] = (double)i * 0.5 + 1.0;
+      c[i] = 2.0 - (double)i;
+    }
+
+    std::vector<double> d(size * 2, 0);
+    std::vector<double> e(size * 2, 0);
+
+    for (mts::vec::stride_t stride : { 1, 2 }) {
+      mts::vec::sum<mts::vec::optimized_op>(a.data(), stride, b.data(), stride, d.data(), 1, size);
+      for (std::size_t i = 0; i < size; i++) {
+        EXPECT_DOUBLE_EQ(d[i], a[i * stride] + b[i * stride]);
+      }
+
+      mts::vec::sub<mts::vec::optimized_op>(a.data(), stride, b.data(), stride, d.data(), 1, size);
+      for (std::size_t i = 0; i < size; i++) {
+        EXPECT_DOUBLE_EQ(d[i], a[i * stride] - b[i * stride]);
+      }
+
+      mts::vec::mul<mts::vec::optimized_op>(a.data(), stride, b.data(), stride, d.data(), 1, size);
+      for (std::size_t i = 0; i < size; i++) {
+        EXPECT_DOUBLE_EQ(d[i], a[i * stride] * b[i * stride]);
+      }
+
+      mts::vec::div<mts::vec::optimized_op>(a.data(), stride, b.data(), stride, d.data(), 1, size);
+      for (std::size_t i = 0; i < size; i++) {
+        EXPECT_DOUBLE_EQ(d[i], a[i * stride] / b[i * stride]);
+      }
+
+      mts::vec::sum_mul<mts::vec::optimized_op>(a.data(), stride, b.data(), stride, 3.0, d.data(), 1, size);
+      mts::vec::sum_mul<mts::vec::default_op>(a.data(), stride, b.data(), stride, 3.0, e.data(), 1, size);
+      EXPECT_EQ(d, e);
+
+      mts::vec::sum_mul<mts::vec::optimized_op>(
+          a.data(), stride, b.data(), stride, c.data(), stride, d.data(), 1, size);
+      mts::vec::sum_mul<mts::vec::default_op>(a.data(), stride, b.data(), stride, c.data(), stride, e.data(), 1, size);
+      EXPECT_EQ(d, e);
+
+      mts::vec::sum_mul<mts::vec::optimized_op>(a.data(), stride, 3.0, b.data(), stride, d.data(), 1, size);
+      mts::vec::sum_mul<mts::vec::default_op>(a.data(), stride, 3.0, b.data(), stride, e.data(), 1, size);
+      EXPECT_EQ(d, e);
+
+      // The simd path may use fma.
+      mts::vec::mul_sum<mts::vec::optimized_op>(a.data(), stride, b.data(), stride, 3.0, d.data(), 1, size);
+      mts::vec::mul_sum<mts::vec::default_op>(a.data(), stride, b.data(), stride, 3.0, e.data(), 1, size);
+      for (std::size_t i = 0; i < size; i++) {
+        EXPECT_NEAR(d[i], e[i], 1e-12);
+      }
+
+      mts::vec::mul_sum<mts::vec::optimized_op>(
+          a.data(), stride, b.data(), stride, c.data(), stride, d.data(), 1, size);
+      mts::vec::mul_sum<mts::vec::default_op>(a.data(), stride, b.data(), stride, c.data(), stride, e.data(), 1, size);
+      for (std::size_t i = 0; i < size; i++) {
+        EXPECT_NEAR(d[i], e[i], 1e-12);
+      }
+
+      mts::vec::mul_sum<mts::vec::optimized_op>(a.data(), stride, 3.0, b.data(), stride, d.data(), 1, size);
+      mts::vec::mul_sum<mts::vec::default_op>(a.data(), stride, 3.0, b.data(), stride, e.data(), 1, size);
+      for (std::size_t i = 0; i < size; i++) {
+        EXPECT_NEAR(d[i], e[i], 1e-12);
+      }
+    }
+  }
+}
+
+TEST(audio_vector_operations, ramps) {
+  const mts::vec::simd_isa current = mts::vec::get_simd_isa();
+
+  for (mts::vec::simd_isa isa : { mts::vec::simd_isa::none, mts::vec::simd_isa::sse2, mts::vec::simd_isa::avx2,
+           mts::vec::simd_isa::avx512, mts::vec::simd_isa::neon }) {
+    if (!mts::vec::set_simd_isa(isa)) {
+      continue;
+    }
+
+    for (std::size_t size : { 1, 5, 16, 37, 100 }) {
+      std::vector<float> a(size * 2);
+      std::vector<float> b(size * 2);
+      for (std::size_t i = 0; i < a.size(); i++) {
+        a[i] = (float)i * 0.25f - 3.0f;
+        b[i] = 2.0f - (float)i * 0.125f;
+      }
+
+      for (mts::vec::stride_t stride : { 1, 2 }) {
+        std::vector<float> d(size * 2, 0);
+        std::vector<float> e(size * 2, 0);
+
+        auto expect_near = [&]() {
+          for (std::size_t i = 0; i < d.size(); i++) {
+            EXPECT_NEAR(d[i], e[i], 1e-4f * std::max(1.0f, std::abs(e[i]))) << "isa " << (int)isa << " i " << i;
+          }
+        };
+
+        mts::vec::ramp<mts::vec::optimized_op>(d.data(), stride, 0.5f, -0.01f, size);
+        mts::vec::ramp<mts::vec::default_op>(e.data(), stride, 0.5f, -0.01f, size);
+        expect_near();
+
+        mts::vec::exp_ramp<mts::vec::optimized_op>(d.data(), stride, 0.5f, 1.01f, size);
+        mts::vec::exp_ramp<mts::vec::default_op>(e.data(), stride, 0.5f, 1.01f, size);
+        expect_near();
+
+        mts::vec::mul_ramp<mts::vec::optimized_op>(a.data(), stride, 1.0f, 0.02f, d.data(), stride, size);
+        mts::vec::mul_ramp<mts::vec::default_op>(a.data(), stride, 1.0f, 0.02f, e.data(), stride, size);
+        expect_near();
+
+        mts::vec::mul_exp_ramp<mts::vec::optimized_op>(a.data(), stride, 1.0f, 0.99f, d.data(), stride, size);
+        mts::vec::mul_exp_ramp<mts::vec::default_op>(a.data(), stride, 1.0f, 0.99f, e.data(), stride, size);
+        expect_near();
+
+        mts::vec::mul_ramp_add<mts::vec::optimized_op>(
+            a.data(), stride, 1.0f, 0.02f, b.data(), stride, d.data(), stride, size);
+        mts::vec::mul_ramp_add<mts::vec::default_op>(
+            a.data(), stride, 1.0f, 0.02f, b.data(), stride, e.data(), stride, size);
+        expect_near();
+
+        mts::vec::mul_exp_ramp_add<mts::vec::optimized_op>(
+            a.data(), stride, 1.0f, 0.99f, b.data(), stride, d.data(), stride, size);
+        mts::vec::mul_exp_ramp_add<mts::vec::default_op>(
+            a.data(), stride, 1.0f, 0.99f, b.data(), stride, e.data(), stride, size);
+        expect_near();
+      }
+    }
+  }
+
+  EXPECT_TRUE(mts::vec::set_simd_isa(current));
+}
+
+TEST(audio_vector_operations, reductions) {
+  for (std::size_t size : { 1, 3, 8, 31, 64, 257 }) {
+    std::vector<float> a(size * 2);
+    std::vector<float> b(size * 2);
+    for (std::size_t i = 0; i < a.size(); i++) {
+      a[i] = std::sin((float)i * 0.37f) * 2.0f;
+      b[i] = std::cos((float)i * 0.11f);
+    }
+
+    for (mts::vec::stride_t stride : { 1, 2 }) {
+      float sum = 0;
+      float squares = 0;
+      float peak = 0;
+      float dot = 0;
+      for (std::size_t i = 0; i < size; i++) {
+        const float v = a[i * stride];
+        sum += v;
+        squares += v * v;
+        peak = std::max(peak, std::abs(v));
+        dot += v * b[i * stride];
+      }
+
+      EXPECT_NEAR(mts::vec::sum(a.data(), stride, size), sum, 1e-4f);
+      EXPECT_NEAR(mts::vec::sum_of_squares(a.data(), stride, size), squares, 1e-3f);
+      EXPECT_NEAR(mts::vec::rms(a.data(), stride, size), std::sqrt(squares / (float)size), 1e-5f);
+      EXPECT_EQ(mts::vec::max_abs(a.data(), stride, size), peak);
+      EXPECT_NEAR(mts::vec::dot(a.data(), stride, b.data(), stride, size), dot, 1e-3f);
+
+      const mts::vec::indexed_value<float> min_value = mts::vec::min_index(a.data(), stride, size);
+      const mts::vec::indexed_value<float> expected_min
+          = mts::vec::min_index<mts::vec::default_op>(a.data(), stride, size);
+      EXPECT_EQ(min_value.index, expected_min.index);
+      EXPECT_EQ(min_value.value, expected_min.value);
+
+      const mts::vec::indexed_value<float> max_value = mts::vec::max_index(a.data(), stride, size);
+      const mts::vec::indexed_value<float> expected_max
+          = mts::vec::max_index<mts::vec::default_op>(a.data(), stride, size);
+      EXPECT_EQ(max_value.index, expected_max.index);
+      EXPECT_EQ(max_value.value, expected_max.value);
+    }
+  }
+}
+
+TEST(audio_vector_operations, reductions_index) {
+  std::vector<double> a(100, 0.5);
+  a[41] = 3.0;
+  a[77] = 3.0;
+  a[13] = -2.0;
+  a[90] = -2.0;
+
+  mts::vec::indexed_value<double> v = mts::vec::max_index(a.data(), 1, a.size());
+  EXPECT_EQ(v.index, 41);
+  EXPECT_EQ(v.value, 3.0);
+
+  v = mts::vec::min_index(a.data(), 1, a.size());
+  EXPECT_EQ(v.index, 13);
+  EXPECT_EQ(v.value, -2.0);
+
+  v = mts::vec::max_index(a.data(), 1, 0);
+  EXPECT_EQ(v.index, 0);
+
+  EXPECT_EQ(mts::vec::rms(a.data(), 1, 0), 0.0);
+  EXPECT_EQ(mts::vec::max_abs(a.data(), 1, a.size()), 3.0);
+}
+
+template <typename O, typename T, typename Op, typename Ref>
+void check_approx(Op op, Ref ref, T min, T max, double tolerance, bool relative = false, double pole_margin = 0) {
+  // Odd size to go through the zero padded tail.
+  constexpr std::size_t size = 20001;
+  std::vector<T> a(size);
+  std::vector<T> b(size);
+  for (std::size_t i = 0; i < size; i++) {
+    a[i] = min + (max - min) * (T)i / (T)(size - 1);
+  }
+
+  const mts::vec::simd_isa current = mts::vec::get_simd_isa();
+
+  for (mts::vec::simd_isa isa : { mts::vec::simd_isa::none, mts::vec::simd_isa::sse2, mts::vec::simd_isa::avx2,
+           mts::vec::simd_isa::avx512, mts::vec::simd_isa::neon }) {
+    if (!mts::vec::set_simd_isa(isa)) {
+      continue;
+    }
+
+    op(a.data(), b.data(), size);
+
+    double max_error = 0;
+    for (std::size_t i = 0; i < size; i++) {
+      // Points closer than pole_margin to pi / 2 + k * pi are skipped.
+      const double pole_distance = std::remainder((double)a[i] - mts::math::half_pi<double>, mts::math::pi<double>);
+      if (pole_margin > 0 && std::abs(pole_distance) < pole_margin) {
+        continue;
+      }
+
+      const double expected = ref((double)a[i]);
+      const double scale = relative ? std::max(1.0, std::abs(expected)) : 1.0;
+      max_error = std::max(max_error, std::abs((double)b[i] - expected) / scale);
+    }
+
+    EXPECT_LE(max_error, tolerance) << "isa " << (int)isa;
+  }
+
+  EXPECT_TRUE(mts::vec::set_simd_isa(current));
+}
+
+template <typename O, typename T>
+void check_approx_ops(double tolerance) {
+  const auto sin_ref = [](double x) { return std::sin(x); };
+  const auto cos_ref = [](double x) { return std::cos(x); };
+  const auto tanh_ref = [](double x) { return std::tanh(x); };
+
+  check_approx<O, T>(
+      [](const T* s, T* d, std::size_t n) { mts::vec::sin<O>(s, d, n); }, sin_ref, (T)-25000, (T)25000, tolerance);
+  check_approx<O, T>(
+      [](const T* s, T* d, std::size_t n) { mts::vec::cos<O>(s, d, n); }, cos_ref, (T)-25000, (T)25000, tolerance);
+  check_approx<O, T>(
+      [](const T* s, T* d, std::size_t n) { mts::vec::tanh<O>(s, d, n); }, tanh_ref, (T)-20, (T)20, tolerance);
+
+  // Away from the poles, over many periods to go through the range reduction.
+  const auto tan_op = [](const T* s, T* d, std::size_t n) { mts::vec::tan<O>(s, d, n); };
+  const auto tan_ref = [](double x) { return std::tan(x); };
+  check_approx<O, T>(tan_op, tan_ref, (T)-1.5, (T)1.5, tolerance, true);
+  check_approx<O, T>(tan_op, tan_ref, (T)-200, (T)200, tolerance, true, 0.2);
+}
+
+TEST(audio_vector_operations, approx) {
+  check_approx_ops<mts::vec::approx_op, float>(1e-6);
+  check_approx_ops<mts::vec::approx_op, double>(1e-6);
+  check_approx_ops<mts::vec::fast_approx_op, float>(1e-3);
+  check_approx_ops<mts::vec::fast_approx_op, double>(1e-3);
+
+  // Exact at 0 and saturated far out.
+  std::vector<float> a = { 0.0f, 1000.0f, -1000.0f };
+  std::vector<float> b(a.size());
+  mts::vec::tanh<mts::vec::approx_op>(a.data(), b.data(), a.size());
+  EXPECT_EQ(b[0], 0.0f);
+  EXPECT_NEAR(b[1], 1.0f, 1e-6f);
+  EXPECT_NEAR(b[2], -1.0f, 1e-6f);
+
+  mts::vec::sin<mts::vec::fast_approx_op>(a.data(), b.data(), 1);
+  EXPECT_EQ(b[0], 0.0f);
+}
+
+template <typename S, typename T, typename Op, typename RefOp>
+void check_deinterleave(Op op, RefOp ref_op) {
+  for (std::size_t n_channels : { 1, 2, 3, 4, 5, 7, 8, 9, 13, 16, 17, 24 }) {
+    for (std::size_t stride : { n_channels, n_channels + 3 }) {
+      for (std::size_t length : { 0, 1, 37, 100 }) {
+        // Exactly length frames, the kernels must not read past the last one.
+        std::vector<S> input(length ? (length - 1) * stride + n_channels : 0);
+        for (std::size_t i = 0; i < input.size(); i++) {
+          input[i] = (S)(((int)(i * 7919) % 201) - 100);
+        }
+
+        std::vector<std::vector<T>> expected(n_channels, std::vector<T>(length));
+        std::vector<std::vector<T>> output(n_channels, std::vector<T>(length));
+        std::vector<T*> expected_ptrs;
+        std::vector<T*> output_ptrs;
+        for (std::size_t c = 0; c < n_channels; c++) {
+          expected_ptrs.push_back(expected[c].data());
+          output_ptrs.push_back(output[c].data());
+        }
+
+        ref_op(input.data(), (mts::vec::stride_t)stride, expected_ptrs.data(), n_channels, length);
+        op(input.data(), (mts::vec::stride_t)stride, output_ptrs.data(), n_channels, length);
+        EXPECT_EQ(output, expected) << n_channels << " channels, stride " << stride << ", length " << length;
+      }
+    }
+  }
+}
+
+template <typename S, typename T, typename Op, typename RefOp>
+void check_interleave(Op op, RefOp ref_op) {
+  for (std::size_t n_channels : { 1, 2, 3, 4, 5, 7, 8, 9, 13, 16, 17, 24 }) {
+    for (std::size_t stride : { n_channels, n_channels + 2 }) {
+      for (std::size_t length : { 0, 1, 37, 100 }) {
+        std::vector<std::vector<S>> input(n_channels, std::vector<S>(length));
+        std::vector<const S*> input_ptrs;
+        for (std::size_t c = 0; c < n_channels; c++) {
+          for (std::size_t i = 0; i < length; i++) {
+            input[c][i] = (S)(c * 1000 + i) * (S)0.25;
+          }
+
+          input_ptrs.push_back(input[c].data());
+        }
+
+        // Values between the frames must be left untouched.
+        std::vector<T> expected(length * stride, (T)-1);
+        std::vector<T> output(length * stride, (T)-1);
+
+        ref_op(input_ptrs.data(), expected.data(), (mts::vec::stride_t)stride, n_channels, length);
+        op(input_ptrs.data(), output.data(), (mts::vec::stride_t)stride, n_channels, length);
+        EXPECT_EQ(output, expected) << n_channels << " channels, stride " << stride << ", length " << length;
+      }
+    }
+  }
+}
+
+TEST(audio_vector_operations, interleave) {
+  namespace vec = mts::vec;
+  const vec::simd_isa current = vec::get_simd_isa();
+
+  for (vec::simd_isa isa :
+      { vec::simd_isa::none, vec::simd_isa::sse2, vec::simd_isa::avx2, vec::simd_isa::avx512, vec::simd_isa::neon }) {
+    if (!vec::set_simd_isa(isa)) {
+      continue;
+    }
+
+    check_deinterleave<std::int16_t, float>(
+        [](auto... args) { vec::deinterleave_from_int16(args...); },
+        [](auto... args) { vec::deinterleave_from_int16<vec::default_op>(args...); });
+
+    check_deinterleave<std::int8_t, double>(
+        [](auto... args) { vec::deinterleave_from_int8(args...); },
+        [](auto... args) { vec::deinterleave_from_int8<vec::default_op>(args...); });
+
+    check_deinterleave<std::int32_t, double>(
+        [](auto... args) { vec::deinterleave_from_int32(args...); },
+        [](auto... args) { vec::deinterleave_from_int32<vec::default_op>(args...); });
+
+    check_deinterleave<mts::int24_t, float>(
+        [](auto... args) { vec::deinterleave_from_int24(args...); },
+        [](auto... args) { vec::deinterleave_from_int24<vec::default_op>(args...); });
+
+    check_deinterleave<float, float>(
+        [](auto... args) { vec::deinterleave_from_float(args...); },
+        [](auto... args) { vec::deinterleave_from_float<vec::default_op>(args...); });
+
+    check_deinterleave<double, float>(
+        [](auto... args) { vec::deinterleave_from_double(args...); },
+        [](auto... args) { vec::deinterleave_from_double<vec::default_op>(args...); });
+
+    check_interleave<float, float>(
+        [](auto... args) { vec::interleave_from_float(args...); },
+        [](auto... args) { vec::interleave_from_float<vec::default_op>(args...); });
+
+    check_interleave<double, float>(
+        [](auto... args) { vec::interleave_from_double(args...); },
+        [](auto... args) { vec::interleave_from_double<vec::default_op>(args...); });
+
+    check_interleave<float, double>(
+        [](auto... args) { vec::interleave_from_float(args...); },
+        [](auto... args) { vec::interleave_from_float<vec::default_op>(args...); });
+  }
+
+  EXPECT_TRUE(vec::set_simd_isa(current));
+
+  // Integer samples are scaled to [-1, 1).
+  const std::int16_t frames[] = { -32768, 16384, 0, -16384 };
+  float left[2];
+  float right[2];
+  float* channels[] = { left, right };
+  vec::deinterleave_from_int16(frames, 2, channels, 2, 2);
+  EXPECT_EQ(left[0], -1.0f);
+  EXPECT_EQ(right[0], 0.5f);
+  EXPECT_EQ(left[1], 0.0f);
+  EXPECT_EQ(right[1], -0.5f);
+}
+
+template <typename T>
+void check_int24() {
+  namespace vec = mts::vec;
+
+  for (std::size_t length : { 0, 1, 5, 17, 37, 100 }) {
+    for (vec::stride_t stride : { 1, 3 }) {
+      // Exactly sized buffers, nothing may be read or written past the last sample.
+      std::vector<mts::int24_t> packed((length ? (length - 1) * stride + 1 : 0));
+      for (std::size_t i = 0; i < packed.size(); i++) {
+        packed[i] = (std::int32_t)((i * 2654435761u) & 0xFFFFFF) - 8388608;
+      }
+
+      std::vector<T> expected(length);
+      std::vector<T> output(length);
+      vec::convert_from_int24<vec::default_op>(packed.data(), stride, expected.data(), length);
+      vec::convert_from_int24(packed.data(), stride, output.data(), length);
+      EXPECT_EQ(output, expected) << "length " << length << ", stride " << stride;
+
+      // Rounded to nearest (ties to even) and saturated.
+      std::vector<T> input(length);
+      for (std::size_t i = 0; i < length; i++) {
+        input[i] = (T)((double)(i * 2654435761u % 20000000) - 10000000.0) + (i % 3 ? (T)0.5 : (T)0.25);
+      }
+
+      std::vector<mts::int24_t> expected_packed(packed.size(), mts::int24_t(0x5A5A5A));
+      std::vector<mts::int24_t> output_packed(packed.size(), mts::int24_t(0x5A5A5A));
+      vec::convert_to_int24<vec::default_op>(input.data(), 1, expected_packed.data(), stride, length);
+      vec::convert_to_int24(input.data(), 1, output_packed.data(), stride, length);
+      EXPECT_EQ(output_packed, expected_packed) << "length " << length << ", stride " << stride;
+    }
+  }
+
+  for (std::size_t n_channels : { 1, 2, 3, 5, 8, 17 }) {
+    for (std::size_t stride : { n_channels, n_channels + 2 }) {
+      const std::size_t length = 37;
+      std::vector<std::vector<T>> input(n_channels, std::vector<T>(length));
+      std::vector<const T*> input_ptrs;
+      for (std::size_t c = 0; c < n_channels; c++) {
+        for (std::size_t i = 0; i < length; i++) {
+          input[c][i] = (T)((double)((c * 7919 + i * 104729) % 2501) / 1000.0 - 1.25);
+        }
+
+        input_ptrs.push_back(input[c].data());
+      }
+
+      std::vector<mts::int24_t> expected(length * stride, mts::int24_t(-1));
+      std::vector<mts::int24_t> output(length * stride, mts::int24_t(-1));
+      vec::interleave_to_int24<vec::default_op>(
+          input_ptrs.data(), expected.data(), (vec::stride_t)stride, n_channels, length);
+      vec::interleave_to_int24(input_ptrs.data(), output.data(), (vec::stride_t)stride, n_channels, length);
+      EXPECT_EQ(output, expected) << n_channels << " channels, stride " << stride;
+
+      // Round trip through deinterleave_from_int24.
+      std::vector<std::vector<T>> decoded(n_channels, std::vector<T>(length));
+      std::vector<T*> decoded_ptrs;
+      for (std::size_t c = 0; c < n_channels; c++) {
+        decoded_ptrs.push_back(decoded[c].data());
+      }
+
+      vec::deinterleave_from_int24(output.data(), (vec::stride_t)stride, decoded_ptrs.data(), n_channels, length);
+      for (std::size_t c = 0; c < n_channels; c++) {
+        for (std::size_t i = 0; i < length; i++) {
+          const T clipped = std::clamp<T>(input[c][i], (T)-1, (T)(8388607.0 / 8388608.0));
+          EXPECT_NEAR(decoded[c][i], clipped, 1.0 / 8388608.0);
+        }
+      }
+    }
+  }
+}
+
+TEST(audio_vector_operations, int24) {
+  namespace vec = mts::vec;
+  const vec::simd_isa current = vec::get_simd_isa();
+
+  for (vec::simd_isa isa :
+      { vec::simd_isa::none, vec::simd_isa::sse2, vec::simd_isa::avx2, vec::simd_isa::avx512, vec::simd_isa::neon }) {
+    if (!vec::set_simd_isa(isa)) {
+      continue;
+    }
+
+    check_int24<float>();
+    check_int24<double>();
+  }
+
+  EXPECT_TRUE(vec::set_simd_isa(current));
+
+  const float input[] = { 1.0f, -1.0f, 0.5f, -2.0f, 0.49999997f / 8388608.0f };
+  float left[] = { input[0], input[2], input[4] };
+  float right[] = { input[1], input[3], 0.0f };
+  const float* channels[] = { left, right };
+  mts::int24_t frames[6];
+  vec::interleave_to_int24(channels, frames, 2, 2, 3);
+  EXPECT_EQ(frames[0], 8388607);
+  EXPECT_EQ(frames[1], -8388608);
+  EXPECT_EQ(frames[2], 4194304);
+  EXPECT_EQ(frames[3], -8388608);
+  EXPECT_EQ(frames[4], 0);
+  EXPECT_EQ(frames[5], 0);
+}
+
+template <typename T, typename D, typename Op, typename RefOp, typename IOp, typename IRefOp>
+void check_encode(Op op, RefOp ref_op, IOp iop, IRefOp iref_op) {
+  constexpr T scale = mts::vec::int_sample_range<D, T>::scale;
+
+  for (std::size_t length : { 0, 1, 5, 17, 37, 100 }) {
+    for (mts::vec::stride_t stride : { 1, 3 }) {
+      // Values up to 1.5 times the integer range, with halves to check the rounding.
+      std::vector<T> input(length * stride);
+      for (std::size_t i = 0; i < input.size(); i++) {
+        input[i] = (T)((double)((i * 7919) % 301) / 100.0 - 1.5) * scale + (i % 2 ? (T)0.5 : (T)0);
+      }
+
+      std::vector<D> expected(length * stride, (D)0x5A);
+      std::vector<D> output(length * stride, (D)0x5A);
+      ref_op(input.data(), stride, expected.data(), 1, length);
+      op(input.data(), stride, output.data(), 1, length);
+      EXPECT_EQ(output, expected) << "length " << length << ", stride " << stride;
+
+      ref_op(input.data(), 1, expected.data(), stride, length);
+      op(input.data(), 1, output.data(), stride, length);
+      EXPECT_EQ(output, expected) << "length " << length << ", stride " << stride;
+    }
+  }
+
+  for (std::size_t n_channels : { 1, 2, 3, 5, 8, 17 }) {
+    for (std::size_t stride : { n_channels, n_channels + 2 }) {
+      const std::size_t length = 37;
+      std::vector<std::vector<T>> input(n_channels, std::vector<T>(length));
+      std::vector<const T*> input_ptrs;
+      for (std::size_t c = 0; c < n_channels; c++) {
+        for (std::size_t i = 0; i < length; i++) {
+          input[c][i] = (T)((double)((c * 7919 + i * 104729) % 2501) / 1000.0 - 1.25);
+        }
+
+        input_ptrs.push_back(input[c].data());
+      }
+
+      std::vector<D> expected(length * stride, (D)-1);
+      std::vector<D> output(length * stride, (D)-1);
+      iref_op(input_ptrs.data(), expected.data(), (mts::vec::stride_t)stride, n_channels, length);
+      iop(input_ptrs.data(), output.data(), (mts::vec::stride_t)stride, n_channels, length);
+      EXPECT_EQ(output, expected) << n_channels << " channels, stride " << stride;
+    }
+  }
+}
+
+TEST(audio_vector_operations, encode) {
+  namespace vec = mts::vec;
+  const vec::simd_isa current = vec::get_simd_isa();
+
+  for (vec::simd_isa isa :
+      { vec::simd_isa::none, vec::simd_isa::sse2, vec::simd_isa::avx2, vec::simd_isa::avx512, vec::simd_isa::neon }) {
+    if (!vec::set_simd_isa(isa)) {
+      continue;
+    }
+
+    check_encode<float, std::int8_t>([](auto... args) { vec::convert_to_int8(args...); },
+        [](auto... args) { vec::convert_to_int8<vec::default_op>(args...); },
+        [](auto... args) { vec::interleave_to_int8(args...); },
+        [](auto... args) { vec::interleave_to_int8<vec::default_op>(args...); });
+
+    check_encode<double, std::int8_t>([](auto... args) { vec::convert_to_int8(args...); },
+        [](auto... args) { vec::convert_to_int8<vec::default_op>(args...); },
+        [](auto... args) { vec::interleave_to_int8(args...); },
+        [](auto... args) { vec::interleave_to_int8<vec::default_op>(args...); });
+
+    check_encode<float, std::int16_t>([](auto... args) { vec::convert_to_int16(args...); },
+        [](auto... args) { vec::convert_to_int16<vec::default_op>(args...); },
+        [](auto... args) { vec::interleave_to_int16(args...); },
+        [](auto... args) { vec::interleave_to_int16<vec::default_op>(args...); });
+
+    check_encode<double, std::int16_t>([](auto... args) { vec::convert_to_int16(args...); },
+        [](auto... args) { vec::convert_to_int16<vec::default_op>(args...); },
+        [](auto... args) { vec::interleave_to_int16(args...); },
+        [](auto... args) { vec::interleave_to_int16<vec::default_op>(args...); });
+
+    check_encode<float, std::int32_t>([](auto... args) { vec::convert_to_int32(args...); },
+        [](auto... args) { vec::convert_to_int32<vec::default_op>(args...); },
+        [](auto... args) { vec::interleave_to_int32(args...); },
+        [](auto... args) { vec::interleave_to_int32<vec::default_op>(args...); });
+
+    check_encode<double, std::int32_t>([](auto... args) { vec::convert_to_int32(args...); },
+        [](auto... args) { vec::convert_to_int32<vec::default_op>(args...); },
+        [](auto... args) { vec::interleave_to_int32(args...); },
+        [](auto... args) { vec::interleave_to_int32<vec::default_op>(args...); });
+  }
+
+  EXPECT_TRUE(vec::set_simd_isa(current));
+
+  // Saturated at both ends, the float 32 bit maximum is the largest float below 2^31.
+  const float input[] = { 2.0f, -2.0f, 1.0f, -1.0f };
+  const float* channels[] = { input };
+  std::int16_t i16[4];
+  vec::interleave_to_int16(channels, i16, 1, 1, 4);
+  EXPECT_EQ(i16[0], 32767);
+  EXPECT_EQ(i16[1], -32768);
+  EXPECT_EQ(i16[2], 32767);
+  EXPECT_EQ(i16[3], -32768);
+
+  std::int32_t i32[4];
+  vec::interleave_to_int32(channels, i32, 1, 1, 4);
+  EXPECT_EQ(i32[0], 2147483520);
+  EXPECT_EQ(i32[1], -2147483647 - 1);
+  EXPECT_EQ(i32[2], 2147483520);
+}
 } // namespace
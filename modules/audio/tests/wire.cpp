@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "mts/audio/wire.h"
 #include <array>
+#include <cmath>
 #include <map>
 #include <unordered_map>
 #include <list>
@@ -243,4 +244,226 @@ TEST(audio_wire, copy) {
     EXPECT_EQ(w2[4], 0);
   }
 }
+TEST(audio_wire, operators) {
+  std::vector<float> vec = { 1, 2, 3, 4, 5 };
+  std::vector<float> other = { 2, 2, 2, 2, 2 };
+  mts::wire<float> w(vec);
+  mts::wire<const float> o(other);
+
+  w += o;
+  EXPECT_EQ(vec, std::vector<float>({ 3, 4, 5, 6, 7 }));
+
+  w -= o;
+  EXPECT_EQ(vec, std::vector<float>({ 1, 2, 3, 4, 5 }));
+
+  w *= o;
+  EXPECT_EQ(vec, std::vector<float>({ 2, 4, 6, 8, 10 }));
+
+  w /= o;
+  EXPECT_EQ(vec, std::vector<float>({ 1, 2, 3, 4, 5 }));
+
+  w += 1.0f;
+  w -= 2.0f;
+  w /= 2.0f;
+  EXPECT_EQ(vec, std::vector<float>({ 0, 0.5f, 1, 1.5f, 2 }));
+}
+
+TEST(audio_wire, fused) {
+  std::vector<float> vec = { 1, 2, 3, 4, 5 };
+  std::vector<float> in1 = { 1, 1, 1, 1, 1 };
+  std::vector<float> in2 = { 2, 2, 2, 2, 2 };
+  mts::wire<float, 5> w(vec.data());
+  mts::wire<const float> i1(in1);
+  mts::wire<const float> i2(in2);
+
+  w.add_scaled(i2, 0.5f);
+  EXPECT_EQ(vec, std::vector<float>({ 2, 3, 4, 5, 6 }));
+
+  w.add_mul(i1, 2.0f);
+  EXPECT_EQ(vec, std::vector<float>({ 6, 8, 10, 12, 14 }));
+
+  w.add_mul(i1, i2);
+  EXPECT_EQ(vec, std::vector<float>({ 14, 18, 22, 26, 30 }));
+
+  w.add_mul(-2.0f, i2);
+  EXPECT_EQ(vec, std::vector<float>({ 24, 32, 40, 48, 56 }));
+
+  w.mul_add(i2, -8.0f);
+  EXPECT_EQ(vec, std::vector<float>({ 40, 56, 72, 88, 104 }));
+
+  w.mul_add(0.5f, i2);
+  EXPECT_EQ(vec, std::vector<float>({ 22, 30, 38, 46, 54 }));
+
+  w.mul_add(i1, i2);
+  EXPECT_EQ(vec, std::vector<float>({ 24, 32, 40, 48, 56 }));
+}
+
+TEST(audio_wire, ramps) {
+  std::vector<float> vec(5);
+  std::vector<float> in = { 2, 2, 2, 2, 2 };
+  mts::wire<float> w(vec);
+  mts::wire<const float> i(in);
+
+  w.ramp(1.0f, 0.5f);
+  EXPECT_EQ(vec, std::vector<float>({ 1, 1.5f, 2, 2.5f, 3 }));
+
+  w.mul_ramp(1.0f, 1.0f);
+  EXPECT_EQ(vec, std::vector<float>({ 1, 3, 6, 10, 15 }));
+
+  w.exp_ramp(1.0f, 2.0f);
+  EXPECT_EQ(vec, std::vector<float>({ 1, 2, 4, 8, 16 }));
+
+  w.mul_exp_ramp(16.0f, 0.5f);
+  EXPECT_EQ(vec, std::vector<float>({ 16, 16, 16, 16, 16 }));
+
+  w.mul_ramp_add(0.0f, 0.25f, i);
+  EXPECT_EQ(vec, std::vector<float>({ 2, 6, 10, 14, 18 }));
+
+  w.mul_exp_ramp_add(1.0f, 0.5f, i);
+  EXPECT_EQ(vec, std::vector<float>({ 4, 5, 4.5f, 3.75f, 3.125f }));
+
+  w.add_ramped(i, 0.0f, 1.0f);
+  EXPECT_EQ(vec, std::vector<float>({ 4, 7, 8.5f, 9.75f, 11.125f }));
+
+  w.add_exp_ramped(i, 1.0f, 2.0f);
+  EXPECT_EQ(vec, std::vector<float>({ 6, 11, 16.5f, 25.75f, 43.125f }));
+}
+
+TEST(audio_wire, reductions) {
+  std::vector<float> vec = { 1, -4, 3, 2, -1 };
+  std::vector<float> other = { 2, 1, 0, 1, 2 };
+  mts::wire<const float> w(vec);
+
+  EXPECT_EQ(w.sum(), 1.0f);
+  EXPECT_EQ(w.sum_of_squares(), 31.0f);
+  EXPECT_FLOAT_EQ(w.rms(), std::sqrt(31.0f / 5.0f));
+  EXPECT_EQ(w.max_abs(), 4.0f);
+  EXPECT_EQ(w.min_index().index, 1);
+  EXPECT_EQ(w.min_index().value, -4.0f);
+  EXPECT_EQ(w.max_index().index, 2);
+  EXPECT_EQ(w.max_index().value, 3.0f);
+  EXPECT_EQ(w.dot(mts::wire<const float>(other)), -2.0f);
+}
+
+template <std::size_t N>
+void check_fixed_ops() {
+  std::vector<float> a(N);
+  std::vector<float> b(N);
+  for (std::size_t i = 0; i < N; i++) {
+    a[i] = (float)i * 0.25f - 3.0f;
+    b[i] = (float)(i % 7) + 1.0f;
+  }
+
+  std::vector<float> fixed_out = a;
+  std::vector<float> dynamic_out = a;
+  mts::wire<float, N> fw(fixed_out.data());
+  mts::wire<float> dw(dynamic_out);
+  mts::wire<const float, N> fb(b.data());
+  mts::wire<const float> db(b);
+
+  fw += fb;
+  dw += db;
+  fw *= 0.5f;
+  dw *= 0.5f;
+  fw.mul_add(fb, 2.0f);
+  dw.mul_add(db, 2.0f);
+  fw.add_mul(1.0f, fb);
+  dw.add_mul(1.0f, db);
+  fw /= fb;
+  dw /= db;
+  fw.add_scaled(fb, -0.25f);
+  dw.add_scaled(db, -0.25f);
+  for (std::size_t i = 0; i < N; i++) {
+    EXPECT_FLOAT_EQ(fixed_out[i], dynamic_out[i]) << N << " " << i;
+  }
+
+  EXPECT_FLOAT_EQ(fw.sum(), dw.sum()) << N;
+  EXPECT_FLOAT_EQ(fw.sum_of_squares(), dw.sum_of_squares()) << N;
+  EXPECT_FLOAT_EQ(fw.rms(), dw.rms()) << N;
+  EXPECT_FLOAT_EQ(fw.max_abs(), dw.max_abs()) << N;
+  EXPECT_FLOAT_EQ(fw.dot(fb), dw.dot(db)) << N;
+
+  fw.copy(fb);
+  EXPECT_EQ(fixed_out, b) << N;
+
+  fw.fill(2.0f);
+  EXPECT_EQ(fixed_out, std::vector<float>(N, 2.0f)) << N;
+
+  fw.clear();
+  EXPECT_EQ(fixed_out, std::vector<float>(N, 0.0f)) << N;
+
+  // Dynamic inputs go through the checked path.
+  fw += db;
+  fw.mul_add(db, fb);
+  EXPECT_FLOAT_EQ(fw.dot(db), fw.dot(fb)) << N;
+  for (std::size_t i = 0; i < N; i++) {
+    EXPECT_FLOAT_EQ(fixed_out[i], b[i] * b[i] + b[i]) << N << " " << i;
+  }
+}
+
+TEST(audio_wire, fixed_ops) {
+  check_fixed_ops<1>();
+  check_fixed_ops<13>();
+  check_fixed_ops<16>();
+  check_fixed_ops<64>();
+  check_fixed_ops<128>();
+  check_fixed_ops<300>();
+}
+
+TEST(audio_wire, expressions) {
+  std::vector<float> a = { 1, 2, 3, 4, 5 };
+  std::vector<float> b = { 5, 4, 3, 2, 1 };
+  std::vector<float> c = { 1, 1, 2, 2, 3 };
+  std::vector<float> out(5);
+
+  mts::wire<const float> wa(a);
+  mts::wire<const float> wb(b);
+  mts::wire<const float> wc(c);
+  mts::wire<float> w(out);
+
+  w = (wa + wb) * 0.5f + wc;
+  EXPECT_EQ(out, std::vector<float>({ 4, 4, 5, 5, 6 }));
+
+  w = -wa / 2.0f - 1.0f;
+  EXPECT_EQ(out, std::vector<float>({ -1.5f, -2, -2.5f, -3, -3.5f }));
+
+  w = 2.0f * wa - wb * wc;
+  EXPECT_EQ(out, std::vector<float>({ -3, 0, 0, 4, 7 }));
+
+  // The destination can be an operand.
+  w += w * wc;
+  EXPECT_EQ(out, std::vector<float>({ -6, 0, 0, 12, 28 }));
+
+  w *= wa - 1.0f;
+  EXPECT_EQ(out, std::vector<float>({ 0, 0, 0, 36, 112 }));
+
+  // Assigning a wire still rebinds it.
+  w = wa + 0.0f;
+  mts::wire<float> w2(b);
+  w = w2;
+  EXPECT_EQ(w.data(), b.data());
+  EXPECT_EQ(out, a);
+
+  // Static extents are propagated.
+  std::array<float, 5> fixed_out;
+  mts::wire<float, 5> fw(fixed_out);
+  mts::wire<const float, 3> fa(a);
+  auto e = wa * fa;
+  static_assert(decltype(e)::extent == 3);
+  EXPECT_EQ(e.size(), 3);
+
+  fw = wa + wb;
+  EXPECT_EQ(fixed_out, (std::array<float, 5>{ 6, 6, 6, 6, 6 }));
+
+  mts::wire<float, 3> fw3(fixed_out.data());
+  fw3 = e - 1.0f;
+  EXPECT_EQ(fixed_out, (std::array<float, 5>{ 0, 3, 8, 6, 6 }));
+
+  // Mixed precision.
+  w = mts::wire<float>(out);
+  std::vector<double> d = { 0.5, 0.5, 0.5, 0.5, 0.5 };
+  w = mts::wire<double>(d) * wa;
+  EXPECT_EQ(out, std::vector<float>({ 0.5f, 1, 1.5f, 2, 2.5f }));
+}
+
 } // namespace
@@ -409,6 +409,11 @@
   #define __MTS_USE_ACCELERATE__ 1
 #endif // __MTS_MACOS__ || __MTS_IOS__
 
+// Portable simd (sse2/avx2/neon) is used whenever the accelerate framework isn't available.
+#if !__MTS_USE_ACCELERATE__ && !defined(__MTS_NO_SIMD__) && (__MTS_ARCH_X86_64__ || __MTS_ARCH_ARM_64__)
+  #define __MTS_USE_SIMD__ 1
+#endif // !__MTS_USE_ACCELERATE__ && (__MTS_ARCH_X86_64__ || __MTS_ARCH_ARM_64__)
+
 #if __MTS_MSVC__
   #define MTS_PUSH_MACROS __pragma(push_macro("min")) __pragma(push_macro("max"))
   #define MTS_POP_MACROS __pragma(pop_macro("min")) __pragma(pop_macro("max"))
@@ -37,6 +37,7 @@
 
 #include <iostream>
 #include <cstdint>
+#include <cstring>
 
 MTS_BEGIN_NAMESPACE
 
@@ -213,6 +214,49 @@ MTS_PACKED_END
 
 static_assert(sizeof(int24_t) == 3, "int24_t size should be 3");
 
+///
+/// Bulk conversions between packed 24 bit samples and 32 bit integers.
+///
+/// Four samples (12 bytes) are moved at a time as three 32 bit words instead
+/// of going through the bitfield one sample at a time. Like the rest of the
+/// audio code, this assumes a little endian target.
+///
+inline void int24_to_int32(const int24_t* src, std::int32_t* dst, std::size_t size) noexcept {
+  const auto sign_extend = [](std::uint32_t v) { return (std::int32_t)(v << 8) >> 8; };
+
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    std::uint32_t w[3];
+    std::memcpy(w, src + i, sizeof(w));
+    dst[i] = sign_extend(w[0]);
+    dst[i + 1] = sign_extend((w[0] >> 24) | (w[1] << 8));
+    dst[i + 2] = sign_extend((w[1] >> 16) | (w[2] << 16));
+    dst[i + 3] = (std::int32_t)w[2] >> 8;
+  }
+
+  for (; i < size; i++) {
+    dst[i] = src[i];
+  }
+}
+
+/// Keeps the low 24 bits of each value (same as assigning an int to an int24_t).
+inline void int32_to_int24(const std::int32_t* src, int24_t* dst, std::size_t size) noexcept {
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const std::uint32_t v[4] = { (std::uint32_t)src[i], (std::uint32_t)src[i + 1], (std::uint32_t)src[i + 2],
+      (std::uint32_t)src[i + 3] };
+
+    const std::uint32_t w[3] = { (v[0] & 0xFFFFFF) | (v[1] << 24), ((v[1] >> 8) & 0xFFFF) | (v[2] << 16),
+      ((v[2] >> 16) & 0xFF) | (v[3] << 8) };
+
+    std::memcpy(dst + i, w, sizeof(w));
+  }
+
+  for (; i < size; i++) {
+    dst[i] = src[i];
+  }
+}
+
 MTS_END_NAMESPACE
 
 //
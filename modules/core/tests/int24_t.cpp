@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include "mts/int24_t.h"
+#include <vector>
+
+namespace {
+TEST(int24_t, bulk_conversion) {
+  const std::int32_t values[] = { 0, 1, -1, 8388607, -8388608, 0x123456, -0x123456, 255, -256, 65536 };
+
+  for (std::size_t size = 0; size < 24; size++) {
+    std::vector<std::int32_t> input(size);
+    for (std::size_t i = 0; i < size; i++) {
+      input[i] = values[i % std::size(values)];
+    }
+
+    std::vector<mts::int24_t> packed(size + 1, mts::int24_t(0x5A5A5A));
+    mts::int32_to_int24(input.data(), packed.data(), size);
+
+    std::vector<std::int32_t> output(size);
+    mts::int24_to_int32(packed.data(), output.data(), size);
+
+    for (std::size_t i = 0; i < size; i++) {
+      EXPECT_EQ((std::int32_t)packed[i], input[i]);
+      EXPECT_EQ(output[i], input[i]);
+    }
+
+    EXPECT_EQ((std::int32_t)packed[size], 0x5A5A5A);
+  }
+}
+} // namespace